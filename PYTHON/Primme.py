@@ -112,7 +112,7 @@ except __builtin__.Exception:
 
 
 
-__all__ = ['PrimmeParams', 'sprimme', 'cprimme', 'dprimme', 'zprimme', 'eigsh', 'PrimmeError', 'PRIMME_Arnoldi', 'PRIMME_DEFAULT_METHOD', 'PRIMME_DEFAULT_MIN_MATVECS', 'PRIMME_DEFAULT_MIN_TIME', 'PRIMME_DYNAMIC', 'PRIMME_GD', 'PRIMME_GD_Olsen_plusK', 'PRIMME_GD_plusK', 'PRIMME_JDQMR', 'PRIMME_JDQMR_ETol', 'PRIMME_JDQR', 'PRIMME_JD_Olsen_plusK', 'PRIMME_LOBPCG_OrthoBasis', 'PRIMME_LOBPCG_OrthoBasis_Window', 'PRIMME_RQI', 'PRIMME_SUBSPACE_ITERATION', 'primme_adaptive', 'primme_adaptive_ETolerance', 'primme_closest_abs', 'primme_closest_geq', 'primme_closest_leq', 'primme_decreasing_LTolerance', 'primme_dtr', 'primme_full_LTolerance', 'primme_init_default', 'primme_init_krylov', 'primme_init_random', 'primme_init_user', 'primme_largest', 'primme_largest_abs', 'primme_proj_RR', 'primme_proj_default', 'primme_proj_harmonic', 'primme_proj_refined', 'primme_smallest', 'primme_thick', 'PrimmeSvdsParams', 'svds', 'primme_svds_augmented', 'primme_svds_closest_abs', 'primme_svds_default', 'primme_svds_hybrid', 'primme_svds_largest', 'primme_svds_normalequations', 'primme_svds_op_AAt', 'primme_svds_op_AtA', 'primme_svds_op_augmented', 'primme_svds_op_none', 'primme_svds_smallest', 'sprimme_svds', 'cprimme_svds', 'dprimme_svds', 'zprimme_svds', 'PrimmeSvdsError']
+__all__ = ['PrimmeParams', 'sprimme', 'cprimme', 'dprimme', 'zprimme', 'eigsh', 'PrimmeError', 'PRIMME_Arnoldi', 'PRIMME_DEFAULT_METHOD', 'PRIMME_DEFAULT_MIN_MATVECS', 'PRIMME_DEFAULT_MIN_TIME', 'PRIMME_DYNAMIC', 'PRIMME_GD', 'PRIMME_GD_Olsen_plusK', 'PRIMME_GD_plusK', 'PRIMME_JDQMR', 'PRIMME_JDQMR_ETol', 'PRIMME_JDQR', 'PRIMME_JD_Olsen_plusK', 'PRIMME_LOBPCG_OrthoBasis', 'PRIMME_LOBPCG_OrthoBasis_Window', 'PRIMME_RQI', 'PRIMME_SUBSPACE_ITERATION', 'primme_adaptive', 'primme_adaptive_ETolerance', 'primme_closest_abs', 'primme_closest_geq', 'primme_closest_leq', 'primme_decreasing_LTolerance', 'primme_dtr', 'primme_full_LTolerance', 'primme_init_default', 'primme_init_krylov', 'primme_init_random', 'primme_init_user', 'primme_largest', 'primme_largest_abs', 'primme_orth_block', 'primme_orth_column', 'primme_orth_default', 'primme_orth_pipelined', 'primme_proj_RR', 'primme_proj_default', 'primme_proj_harmonic', 'primme_proj_refined', 'primme_smallest', 'primme_thick', 'PrimmeSvdsParams', 'svds', 'primme_svds_augmented', 'primme_svds_bidiag', 'primme_svds_closest_abs', 'primme_svds_default', 'primme_svds_hybrid', 'primme_svds_largest', 'primme_svds_normalequations', 'primme_svds_op_AAt', 'primme_svds_op_AtA', 'primme_svds_op_augmented', 'primme_svds_op_bidiag', 'primme_svds_op_none', 'primme_svds_smallest', 'sprimme_svds', 'cprimme_svds', 'dprimme_svds', 'zprimme_svds', 'PrimmeSvdsError']
 
 primme_smallest = _Primme.primme_smallest
 primme_largest = _Primme.primme_largest
@@ -128,12 +128,28 @@ primme_init_default = _Primme.primme_init_default
 primme_init_krylov = _Primme.primme_init_krylov
 primme_init_random = _Primme.primme_init_random
 primme_init_user = _Primme.primme_init_user
+primme_orth_default = _Primme.primme_orth_default
+primme_orth_column = _Primme.primme_orth_column
+primme_orth_block = _Primme.primme_orth_block
+primme_orth_pipelined = _Primme.primme_orth_pipelined
 primme_thick = _Primme.primme_thick
 primme_dtr = _Primme.primme_dtr
 primme_full_LTolerance = _Primme.primme_full_LTolerance
 primme_decreasing_LTolerance = _Primme.primme_decreasing_LTolerance
 primme_adaptive_ETolerance = _Primme.primme_adaptive_ETolerance
 primme_adaptive = _Primme.primme_adaptive
+primme_event_start = _Primme.primme_event_start
+primme_event_init = _Primme.primme_event_init
+primme_event_prepare_candidates = _Primme.primme_event_prepare_candidates
+primme_event_iteration = _Primme.primme_event_iteration
+primme_event_correction = _Primme.primme_event_correction
+primme_event_ortho = _Primme.primme_event_ortho
+primme_event_matvec = _Primme.primme_event_matvec
+primme_event_update_projection = _Primme.primme_event_update_projection
+primme_event_solve_H = _Primme.primme_event_solve_H
+primme_event_restart = _Primme.primme_event_restart
+primme_event_locking = _Primme.primme_event_locking
+primme_event_finish = _Primme.primme_event_finish
 class primme_stats(_object):
     __swig_setmethods__ = {}
     __setattr__ = lambda self, name, value: _swig_setattr(self, primme_stats, name, value)
@@ -208,6 +224,10 @@ class primme_stats(_object):
     __swig_getmethods__["estimateResidualError"] = _Primme.primme_stats_estimateResidualError_get
     if _newclass:
         estimateResidualError = _swig_property(_Primme.primme_stats_estimateResidualError_get, _Primme.primme_stats_estimateResidualError_set)
+    __swig_setmethods__["avgBlockSize"] = _Primme.primme_stats_avgBlockSize_set
+    __swig_getmethods__["avgBlockSize"] = _Primme.primme_stats_avgBlockSize_get
+    if _newclass:
+        avgBlockSize = _swig_property(_Primme.primme_stats_avgBlockSize_get, _Primme.primme_stats_avgBlockSize_set)
 
     def __init__(self):
         this = _Primme.new_primme_stats()
@@ -314,6 +334,14 @@ class correction_params(_object):
     __swig_getmethods__["relTolBase"] = _Primme.correction_params_relTolBase_get
     if _newclass:
         relTolBase = _swig_property(_Primme.correction_params_relTolBase_get, _Primme.correction_params_relTolBase_set)
+    __swig_setmethods__["fuseGlobalSums"] = _Primme.correction_params_fuseGlobalSums_set
+    __swig_getmethods__["fuseGlobalSums"] = _Primme.correction_params_fuseGlobalSums_get
+    if _newclass:
+        fuseGlobalSums = _swig_property(_Primme.correction_params_fuseGlobalSums_get, _Primme.correction_params_fuseGlobalSums_set)
+    __swig_setmethods__["filterDegree"] = _Primme.correction_params_filterDegree_set
+    __swig_getmethods__["filterDegree"] = _Primme.correction_params_filterDegree_get
+    if _newclass:
+        filterDegree = _swig_property(_Primme.correction_params_filterDegree_get, _Primme.correction_params_filterDegree_set)
 
     def __init__(self):
         this = _Primme.new_correction_params()
@@ -390,6 +418,10 @@ class primme_params(_object):
     __swig_getmethods__["dynamicMethodSwitch"] = _Primme.primme_params_dynamicMethodSwitch_get
     if _newclass:
         dynamicMethodSwitch = _swig_property(_Primme.primme_params_dynamicMethodSwitch_get, _Primme.primme_params_dynamicMethodSwitch_set)
+    __swig_setmethods__["dynamicBlockSize"] = _Primme.primme_params_dynamicBlockSize_set
+    __swig_getmethods__["dynamicBlockSize"] = _Primme.primme_params_dynamicBlockSize_get
+    if _newclass:
+        dynamicBlockSize = _swig_property(_Primme.primme_params_dynamicBlockSize_get, _Primme.primme_params_dynamicBlockSize_set)
     __swig_setmethods__["locking"] = _Primme.primme_params_locking_set
     __swig_getmethods__["locking"] = _Primme.primme_params_locking_get
     if _newclass:
@@ -450,6 +482,10 @@ class primme_params(_object):
     __swig_getmethods__["initBasisMode"] = _Primme.primme_params_initBasisMode_get
     if _newclass:
         initBasisMode = _swig_property(_Primme.primme_params_initBasisMode_get, _Primme.primme_params_initBasisMode_set)
+    __swig_setmethods__["orth"] = _Primme.primme_params_orth_set
+    __swig_getmethods__["orth"] = _Primme.primme_params_orth_get
+    if _newclass:
+        orth = _swig_property(_Primme.primme_params_orth_get, _Primme.primme_params_orth_set)
     __swig_setmethods__["ldevecs"] = _Primme.primme_params_ldevecs_set
     __swig_getmethods__["ldevecs"] = _Primme.primme_params_ldevecs_get
     if _newclass:
@@ -458,6 +494,34 @@ class primme_params(_object):
     __swig_getmethods__["ldOPs"] = _Primme.primme_params_ldOPs_get
     if _newclass:
         ldOPs = _swig_property(_Primme.primme_params_ldOPs_get, _Primme.primme_params_ldOPs_set)
+    __swig_setmethods__["cacheBlockSize"] = _Primme.primme_params_cacheBlockSize_set
+    __swig_getmethods__["cacheBlockSize"] = _Primme.primme_params_cacheBlockSize_get
+    if _newclass:
+        cacheBlockSize = _swig_property(_Primme.primme_params_cacheBlockSize_get, _Primme.primme_params_cacheBlockSize_set)
+    __swig_setmethods__["mixedPrecision"] = _Primme.primme_params_mixedPrecision_set
+    __swig_getmethods__["mixedPrecision"] = _Primme.primme_params_mixedPrecision_get
+    if _newclass:
+        mixedPrecision = _swig_property(_Primme.primme_params_mixedPrecision_get, _Primme.primme_params_mixedPrecision_set)
+    __swig_setmethods__["checkpointFile"] = _Primme.primme_params_checkpointFile_set
+    __swig_getmethods__["checkpointFile"] = _Primme.primme_params_checkpointFile_get
+    if _newclass:
+        checkpointFile = _swig_property(_Primme.primme_params_checkpointFile_get, _Primme.primme_params_checkpointFile_set)
+    __swig_setmethods__["checkpointInterval"] = _Primme.primme_params_checkpointInterval_set
+    __swig_getmethods__["checkpointInterval"] = _Primme.primme_params_checkpointInterval_get
+    if _newclass:
+        checkpointInterval = _swig_property(_Primme.primme_params_checkpointInterval_get, _Primme.primme_params_checkpointInterval_set)
+    __swig_setmethods__["checkpointResume"] = _Primme.primme_params_checkpointResume_set
+    __swig_getmethods__["checkpointResume"] = _Primme.primme_params_checkpointResume_get
+    if _newclass:
+        checkpointResume = _swig_property(_Primme.primme_params_checkpointResume_get, _Primme.primme_params_checkpointResume_set)
+    __swig_setmethods__["outOfCoreDir"] = _Primme.primme_params_outOfCoreDir_set
+    __swig_getmethods__["outOfCoreDir"] = _Primme.primme_params_outOfCoreDir_get
+    if _newclass:
+        outOfCoreDir = _swig_property(_Primme.primme_params_outOfCoreDir_get, _Primme.primme_params_outOfCoreDir_set)
+    __swig_setmethods__["warmStart"] = _Primme.primme_params_warmStart_set
+    __swig_getmethods__["warmStart"] = _Primme.primme_params_warmStart_get
+    if _newclass:
+        warmStart = _swig_property(_Primme.primme_params_warmStart_get, _Primme.primme_params_warmStart_set)
     __swig_setmethods__["projectionParams"] = _Primme.primme_params_projectionParams_set
     __swig_getmethods__["projectionParams"] = _Primme.primme_params_projectionParams_get
     if _newclass:
@@ -525,10 +589,12 @@ primme_svds_default = _Primme.primme_svds_default
 primme_svds_hybrid = _Primme.primme_svds_hybrid
 primme_svds_normalequations = _Primme.primme_svds_normalequations
 primme_svds_augmented = _Primme.primme_svds_augmented
+primme_svds_bidiag = _Primme.primme_svds_bidiag
 primme_svds_op_none = _Primme.primme_svds_op_none
 primme_svds_op_AtA = _Primme.primme_svds_op_AtA
 primme_svds_op_AAt = _Primme.primme_svds_op_AAt
 primme_svds_op_augmented = _Primme.primme_svds_op_augmented
+primme_svds_op_bidiag = _Primme.primme_svds_op_bidiag
 class primme_svds_stats(_object):
     __swig_setmethods__ = {}
     __setattr__ = lambda self, name, value: _swig_setattr(self, primme_svds_stats, name, value)
@@ -804,6 +870,9 @@ class PrimmeParams(primme_params):
     def _get_targetShifts(self):
         return _Primme.PrimmeParams__get_targetShifts(self)
 
+    def _set_matrix(self, format, indptr, indices, data):
+        return _Primme.PrimmeParams__set_matrix(self, format, indptr, indices, data)
+
     def matvec(self, *args):
         return _Primme.PrimmeParams_matvec(self, *args)
 
@@ -928,6 +997,9 @@ class PrimmeSvdsParams(primme_svds_params):
     def _get_targetShifts(self):
         return _Primme.PrimmeSvdsParams__get_targetShifts(self)
 
+    def _set_matrix(self, format, indptr, indices, data, indptrH, indicesH, dataH):
+        return _Primme.PrimmeSvdsParams__set_matrix(self, format, indptr, indices, data, indptrH, indicesH, dataH)
+
     def matvec(self, *args):
         return _Primme.PrimmeSvdsParams_matvec(self, *args)
 
@@ -948,6 +1020,7 @@ PrimmeSvdsParams_swigregister = _Primme.PrimmeSvdsParams_swigregister
 PrimmeSvdsParams_swigregister(PrimmeSvdsParams)
 
 import numpy as np
+import scipy.sparse
 from scipy.sparse.linalg.interface import aslinearoperator
 
 __docformat__ = "restructuredtext en"
@@ -991,7 +1064,16 @@ _PRIMMEErrors = {
 -34: "'ldevecs' is less than 'nLocal'",
 -35: "'ldOPs' is non-zero and less than 'nLocal'",
 -36 : "not enough memory for realWork",
--37 : "not enough memory for intWork"
+-37 : "not enough memory for intWork",
+-38 : "only one of 'globalSumRealStart' and 'globalSumRealWait' is set",
+-39 : "'cacheBlockSize' < 0",
+-40 : "'massMatrixMatvec' is set and the configuration is not supported for the generalized problem",
+-41 : "'checkpointInterval' < 0, or 'checkpointInterval' or 'checkpointResume' is set and 'checkpointFile' is not",
+-42 : "'filterDegree' < 0",
+-43 : "the interval or the number of slices is not valid",
+-44 : "found more eigenvalues in the interval than 'numEvals'",
+-45 : "the number of problems is negative or some array is NULL",
+-46 : "the file in 'outOfCoreDir' could not be created or mapped"
 }
 
 _PRIMMESvdsErrors = {
@@ -1016,7 +1098,8 @@ _PRIMMESvdsErrors = {
 -18 : "svecs is not set",
 -19 : "resNorms is not set",
 -20 : "not enough memory for realWork",
--21 : "not enough memory for intWork"
+-21 : "not enough memory for intWork",
+-22 : "method is primme_svds_op_bidiag and target is not primme_svds_largest"
 }
 
 
@@ -1043,6 +1126,33 @@ class PrimmeSvdsError(RuntimeError):
         RuntimeError.__init__(self, "PRIMME SVDS error %d: %s" % (err, msg))
 
 
+def _native_matrix(A, dtype, adjoint=False):
+    """
+    Return the arguments of _set_matrix that make PRIMME multiply by A in C,
+    and the arrays they point to, which should be kept alive while PRIMME
+    runs; or None if A is not a dense array or a CSR/CSC sparse matrix.
+    If adjoint, the arguments also include the CSR arrays of A.H.
+    """
+
+    maxint = np.iinfo(np.intc).max
+
+    if isinstance(A, np.ndarray) and A.ndim == 2:
+        A = np.asfortranarray(A, dtype=dtype)
+        return (2, 0, 0, A.ctypes.data) + ((0, 0, 0) if adjoint else ()), [A]
+
+    if (not scipy.sparse.issparse(A) or A.format not in ('csr', 'csc') or
+            A.nnz > maxint or max(A.shape) > maxint):
+        return None
+
+    arrays = []
+    for B in ((A, A.T.conj()) if adjoint else (A,)):
+        B = B.tocsr()
+        arrays += [np.ascontiguousarray(B.indptr, dtype=np.intc),
+                   np.ascontiguousarray(B.indices, dtype=np.intc),
+                   np.ascontiguousarray(B.data, dtype=dtype)]
+    return (1,) + tuple(x.ctypes.data for x in arrays), arrays
+
+
 def eigsh(A, k=6, M=None, sigma=None, which='LM', v0=None,
           ncv=None, maxiter=None, tol=0, return_eigenvectors=True,
           Minv=None, OPinv=None, mode='normal', lock=None,
@@ -1063,7 +1173,8 @@ def eigsh(A, k=6, M=None, sigma=None, which='LM', v0=None,
     ----------
     A : An N x N matrix, array, sparse matrix, or LinearOperator
         the operation A * x, where A is a real symmetric matrix or complex
-        Hermitian.
+        Hermitian. If A is a dense array or a CSR/CSC sparse matrix, A * x
+        is computed in C without calling Python.
     k : int, optional
         The number of eigenvalues and eigenvectors desired.
     M : An N x N matrix, array, sparse matrix, or LinearOperator
@@ -1188,6 +1299,7 @@ def eigsh(A, k=6, M=None, sigma=None, which='LM', v0=None,
     array([ 96.,  95.,  94.])
     """
 
+    Aorig = A
     A = aslinearoperator(A)
     if len(A.shape) != 2 or A.shape[0] != A.shape[1]:
         raise ValueError('A: expected square matrix (shape=%s)' % (A.shape,))
@@ -1298,6 +1410,11 @@ def eigsh(A, k=6, M=None, sigma=None, which='LM', v0=None,
     if method is not None:
         pp.set_method(method)
 
+# Multiply by A in C if possible; the arrays are alive until Xprimme ends
+    native = _native_matrix(Aorig, dtype)
+    if native is not None:
+        pp._set_matrix(*native[0])
+
     err = Xprimme(evals, evecs, norms, pp)
 
     if err != 0:
@@ -1329,7 +1446,9 @@ def svds(A, k=6, ncv=None, tol=0, which='LM', v0=None,
     Parameters
     ----------
     A : {sparse matrix, LinearOperator}
-        Array to compute the SVD on, of shape (M, N)
+        Array to compute the SVD on, of shape (M, N). If A is a dense array
+        or a CSR/CSC sparse matrix, A * x and A.H * x are computed in C
+        without calling Python.
     k : int, optional
         Number of singular values and vectors to compute.
         Must be 1 <= k < min(A.shape).
@@ -1419,6 +1538,7 @@ def svds(A, k=6, ncv=None, tol=0, which='LM', v0=None,
     ['5.99871', '5.99057', '6.01065']
     """
 
+    Aorig = A
     A = aslinearoperator(A)
 
     m, n = A.shape
@@ -1558,6 +1678,12 @@ def svds(A, k=6, ncv=None, tol=0, which='LM', v0=None,
         np.copyto(svecsl[:, pp.numOrthoConst:pp.numOrthoConst+pp.initSize], u0[:, 0:pp.initSize])
         np.copyto(svecsr[:, pp.numOrthoConst:pp.numOrthoConst+pp.initSize], v0[:, 0:pp.initSize])
 
+# Multiply by A and A.H in C if possible; the arrays are alive until
+# Xprimme_svds ends
+    native = _native_matrix(Aorig, dtype, adjoint=True)
+    if native is not None:
+        pp._set_matrix(*native[0])
+
     err = Xprimme_svds(svals, svecsl, svecsr, norms, pp)
 
     if err != 0:
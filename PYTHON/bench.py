@@ -0,0 +1,73 @@
+#!/usr/bin/env python
+
+#  Copyright (c) 2016, College of William & Mary
+#  All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are met:
+#      * Redistributions of source code must retain the above copyright
+#        notice, this list of conditions and the following disclaimer.
+#      * Redistributions in binary form must reproduce the above copyright
+#        notice, this list of conditions and the following disclaimer in the
+#        documentation and/or other materials provided with the distribution.
+#      * Neither the name of College of William & Mary nor the
+#        names of its contributors may be used to endorse or promote products
+#        derived from this software without specific prior written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+#  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+#  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+#  DISCLAIMED. IN NO EVENT SHALL COLLEGE OF WILLIAM & MARY BE LIABLE FOR ANY
+#  DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+#  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+#  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+#  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+#  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#  PRIMME: https://github.com/primme/primme
+#  Contact: Andreas Stathopoulos, a n d r e a s _at_ c s . w m . e d u
+
+# Compare Primme.eigsh multiplying a CSR matrix in C, Primme.eigsh calling
+# Python for every matvec (the matrix passed as a LinearOperator), and
+# scipy.sparse.linalg.eigsh, computing the largest eigenvalues of 2-D
+# Laplacians of several sizes. Usage:
+#
+#    python bench.py [k [tol]]
+#
+# Set OMP_NUM_THREADS to choose the threads that multiply the CSR matrix.
+
+from __future__ import print_function
+import sys, time
+import numpy as np
+import scipy.sparse
+import scipy.sparse.linalg
+import Primme
+
+k = int(sys.argv[1]) if len(sys.argv) > 1 else 10
+tol = float(sys.argv[2]) if len(sys.argv) > 2 else 1e-6
+
+def laplacian2d(n):
+    T = scipy.sparse.diags([-1, 2, -1], [-1, 0, 1], shape=(n, n))
+    I = scipy.sparse.eye(n)
+    return (scipy.sparse.kron(T, I) + scipy.sparse.kron(I, T)).tocsr()
+
+solvers = (
+    ("Primme (CSR)", lambda A: Primme.eigsh(A, k, which='LA', tol=tol)),
+    ("Primme (callback)", lambda A: Primme.eigsh(
+        scipy.sparse.linalg.aslinearoperator(A), k, which='LA', tol=tol)),
+    ("scipy eigsh", lambda A: scipy.sparse.linalg.eigsh(A, k, which='LA',
+        tol=tol)))
+
+print("k = %d tol = %g; time in seconds and largest residual norm" % (k, tol))
+print("%8s" % "n" + "".join(" %24s" % name for name, _ in solvers))
+for m in (30, 70, 150, 300):
+    A = laplacian2d(m)
+    print("%8d" % A.shape[0], end="")
+    for name, solver in solvers:
+        t0 = time.time()
+        evals, evecs = solver(A)
+        t = time.time() - t0
+        rnorm = np.linalg.norm(A.dot(evecs) - evecs*evals, axis=0).max()
+        print(" %14.3f (%7.1e)" % (t, rnorm), end="")
+    print()
@@ -42,13 +42,32 @@ Uses PRIMME: https://github.com/primme/primme
 %module(docstring=DOCSTRING,directors="1") Primme
 
 %pythoncode %{
-__all__ = ['PrimmeParams', 'sprimme', 'cprimme', 'dprimme', 'zprimme', 'eigsh', 'PrimmeError', 'PRIMME_Arnoldi', 'PRIMME_DEFAULT_METHOD', 'PRIMME_DEFAULT_MIN_MATVECS', 'PRIMME_DEFAULT_MIN_TIME', 'PRIMME_DYNAMIC', 'PRIMME_GD', 'PRIMME_GD_Olsen_plusK', 'PRIMME_GD_plusK', 'PRIMME_JDQMR', 'PRIMME_JDQMR_ETol', 'PRIMME_JDQR', 'PRIMME_JD_Olsen_plusK', 'PRIMME_LOBPCG_OrthoBasis', 'PRIMME_LOBPCG_OrthoBasis_Window', 'PRIMME_RQI', 'PRIMME_SUBSPACE_ITERATION', 'primme_adaptive', 'primme_adaptive_ETolerance', 'primme_closest_abs', 'primme_closest_geq', 'primme_closest_leq', 'primme_decreasing_LTolerance', 'primme_dtr', 'primme_full_LTolerance', 'primme_init_default', 'primme_init_krylov', 'primme_init_random', 'primme_init_user', 'primme_largest', 'primme_largest_abs', 'primme_proj_RR', 'primme_proj_default', 'primme_proj_harmonic', 'primme_proj_refined', 'primme_smallest', 'primme_thick', 'PrimmeSvdsParams', 'svds', 'primme_svds_augmented', 'primme_svds_closest_abs', 'primme_svds_default', 'primme_svds_hybrid', 'primme_svds_largest', 'primme_svds_normalequations', 'primme_svds_op_AAt', 'primme_svds_op_AtA', 'primme_svds_op_augmented', 'primme_svds_op_none', 'primme_svds_smallest', 'sprimme_svds', 'cprimme_svds', 'dprimme_svds', 'zprimme_svds', 'PrimmeSvdsError']
+__all__ = ['PrimmeParams', 'sprimme', 'cprimme', 'dprimme', 'zprimme', 'eigsh', 'PrimmeError', 'PRIMME_Arnoldi', 'PRIMME_DEFAULT_METHOD', 'PRIMME_DEFAULT_MIN_MATVECS', 'PRIMME_DEFAULT_MIN_TIME', 'PRIMME_DYNAMIC', 'PRIMME_GD', 'PRIMME_GD_Olsen_plusK', 'PRIMME_GD_plusK', 'PRIMME_JDQMR', 'PRIMME_JDQMR_ETol', 'PRIMME_JDQR', 'PRIMME_JD_Olsen_plusK', 'PRIMME_LOBPCG_OrthoBasis', 'PRIMME_LOBPCG_OrthoBasis_Window', 'PRIMME_RQI', 'PRIMME_SUBSPACE_ITERATION', 'primme_adaptive', 'primme_adaptive_ETolerance', 'primme_closest_abs', 'primme_closest_geq', 'primme_closest_leq', 'primme_decreasing_LTolerance', 'primme_dtr', 'primme_full_LTolerance', 'primme_init_default', 'primme_init_krylov', 'primme_init_random', 'primme_init_user', 'primme_largest', 'primme_largest_abs', 'primme_orth_block', 'primme_orth_column', 'primme_orth_default', 'primme_orth_pipelined', 'primme_proj_RR', 'primme_proj_default', 'primme_proj_harmonic', 'primme_proj_refined', 'primme_smallest', 'primme_thick', 'PrimmeSvdsParams', 'svds', 'primme_svds_augmented', 'primme_svds_bidiag', 'primme_svds_closest_abs', 'primme_svds_default', 'primme_svds_hybrid', 'primme_svds_largest', 'primme_svds_normalequations', 'primme_svds_op_AAt', 'primme_svds_op_AtA', 'primme_svds_op_augmented', 'primme_svds_op_bidiag', 'primme_svds_op_none', 'primme_svds_smallest', 'sprimme_svds', 'cprimme_svds', 'dprimme_svds', 'zprimme_svds', 'PrimmeSvdsError']
 %}
 // Support PRIMME_INT for int64_t
 %include "stdint.i"
 %{
 #define SWIG_FILE_WITH_INIT
 #include "primmew.h"
+
+/* Release the GIL while alive, so the solver runs without it; it is only */
+/* needed to call the methods of PrimmeParams and PrimmeSvdsParams        */
+
+class ReleaseGIL {
+   PyThreadState *state;
+   public:
+   ReleaseGIL() { state = PyEval_SaveThread(); }
+   ~ReleaseGIL() { PyEval_RestoreThread(state); }
+};
+
+/* Hold the GIL while alive */
+
+class EnsureGIL {
+   PyGILState_STATE state;
+   public:
+   EnsureGIL() { state = PyGILState_Ensure(); }
+   ~EnsureGIL() { PyGILState_Release(state); }
+};
 %}
 
 // Get the NumPy typemaps
@@ -94,6 +113,18 @@ __all__ = ['PrimmeParams', 'sprimme', 'cprimme', 'dprimme', 'zprimme', 'eigsh',
 %ignore tprimme;
 %ignore tprimme_svds;
 
+%ignore sprimme_slicing;
+%ignore cprimme_slicing;
+%ignore dprimme_slicing;
+%ignore zprimme_slicing;
+%ignore sprimme_batch;
+%ignore cprimme_batch;
+%ignore dprimme_batch;
+%ignore zprimme_batch;
+%ignore primme_monitor_trace;
+%ignore primme_context;
+%ignore primme_warm_start;
+
 %ignore PrimmeParams::matrixMatvec;
 %ignore PrimmeParams::massMatrixMatvec;
 %ignore PrimmeParams::applyPreconditioner;
@@ -108,6 +139,12 @@ __all__ = ['PrimmeParams', 'sprimme', 'cprimme', 'dprimme', 'zprimme', 'eigsh',
 %ignore PrimmeParams::matrix;
 %ignore PrimmeParams::preconditioner;
 %ignore PrimmeParams::ShiftsForPreconditioner;
+%ignore PrimmeParams::globalSumRealStart;
+%ignore PrimmeParams::globalSumRealWait;
+%ignore PrimmeParams::warmStartState;
+%ignore PrimmeParams::ctx;
+%ignore PrimmeParams::monitor;
+%ignore PrimmeParams::monitorFun;
 %ignore primme_params::matrixMatvec;
 %ignore primme_params::massMatrixMatvec;
 %ignore primme_params::applyPreconditioner;
@@ -122,7 +159,14 @@ __all__ = ['PrimmeParams', 'sprimme', 'cprimme', 'dprimme', 'zprimme', 'eigsh',
 %ignore primme_params::matrix;
 %ignore primme_params::preconditioner;
 %ignore primme_params::ShiftsForPreconditioner;
+%ignore primme_params::globalSumRealStart;
+%ignore primme_params::globalSumRealWait;
+%ignore primme_params::warmStartState;
+%ignore primme_params::ctx;
+%ignore primme_params::monitor;
+%ignore primme_params::monitorFun;
 %ignore PrimmeSvdsParams::matrixMatvec;
+%ignore PrimmeSvdsParams::matrixNormalMatvec;
 %ignore PrimmeSvdsParams::applyPreconditioner;
 %ignore PrimmeSvdsParams::convTestFun;
 %ignore PrimmeSvdsParams::targetShifts;
@@ -138,6 +182,7 @@ __all__ = ['PrimmeParams', 'sprimme', 'cprimme', 'dprimme', 'zprimme', 'eigsh',
 %ignore PrimmeSvdsParams::primme;
 %ignore PrimmeSvdsParams::primmeStage2;
 %ignore primme_svds_params::matrixMatvec;
+%ignore primme_svds_params::matrixNormalMatvec;
 %ignore primme_svds_params::applyPreconditioner;
 %ignore primme_svds_params::convTestFun;
 %ignore primme_svds_params::targetShifts;
@@ -405,13 +450,20 @@ static int tprimme(double *evals, std::complex<double> *evecs, double *resNorms,
 template <typename T>
 static void mymatvec(void *x, PRIMME_INT *ldx, void *y, PRIMME_INT *ldy, int *blockSize, struct primme_params *primme, int *ierr) {
     PrimmeParams *pp = static_cast<PrimmeParams*>(primme);
-    pp->matvec((int)primme->nLocal, *blockSize, (int)*ldx, (T*)x, (int)primme->nLocal, *blockSize, (int)*ldy, (T*)y);
+    if (pp->matrixFormat) {
+       pp->_matmat((T*)x, *ldx, (T*)y, *ldy, *blockSize);
+    }
+    else {
+       EnsureGIL gil;
+       pp->matvec((int)primme->nLocal, *blockSize, (int)*ldx, (T*)x, (int)primme->nLocal, *blockSize, (int)*ldy, (T*)y);
+    }
     *ierr = 0; 
 }
 
 template <typename T>
 static void myprevec(void *x, PRIMME_INT *ldx,  void *y, PRIMME_INT *ldy, int *blockSize, struct primme_params *primme, int *ierr) {
     PrimmeParams *pp = static_cast<PrimmeParams*>(primme);
+    EnsureGIL gil;
     pp->prevec((int)primme->nLocal, *blockSize, (int)*ldx, (T*)x, (int)primme->nLocal, *blockSize, (int)*ldy, (T*)y);
     *ierr = 0; 
 }
@@ -426,6 +478,7 @@ struct Real<std::complex<float> > { typedef float type;};
 template <typename T>
 static void myglobalSum(void *sendBuf, void *recvBuf, int *count, struct primme_params *primme, int *ierr) {
     PrimmeParams *pp = static_cast<PrimmeParams*>(primme);
+    EnsureGIL gil;
     pp->globalSum(*count, static_cast<typename Real<T>::type*>(sendBuf), *count, static_cast<typename Real<T>::type*>(recvBuf));
     *ierr = 0;
 }
@@ -460,7 +513,11 @@ int my_primme(int lenEvals, R *evals,
       primme->applyPreconditioner = myprevec<T>;
    if (primme->globalSum_set)
       primme->globalSumReal = myglobalSum<T>;
-   int ret = tprimme(evals, evecs, resNorms, static_cast<primme_params*>(primme));
+   int ret;
+   {
+      ReleaseGIL nogil;
+      ret = tprimme(evals, evecs, resNorms, static_cast<primme_params*>(primme));
+   }
    return ret;
 }
 
@@ -480,6 +537,7 @@ static int tprimme_svds(double *svals, std::complex<double> *svecs, double *resN
 template <typename T>
 static void myglobalSum_svds(void *sendBuf, void *recvBuf, int *count, struct primme_svds_params *primme_svds, int *ierr) {
     PrimmeSvdsParams *pp = static_cast<PrimmeSvdsParams*>(primme_svds);
+    EnsureGIL gil;
     pp->globalSum(*count, static_cast<typename Real<T>::type*>(sendBuf), *count, static_cast<typename Real<T>::type*>(recvBuf));
     *ierr = 0;
 }
@@ -488,6 +546,12 @@ template <typename T>
 static void mymatvec_svds(void *x, PRIMME_INT *ldx, void *y, PRIMME_INT *ldy, int *blockSize, int *transpose, struct primme_svds_params *primme_svds, int *ierr) {
    PrimmeSvdsParams *pp = static_cast<PrimmeSvdsParams*>(primme_svds);
    PRIMME_INT m, n;
+   if (pp->matrixFormat) {
+      pp->_matmat((T*)x, *ldx, (T*)y, *ldy, *blockSize, *transpose);
+      *ierr = 0;
+      return;
+   }
+   EnsureGIL gil;
    if (*transpose == 0) {
       m = primme_svds->mLocal;
       n = primme_svds->nLocal;
@@ -504,6 +568,7 @@ template <typename T>
 static void myprevec_svds(void *x, PRIMME_INT *ldx, void *y, PRIMME_INT *ldy, int *blockSize, int *mode, struct primme_svds_params *primme_svds, int *ierr) {
    PrimmeSvdsParams *pp = static_cast<PrimmeSvdsParams*>(primme_svds);
    PRIMME_INT m=0;
+   EnsureGIL gil;
    if (*mode == primme_svds_op_AtA) {
       m = primme_svds->nLocal;
    } else if (*mode ==  primme_svds_op_AAt) {
@@ -560,7 +625,11 @@ int my_primme_svds(int lenSvals, R *svals,
    copy_matrix(svecsRight, primme_svds->nLocal, primme_svds->numOrthoConst,
          (PRIMME_INT)len1SvecsRight, &svecs[primme_svds->numOrthoConst*primme_svds->mLocal],
          primme_svds->nLocal);
-   int ret = tprimme_svds(svals, svecs, resNorms, static_cast<primme_svds_params*>(primme_svds));
+   int ret;
+   {
+      ReleaseGIL nogil;
+      ret = tprimme_svds(svals, svecs, resNorms, static_cast<primme_svds_params*>(primme_svds));
+   }
    copy_matrix(&svecs[primme_svds->mLocal*primme_svds->numOrthoConst],
          primme_svds->mLocal, primme_svds->numSvals,
          primme_svds->mLocal, &svecsLeft[len1SvecsLeft*primme_svds->numOrthoConst], (PRIMME_INT)len1SvecsLeft);
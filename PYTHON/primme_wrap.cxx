@@ -3466,29 +3466,30 @@ namespace Swig {
 #define SWIGTYPE_p_p_double swig_types[11]
 #define SWIGTYPE_p_primme_convergencetest swig_types[12]
 #define SWIGTYPE_p_primme_init swig_types[13]
-#define SWIGTYPE_p_primme_params swig_types[14]
-#define SWIGTYPE_p_primme_preset_method swig_types[15]
-#define SWIGTYPE_p_primme_projection swig_types[16]
-#define SWIGTYPE_p_primme_restartscheme swig_types[17]
-#define SWIGTYPE_p_primme_stats swig_types[18]
-#define SWIGTYPE_p_primme_svds_operator swig_types[19]
-#define SWIGTYPE_p_primme_svds_params swig_types[20]
-#define SWIGTYPE_p_primme_svds_preset_method swig_types[21]
-#define SWIGTYPE_p_primme_svds_stats swig_types[22]
-#define SWIGTYPE_p_primme_svds_target swig_types[23]
-#define SWIGTYPE_p_primme_target swig_types[24]
-#define SWIGTYPE_p_projection_params swig_types[25]
-#define SWIGTYPE_p_restarting_params swig_types[26]
-#define SWIGTYPE_p_short swig_types[27]
-#define SWIGTYPE_p_signed_char swig_types[28]
-#define SWIGTYPE_p_std__complexT_double_t swig_types[29]
-#define SWIGTYPE_p_std__complexT_float_t swig_types[30]
-#define SWIGTYPE_p_unsigned_char swig_types[31]
-#define SWIGTYPE_p_unsigned_int swig_types[32]
-#define SWIGTYPE_p_unsigned_long_long swig_types[33]
-#define SWIGTYPE_p_unsigned_short swig_types[34]
-static swig_type_info *swig_types[36];
-static swig_module_info swig_module = {swig_types, 35, 0, 0, 0, 0};
+#define SWIGTYPE_p_primme_orth swig_types[14]
+#define SWIGTYPE_p_primme_params swig_types[15]
+#define SWIGTYPE_p_primme_preset_method swig_types[16]
+#define SWIGTYPE_p_primme_projection swig_types[17]
+#define SWIGTYPE_p_primme_restartscheme swig_types[18]
+#define SWIGTYPE_p_primme_stats swig_types[19]
+#define SWIGTYPE_p_primme_svds_operator swig_types[20]
+#define SWIGTYPE_p_primme_svds_params swig_types[21]
+#define SWIGTYPE_p_primme_svds_preset_method swig_types[22]
+#define SWIGTYPE_p_primme_svds_stats swig_types[23]
+#define SWIGTYPE_p_primme_svds_target swig_types[24]
+#define SWIGTYPE_p_primme_target swig_types[25]
+#define SWIGTYPE_p_projection_params swig_types[26]
+#define SWIGTYPE_p_restarting_params swig_types[27]
+#define SWIGTYPE_p_short swig_types[28]
+#define SWIGTYPE_p_signed_char swig_types[29]
+#define SWIGTYPE_p_std__complexT_double_t swig_types[30]
+#define SWIGTYPE_p_std__complexT_float_t swig_types[31]
+#define SWIGTYPE_p_unsigned_char swig_types[32]
+#define SWIGTYPE_p_unsigned_int swig_types[33]
+#define SWIGTYPE_p_unsigned_long_long swig_types[34]
+#define SWIGTYPE_p_unsigned_short swig_types[35]
+static swig_type_info *swig_types[37];
+static swig_module_info swig_module = {swig_types, 36, 0, 0, 0, 0};
 #define SWIG_TypeQuery(name) SWIG_TypeQueryModule(&swig_module, &swig_module, name)
 #define SWIG_MangledTypeQuery(name) SWIG_MangledTypeQueryModule(&swig_module, &swig_module, name)
 
@@ -3599,6 +3600,25 @@ namespace swig {
 #define SWIG_FILE_WITH_INIT
 #include "primmew.h"
 
+/* Release the GIL while alive, so the solver runs without it; it is only */
+/* needed to call the methods of PrimmeParams and PrimmeSvdsParams        */
+
+class ReleaseGIL {
+   PyThreadState *state;
+   public:
+   ReleaseGIL() { state = PyEval_SaveThread(); }
+   ~ReleaseGIL() { PyEval_RestoreThread(state); }
+};
+
+/* Hold the GIL while alive */
+
+class EnsureGIL {
+   PyGILState_STATE state;
+   public:
+   EnsureGIL() { state = PyGILState_Ensure(); }
+   ~EnsureGIL() { PyGILState_Release(state); }
+};
+
 
 #ifndef SWIG_FILE_WITH_INIT
 #define NO_IMPORT_ARRAY
@@ -3665,13 +3685,20 @@ static int tprimme(double *evals, std::complex<double> *evecs, double *resNorms,
 template <typename T>
 static void mymatvec(void *x, PRIMME_INT *ldx, void *y, PRIMME_INT *ldy, int *blockSize, struct primme_params *primme, int *ierr) {
     PrimmeParams *pp = static_cast<PrimmeParams*>(primme);
-    pp->matvec((int)primme->nLocal, *blockSize, (int)*ldx, (T*)x, (int)primme->nLocal, *blockSize, (int)*ldy, (T*)y);
+    if (pp->matrixFormat) {
+       pp->_matmat((T*)x, *ldx, (T*)y, *ldy, *blockSize);
+    }
+    else {
+       EnsureGIL gil;
+       pp->matvec((int)primme->nLocal, *blockSize, (int)*ldx, (T*)x, (int)primme->nLocal, *blockSize, (int)*ldy, (T*)y);
+    }
     *ierr = 0; 
 }
 
 template <typename T>
 static void myprevec(void *x, PRIMME_INT *ldx,  void *y, PRIMME_INT *ldy, int *blockSize, struct primme_params *primme, int *ierr) {
     PrimmeParams *pp = static_cast<PrimmeParams*>(primme);
+    EnsureGIL gil;
     pp->prevec((int)primme->nLocal, *blockSize, (int)*ldx, (T*)x, (int)primme->nLocal, *blockSize, (int)*ldy, (T*)y);
     *ierr = 0; 
 }
@@ -3686,6 +3713,7 @@ struct Real<std::complex<float> > { typedef float type;};
 template <typename T>
 static void myglobalSum(void *sendBuf, void *recvBuf, int *count, struct primme_params *primme, int *ierr) {
     PrimmeParams *pp = static_cast<PrimmeParams*>(primme);
+    EnsureGIL gil;
     pp->globalSum(*count, static_cast<typename Real<T>::type*>(sendBuf), *count, static_cast<typename Real<T>::type*>(recvBuf));
     *ierr = 0;
 }
@@ -3720,7 +3748,11 @@ int my_primme(int lenEvals, R *evals,
       primme->applyPreconditioner = myprevec<T>;
    if (primme->globalSum_set)
       primme->globalSumReal = myglobalSum<T>;
-   int ret = tprimme(evals, evecs, resNorms, static_cast<primme_params*>(primme));
+   int ret;
+   {
+      ReleaseGIL nogil;
+      ret = tprimme(evals, evecs, resNorms, static_cast<primme_params*>(primme));
+   }
    return ret;
 }
 
@@ -3740,6 +3772,7 @@ static int tprimme_svds(double *svals, std::complex<double> *svecs, double *resN
 template <typename T>
 static void myglobalSum_svds(void *sendBuf, void *recvBuf, int *count, struct primme_svds_params *primme_svds, int *ierr) {
     PrimmeSvdsParams *pp = static_cast<PrimmeSvdsParams*>(primme_svds);
+    EnsureGIL gil;
     pp->globalSum(*count, static_cast<typename Real<T>::type*>(sendBuf), *count, static_cast<typename Real<T>::type*>(recvBuf));
     *ierr = 0;
 }
@@ -3748,6 +3781,12 @@ template <typename T>
 static void mymatvec_svds(void *x, PRIMME_INT *ldx, void *y, PRIMME_INT *ldy, int *blockSize, int *transpose, struct primme_svds_params *primme_svds, int *ierr) {
    PrimmeSvdsParams *pp = static_cast<PrimmeSvdsParams*>(primme_svds);
    PRIMME_INT m, n;
+   if (pp->matrixFormat) {
+      pp->_matmat((T*)x, *ldx, (T*)y, *ldy, *blockSize, *transpose);
+      *ierr = 0;
+      return;
+   }
+   EnsureGIL gil;
    if (*transpose == 0) {
       m = primme_svds->mLocal;
       n = primme_svds->nLocal;
@@ -3764,6 +3803,7 @@ template <typename T>
 static void myprevec_svds(void *x, PRIMME_INT *ldx, void *y, PRIMME_INT *ldy, int *blockSize, int *mode, struct primme_svds_params *primme_svds, int *ierr) {
    PrimmeSvdsParams *pp = static_cast<PrimmeSvdsParams*>(primme_svds);
    PRIMME_INT m=0;
+   EnsureGIL gil;
    if (*mode == primme_svds_op_AtA) {
       m = primme_svds->nLocal;
    } else if (*mode ==  primme_svds_op_AAt) {
@@ -3820,7 +3860,11 @@ int my_primme_svds(int lenSvals, R *svals,
    copy_matrix(svecsRight, primme_svds->nLocal, primme_svds->numOrthoConst,
          (PRIMME_INT)len1SvecsRight, &svecs[primme_svds->numOrthoConst*primme_svds->mLocal],
          primme_svds->nLocal);
-   int ret = tprimme_svds(svals, svecs, resNorms, static_cast<primme_svds_params*>(primme_svds));
+   int ret;
+   {
+      ReleaseGIL nogil;
+      ret = tprimme_svds(svals, svecs, resNorms, static_cast<primme_svds_params*>(primme_svds));
+   }
    copy_matrix(&svecs[primme_svds->mLocal*primme_svds->numOrthoConst],
          primme_svds->mLocal, primme_svds->numSvals,
          primme_svds->mLocal, &svecsLeft[len1SvecsLeft*primme_svds->numOrthoConst], (PRIMME_INT)len1SvecsLeft);
@@ -4519,6 +4563,171 @@ SWIG_AsVal_int (PyObject * obj, int *val)
 }
 
 
+SWIGINTERN swig_type_info*
+SWIG_pchar_descriptor(void)
+{
+  static int init = 0;
+  static swig_type_info* info = 0;
+  if (!init) {
+    info = SWIG_TypeQuery("_p_char");
+    init = 1;
+  }
+  return info;
+}
+
+
+SWIGINTERN int
+SWIG_AsCharPtrAndSize(PyObject *obj, char** cptr, size_t* psize, int *alloc)
+{
+#if PY_VERSION_HEX>=0x03000000
+#if defined(SWIG_PYTHON_STRICT_BYTE_CHAR)
+  if (PyBytes_Check(obj))
+#else
+  if (PyUnicode_Check(obj))
+#endif
+#else
+  if (PyString_Check(obj))
+#endif
+  {
+    char *cstr; Py_ssize_t len;
+#if PY_VERSION_HEX>=0x03000000
+#if !defined(SWIG_PYTHON_STRICT_BYTE_CHAR)
+    if (!alloc && cptr) {
+        /* We can't allow converting without allocation, since the internal
+           representation of string in Python 3 is UCS-2/UCS-4 but we require
+           a UTF-8 representation.
+           TODO(bhy) More detailed explanation */
+        return SWIG_RuntimeError;
+    }
+    obj = PyUnicode_AsUTF8String(obj);
+    if(alloc) *alloc = SWIG_NEWOBJ;
+#endif
+    PyBytes_AsStringAndSize(obj, &cstr, &len);
+#else
+    PyString_AsStringAndSize(obj, &cstr, &len);
+#endif
+    if (cptr) {
+      if (alloc) {
+	/*
+	   In python the user should not be able to modify the inner
+	   string representation. To warranty that, if you define
+	   SWIG_PYTHON_SAFE_CSTRINGS, a new/copy of the python string
+	   buffer is always returned.
+
+	   The default behavior is just to return the pointer value,
+	   so, be careful.
+	*/
+#if defined(SWIG_PYTHON_SAFE_CSTRINGS)
+	if (*alloc != SWIG_OLDOBJ)
+#else
+	if (*alloc == SWIG_NEWOBJ)
+#endif
+	{
+	  *cptr = reinterpret_cast< char* >(memcpy((new char[len + 1]), cstr, sizeof(char)*(len + 1)));
+	  *alloc = SWIG_NEWOBJ;
+	} else {
+	  *cptr = cstr;
+	  *alloc = SWIG_OLDOBJ;
+	}
+      } else {
+#if PY_VERSION_HEX>=0x03000000
+#if defined(SWIG_PYTHON_STRICT_BYTE_CHAR)
+	*cptr = PyBytes_AsString(obj);
+#else
+	assert(0); /* Should never reach here with Unicode strings in Python 3 */
+#endif
+#else
+	*cptr = SWIG_Python_str_AsChar(obj);
+#endif
+      }
+    }
+    if (psize) *psize = len + 1;
+#if PY_VERSION_HEX>=0x03000000 && !defined(SWIG_PYTHON_STRICT_BYTE_CHAR)
+    Py_XDECREF(obj);
+#endif
+    return SWIG_OK;
+  } else {
+#if defined(SWIG_PYTHON_2_UNICODE)
+#if defined(SWIG_PYTHON_STRICT_BYTE_CHAR)
+#error "Cannot use both SWIG_PYTHON_2_UNICODE and SWIG_PYTHON_STRICT_BYTE_CHAR at once"
+#endif
+#if PY_VERSION_HEX<0x03000000
+    if (PyUnicode_Check(obj)) {
+      char *cstr; Py_ssize_t len;
+      if (!alloc && cptr) {
+        return SWIG_RuntimeError;
+      }
+      obj = PyUnicode_AsUTF8String(obj);
+      if (PyString_AsStringAndSize(obj, &cstr, &len) != -1) {
+        if (cptr) {
+          if (alloc) *alloc = SWIG_NEWOBJ;
+          *cptr = reinterpret_cast< char* >(memcpy((new char[len + 1]), cstr, sizeof(char)*(len + 1)));
+        }
+        if (psize) *psize = len + 1;
+
+        Py_XDECREF(obj);
+        return SWIG_OK;
+      } else {
+        Py_XDECREF(obj);
+      }
+    }
+#endif
+#endif
+
+    swig_type_info* pchar_descriptor = SWIG_pchar_descriptor();
+    if (pchar_descriptor) {
+      void* vptr = 0;
+      if (SWIG_ConvertPtr(obj, &vptr, pchar_descriptor, 0) == SWIG_OK) {
+	if (cptr) *cptr = (char *) vptr;
+	if (psize) *psize = vptr ? (strlen((char *)vptr) + 1) : 0;
+	if (alloc) *alloc = SWIG_OLDOBJ;
+	return SWIG_OK;
+      }
+    }
+  }
+  return SWIG_TypeError;
+}
+
+
+
+
+
+SWIGINTERNINLINE PyObject *
+SWIG_FromCharPtrAndSize(const char* carray, size_t size)
+{
+  if (carray) {
+    if (size > INT_MAX) {
+      swig_type_info* pchar_descriptor = SWIG_pchar_descriptor();
+      return pchar_descriptor ?
+	SWIG_InternalNewPointerObj(const_cast< char * >(carray), pchar_descriptor, 0) : SWIG_Py_Void();
+    } else {
+#if PY_VERSION_HEX >= 0x03000000
+#if defined(SWIG_PYTHON_STRICT_BYTE_CHAR)
+      return PyBytes_FromStringAndSize(carray, static_cast< Py_ssize_t >(size));
+#else
+#if PY_VERSION_HEX >= 0x03010000
+      return PyUnicode_DecodeUTF8(carray, static_cast< Py_ssize_t >(size), "surrogateescape");
+#else
+      return PyUnicode_FromStringAndSize(carray, static_cast< Py_ssize_t >(size));
+#endif
+#endif
+#else
+      return PyString_FromStringAndSize(carray, static_cast< Py_ssize_t >(size));
+#endif
+    }
+  } else {
+    return SWIG_Py_Void();
+  }
+}
+
+
+SWIGINTERNINLINE PyObject *
+SWIG_FromCharPtr(const char *cptr)
+{
+  return SWIG_FromCharPtrAndSize(cptr, (cptr ? strlen(cptr) : 0));
+}
+
+
   SWIGINTERN int
   SWIG_AsVal_unsigned_SS_long (PyObject *obj, unsigned long *val)
   {
@@ -7468,6 +7677,58 @@ fail:
 }
 
 
+SWIGINTERN PyObject *_wrap_primme_stats_avgBlockSize_set(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  primme_stats *arg1 = (primme_stats *) 0 ;
+  double arg2 ;
+  void *argp1 = 0 ;
+  int res1 = 0 ;
+  double val2 ;
+  int ecode2 = 0 ;
+  PyObject * obj0 = 0 ;
+  PyObject * obj1 = 0 ;
+  
+  if (!PyArg_ParseTuple(args,(char *)"OO:primme_stats_avgBlockSize_set",&obj0,&obj1)) SWIG_fail;
+  res1 = SWIG_ConvertPtr(obj0, &argp1,SWIGTYPE_p_primme_stats, 0 |  0 );
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "primme_stats_avgBlockSize_set" "', argument " "1"" of type '" "primme_stats *""'"); 
+  }
+  arg1 = reinterpret_cast< primme_stats * >(argp1);
+  ecode2 = SWIG_AsVal_double(obj1, &val2);
+  if (!SWIG_IsOK(ecode2)) {
+    SWIG_exception_fail(SWIG_ArgError(ecode2), "in method '" "primme_stats_avgBlockSize_set" "', argument " "2"" of type '" "double""'");
+  } 
+  arg2 = static_cast< double >(val2);
+  if (arg1) (arg1)->avgBlockSize = arg2;
+  resultobj = SWIG_Py_Void();
+  return resultobj;
+fail:
+  return NULL;
+}
+
+
+SWIGINTERN PyObject *_wrap_primme_stats_avgBlockSize_get(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  primme_stats *arg1 = (primme_stats *) 0 ;
+  void *argp1 = 0 ;
+  int res1 = 0 ;
+  PyObject * obj0 = 0 ;
+  double result;
+  
+  if (!PyArg_ParseTuple(args,(char *)"O:primme_stats_avgBlockSize_get",&obj0)) SWIG_fail;
+  res1 = SWIG_ConvertPtr(obj0, &argp1,SWIGTYPE_p_primme_stats, 0 |  0 );
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "primme_stats_avgBlockSize_get" "', argument " "1"" of type '" "primme_stats *""'"); 
+  }
+  arg1 = reinterpret_cast< primme_stats * >(argp1);
+  result = (double) ((arg1)->avgBlockSize);
+  resultobj = SWIG_From_double(static_cast< double >(result));
+  return resultobj;
+fail:
+  return NULL;
+}
+
+
 SWIGINTERN PyObject *_wrap_new_primme_stats(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
   PyObject *resultobj = 0;
   primme_stats *result = 0 ;
@@ -8375,6 +8636,110 @@ fail:
 }
 
 
+SWIGINTERN PyObject *_wrap_correction_params_fuseGlobalSums_set(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  correction_params *arg1 = (correction_params *) 0 ;
+  int arg2 ;
+  void *argp1 = 0 ;
+  int res1 = 0 ;
+  int val2 ;
+  int ecode2 = 0 ;
+  PyObject * obj0 = 0 ;
+  PyObject * obj1 = 0 ;
+  
+  if (!PyArg_ParseTuple(args,(char *)"OO:correction_params_fuseGlobalSums_set",&obj0,&obj1)) SWIG_fail;
+  res1 = SWIG_ConvertPtr(obj0, &argp1,SWIGTYPE_p_correction_params, 0 |  0 );
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "correction_params_fuseGlobalSums_set" "', argument " "1"" of type '" "correction_params *""'"); 
+  }
+  arg1 = reinterpret_cast< correction_params * >(argp1);
+  ecode2 = SWIG_AsVal_int(obj1, &val2);
+  if (!SWIG_IsOK(ecode2)) {
+    SWIG_exception_fail(SWIG_ArgError(ecode2), "in method '" "correction_params_fuseGlobalSums_set" "', argument " "2"" of type '" "int""'");
+  } 
+  arg2 = static_cast< int >(val2);
+  if (arg1) (arg1)->fuseGlobalSums = arg2;
+  resultobj = SWIG_Py_Void();
+  return resultobj;
+fail:
+  return NULL;
+}
+
+
+SWIGINTERN PyObject *_wrap_correction_params_fuseGlobalSums_get(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  correction_params *arg1 = (correction_params *) 0 ;
+  void *argp1 = 0 ;
+  int res1 = 0 ;
+  PyObject * obj0 = 0 ;
+  int result;
+  
+  if (!PyArg_ParseTuple(args,(char *)"O:correction_params_fuseGlobalSums_get",&obj0)) SWIG_fail;
+  res1 = SWIG_ConvertPtr(obj0, &argp1,SWIGTYPE_p_correction_params, 0 |  0 );
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "correction_params_fuseGlobalSums_get" "', argument " "1"" of type '" "correction_params *""'"); 
+  }
+  arg1 = reinterpret_cast< correction_params * >(argp1);
+  result = (int) ((arg1)->fuseGlobalSums);
+  resultobj = SWIG_From_int(static_cast< int >(result));
+  return resultobj;
+fail:
+  return NULL;
+}
+
+
+SWIGINTERN PyObject *_wrap_correction_params_filterDegree_set(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  correction_params *arg1 = (correction_params *) 0 ;
+  int arg2 ;
+  void *argp1 = 0 ;
+  int res1 = 0 ;
+  int val2 ;
+  int ecode2 = 0 ;
+  PyObject * obj0 = 0 ;
+  PyObject * obj1 = 0 ;
+  
+  if (!PyArg_ParseTuple(args,(char *)"OO:correction_params_filterDegree_set",&obj0,&obj1)) SWIG_fail;
+  res1 = SWIG_ConvertPtr(obj0, &argp1,SWIGTYPE_p_correction_params, 0 |  0 );
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "correction_params_filterDegree_set" "', argument " "1"" of type '" "correction_params *""'"); 
+  }
+  arg1 = reinterpret_cast< correction_params * >(argp1);
+  ecode2 = SWIG_AsVal_int(obj1, &val2);
+  if (!SWIG_IsOK(ecode2)) {
+    SWIG_exception_fail(SWIG_ArgError(ecode2), "in method '" "correction_params_filterDegree_set" "', argument " "2"" of type '" "int""'");
+  } 
+  arg2 = static_cast< int >(val2);
+  if (arg1) (arg1)->filterDegree = arg2;
+  resultobj = SWIG_Py_Void();
+  return resultobj;
+fail:
+  return NULL;
+}
+
+
+SWIGINTERN PyObject *_wrap_correction_params_filterDegree_get(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  correction_params *arg1 = (correction_params *) 0 ;
+  void *argp1 = 0 ;
+  int res1 = 0 ;
+  PyObject * obj0 = 0 ;
+  int result;
+  
+  if (!PyArg_ParseTuple(args,(char *)"O:correction_params_filterDegree_get",&obj0)) SWIG_fail;
+  res1 = SWIG_ConvertPtr(obj0, &argp1,SWIGTYPE_p_correction_params, 0 |  0 );
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "correction_params_filterDegree_get" "', argument " "1"" of type '" "correction_params *""'"); 
+  }
+  arg1 = reinterpret_cast< correction_params * >(argp1);
+  result = (int) ((arg1)->filterDegree);
+  resultobj = SWIG_From_int(static_cast< int >(result));
+  return resultobj;
+fail:
+  return NULL;
+}
+
+
 SWIGINTERN PyObject *_wrap_new_correction_params(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
   PyObject *resultobj = 0;
   correction_params *result = 0 ;
@@ -9048,7 +9413,7 @@ fail:
 }
 
 
-SWIGINTERN PyObject *_wrap_primme_params_locking_set(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+SWIGINTERN PyObject *_wrap_primme_params_dynamicBlockSize_set(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
   PyObject *resultobj = 0;
   primme_params *arg1 = (primme_params *) 0 ;
   int arg2 ;
@@ -9059,18 +9424,18 @@ SWIGINTERN PyObject *_wrap_primme_params_locking_set(PyObject *SWIGUNUSEDPARM(se
   PyObject * obj0 = 0 ;
   PyObject * obj1 = 0 ;
   
-  if (!PyArg_ParseTuple(args,(char *)"OO:primme_params_locking_set",&obj0,&obj1)) SWIG_fail;
+  if (!PyArg_ParseTuple(args,(char *)"OO:primme_params_dynamicBlockSize_set",&obj0,&obj1)) SWIG_fail;
   res1 = SWIG_ConvertPtr(obj0, &argp1,SWIGTYPE_p_primme_params, 0 |  0 );
   if (!SWIG_IsOK(res1)) {
-    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "primme_params_locking_set" "', argument " "1"" of type '" "primme_params *""'"); 
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "primme_params_dynamicBlockSize_set" "', argument " "1"" of type '" "primme_params *""'"); 
   }
   arg1 = reinterpret_cast< primme_params * >(argp1);
   ecode2 = SWIG_AsVal_int(obj1, &val2);
   if (!SWIG_IsOK(ecode2)) {
-    SWIG_exception_fail(SWIG_ArgError(ecode2), "in method '" "primme_params_locking_set" "', argument " "2"" of type '" "int""'");
+    SWIG_exception_fail(SWIG_ArgError(ecode2), "in method '" "primme_params_dynamicBlockSize_set" "', argument " "2"" of type '" "int""'");
   } 
   arg2 = static_cast< int >(val2);
-  if (arg1) (arg1)->locking = arg2;
+  if (arg1) (arg1)->dynamicBlockSize = arg2;
   resultobj = SWIG_Py_Void();
   return resultobj;
 fail:
@@ -9078,7 +9443,7 @@ fail:
 }
 
 
-SWIGINTERN PyObject *_wrap_primme_params_locking_get(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+SWIGINTERN PyObject *_wrap_primme_params_dynamicBlockSize_get(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
   PyObject *resultobj = 0;
   primme_params *arg1 = (primme_params *) 0 ;
   void *argp1 = 0 ;
@@ -9086,13 +9451,13 @@ SWIGINTERN PyObject *_wrap_primme_params_locking_get(PyObject *SWIGUNUSEDPARM(se
   PyObject * obj0 = 0 ;
   int result;
   
-  if (!PyArg_ParseTuple(args,(char *)"O:primme_params_locking_get",&obj0)) SWIG_fail;
+  if (!PyArg_ParseTuple(args,(char *)"O:primme_params_dynamicBlockSize_get",&obj0)) SWIG_fail;
   res1 = SWIG_ConvertPtr(obj0, &argp1,SWIGTYPE_p_primme_params, 0 |  0 );
   if (!SWIG_IsOK(res1)) {
-    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "primme_params_locking_get" "', argument " "1"" of type '" "primme_params *""'"); 
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "primme_params_dynamicBlockSize_get" "', argument " "1"" of type '" "primme_params *""'"); 
   }
   arg1 = reinterpret_cast< primme_params * >(argp1);
-  result = (int) ((arg1)->locking);
+  result = (int) ((arg1)->dynamicBlockSize);
   resultobj = SWIG_From_int(static_cast< int >(result));
   return resultobj;
 fail:
@@ -9100,7 +9465,7 @@ fail:
 }
 
 
-SWIGINTERN PyObject *_wrap_primme_params_initSize_set(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+SWIGINTERN PyObject *_wrap_primme_params_locking_set(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
   PyObject *resultobj = 0;
   primme_params *arg1 = (primme_params *) 0 ;
   int arg2 ;
@@ -9111,18 +9476,18 @@ SWIGINTERN PyObject *_wrap_primme_params_initSize_set(PyObject *SWIGUNUSEDPARM(s
   PyObject * obj0 = 0 ;
   PyObject * obj1 = 0 ;
   
-  if (!PyArg_ParseTuple(args,(char *)"OO:primme_params_initSize_set",&obj0,&obj1)) SWIG_fail;
+  if (!PyArg_ParseTuple(args,(char *)"OO:primme_params_locking_set",&obj0,&obj1)) SWIG_fail;
   res1 = SWIG_ConvertPtr(obj0, &argp1,SWIGTYPE_p_primme_params, 0 |  0 );
   if (!SWIG_IsOK(res1)) {
-    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "primme_params_initSize_set" "', argument " "1"" of type '" "primme_params *""'"); 
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "primme_params_locking_set" "', argument " "1"" of type '" "primme_params *""'"); 
   }
   arg1 = reinterpret_cast< primme_params * >(argp1);
   ecode2 = SWIG_AsVal_int(obj1, &val2);
   if (!SWIG_IsOK(ecode2)) {
-    SWIG_exception_fail(SWIG_ArgError(ecode2), "in method '" "primme_params_initSize_set" "', argument " "2"" of type '" "int""'");
+    SWIG_exception_fail(SWIG_ArgError(ecode2), "in method '" "primme_params_locking_set" "', argument " "2"" of type '" "int""'");
   } 
   arg2 = static_cast< int >(val2);
-  if (arg1) (arg1)->initSize = arg2;
+  if (arg1) (arg1)->locking = arg2;
   resultobj = SWIG_Py_Void();
   return resultobj;
 fail:
@@ -9130,7 +9495,7 @@ fail:
 }
 
 
-SWIGINTERN PyObject *_wrap_primme_params_initSize_get(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+SWIGINTERN PyObject *_wrap_primme_params_locking_get(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
   PyObject *resultobj = 0;
   primme_params *arg1 = (primme_params *) 0 ;
   void *argp1 = 0 ;
@@ -9138,13 +9503,13 @@ SWIGINTERN PyObject *_wrap_primme_params_initSize_get(PyObject *SWIGUNUSEDPARM(s
   PyObject * obj0 = 0 ;
   int result;
   
-  if (!PyArg_ParseTuple(args,(char *)"O:primme_params_initSize_get",&obj0)) SWIG_fail;
+  if (!PyArg_ParseTuple(args,(char *)"O:primme_params_locking_get",&obj0)) SWIG_fail;
   res1 = SWIG_ConvertPtr(obj0, &argp1,SWIGTYPE_p_primme_params, 0 |  0 );
   if (!SWIG_IsOK(res1)) {
-    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "primme_params_initSize_get" "', argument " "1"" of type '" "primme_params *""'"); 
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "primme_params_locking_get" "', argument " "1"" of type '" "primme_params *""'"); 
   }
   arg1 = reinterpret_cast< primme_params * >(argp1);
-  result = (int) ((arg1)->initSize);
+  result = (int) ((arg1)->locking);
   resultobj = SWIG_From_int(static_cast< int >(result));
   return resultobj;
 fail:
@@ -9152,7 +9517,7 @@ fail:
 }
 
 
-SWIGINTERN PyObject *_wrap_primme_params_numOrthoConst_set(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+SWIGINTERN PyObject *_wrap_primme_params_initSize_set(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
   PyObject *resultobj = 0;
   primme_params *arg1 = (primme_params *) 0 ;
   int arg2 ;
@@ -9163,18 +9528,18 @@ SWIGINTERN PyObject *_wrap_primme_params_numOrthoConst_set(PyObject *SWIGUNUSEDP
   PyObject * obj0 = 0 ;
   PyObject * obj1 = 0 ;
   
-  if (!PyArg_ParseTuple(args,(char *)"OO:primme_params_numOrthoConst_set",&obj0,&obj1)) SWIG_fail;
+  if (!PyArg_ParseTuple(args,(char *)"OO:primme_params_initSize_set",&obj0,&obj1)) SWIG_fail;
   res1 = SWIG_ConvertPtr(obj0, &argp1,SWIGTYPE_p_primme_params, 0 |  0 );
   if (!SWIG_IsOK(res1)) {
-    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "primme_params_numOrthoConst_set" "', argument " "1"" of type '" "primme_params *""'"); 
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "primme_params_initSize_set" "', argument " "1"" of type '" "primme_params *""'"); 
   }
   arg1 = reinterpret_cast< primme_params * >(argp1);
   ecode2 = SWIG_AsVal_int(obj1, &val2);
   if (!SWIG_IsOK(ecode2)) {
-    SWIG_exception_fail(SWIG_ArgError(ecode2), "in method '" "primme_params_numOrthoConst_set" "', argument " "2"" of type '" "int""'");
+    SWIG_exception_fail(SWIG_ArgError(ecode2), "in method '" "primme_params_initSize_set" "', argument " "2"" of type '" "int""'");
   } 
   arg2 = static_cast< int >(val2);
-  if (arg1) (arg1)->numOrthoConst = arg2;
+  if (arg1) (arg1)->initSize = arg2;
   resultobj = SWIG_Py_Void();
   return resultobj;
 fail:
@@ -9182,7 +9547,7 @@ fail:
 }
 
 
-SWIGINTERN PyObject *_wrap_primme_params_numOrthoConst_get(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+SWIGINTERN PyObject *_wrap_primme_params_initSize_get(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
   PyObject *resultobj = 0;
   primme_params *arg1 = (primme_params *) 0 ;
   void *argp1 = 0 ;
@@ -9190,7 +9555,59 @@ SWIGINTERN PyObject *_wrap_primme_params_numOrthoConst_get(PyObject *SWIGUNUSEDP
   PyObject * obj0 = 0 ;
   int result;
   
-  if (!PyArg_ParseTuple(args,(char *)"O:primme_params_numOrthoConst_get",&obj0)) SWIG_fail;
+  if (!PyArg_ParseTuple(args,(char *)"O:primme_params_initSize_get",&obj0)) SWIG_fail;
+  res1 = SWIG_ConvertPtr(obj0, &argp1,SWIGTYPE_p_primme_params, 0 |  0 );
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "primme_params_initSize_get" "', argument " "1"" of type '" "primme_params *""'"); 
+  }
+  arg1 = reinterpret_cast< primme_params * >(argp1);
+  result = (int) ((arg1)->initSize);
+  resultobj = SWIG_From_int(static_cast< int >(result));
+  return resultobj;
+fail:
+  return NULL;
+}
+
+
+SWIGINTERN PyObject *_wrap_primme_params_numOrthoConst_set(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  primme_params *arg1 = (primme_params *) 0 ;
+  int arg2 ;
+  void *argp1 = 0 ;
+  int res1 = 0 ;
+  int val2 ;
+  int ecode2 = 0 ;
+  PyObject * obj0 = 0 ;
+  PyObject * obj1 = 0 ;
+  
+  if (!PyArg_ParseTuple(args,(char *)"OO:primme_params_numOrthoConst_set",&obj0,&obj1)) SWIG_fail;
+  res1 = SWIG_ConvertPtr(obj0, &argp1,SWIGTYPE_p_primme_params, 0 |  0 );
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "primme_params_numOrthoConst_set" "', argument " "1"" of type '" "primme_params *""'"); 
+  }
+  arg1 = reinterpret_cast< primme_params * >(argp1);
+  ecode2 = SWIG_AsVal_int(obj1, &val2);
+  if (!SWIG_IsOK(ecode2)) {
+    SWIG_exception_fail(SWIG_ArgError(ecode2), "in method '" "primme_params_numOrthoConst_set" "', argument " "2"" of type '" "int""'");
+  } 
+  arg2 = static_cast< int >(val2);
+  if (arg1) (arg1)->numOrthoConst = arg2;
+  resultobj = SWIG_Py_Void();
+  return resultobj;
+fail:
+  return NULL;
+}
+
+
+SWIGINTERN PyObject *_wrap_primme_params_numOrthoConst_get(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  primme_params *arg1 = (primme_params *) 0 ;
+  void *argp1 = 0 ;
+  int res1 = 0 ;
+  PyObject * obj0 = 0 ;
+  int result;
+  
+  if (!PyArg_ParseTuple(args,(char *)"O:primme_params_numOrthoConst_get",&obj0)) SWIG_fail;
   res1 = SWIG_ConvertPtr(obj0, &argp1,SWIGTYPE_p_primme_params, 0 |  0 );
   if (!SWIG_IsOK(res1)) {
     SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "primme_params_numOrthoConst_get" "', argument " "1"" of type '" "primme_params *""'"); 
@@ -9835,6 +10252,58 @@ fail:
 }
 
 
+SWIGINTERN PyObject *_wrap_primme_params_orth_set(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  primme_params *arg1 = (primme_params *) 0 ;
+  primme_orth arg2 ;
+  void *argp1 = 0 ;
+  int res1 = 0 ;
+  int val2 ;
+  int ecode2 = 0 ;
+  PyObject * obj0 = 0 ;
+  PyObject * obj1 = 0 ;
+  
+  if (!PyArg_ParseTuple(args,(char *)"OO:primme_params_orth_set",&obj0,&obj1)) SWIG_fail;
+  res1 = SWIG_ConvertPtr(obj0, &argp1,SWIGTYPE_p_primme_params, 0 |  0 );
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "primme_params_orth_set" "', argument " "1"" of type '" "primme_params *""'"); 
+  }
+  arg1 = reinterpret_cast< primme_params * >(argp1);
+  ecode2 = SWIG_AsVal_int(obj1, &val2);
+  if (!SWIG_IsOK(ecode2)) {
+    SWIG_exception_fail(SWIG_ArgError(ecode2), "in method '" "primme_params_orth_set" "', argument " "2"" of type '" "primme_orth""'");
+  } 
+  arg2 = static_cast< primme_orth >(val2);
+  if (arg1) (arg1)->orth = arg2;
+  resultobj = SWIG_Py_Void();
+  return resultobj;
+fail:
+  return NULL;
+}
+
+
+SWIGINTERN PyObject *_wrap_primme_params_orth_get(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  primme_params *arg1 = (primme_params *) 0 ;
+  void *argp1 = 0 ;
+  int res1 = 0 ;
+  PyObject * obj0 = 0 ;
+  primme_orth result;
+  
+  if (!PyArg_ParseTuple(args,(char *)"O:primme_params_orth_get",&obj0)) SWIG_fail;
+  res1 = SWIG_ConvertPtr(obj0, &argp1,SWIGTYPE_p_primme_params, 0 |  0 );
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "primme_params_orth_get" "', argument " "1"" of type '" "primme_params *""'"); 
+  }
+  arg1 = reinterpret_cast< primme_params * >(argp1);
+  result = (primme_orth) ((arg1)->orth);
+  resultobj = SWIG_From_int(static_cast< int >(result));
+  return resultobj;
+fail:
+  return NULL;
+}
+
+
 SWIGINTERN PyObject *_wrap_primme_params_ldevecs_set(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
   PyObject *resultobj = 0;
   primme_params *arg1 = (primme_params *) 0 ;
@@ -9939,6 +10408,386 @@ fail:
 }
 
 
+SWIGINTERN PyObject *_wrap_primme_params_cacheBlockSize_set(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  primme_params *arg1 = (primme_params *) 0 ;
+  int arg2 ;
+  void *argp1 = 0 ;
+  int res1 = 0 ;
+  int val2 ;
+  int ecode2 = 0 ;
+  PyObject * obj0 = 0 ;
+  PyObject * obj1 = 0 ;
+  
+  if (!PyArg_ParseTuple(args,(char *)"OO:primme_params_cacheBlockSize_set",&obj0,&obj1)) SWIG_fail;
+  res1 = SWIG_ConvertPtr(obj0, &argp1,SWIGTYPE_p_primme_params, 0 |  0 );
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "primme_params_cacheBlockSize_set" "', argument " "1"" of type '" "primme_params *""'"); 
+  }
+  arg1 = reinterpret_cast< primme_params * >(argp1);
+  ecode2 = SWIG_AsVal_int(obj1, &val2);
+  if (!SWIG_IsOK(ecode2)) {
+    SWIG_exception_fail(SWIG_ArgError(ecode2), "in method '" "primme_params_cacheBlockSize_set" "', argument " "2"" of type '" "int""'");
+  } 
+  arg2 = static_cast< int >(val2);
+  if (arg1) (arg1)->cacheBlockSize = arg2;
+  resultobj = SWIG_Py_Void();
+  return resultobj;
+fail:
+  return NULL;
+}
+
+
+SWIGINTERN PyObject *_wrap_primme_params_cacheBlockSize_get(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  primme_params *arg1 = (primme_params *) 0 ;
+  void *argp1 = 0 ;
+  int res1 = 0 ;
+  PyObject * obj0 = 0 ;
+  int result;
+  
+  if (!PyArg_ParseTuple(args,(char *)"O:primme_params_cacheBlockSize_get",&obj0)) SWIG_fail;
+  res1 = SWIG_ConvertPtr(obj0, &argp1,SWIGTYPE_p_primme_params, 0 |  0 );
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "primme_params_cacheBlockSize_get" "', argument " "1"" of type '" "primme_params *""'"); 
+  }
+  arg1 = reinterpret_cast< primme_params * >(argp1);
+  result = (int) ((arg1)->cacheBlockSize);
+  resultobj = SWIG_From_int(static_cast< int >(result));
+  return resultobj;
+fail:
+  return NULL;
+}
+
+
+SWIGINTERN PyObject *_wrap_primme_params_mixedPrecision_set(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  primme_params *arg1 = (primme_params *) 0 ;
+  int arg2 ;
+  void *argp1 = 0 ;
+  int res1 = 0 ;
+  int val2 ;
+  int ecode2 = 0 ;
+  PyObject * obj0 = 0 ;
+  PyObject * obj1 = 0 ;
+  
+  if (!PyArg_ParseTuple(args,(char *)"OO:primme_params_mixedPrecision_set",&obj0,&obj1)) SWIG_fail;
+  res1 = SWIG_ConvertPtr(obj0, &argp1,SWIGTYPE_p_primme_params, 0 |  0 );
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "primme_params_mixedPrecision_set" "', argument " "1"" of type '" "primme_params *""'"); 
+  }
+  arg1 = reinterpret_cast< primme_params * >(argp1);
+  ecode2 = SWIG_AsVal_int(obj1, &val2);
+  if (!SWIG_IsOK(ecode2)) {
+    SWIG_exception_fail(SWIG_ArgError(ecode2), "in method '" "primme_params_mixedPrecision_set" "', argument " "2"" of type '" "int""'");
+  } 
+  arg2 = static_cast< int >(val2);
+  if (arg1) (arg1)->mixedPrecision = arg2;
+  resultobj = SWIG_Py_Void();
+  return resultobj;
+fail:
+  return NULL;
+}
+
+
+SWIGINTERN PyObject *_wrap_primme_params_mixedPrecision_get(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  primme_params *arg1 = (primme_params *) 0 ;
+  void *argp1 = 0 ;
+  int res1 = 0 ;
+  PyObject * obj0 = 0 ;
+  int result;
+  
+  if (!PyArg_ParseTuple(args,(char *)"O:primme_params_mixedPrecision_get",&obj0)) SWIG_fail;
+  res1 = SWIG_ConvertPtr(obj0, &argp1,SWIGTYPE_p_primme_params, 0 |  0 );
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "primme_params_mixedPrecision_get" "', argument " "1"" of type '" "primme_params *""'"); 
+  }
+  arg1 = reinterpret_cast< primme_params * >(argp1);
+  result = (int) ((arg1)->mixedPrecision);
+  resultobj = SWIG_From_int(static_cast< int >(result));
+  return resultobj;
+fail:
+  return NULL;
+}
+
+
+SWIGINTERN PyObject *_wrap_primme_params_checkpointFile_set(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  primme_params *arg1 = (primme_params *) 0 ;
+  char *arg2 = (char *) 0 ;
+  void *argp1 = 0 ;
+  int res1 = 0 ;
+  int res2 ;
+  char *buf2 = 0 ;
+  int alloc2 = 0 ;
+  PyObject * obj0 = 0 ;
+  PyObject * obj1 = 0 ;
+
+  if (!PyArg_ParseTuple(args,(char *)"OO:primme_params_checkpointFile_set",&obj0,&obj1)) SWIG_fail;
+  res1 = SWIG_ConvertPtr(obj0, &argp1,SWIGTYPE_p_primme_params, 0 |  0 );
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "primme_params_checkpointFile_set" "', argument " "1"" of type '" "primme_params *""'");
+  }
+  arg1 = reinterpret_cast< primme_params * >(argp1);
+  res2 = SWIG_AsCharPtrAndSize(obj1, &buf2, NULL, &alloc2);
+  if (!SWIG_IsOK(res2)) {
+    SWIG_exception_fail(SWIG_ArgError(res2), "in method '" "primme_params_checkpointFile_set" "', argument " "2"" of type '" "char const *""'");
+  }
+  arg2 = reinterpret_cast< char * >(buf2);
+  if (arg2) {
+    size_t size = strlen(reinterpret_cast< const char * >(reinterpret_cast< const char * >(arg2))) + 1;
+    arg1->checkpointFile = (char const *)reinterpret_cast< char* >(memcpy(new char[size], arg2, sizeof(char)*(size)));
+  } else {
+    arg1->checkpointFile = 0;
+  }
+  resultobj = SWIG_Py_Void();
+  if (alloc2 == SWIG_NEWOBJ) delete[] buf2;
+  return resultobj;
+fail:
+  if (alloc2 == SWIG_NEWOBJ) delete[] buf2;
+  return NULL;
+}
+
+
+SWIGINTERN PyObject *_wrap_primme_params_checkpointFile_get(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  primme_params *arg1 = (primme_params *) 0 ;
+  void *argp1 = 0 ;
+  int res1 = 0 ;
+  PyObject * obj0 = 0 ;
+  char *result = 0 ;
+
+  if (!PyArg_ParseTuple(args,(char *)"O:primme_params_checkpointFile_get",&obj0)) SWIG_fail;
+  res1 = SWIG_ConvertPtr(obj0, &argp1,SWIGTYPE_p_primme_params, 0 |  0 );
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "primme_params_checkpointFile_get" "', argument " "1"" of type '" "primme_params *""'");
+  }
+  arg1 = reinterpret_cast< primme_params * >(argp1);
+  result = (char *) ((arg1)->checkpointFile);
+  resultobj = SWIG_FromCharPtr((const char *)result);
+  return resultobj;
+fail:
+  return NULL;
+}
+
+
+SWIGINTERN PyObject *_wrap_primme_params_checkpointInterval_set(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  primme_params *arg1 = (primme_params *) 0 ;
+  int arg2 ;
+  void *argp1 = 0 ;
+  int res1 = 0 ;
+  int val2 ;
+  int ecode2 = 0 ;
+  PyObject * obj0 = 0 ;
+  PyObject * obj1 = 0 ;
+  
+  if (!PyArg_ParseTuple(args,(char *)"OO:primme_params_checkpointInterval_set",&obj0,&obj1)) SWIG_fail;
+  res1 = SWIG_ConvertPtr(obj0, &argp1,SWIGTYPE_p_primme_params, 0 |  0 );
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "primme_params_checkpointInterval_set" "', argument " "1"" of type '" "primme_params *""'"); 
+  }
+  arg1 = reinterpret_cast< primme_params * >(argp1);
+  ecode2 = SWIG_AsVal_int(obj1, &val2);
+  if (!SWIG_IsOK(ecode2)) {
+    SWIG_exception_fail(SWIG_ArgError(ecode2), "in method '" "primme_params_checkpointInterval_set" "', argument " "2"" of type '" "int""'");
+  } 
+  arg2 = static_cast< int >(val2);
+  if (arg1) (arg1)->checkpointInterval = arg2;
+  resultobj = SWIG_Py_Void();
+  return resultobj;
+fail:
+  return NULL;
+}
+
+
+SWIGINTERN PyObject *_wrap_primme_params_checkpointInterval_get(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  primme_params *arg1 = (primme_params *) 0 ;
+  void *argp1 = 0 ;
+  int res1 = 0 ;
+  PyObject * obj0 = 0 ;
+  int result;
+  
+  if (!PyArg_ParseTuple(args,(char *)"O:primme_params_checkpointInterval_get",&obj0)) SWIG_fail;
+  res1 = SWIG_ConvertPtr(obj0, &argp1,SWIGTYPE_p_primme_params, 0 |  0 );
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "primme_params_checkpointInterval_get" "', argument " "1"" of type '" "primme_params *""'"); 
+  }
+  arg1 = reinterpret_cast< primme_params * >(argp1);
+  result = (int) ((arg1)->checkpointInterval);
+  resultobj = SWIG_From_int(static_cast< int >(result));
+  return resultobj;
+fail:
+  return NULL;
+}
+
+
+SWIGINTERN PyObject *_wrap_primme_params_checkpointResume_set(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  primme_params *arg1 = (primme_params *) 0 ;
+  int arg2 ;
+  void *argp1 = 0 ;
+  int res1 = 0 ;
+  int val2 ;
+  int ecode2 = 0 ;
+  PyObject * obj0 = 0 ;
+  PyObject * obj1 = 0 ;
+  
+  if (!PyArg_ParseTuple(args,(char *)"OO:primme_params_checkpointResume_set",&obj0,&obj1)) SWIG_fail;
+  res1 = SWIG_ConvertPtr(obj0, &argp1,SWIGTYPE_p_primme_params, 0 |  0 );
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "primme_params_checkpointResume_set" "', argument " "1"" of type '" "primme_params *""'"); 
+  }
+  arg1 = reinterpret_cast< primme_params * >(argp1);
+  ecode2 = SWIG_AsVal_int(obj1, &val2);
+  if (!SWIG_IsOK(ecode2)) {
+    SWIG_exception_fail(SWIG_ArgError(ecode2), "in method '" "primme_params_checkpointResume_set" "', argument " "2"" of type '" "int""'");
+  } 
+  arg2 = static_cast< int >(val2);
+  if (arg1) (arg1)->checkpointResume = arg2;
+  resultobj = SWIG_Py_Void();
+  return resultobj;
+fail:
+  return NULL;
+}
+
+
+SWIGINTERN PyObject *_wrap_primme_params_checkpointResume_get(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  primme_params *arg1 = (primme_params *) 0 ;
+  void *argp1 = 0 ;
+  int res1 = 0 ;
+  PyObject * obj0 = 0 ;
+  int result;
+  
+  if (!PyArg_ParseTuple(args,(char *)"O:primme_params_checkpointResume_get",&obj0)) SWIG_fail;
+  res1 = SWIG_ConvertPtr(obj0, &argp1,SWIGTYPE_p_primme_params, 0 |  0 );
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "primme_params_checkpointResume_get" "', argument " "1"" of type '" "primme_params *""'"); 
+  }
+  arg1 = reinterpret_cast< primme_params * >(argp1);
+  result = (int) ((arg1)->checkpointResume);
+  resultobj = SWIG_From_int(static_cast< int >(result));
+  return resultobj;
+fail:
+  return NULL;
+}
+
+
+SWIGINTERN PyObject *_wrap_primme_params_outOfCoreDir_set(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  primme_params *arg1 = (primme_params *) 0 ;
+  char *arg2 = (char *) 0 ;
+  void *argp1 = 0 ;
+  int res1 = 0 ;
+  int res2 ;
+  char *buf2 = 0 ;
+  int alloc2 = 0 ;
+  PyObject * obj0 = 0 ;
+  PyObject * obj1 = 0 ;
+
+  if (!PyArg_ParseTuple(args,(char *)"OO:primme_params_outOfCoreDir_set",&obj0,&obj1)) SWIG_fail;
+  res1 = SWIG_ConvertPtr(obj0, &argp1,SWIGTYPE_p_primme_params, 0 |  0 );
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "primme_params_outOfCoreDir_set" "', argument " "1"" of type '" "primme_params *""'");
+  }
+  arg1 = reinterpret_cast< primme_params * >(argp1);
+  res2 = SWIG_AsCharPtrAndSize(obj1, &buf2, NULL, &alloc2);
+  if (!SWIG_IsOK(res2)) {
+    SWIG_exception_fail(SWIG_ArgError(res2), "in method '" "primme_params_outOfCoreDir_set" "', argument " "2"" of type '" "char const *""'");
+  }
+  arg2 = reinterpret_cast< char * >(buf2);
+  if (arg2) {
+    size_t size = strlen(reinterpret_cast< const char * >(reinterpret_cast< const char * >(arg2))) + 1;
+    arg1->outOfCoreDir = (char const *)reinterpret_cast< char* >(memcpy(new char[size], arg2, sizeof(char)*(size)));
+  } else {
+    arg1->outOfCoreDir = 0;
+  }
+  resultobj = SWIG_Py_Void();
+  if (alloc2 == SWIG_NEWOBJ) delete[] buf2;
+  return resultobj;
+fail:
+  if (alloc2 == SWIG_NEWOBJ) delete[] buf2;
+  return NULL;
+}
+
+
+SWIGINTERN PyObject *_wrap_primme_params_outOfCoreDir_get(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  primme_params *arg1 = (primme_params *) 0 ;
+  void *argp1 = 0 ;
+  int res1 = 0 ;
+  PyObject * obj0 = 0 ;
+  char *result = 0 ;
+
+  if (!PyArg_ParseTuple(args,(char *)"O:primme_params_outOfCoreDir_get",&obj0)) SWIG_fail;
+  res1 = SWIG_ConvertPtr(obj0, &argp1,SWIGTYPE_p_primme_params, 0 |  0 );
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "primme_params_outOfCoreDir_get" "', argument " "1"" of type '" "primme_params *""'");
+  }
+  arg1 = reinterpret_cast< primme_params * >(argp1);
+  result = (char *) ((arg1)->outOfCoreDir);
+  resultobj = SWIG_FromCharPtr((const char *)result);
+  return resultobj;
+fail:
+  return NULL;
+}
+
+
+SWIGINTERN PyObject *_wrap_primme_params_warmStart_set(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  primme_params *arg1 = (primme_params *) 0 ;
+  int arg2 ;
+  void *argp1 = 0 ;
+  int res1 = 0 ;
+  int val2 ;
+  int ecode2 = 0 ;
+  PyObject * obj0 = 0 ;
+  PyObject * obj1 = 0 ;
+  
+  if (!PyArg_ParseTuple(args,(char *)"OO:primme_params_warmStart_set",&obj0,&obj1)) SWIG_fail;
+  res1 = SWIG_ConvertPtr(obj0, &argp1,SWIGTYPE_p_primme_params, 0 |  0 );
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "primme_params_warmStart_set" "', argument " "1"" of type '" "primme_params *""'"); 
+  }
+  arg1 = reinterpret_cast< primme_params * >(argp1);
+  ecode2 = SWIG_AsVal_int(obj1, &val2);
+  if (!SWIG_IsOK(ecode2)) {
+    SWIG_exception_fail(SWIG_ArgError(ecode2), "in method '" "primme_params_warmStart_set" "', argument " "2"" of type '" "int""'");
+  } 
+  arg2 = static_cast< int >(val2);
+  if (arg1) (arg1)->warmStart = arg2;
+  resultobj = SWIG_Py_Void();
+  return resultobj;
+fail:
+  return NULL;
+}
+
+
+SWIGINTERN PyObject *_wrap_primme_params_warmStart_get(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  primme_params *arg1 = (primme_params *) 0 ;
+  void *argp1 = 0 ;
+  int res1 = 0 ;
+  PyObject * obj0 = 0 ;
+  int result;
+  
+  if (!PyArg_ParseTuple(args,(char *)"O:primme_params_warmStart_get",&obj0)) SWIG_fail;
+  res1 = SWIG_ConvertPtr(obj0, &argp1,SWIGTYPE_p_primme_params, 0 |  0 );
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "primme_params_warmStart_get" "', argument " "1"" of type '" "primme_params *""'"); 
+  }
+  arg1 = reinterpret_cast< primme_params * >(argp1);
+  result = (int) ((arg1)->warmStart);
+  resultobj = SWIG_From_int(static_cast< int >(result));
+  return resultobj;
+fail:
+  return NULL;
+}
+
+
 SWIGINTERN PyObject *_wrap_primme_params_projectionParams_set(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
   PyObject *resultobj = 0;
   primme_params *arg1 = (primme_params *) 0 ;
@@ -13380,6 +14229,81 @@ fail:
 }
 
 
+SWIGINTERN PyObject *_wrap_PrimmeParams__set_matrix(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  PrimmeParams *arg1 = (PrimmeParams *) 0 ;
+  int arg2 ;
+  size_t arg3 ;
+  size_t arg4 ;
+  size_t arg5 ;
+  void *argp1 = 0 ;
+  int res1 = 0 ;
+  int val2 ;
+  int ecode2 = 0 ;
+  size_t val3 ;
+  int ecode3 = 0 ;
+  size_t val4 ;
+  int ecode4 = 0 ;
+  size_t val5 ;
+  int ecode5 = 0 ;
+  PyObject * obj0 = 0 ;
+  PyObject * obj1 = 0 ;
+  PyObject * obj2 = 0 ;
+  PyObject * obj3 = 0 ;
+  PyObject * obj4 = 0 ;
+  
+  if (!PyArg_ParseTuple(args,(char *)"OOOOO:PrimmeParams__set_matrix",&obj0,&obj1,&obj2,&obj3,&obj4)) SWIG_fail;
+  res1 = SWIG_ConvertPtr(obj0, &argp1,SWIGTYPE_p_PrimmeParams, 0 |  0 );
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "PrimmeParams__set_matrix" "', argument " "1"" of type '" "PrimmeParams *""'"); 
+  }
+  arg1 = reinterpret_cast< PrimmeParams * >(argp1);
+  ecode2 = SWIG_AsVal_int(obj1, &val2);
+  if (!SWIG_IsOK(ecode2)) {
+    SWIG_exception_fail(SWIG_ArgError(ecode2), "in method '" "PrimmeParams__set_matrix" "', argument " "2"" of type '" "int""'");
+  } 
+  arg2 = static_cast< int >(val2);
+  ecode3 = SWIG_AsVal_size_t(obj2, &val3);
+  if (!SWIG_IsOK(ecode3)) {
+    SWIG_exception_fail(SWIG_ArgError(ecode3), "in method '" "PrimmeParams__set_matrix" "', argument " "3"" of type '" "size_t""'");
+  } 
+  arg3 = static_cast< size_t >(val3);
+  ecode4 = SWIG_AsVal_size_t(obj3, &val4);
+  if (!SWIG_IsOK(ecode4)) {
+    SWIG_exception_fail(SWIG_ArgError(ecode4), "in method '" "PrimmeParams__set_matrix" "', argument " "4"" of type '" "size_t""'");
+  } 
+  arg4 = static_cast< size_t >(val4);
+  ecode5 = SWIG_AsVal_size_t(obj4, &val5);
+  if (!SWIG_IsOK(ecode5)) {
+    SWIG_exception_fail(SWIG_ArgError(ecode5), "in method '" "PrimmeParams__set_matrix" "', argument " "5"" of type '" "size_t""'");
+  } 
+  arg5 = static_cast< size_t >(val5);
+  {
+    try
+    {
+      (arg1)->_set_matrix(arg2,arg3,arg4,arg5);
+    }
+    catch (const std::invalid_argument& e)
+    {
+      SWIG_exception(SWIG_ValueError, e.what());
+    }
+    catch (const std::out_of_range& e)
+    {
+      SWIG_exception(SWIG_IndexError, e.what());
+    }
+    catch (Swig::DirectorException &e)
+    {
+      SWIG_fail;
+    }
+    if (PyErr_Occurred()) SWIG_fail;
+  }
+  resultobj = SWIG_Py_Void();
+  return resultobj;
+fail:
+  return NULL;
+}
+
+
 SWIGINTERN PyObject *_wrap_PrimmeParams_matvec__SWIG_0(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
   PyObject *resultobj = 0;
   PrimmeParams *arg1 = (PrimmeParams *) 0 ;
@@ -15040,6 +15964,108 @@ fail:
 }
 
 
+SWIGINTERN PyObject *_wrap_PrimmeSvdsParams__set_matrix(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  PrimmeSvdsParams *arg1 = (PrimmeSvdsParams *) 0 ;
+  int arg2 ;
+  size_t arg3 ;
+  size_t arg4 ;
+  size_t arg5 ;
+  size_t arg6 ;
+  size_t arg7 ;
+  size_t arg8 ;
+  void *argp1 = 0 ;
+  int res1 = 0 ;
+  int val2 ;
+  int ecode2 = 0 ;
+  size_t val3 ;
+  int ecode3 = 0 ;
+  size_t val4 ;
+  int ecode4 = 0 ;
+  size_t val5 ;
+  int ecode5 = 0 ;
+  size_t val6 ;
+  int ecode6 = 0 ;
+  size_t val7 ;
+  int ecode7 = 0 ;
+  size_t val8 ;
+  int ecode8 = 0 ;
+  PyObject * obj0 = 0 ;
+  PyObject * obj1 = 0 ;
+  PyObject * obj2 = 0 ;
+  PyObject * obj3 = 0 ;
+  PyObject * obj4 = 0 ;
+  PyObject * obj5 = 0 ;
+  PyObject * obj6 = 0 ;
+  PyObject * obj7 = 0 ;
+  
+  if (!PyArg_ParseTuple(args,(char *)"OOOOOOOO:PrimmeSvdsParams__set_matrix",&obj0,&obj1,&obj2,&obj3,&obj4,&obj5,&obj6,&obj7)) SWIG_fail;
+  res1 = SWIG_ConvertPtr(obj0, &argp1,SWIGTYPE_p_PrimmeSvdsParams, 0 |  0 );
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "PrimmeSvdsParams__set_matrix" "', argument " "1"" of type '" "PrimmeSvdsParams *""'"); 
+  }
+  arg1 = reinterpret_cast< PrimmeSvdsParams * >(argp1);
+  ecode2 = SWIG_AsVal_int(obj1, &val2);
+  if (!SWIG_IsOK(ecode2)) {
+    SWIG_exception_fail(SWIG_ArgError(ecode2), "in method '" "PrimmeSvdsParams__set_matrix" "', argument " "2"" of type '" "int""'");
+  } 
+  arg2 = static_cast< int >(val2);
+  ecode3 = SWIG_AsVal_size_t(obj2, &val3);
+  if (!SWIG_IsOK(ecode3)) {
+    SWIG_exception_fail(SWIG_ArgError(ecode3), "in method '" "PrimmeSvdsParams__set_matrix" "', argument " "3"" of type '" "size_t""'");
+  } 
+  arg3 = static_cast< size_t >(val3);
+  ecode4 = SWIG_AsVal_size_t(obj3, &val4);
+  if (!SWIG_IsOK(ecode4)) {
+    SWIG_exception_fail(SWIG_ArgError(ecode4), "in method '" "PrimmeSvdsParams__set_matrix" "', argument " "4"" of type '" "size_t""'");
+  } 
+  arg4 = static_cast< size_t >(val4);
+  ecode5 = SWIG_AsVal_size_t(obj4, &val5);
+  if (!SWIG_IsOK(ecode5)) {
+    SWIG_exception_fail(SWIG_ArgError(ecode5), "in method '" "PrimmeSvdsParams__set_matrix" "', argument " "5"" of type '" "size_t""'");
+  } 
+  arg5 = static_cast< size_t >(val5);
+  ecode6 = SWIG_AsVal_size_t(obj5, &val6);
+  if (!SWIG_IsOK(ecode6)) {
+    SWIG_exception_fail(SWIG_ArgError(ecode6), "in method '" "PrimmeSvdsParams__set_matrix" "', argument " "6"" of type '" "size_t""'");
+  } 
+  arg6 = static_cast< size_t >(val6);
+  ecode7 = SWIG_AsVal_size_t(obj6, &val7);
+  if (!SWIG_IsOK(ecode7)) {
+    SWIG_exception_fail(SWIG_ArgError(ecode7), "in method '" "PrimmeSvdsParams__set_matrix" "', argument " "7"" of type '" "size_t""'");
+  } 
+  arg7 = static_cast< size_t >(val7);
+  ecode8 = SWIG_AsVal_size_t(obj7, &val8);
+  if (!SWIG_IsOK(ecode8)) {
+    SWIG_exception_fail(SWIG_ArgError(ecode8), "in method '" "PrimmeSvdsParams__set_matrix" "', argument " "8"" of type '" "size_t""'");
+  } 
+  arg8 = static_cast< size_t >(val8);
+  {
+    try
+    {
+      (arg1)->_set_matrix(arg2,arg3,arg4,arg5,arg6,arg7,arg8);
+    }
+    catch (const std::invalid_argument& e)
+    {
+      SWIG_exception(SWIG_ValueError, e.what());
+    }
+    catch (const std::out_of_range& e)
+    {
+      SWIG_exception(SWIG_IndexError, e.what());
+    }
+    catch (Swig::DirectorException &e)
+    {
+      SWIG_fail;
+    }
+    if (PyErr_Occurred()) SWIG_fail;
+  }
+  resultobj = SWIG_Py_Void();
+  return resultobj;
+fail:
+  return NULL;
+}
+
+
 SWIGINTERN PyObject *_wrap_PrimmeSvdsParams_matvec__SWIG_0(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
   PyObject *resultobj = 0;
   PrimmeSvdsParams *arg1 = (PrimmeSvdsParams *) 0 ;
@@ -16546,6 +17572,8 @@ static PyMethodDef SwigMethods[] = {
 	 { (char *)"primme_stats_maxConvTol_get", _wrap_primme_stats_maxConvTol_get, METH_VARARGS, NULL},
 	 { (char *)"primme_stats_estimateResidualError_set", _wrap_primme_stats_estimateResidualError_set, METH_VARARGS, NULL},
 	 { (char *)"primme_stats_estimateResidualError_get", _wrap_primme_stats_estimateResidualError_get, METH_VARARGS, NULL},
+	 { (char *)"primme_stats_avgBlockSize_set", _wrap_primme_stats_avgBlockSize_set, METH_VARARGS, NULL},
+	 { (char *)"primme_stats_avgBlockSize_get", _wrap_primme_stats_avgBlockSize_get, METH_VARARGS, NULL},
 	 { (char *)"new_primme_stats", _wrap_new_primme_stats, METH_VARARGS, NULL},
 	 { (char *)"delete_primme_stats", _wrap_delete_primme_stats, METH_VARARGS, NULL},
 	 { (char *)"primme_stats_swigregister", primme_stats_swigregister, METH_VARARGS, NULL},
@@ -16581,6 +17609,10 @@ static PyMethodDef SwigMethods[] = {
 	 { (char *)"correction_params_convTest_get", _wrap_correction_params_convTest_get, METH_VARARGS, NULL},
 	 { (char *)"correction_params_relTolBase_set", _wrap_correction_params_relTolBase_set, METH_VARARGS, NULL},
 	 { (char *)"correction_params_relTolBase_get", _wrap_correction_params_relTolBase_get, METH_VARARGS, NULL},
+	 { (char *)"correction_params_fuseGlobalSums_set", _wrap_correction_params_fuseGlobalSums_set, METH_VARARGS, NULL},
+	 { (char *)"correction_params_fuseGlobalSums_get", _wrap_correction_params_fuseGlobalSums_get, METH_VARARGS, NULL},
+	 { (char *)"correction_params_filterDegree_set", _wrap_correction_params_filterDegree_set, METH_VARARGS, NULL},
+	 { (char *)"correction_params_filterDegree_get", _wrap_correction_params_filterDegree_get, METH_VARARGS, NULL},
 	 { (char *)"new_correction_params", _wrap_new_correction_params, METH_VARARGS, NULL},
 	 { (char *)"delete_correction_params", _wrap_delete_correction_params, METH_VARARGS, NULL},
 	 { (char *)"correction_params_swigregister", correction_params_swigregister, METH_VARARGS, NULL},
@@ -16607,6 +17639,8 @@ static PyMethodDef SwigMethods[] = {
 	 { (char *)"primme_params_target_get", _wrap_primme_params_target_get, METH_VARARGS, NULL},
 	 { (char *)"primme_params_dynamicMethodSwitch_set", _wrap_primme_params_dynamicMethodSwitch_set, METH_VARARGS, NULL},
 	 { (char *)"primme_params_dynamicMethodSwitch_get", _wrap_primme_params_dynamicMethodSwitch_get, METH_VARARGS, NULL},
+	 { (char *)"primme_params_dynamicBlockSize_set", _wrap_primme_params_dynamicBlockSize_set, METH_VARARGS, NULL},
+	 { (char *)"primme_params_dynamicBlockSize_get", _wrap_primme_params_dynamicBlockSize_get, METH_VARARGS, NULL},
 	 { (char *)"primme_params_locking_set", _wrap_primme_params_locking_set, METH_VARARGS, NULL},
 	 { (char *)"primme_params_locking_get", _wrap_primme_params_locking_get, METH_VARARGS, NULL},
 	 { (char *)"primme_params_initSize_set", _wrap_primme_params_initSize_set, METH_VARARGS, NULL},
@@ -16637,10 +17671,26 @@ static PyMethodDef SwigMethods[] = {
 	 { (char *)"primme_params_printLevel_get", _wrap_primme_params_printLevel_get, METH_VARARGS, NULL},
 	 { (char *)"primme_params_initBasisMode_set", _wrap_primme_params_initBasisMode_set, METH_VARARGS, NULL},
 	 { (char *)"primme_params_initBasisMode_get", _wrap_primme_params_initBasisMode_get, METH_VARARGS, NULL},
+	 { (char *)"primme_params_orth_set", _wrap_primme_params_orth_set, METH_VARARGS, NULL},
+	 { (char *)"primme_params_orth_get", _wrap_primme_params_orth_get, METH_VARARGS, NULL},
 	 { (char *)"primme_params_ldevecs_set", _wrap_primme_params_ldevecs_set, METH_VARARGS, NULL},
 	 { (char *)"primme_params_ldevecs_get", _wrap_primme_params_ldevecs_get, METH_VARARGS, NULL},
 	 { (char *)"primme_params_ldOPs_set", _wrap_primme_params_ldOPs_set, METH_VARARGS, NULL},
 	 { (char *)"primme_params_ldOPs_get", _wrap_primme_params_ldOPs_get, METH_VARARGS, NULL},
+	 { (char *)"primme_params_cacheBlockSize_set", _wrap_primme_params_cacheBlockSize_set, METH_VARARGS, NULL},
+	 { (char *)"primme_params_cacheBlockSize_get", _wrap_primme_params_cacheBlockSize_get, METH_VARARGS, NULL},
+	 { (char *)"primme_params_mixedPrecision_set", _wrap_primme_params_mixedPrecision_set, METH_VARARGS, NULL},
+	 { (char *)"primme_params_mixedPrecision_get", _wrap_primme_params_mixedPrecision_get, METH_VARARGS, NULL},
+	 { (char *)"primme_params_checkpointFile_set", _wrap_primme_params_checkpointFile_set, METH_VARARGS, NULL},
+	 { (char *)"primme_params_checkpointFile_get", _wrap_primme_params_checkpointFile_get, METH_VARARGS, NULL},
+	 { (char *)"primme_params_checkpointInterval_set", _wrap_primme_params_checkpointInterval_set, METH_VARARGS, NULL},
+	 { (char *)"primme_params_checkpointInterval_get", _wrap_primme_params_checkpointInterval_get, METH_VARARGS, NULL},
+	 { (char *)"primme_params_checkpointResume_set", _wrap_primme_params_checkpointResume_set, METH_VARARGS, NULL},
+	 { (char *)"primme_params_checkpointResume_get", _wrap_primme_params_checkpointResume_get, METH_VARARGS, NULL},
+	 { (char *)"primme_params_outOfCoreDir_set", _wrap_primme_params_outOfCoreDir_set, METH_VARARGS, NULL},
+	 { (char *)"primme_params_outOfCoreDir_get", _wrap_primme_params_outOfCoreDir_get, METH_VARARGS, NULL},
+	 { (char *)"primme_params_warmStart_set", _wrap_primme_params_warmStart_set, METH_VARARGS, NULL},
+	 { (char *)"primme_params_warmStart_get", _wrap_primme_params_warmStart_get, METH_VARARGS, NULL},
 	 { (char *)"primme_params_projectionParams_set", _wrap_primme_params_projectionParams_set, METH_VARARGS, NULL},
 	 { (char *)"primme_params_projectionParams_get", _wrap_primme_params_projectionParams_get, METH_VARARGS, NULL},
 	 { (char *)"primme_params_restartingParams_set", _wrap_primme_params_restartingParams_set, METH_VARARGS, NULL},
@@ -16764,6 +17814,7 @@ static PyMethodDef SwigMethods[] = {
 	 { (char *)"PrimmeParams_set_method", _wrap_PrimmeParams_set_method, METH_VARARGS, NULL},
 	 { (char *)"PrimmeParams__set_targetShifts", _wrap_PrimmeParams__set_targetShifts, METH_VARARGS, NULL},
 	 { (char *)"PrimmeParams__get_targetShifts", _wrap_PrimmeParams__get_targetShifts, METH_VARARGS, NULL},
+	 { (char *)"PrimmeParams__set_matrix", _wrap_PrimmeParams__set_matrix, METH_VARARGS, NULL},
 	 { (char *)"PrimmeParams_matvec", _wrap_PrimmeParams_matvec, METH_VARARGS, NULL},
 	 { (char *)"PrimmeParams_prevec", _wrap_PrimmeParams_prevec, METH_VARARGS, NULL},
 	 { (char *)"PrimmeParams_globalSum", _wrap_PrimmeParams_globalSum, METH_VARARGS, NULL},
@@ -16810,6 +17861,7 @@ static PyMethodDef SwigMethods[] = {
 	 { (char *)"PrimmeSvdsParams_set_method", _wrap_PrimmeSvdsParams_set_method, METH_VARARGS, NULL},
 	 { (char *)"PrimmeSvdsParams__set_targetShifts", _wrap_PrimmeSvdsParams__set_targetShifts, METH_VARARGS, NULL},
 	 { (char *)"PrimmeSvdsParams__get_targetShifts", _wrap_PrimmeSvdsParams__get_targetShifts, METH_VARARGS, NULL},
+	 { (char *)"PrimmeSvdsParams__set_matrix", _wrap_PrimmeSvdsParams__set_matrix, METH_VARARGS, NULL},
 	 { (char *)"PrimmeSvdsParams_matvec", _wrap_PrimmeSvdsParams_matvec, METH_VARARGS, NULL},
 	 { (char *)"PrimmeSvdsParams_prevec", _wrap_PrimmeSvdsParams_prevec, METH_VARARGS, NULL},
 	 { (char *)"PrimmeSvdsParams_globalSum", _wrap_PrimmeSvdsParams_globalSum, METH_VARARGS, NULL},
@@ -16843,6 +17895,7 @@ static swig_type_info _swigt__p_long_long = {"_p_long_long", "int_least64_t *|in
 static swig_type_info _swigt__p_p_double = {"_p_p_double", "double **", 0, 0, (void*)0, 0};
 static swig_type_info _swigt__p_primme_convergencetest = {"_p_primme_convergencetest", "enum primme_convergencetest *|primme_convergencetest *", 0, 0, (void*)0, 0};
 static swig_type_info _swigt__p_primme_init = {"_p_primme_init", "enum primme_init *|primme_init *", 0, 0, (void*)0, 0};
+static swig_type_info _swigt__p_primme_orth = {"_p_primme_orth", "enum primme_orth *|primme_orth *", 0, 0, (void*)0, 0};
 static swig_type_info _swigt__p_primme_params = {"_p_primme_params", "primme_params *", 0, 0, (void*)0, 0};
 static swig_type_info _swigt__p_primme_preset_method = {"_p_primme_preset_method", "enum primme_preset_method *|primme_preset_method *", 0, 0, (void*)0, 0};
 static swig_type_info _swigt__p_primme_projection = {"_p_primme_projection", "enum primme_projection *|primme_projection *", 0, 0, (void*)0, 0};
@@ -16880,6 +17933,7 @@ static swig_type_info *swig_type_initial[] = {
   &_swigt__p_p_double,
   &_swigt__p_primme_convergencetest,
   &_swigt__p_primme_init,
+  &_swigt__p_primme_orth,
   &_swigt__p_primme_params,
   &_swigt__p_primme_preset_method,
   &_swigt__p_primme_projection,
@@ -16917,6 +17971,7 @@ static swig_cast_info _swigc__p_long_long[] = {  {&_swigt__p_long_long, 0, 0, 0}
 static swig_cast_info _swigc__p_p_double[] = {  {&_swigt__p_p_double, 0, 0, 0},{0, 0, 0, 0}};
 static swig_cast_info _swigc__p_primme_convergencetest[] = {  {&_swigt__p_primme_convergencetest, 0, 0, 0},{0, 0, 0, 0}};
 static swig_cast_info _swigc__p_primme_init[] = {  {&_swigt__p_primme_init, 0, 0, 0},{0, 0, 0, 0}};
+static swig_cast_info _swigc__p_primme_orth[] = {  {&_swigt__p_primme_orth, 0, 0, 0},{0, 0, 0, 0}};
 static swig_cast_info _swigc__p_primme_params[] = {  {&_swigt__p_primme_params, 0, 0, 0},  {&_swigt__p_PrimmeParams, _p_PrimmeParamsTo_p_primme_params, 0, 0},{0, 0, 0, 0}};
 static swig_cast_info _swigc__p_primme_preset_method[] = {  {&_swigt__p_primme_preset_method, 0, 0, 0},{0, 0, 0, 0}};
 static swig_cast_info _swigc__p_primme_projection[] = {  {&_swigt__p_primme_projection, 0, 0, 0},{0, 0, 0, 0}};
@@ -16954,6 +18009,7 @@ static swig_cast_info *swig_cast_initial[] = {
   _swigc__p_p_double,
   _swigc__p_primme_convergencetest,
   _swigc__p_primme_init,
+  _swigc__p_primme_orth,
   _swigc__p_primme_params,
   _swigc__p_primme_preset_method,
   _swigc__p_primme_projection,
@@ -17686,12 +18742,28 @@ SWIG_init(void) {
   SWIG_Python_SetConstant(d, "primme_init_krylov",SWIG_From_int(static_cast< int >(primme_init_krylov)));
   SWIG_Python_SetConstant(d, "primme_init_random",SWIG_From_int(static_cast< int >(primme_init_random)));
   SWIG_Python_SetConstant(d, "primme_init_user",SWIG_From_int(static_cast< int >(primme_init_user)));
+  SWIG_Python_SetConstant(d, "primme_orth_default",SWIG_From_int(static_cast< int >(primme_orth_default)));
+  SWIG_Python_SetConstant(d, "primme_orth_column",SWIG_From_int(static_cast< int >(primme_orth_column)));
+  SWIG_Python_SetConstant(d, "primme_orth_block",SWIG_From_int(static_cast< int >(primme_orth_block)));
+  SWIG_Python_SetConstant(d, "primme_orth_pipelined",SWIG_From_int(static_cast< int >(primme_orth_pipelined)));
   SWIG_Python_SetConstant(d, "primme_thick",SWIG_From_int(static_cast< int >(primme_thick)));
   SWIG_Python_SetConstant(d, "primme_dtr",SWIG_From_int(static_cast< int >(primme_dtr)));
   SWIG_Python_SetConstant(d, "primme_full_LTolerance",SWIG_From_int(static_cast< int >(primme_full_LTolerance)));
   SWIG_Python_SetConstant(d, "primme_decreasing_LTolerance",SWIG_From_int(static_cast< int >(primme_decreasing_LTolerance)));
   SWIG_Python_SetConstant(d, "primme_adaptive_ETolerance",SWIG_From_int(static_cast< int >(primme_adaptive_ETolerance)));
   SWIG_Python_SetConstant(d, "primme_adaptive",SWIG_From_int(static_cast< int >(primme_adaptive)));
+  SWIG_Python_SetConstant(d, "primme_event_start",SWIG_From_int(static_cast< int >(primme_event_start)));
+  SWIG_Python_SetConstant(d, "primme_event_init",SWIG_From_int(static_cast< int >(primme_event_init)));
+  SWIG_Python_SetConstant(d, "primme_event_prepare_candidates",SWIG_From_int(static_cast< int >(primme_event_prepare_candidates)));
+  SWIG_Python_SetConstant(d, "primme_event_iteration",SWIG_From_int(static_cast< int >(primme_event_iteration)));
+  SWIG_Python_SetConstant(d, "primme_event_correction",SWIG_From_int(static_cast< int >(primme_event_correction)));
+  SWIG_Python_SetConstant(d, "primme_event_ortho",SWIG_From_int(static_cast< int >(primme_event_ortho)));
+  SWIG_Python_SetConstant(d, "primme_event_matvec",SWIG_From_int(static_cast< int >(primme_event_matvec)));
+  SWIG_Python_SetConstant(d, "primme_event_update_projection",SWIG_From_int(static_cast< int >(primme_event_update_projection)));
+  SWIG_Python_SetConstant(d, "primme_event_solve_H",SWIG_From_int(static_cast< int >(primme_event_solve_H)));
+  SWIG_Python_SetConstant(d, "primme_event_restart",SWIG_From_int(static_cast< int >(primme_event_restart)));
+  SWIG_Python_SetConstant(d, "primme_event_locking",SWIG_From_int(static_cast< int >(primme_event_locking)));
+  SWIG_Python_SetConstant(d, "primme_event_finish",SWIG_From_int(static_cast< int >(primme_event_finish)));
   SWIG_Python_SetConstant(d, "PRIMME_DEFAULT_METHOD",SWIG_From_int(static_cast< int >(PRIMME_DEFAULT_METHOD)));
   SWIG_Python_SetConstant(d, "PRIMME_DYNAMIC",SWIG_From_int(static_cast< int >(PRIMME_DYNAMIC)));
   SWIG_Python_SetConstant(d, "PRIMME_DEFAULT_MIN_TIME",SWIG_From_int(static_cast< int >(PRIMME_DEFAULT_MIN_TIME)));
@@ -17715,10 +18787,12 @@ SWIG_init(void) {
   SWIG_Python_SetConstant(d, "primme_svds_hybrid",SWIG_From_int(static_cast< int >(primme_svds_hybrid)));
   SWIG_Python_SetConstant(d, "primme_svds_normalequations",SWIG_From_int(static_cast< int >(primme_svds_normalequations)));
   SWIG_Python_SetConstant(d, "primme_svds_augmented",SWIG_From_int(static_cast< int >(primme_svds_augmented)));
+  SWIG_Python_SetConstant(d, "primme_svds_bidiag",SWIG_From_int(static_cast< int >(primme_svds_bidiag)));
   SWIG_Python_SetConstant(d, "primme_svds_op_none",SWIG_From_int(static_cast< int >(primme_svds_op_none)));
   SWIG_Python_SetConstant(d, "primme_svds_op_AtA",SWIG_From_int(static_cast< int >(primme_svds_op_AtA)));
   SWIG_Python_SetConstant(d, "primme_svds_op_AAt",SWIG_From_int(static_cast< int >(primme_svds_op_AAt)));
   SWIG_Python_SetConstant(d, "primme_svds_op_augmented",SWIG_From_int(static_cast< int >(primme_svds_op_augmented)));
+  SWIG_Python_SetConstant(d, "primme_svds_op_bidiag",SWIG_From_int(static_cast< int >(primme_svds_op_bidiag)));
 #if PY_VERSION_HEX >= 0x03000000
   return m;
 #else
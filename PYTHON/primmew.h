@@ -40,6 +40,95 @@
 
 #include "../include/primme.h"
 
+#ifndef SWIG
+
+/* BLAS gemm and gemv from PRIMME, which take care of the Fortran calling  */
+/* convention and of the BLAS integer size                                  */
+
+extern "C" {
+void Num_gemm_sprimme(const char *transa, const char *transb, int m, int n,
+      int k, float alpha, float *a, int lda, float *b, int ldb, float beta,
+      float *c, int ldc);
+void Num_gemm_cprimme(const char *transa, const char *transb, int m, int n,
+      int k, PRIMME_COMPLEX_FLOAT alpha, PRIMME_COMPLEX_FLOAT *a, int lda,
+      PRIMME_COMPLEX_FLOAT *b, int ldb, PRIMME_COMPLEX_FLOAT beta,
+      PRIMME_COMPLEX_FLOAT *c, int ldc);
+void Num_gemm_dprimme(const char *transa, const char *transb, int m, int n,
+      int k, double alpha, double *a, int lda, double *b, int ldb, double beta,
+      double *c, int ldc);
+void Num_gemm_zprimme(const char *transa, const char *transb, int m, int n,
+      int k, PRIMME_COMPLEX_DOUBLE alpha, PRIMME_COMPLEX_DOUBLE *a, int lda,
+      PRIMME_COMPLEX_DOUBLE *b, int ldb, PRIMME_COMPLEX_DOUBLE beta,
+      PRIMME_COMPLEX_DOUBLE *c, int ldc);
+void Num_gemv_sprimme(const char *transa, PRIMME_INT m, int n, float alpha,
+      float *a, int lda, float *x, int incx, float beta, float *y, int incy);
+void Num_gemv_cprimme(const char *transa, PRIMME_INT m, int n,
+      PRIMME_COMPLEX_FLOAT alpha, PRIMME_COMPLEX_FLOAT *a, int lda,
+      PRIMME_COMPLEX_FLOAT *x, int incx, PRIMME_COMPLEX_FLOAT beta,
+      PRIMME_COMPLEX_FLOAT *y, int incy);
+void Num_gemv_dprimme(const char *transa, PRIMME_INT m, int n, double alpha,
+      double *a, int lda, double *x, int incx, double beta, double *y,
+      int incy);
+void Num_gemv_zprimme(const char *transa, PRIMME_INT m, int n,
+      PRIMME_COMPLEX_DOUBLE alpha, PRIMME_COMPLEX_DOUBLE *a, int lda,
+      PRIMME_COMPLEX_DOUBLE *x, int incx, PRIMME_COMPLEX_DOUBLE beta,
+      PRIMME_COMPLEX_DOUBLE *y, int incy);
+}
+
+#define DENSE_MATMAT(T, gemm, gemv) \
+static inline void dense_matmat(const char *transa, int m, int n, T *a, \
+      int lda, T *x, int ldx, T *y, int ldy, int blockSize) { \
+   if (blockSize == 1) { \
+      gemv(transa, m, n, 1.0, a, lda, x, 1, 0.0, y, 1); \
+   } else if (*transa == 'N') { \
+      gemm("N", "N", m, blockSize, n, 1.0, a, lda, x, ldx, 0.0, y, ldy); \
+   } else { \
+      gemm("C", "N", n, blockSize, m, 1.0, a, lda, x, ldx, 0.0, y, ldy); \
+   } \
+}
+
+/******************************************************************************
+ * Subroutine dense_matmat - Compute Y = A*X or Y = A'*X with BLAS, where A is
+ *    a m x n matrix in column-major order; with a single column it calls gemv,
+ *    which some BLAS libraries do faster than gemm.
+ ******************************************************************************/
+
+DENSE_MATMAT(float, Num_gemm_sprimme, Num_gemv_sprimme)
+DENSE_MATMAT(std::complex<float>, Num_gemm_cprimme, Num_gemv_cprimme)
+DENSE_MATMAT(double, Num_gemm_dprimme, Num_gemv_dprimme)
+DENSE_MATMAT(std::complex<double>, Num_gemm_zprimme, Num_gemv_zprimme)
+#undef DENSE_MATMAT
+
+/******************************************************************************
+ * Subroutine csr_matmat - Compute Y = A*X without calling Python, where A is
+ *    a m x n matrix in CSR format with int indices. The rows of Y are
+ *    distributed among the OpenMP threads.
+ ******************************************************************************/
+
+template <typename T>
+static void csr_matmat(PRIMME_INT m, const int *indptr, const int *indices,
+      const T *data, const T *x, PRIMME_INT ldx, T *y, PRIMME_INT ldy,
+      int blockSize) {
+
+   PRIMME_INT i;
+
+#ifdef _OPENMP
+   #pragma omp parallel for schedule(static)
+#endif
+   for (i=0; i<m; i++) {
+      const int k0 = indptr[i], k1 = indptr[i+1];
+      for (int j=0; j<blockSize; j++) {
+         const T *xj = &x[ldx*j];
+         T s(0);
+         for (int k=k0; k<k1; k++)
+            s += data[k]*xj[indices[k]];
+         y[ldy*j+i] = s;
+      }
+   }
+}
+
+#endif /* SWIG */
+
 class PrimmeParams : public primme_params {
    public:
 
@@ -47,6 +136,7 @@ class PrimmeParams : public primme_params {
       primme_initialize(static_cast<primme_params*>(this));
       correctionParams.precondition = 0;
       globalSum_set = 0;
+      matrixFormat = 0;
    }
 
    virtual ~PrimmeParams() {
@@ -78,6 +168,19 @@ class PrimmeParams : public primme_params {
       *n = this->numTargetShifts;
    }
 
+   /* Multiply by the n x n matrix A in C instead of calling matvec. With    */
+   /* format 1, indptr, indices and data are the addresses of the arrays of  */
+   /* A in CSR format; with format 2, data is the address of A in            */
+   /* column-major order; format 0 calls matvec again. The arrays should be  */
+   /* of the type of evecs and remain alive until the solver returns.        */
+
+   void _set_matrix(int format, size_t indptr, size_t indices, size_t data) {
+      matrixFormat = format;
+      matrixIndptr = reinterpret_cast<int*>(indptr);
+      matrixIndices = reinterpret_cast<int*>(indices);
+      matrixData = reinterpret_cast<void*>(data);
+   }
+
    virtual void matvec(int len1YD, int len2YD, int ldYD, float *yd, int len1XD, int len2XD, int ldXD, float *xd)=0;
    virtual void matvec(int len1YD, int len2YD, int ldYD, std::complex<float> *yd, int len1XD, int len2XD, int ldXD, std::complex<float> *xd)=0;
    virtual void matvec(int len1YD, int len2YD, int ldYD, double *yd, int len1XD, int len2XD, int ldXD, double *xd)=0;
@@ -89,6 +192,24 @@ class PrimmeParams : public primme_params {
    virtual void globalSum(int lenYD, float *yd, int lenXD, float *xd)=0;
    virtual void globalSum(int lenYD, double *yd, int lenXD, double *xd)=0;
    int globalSum_set;
+
+#ifndef SWIG
+   template <typename T>
+   void _matmat(T *x, PRIMME_INT ldx, T *y, PRIMME_INT ldy, int blockSize) {
+      if (matrixFormat == 1) {
+         csr_matmat(nLocal, matrixIndptr, matrixIndices, (T*)matrixData, x,
+               ldx, y, ldy, blockSize);
+      }
+      else {
+         dense_matmat("N", (int)nLocal, (int)nLocal, (T*)matrixData,
+               (int)nLocal, x, (int)ldx, y, (int)ldy, blockSize);
+      }
+   }
+
+   int matrixFormat;            /* 0: call matvec, 1: CSR, 2: dense */
+   int *matrixIndptr, *matrixIndices;
+   void *matrixData;
+#endif
 };
 
 class PrimmeSvdsParams : public primme_svds_params {
@@ -98,6 +219,7 @@ class PrimmeSvdsParams : public primme_svds_params {
       primme_svds_initialize(static_cast<primme_svds_params*>(this));
       precondition = 0;
       globalSum_set = 0;
+      matrixFormat = 0;
    }
 
    virtual ~PrimmeSvdsParams() {
@@ -130,6 +252,24 @@ class PrimmeSvdsParams : public primme_svds_params {
       *n = this->numTargetShifts;
    }
 
+   /* Multiply by the m x n matrix A in C instead of calling matvec. With    */
+   /* format 1, indptr, indices and data are the addresses of the arrays of  */
+   /* A in CSR format, and indptrH, indicesH and dataH the ones of A'; with  */
+   /* format 2, data is the address of A in column-major order; format 0     */
+   /* calls matvec again. The arrays should be of the type of svecs and      */
+   /* remain alive until the solver returns.                                 */
+
+   void _set_matrix(int format, size_t indptr, size_t indices, size_t data,
+         size_t indptrH, size_t indicesH, size_t dataH) {
+      matrixFormat = format;
+      matrixIndptr[0] = reinterpret_cast<int*>(indptr);
+      matrixIndices[0] = reinterpret_cast<int*>(indices);
+      matrixData[0] = reinterpret_cast<void*>(data);
+      matrixIndptr[1] = reinterpret_cast<int*>(indptrH);
+      matrixIndices[1] = reinterpret_cast<int*>(indicesH);
+      matrixData[1] = reinterpret_cast<void*>(dataH);
+   }
+
    virtual void matvec(int len1YD, int len2YD, int ldYD, float *yd, int len1XD, int len2XD, int ldXD, float *xd, int transpose)=0;
    virtual void matvec(int len1YD, int len2YD, int ldYD, std::complex<float> *yd, int len1XD, int len2XD, int ldXD, std::complex<float> *xd, int transpose)=0;
    virtual void matvec(int len1YD, int len2YD, int ldYD, double *yd, int len1XD, int len2XD, int ldXD, double *xd, int transpose)=0;
@@ -141,4 +281,26 @@ class PrimmeSvdsParams : public primme_svds_params {
    virtual void globalSum(int lenYD, float *yd, int lenXD, float *xd)=0;
    virtual void globalSum(int lenYD, double *yd, int lenXD, double *xd)=0;
    int globalSum_set;
+
+#ifndef SWIG
+   template <typename T>
+   void _matmat(T *x, PRIMME_INT ldx, T *y, PRIMME_INT ldy, int blockSize,
+         int transpose) {
+      if (matrixFormat == 1) {
+         int t = transpose ? 1 : 0;
+         csr_matmat(transpose ? nLocal : mLocal, matrixIndptr[t],
+               matrixIndices[t], (T*)matrixData[t], x, ldx, y, ldy,
+               blockSize);
+      }
+      else {
+         dense_matmat(transpose ? "C" : "N", (int)mLocal, (int)nLocal,
+               (T*)matrixData[0], (int)mLocal, x, (int)ldx, y, (int)ldy,
+               blockSize);
+      }
+   }
+
+   int matrixFormat;            /* 0: call matvec, 1: CSR, 2: dense */
+   int *matrixIndptr[2], *matrixIndices[2];   /* CSR arrays of A and A' */
+   void *matrixData[2];
+#endif
 };
@@ -2,6 +2,7 @@
 from __future__ import division, print_function
 
 # System imports
+import sys
 from distutils.core import *
 
 # Third-party modules - we depend on numpy for everything
@@ -23,13 +24,18 @@ blaslapack_extra_link_args = lapack_info.get('extra_link_args', []) + blas_info.
 if not blaslapack_libraries and not blaslapack_extra_link_args:
     blaslapack_libraries = ['lapack', 'blas']
 
+# Multiply by dense and sparse matrices with OpenMP threads (see primmew.h),
+# except with the default compiler on OS X, which does not support OpenMP
+openmp_args = [] if sys.platform == 'darwin' else ['-fopenmp']
+
 # Array extension module
 _Primme = Extension("_Primme",
                    ["primme_wrap.cxx", "primmew.cxx"],
                    include_dirs = [numpy_include],
                    library_dirs = ["../lib"] + blaslapack_library_dirs,
                    libraries = ["primme"] + blaslapack_libraries,
-                   extra_link_args = blaslapack_extra_link_args
+                   extra_link_args = blaslapack_extra_link_args + openmp_args,
+                   extra_compile_args = openmp_args
                    #extra_compile_args = ["-g", "-O0", "-Wall", "-Wextra"]
                    )
 
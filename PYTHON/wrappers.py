@@ -1,4 +1,5 @@
 import numpy as np
+import scipy.sparse
 from scipy.sparse.linalg.interface import aslinearoperator
 
 __docformat__ = "restructuredtext en"
@@ -42,7 +43,16 @@ _PRIMMEErrors = {
 -34: "'ldevecs' is less than 'nLocal'",
 -35: "'ldOPs' is non-zero and less than 'nLocal'",
 -36 : "not enough memory for realWork",
--37 : "not enough memory for intWork"
+-37 : "not enough memory for intWork",
+-38 : "only one of 'globalSumRealStart' and 'globalSumRealWait' is set",
+-39 : "'cacheBlockSize' < 0",
+-40 : "'massMatrixMatvec' is set and the configuration is not supported for the generalized problem",
+-41 : "'checkpointInterval' < 0, or 'checkpointInterval' or 'checkpointResume' is set and 'checkpointFile' is not",
+-42 : "'filterDegree' < 0",
+-43 : "the interval or the number of slices is not valid",
+-44 : "found more eigenvalues in the interval than 'numEvals'",
+-45 : "the number of problems is negative or some array is NULL",
+-46 : "the file in 'outOfCoreDir' could not be created or mapped"
 }
 
 _PRIMMESvdsErrors = {
@@ -67,7 +77,8 @@ _PRIMMESvdsErrors = {
 -18 : "svecs is not set",
 -19 : "resNorms is not set",
 -20 : "not enough memory for realWork",
--21 : "not enough memory for intWork"
+-21 : "not enough memory for intWork",
+-22 : "method is primme_svds_op_bidiag and target is not primme_svds_largest"
 }
 
 
@@ -94,6 +105,33 @@ class PrimmeSvdsError(RuntimeError):
         RuntimeError.__init__(self, "PRIMME SVDS error %d: %s" % (err, msg))
 
 
+def _native_matrix(A, dtype, adjoint=False):
+    """
+    Return the arguments of _set_matrix that make PRIMME multiply by A in C,
+    and the arrays they point to, which should be kept alive while PRIMME
+    runs; or None if A is not a dense array or a CSR/CSC sparse matrix.
+    If adjoint, the arguments also include the CSR arrays of A.H.
+    """
+
+    maxint = np.iinfo(np.intc).max
+
+    if isinstance(A, np.ndarray) and A.ndim == 2:
+        A = np.asfortranarray(A, dtype=dtype)
+        return (2, 0, 0, A.ctypes.data) + ((0, 0, 0) if adjoint else ()), [A]
+
+    if (not scipy.sparse.issparse(A) or A.format not in ('csr', 'csc') or
+            A.nnz > maxint or max(A.shape) > maxint):
+        return None
+
+    arrays = []
+    for B in ((A, A.T.conj()) if adjoint else (A,)):
+        B = B.tocsr()
+        arrays += [np.ascontiguousarray(B.indptr, dtype=np.intc),
+                   np.ascontiguousarray(B.indices, dtype=np.intc),
+                   np.ascontiguousarray(B.data, dtype=dtype)]
+    return (1,) + tuple(x.ctypes.data for x in arrays), arrays
+
+
 def eigsh(A, k=6, M=None, sigma=None, which='LM', v0=None,
           ncv=None, maxiter=None, tol=0, return_eigenvectors=True,
           Minv=None, OPinv=None, mode='normal', lock=None,
@@ -114,7 +152,8 @@ def eigsh(A, k=6, M=None, sigma=None, which='LM', v0=None,
     ----------
     A : An N x N matrix, array, sparse matrix, or LinearOperator
         the operation A * x, where A is a real symmetric matrix or complex
-        Hermitian.
+        Hermitian. If A is a dense array or a CSR/CSC sparse matrix, A * x
+        is computed in C without calling Python.
     k : int, optional
         The number of eigenvalues and eigenvectors desired.
     M : An N x N matrix, array, sparse matrix, or LinearOperator
@@ -239,6 +278,7 @@ def eigsh(A, k=6, M=None, sigma=None, which='LM', v0=None,
     array([ 96.,  95.,  94.])
     """
 
+    Aorig = A
     A = aslinearoperator(A)
     if len(A.shape) != 2 or A.shape[0] != A.shape[1]:
         raise ValueError('A: expected square matrix (shape=%s)' % (A.shape,))
@@ -348,6 +388,11 @@ def eigsh(A, k=6, M=None, sigma=None, which='LM', v0=None,
 
     if method is not None:
         pp.set_method(method)
+
+    # Multiply by A in C if possible; the arrays are alive until Xprimme ends
+    native = _native_matrix(Aorig, dtype)
+    if native is not None:
+        pp._set_matrix(*native[0])
  
     err = Xprimme(evals, evecs, norms, pp)
 
@@ -380,7 +425,9 @@ def svds(A, k=6, ncv=None, tol=0, which='LM', v0=None,
     Parameters
     ----------
     A : {sparse matrix, LinearOperator}
-        Array to compute the SVD on, of shape (M, N)
+        Array to compute the SVD on, of shape (M, N). If A is a dense array
+        or a CSR/CSC sparse matrix, A * x and A.H * x are computed in C
+        without calling Python.
     k : int, optional
         Number of singular values and vectors to compute.
         Must be 1 <= k < min(A.shape).
@@ -470,6 +517,7 @@ def svds(A, k=6, ncv=None, tol=0, which='LM', v0=None,
     ['5.99871', '5.99057', '6.01065']
     """
 
+    Aorig = A
     A = aslinearoperator(A)
 
     m, n = A.shape
@@ -609,6 +657,12 @@ def svds(A, k=6, ncv=None, tol=0, which='LM', v0=None,
         np.copyto(svecsl[:, pp.numOrthoConst:pp.numOrthoConst+pp.initSize], u0[:, 0:pp.initSize])
         np.copyto(svecsr[:, pp.numOrthoConst:pp.numOrthoConst+pp.initSize], v0[:, 0:pp.initSize])
 
+    # Multiply by A and A.H in C if possible; the arrays are alive until
+    # Xprimme_svds ends
+    native = _native_matrix(Aorig, dtype, adjoint=True)
+    if native is not None:
+        pp._set_matrix(*native[0])
+
     err = Xprimme_svds(svals, svecsl, svecsr, norms, pp)
 
     if err != 0:
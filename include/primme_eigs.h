@@ -68,6 +68,14 @@ typedef enum {         /* Initially fill up the search subspace with: */
    primme_init_user    /* c) provided vectors or a single random vector */
 } primme_init;
 
+typedef enum {         /* Orthogonalize each new block of vectors with: */
+   primme_orth_default,
+   primme_orth_column, /* a) CGS, one vector at a time, with reorthogonalization */
+   primme_orth_block,  /* b) BCGS2 and CholQR2 on the whole block */
+   primme_orth_pipelined /* c) one pass of BCGS and CholQR fused with the */
+                         /*    projection, with a single global sum       */
+} primme_orth;
+
 
 typedef enum {
    primme_thick,
@@ -83,6 +91,24 @@ typedef enum {
 } primme_convergencetest;
 
 
+/* Points of the solver where the monitor function is called; the events */
+/* from init to locking mark the end of a phase                           */
+typedef enum {
+   primme_event_start,              /* The solver starts                  */
+   primme_event_init,               /* Initialization of the basis        */
+   primme_event_prepare_candidates, /* Selection of the next block        */
+   primme_event_iteration,          /* Outer iteration, with the residual */
+                                    /* norms of the block                 */
+   primme_event_correction,         /* Correction equations               */
+   primme_event_ortho,              /* Orthogonalization of the block     */
+   primme_event_matvec,             /* Matrix-vector products of the block*/
+   primme_event_update_projection,  /* Update of H, and Q and R if needed */
+   primme_event_solve_H,            /* Solution of the projected problem  */
+   primme_event_restart,            /* Restart, including the locking     */
+   primme_event_locking,            /* Locking of converged pairs         */
+   primme_event_finish              /* The solver finishes                */
+} primme_event;
+
 typedef struct primme_stats {
    PRIMME_INT numOuterIterations;
    PRIMME_INT numRestarts;
@@ -101,8 +127,26 @@ typedef struct primme_stats {
    double estimateLargestSVal;      /* absolute value of the farthest to zero Ritz value seen */
    double maxConvTol;               /* largest norm residual of a locked eigenpair */
    double estimateResidualError;    /* accumulated error in V and W */
+   double avgBlockSize;             /* average block size of the outer iterations */
 } primme_stats;
 
+/* State of a single call to the solver; it is set by the solver and should */
+/* not be modified by the user                                              */
+typedef struct primme_context {
+   double timerStart;               /* wall-clock time when the solve started */
+   int cacheBlockSize;              /* rows in the cache-blocked kernels */
+} primme_context;
+
+/* Basis kept by the solver between calls when warmStart is set; it is set */
+/* by the solver and released by primme_free                              */
+typedef struct primme_warm_start {
+   void *V;                         /* basisSize vectors of nLocal rows */
+   PRIMME_INT nLocal;               /* rows of the vectors in V */
+   int basisSize;                   /* number of vectors in V */
+   int type;                        /* sizeof the scalar, negative if complex */
+   size_t size;                     /* bytes allocated for V */
+} primme_warm_start;
+
 typedef struct JD_projectors {
    int LeftQ;
    int LeftX;
@@ -123,6 +167,8 @@ typedef struct correction_params {
    struct JD_projectors projectors;
    primme_convergencetest convTest;
    double relTolBase;
+   int fuseGlobalSums;
+   int filterDegree;
 } correction_params;
 
 
@@ -159,6 +205,11 @@ typedef struct primme_params {
    void (*globalSumReal)
       (void *sendBuf, void *recvBuf, int *count, struct primme_params *primme,
        int *ierr );
+   void (*globalSumRealStart)
+      (void *sendBuf, void *recvBuf, int *count, struct primme_params *primme,
+       void **request, int *ierr );
+   void (*globalSumRealWait)
+      (void *request, struct primme_params *primme, int *ierr );
 
    /*Though primme_initialize will assign defaults, most users will set these */
    int numEvals;          
@@ -168,6 +219,7 @@ typedef struct primme_params {
 
    /* the following will be given default values depending on the method */
    int dynamicMethodSwitch;
+   int dynamicBlockSize;
    int locking;
    int initSize;
    int numOrthoConst;
@@ -191,16 +243,32 @@ typedef struct primme_params {
    void *preconditioner;
    double *ShiftsForPreconditioner;
    primme_init initBasisMode;
+   primme_orth orth;
    PRIMME_INT ldevecs;
    PRIMME_INT ldOPs;
+   int cacheBlockSize;
+   int mixedPrecision;
+   const char *checkpointFile;
+   int checkpointInterval;
+   int checkpointResume;
+   const char *outOfCoreDir;
+   int warmStart;
+   struct primme_warm_start *warmStartState;
 
    struct projection_params projectionParams; 
    struct restarting_params restartingParams;
    struct correction_params correctionParams;
    struct primme_stats stats;
+   struct primme_context ctx;
 
    void (*convTestFun)(double *eval, void *evec, double *rNorm, int *isconv, 
          struct primme_params *primme, int *ierr);
+
+   /* Optional function called at the events of the solver */
+   void *monitor;
+   void (*monitorFun)(primme_event *event, double *time, double *duration,
+         int *basisSize, int *blockSize, double *blockNorms, int *numConverged,
+         struct primme_params *primme, int *ierr);
 } primme_params;
 /*---------------------------------------------------------------------------*/
 
@@ -232,10 +300,31 @@ int dprimme(double *evals, double *evecs, double *resNorms,
       primme_params *primme);
 int zprimme(double *evals, PRIMME_COMPLEX_DOUBLE *evecs, double *resNorms, 
       primme_params *primme);
+int sprimme_slicing(float *evals, float *evecs, float *resNorms,
+      double lower, double upper, int numSlices, primme_params *primme);
+int cprimme_slicing(float *evals, PRIMME_COMPLEX_FLOAT *evecs,
+      float *resNorms, double lower, double upper, int numSlices,
+      primme_params *primme);
+int dprimme_slicing(double *evals, double *evecs, double *resNorms,
+      double lower, double upper, int numSlices, primme_params *primme);
+int zprimme_slicing(double *evals, PRIMME_COMPLEX_DOUBLE *evecs,
+      double *resNorms, double lower, double upper, int numSlices,
+      primme_params *primme);
+int sprimme_batch(float **evals, float **evecs, float **resNorms,
+      int numProblems, primme_params *primme, int *ierrs);
+int cprimme_batch(float **evals, PRIMME_COMPLEX_FLOAT **evecs,
+      float **resNorms, int numProblems, primme_params *primme, int *ierrs);
+int dprimme_batch(double **evals, double **evecs, double **resNorms,
+      int numProblems, primme_params *primme, int *ierrs);
+int zprimme_batch(double **evals, PRIMME_COMPLEX_DOUBLE **evecs,
+      double **resNorms, int numProblems, primme_params *primme, int *ierrs);
 void primme_initialize(primme_params *primme);
 int  primme_set_method(primme_preset_method method, primme_params *params);
 void primme_display_params(primme_params primme);
 void primme_free(primme_params *primme);
+void primme_monitor_trace(primme_event *event, double *time, double *duration,
+      int *basisSize, int *blockSize, double *blockNorms, int *numConverged,
+      primme_params *primme, int *ierr);
 
 #ifdef __cplusplus
 }
@@ -87,6 +87,8 @@ C-------------------------------------------------------
      : PRIMME_commInfo,
      : PRIMME_nLocal,
      : PRIMME_globalSumReal,
+     : PRIMME_globalSumRealStart,
+     : PRIMME_globalSumRealWait,
      : PRIMME_numEvals,
      : PRIMME_target,
      : PRIMME_numTargetShifts,
@@ -111,6 +113,7 @@ C-------------------------------------------------------
      : PRIMME_matrix,
      : PRIMME_preconditioner,
      : PRIMME_initBasisMode,
+     : PRIMME_orth,
      : PRIMME_projectionParams_projection,
      : PRIMME_restartingParams_scheme,
      : PRIMME_restartingParams_maxPrevRetain,
@@ -125,6 +128,8 @@ C-------------------------------------------------------
      : PRIMME_correctionParams_projectors_SkewX,
      : PRIMME_correctionParams_convTest,
      : PRIMME_correctionParams_relTolBase,
+     : PRIMME_correctionParams_fuseGlobalSums,
+     : PRIMME_correctionParams_filterDegree,
      : PRIMME_stats_numOuterIterations,
      : PRIMME_stats_numRestarts,
      : PRIMME_stats_numMatvecs,
@@ -134,9 +139,20 @@ C-------------------------------------------------------
      : PRIMME_stats_estimateMaxEVal,
      : PRIMME_stats_estimateLargestSVal,
      : PRIMME_stats_maxConvTol,
+     : PRIMME_stats_avgBlockSize,
      : PRIMME_dynamicMethodSwitch,
+     : PRIMME_dynamicBlockSize,
      : PRIMME_massMatrixMatvec,
-     : PRIMME_convTestFun
+     : PRIMME_convTestFun,
+     : PRIMME_cacheBlockSize,
+     : PRIMME_mixedPrecision,
+     : PRIMME_checkpointFile,
+     : PRIMME_checkpointInterval,
+     : PRIMME_checkpointResume,
+     : PRIMME_monitor,
+     : PRIMME_monitorFun,
+     : PRIMME_outOfCoreDir,
+     : PRIMME_warmStart
 
       parameter(
      : PRIMME_n = 0,
@@ -147,6 +163,8 @@ C-------------------------------------------------------
      : PRIMME_commInfo = 5,
      : PRIMME_nLocal = 6,
      : PRIMME_globalSumReal = 7,
+     : PRIMME_globalSumRealStart = 71,
+     : PRIMME_globalSumRealWait = 72,
      : PRIMME_numEvals = 8,
      : PRIMME_target = 9,
      : PRIMME_numTargetShifts = 10,
@@ -171,6 +189,7 @@ C-------------------------------------------------------
      : PRIMME_matrix = 29,
      : PRIMME_preconditioner = 30,
      : PRIMME_initBasisMode = 301,
+     : PRIMME_orth = 303,
      : PRIMME_projectionParams_projection = 302,
      : PRIMME_restartingParams_scheme = 31,
      : PRIMME_restartingParams_maxPrevRetain = 32,
@@ -185,6 +204,8 @@ C-------------------------------------------------------
      : PRIMME_correctionParams_projectors_SkewX = 41,
      : PRIMME_correctionParams_convTest = 42,
      : PRIMME_correctionParams_relTolBase = 43,
+     : PRIMME_correctionParams_fuseGlobalSums = 431,
+     : PRIMME_correctionParams_filterDegree = 432,
      : PRIMME_stats_numOuterIterations = 44,
      : PRIMME_stats_numRestarts = 45,
      : PRIMME_stats_numMatvecs = 46,
@@ -194,9 +215,20 @@ C-------------------------------------------------------
      : PRIMME_stats_estimateMaxEVal = 482,
      : PRIMME_stats_estimateLargestSVal = 483,
      : PRIMME_stats_maxConvTol = 484,
+     : PRIMME_stats_avgBlockSize = 485,
      : PRIMME_dynamicMethodSwitch = 49,
+     : PRIMME_dynamicBlockSize = 62,
      : PRIMME_massMatrixMatvec = 50,
-     : PRIMME_convTestFun = 51
+     : PRIMME_convTestFun = 51,
+     : PRIMME_cacheBlockSize = 54,
+     : PRIMME_mixedPrecision = 55,
+     : PRIMME_checkpointFile = 56,
+     : PRIMME_checkpointInterval = 57,
+     : PRIMME_checkpointResume = 58,
+     : PRIMME_monitor = 59,
+     : PRIMME_monitorFun = 60,
+     : PRIMME_outOfCoreDir = 61,
+     : PRIMME_warmStart = 63
      : )
 
 C-------------------------------------------------------
@@ -219,6 +251,10 @@ C-------------------------------------------------------
      : primme_init_krylov,
      : primme_init_random,
      : primme_init_user,
+     : primme_orth_default,
+     : primme_orth_column,
+     : primme_orth_block,
+     : primme_orth_pipelined,
      : primme_thick,
      : primme_dtr,
      : primme_full_LTolerance,
@@ -241,6 +277,10 @@ C-------------------------------------------------------
      : primme_init_krylov = 1,
      : primme_init_random = 2,
      : primme_init_user = 3,
+     : primme_orth_default = 0,
+     : primme_orth_column = 1,
+     : primme_orth_block = 2,
+     : primme_orth_pipelined = 3,
      : primme_thick = 0,
      : primme_dtr = 1,
      : primme_full_LTolerance = 0,
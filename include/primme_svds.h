@@ -53,14 +53,16 @@ typedef enum {
    primme_svds_default,
    primme_svds_hybrid,
    primme_svds_normalequations, /* At*A or A*At */
-   primme_svds_augmented
+   primme_svds_augmented,
+   primme_svds_bidiag           /* Golub-Kahan-Lanczos bidiagonalization */
 } primme_svds_preset_method;
 
 typedef enum {
    primme_svds_op_none,
    primme_svds_op_AtA,
    primme_svds_op_AAt,
-   primme_svds_op_augmented
+   primme_svds_op_augmented,
+   primme_svds_op_bidiag
 } primme_svds_operator;
 
 typedef struct primme_svds_stats {
@@ -88,6 +90,10 @@ typedef struct primme_svds_params {
    void (*applyPreconditioner)
       (void *x, PRIMME_INT *ldx, void *y, PRIMME_INT *ldy, int *blockSize,
        int *transpose, struct primme_svds_params *primme_svds, int *ierr);
+   /* Optional; y = A'*A*x if transpose is zero and y = A*A'*x otherwise */
+   void (*matrixNormalMatvec)
+      (void *x, PRIMME_INT *ldx, void *y, PRIMME_INT *ldy, int *blockSize,
+       int *transpose, struct primme_svds_params *primme_svds, int *ierr);
 
    /* Input for the following is only required for parallel programs */
    int numProcs;
@@ -104,7 +110,7 @@ typedef struct primme_svds_params {
    primme_svds_target target;
    int numTargetShifts;    /* For primme_svds_augmented method, user has to */ 
    double *targetShifts;   /* make sure  at least one shift must also be set */
-   primme_svds_operator method; /* one of primme_svds_AtA, primme_svds_AAt or primme_svds_augmented */
+   primme_svds_operator method; /* one of primme_svds_AtA, primme_svds_AAt, primme_svds_augmented or primme_svds_bidiag */
    primme_svds_operator methodStage2; /* hybrid second stage method; accepts the same values as method */
 
    /* These pointers are not for users but for d/zprimme_svds function */
@@ -41,13 +41,15 @@ C-------------------------------------------------------
      : primme_svds_default,
      : primme_svds_hybrid,
      : primme_svds_normalequations,
-     : primme_svds_augmented
+     : primme_svds_augmented,
+     : primme_svds_bidiag
 
       parameter(
      : primme_svds_default = 0,
      : primme_svds_hybrid = 1,
      : primme_svds_normalequations = 2,
-     : primme_svds_augmented = 3
+     : primme_svds_augmented = 3,
+     : primme_svds_bidiag = 4
      :)
 
 C-------------------------------------------------------
@@ -96,7 +98,8 @@ C-------------------------------------------------------
      : PRIMME_SVDS_stats_numRestarts,
      : PRIMME_SVDS_stats_numMatvecs,
      : PRIMME_SVDS_stats_numPreconds,
-     : PRIMME_SVDS_stats_elapsedTime
+     : PRIMME_SVDS_stats_elapsedTime,
+     : PRIMME_SVDS_matrixNormalMatvec
 
       parameter(
      : PRIMME_SVDS_primme = 0,
@@ -139,7 +142,8 @@ C-------------------------------------------------------
      : PRIMME_SVDS_stats_numRestarts = 37,
      : PRIMME_SVDS_stats_numMatvecs = 38,
      : PRIMME_SVDS_stats_numPreconds = 39,
-     : PRIMME_SVDS_stats_elapsedTime = 40
+     : PRIMME_SVDS_stats_elapsedTime = 40,
+     : PRIMME_SVDS_matrixNormalMatvec = 41
      :)
 
 C-------------------------------------------------------
@@ -154,7 +158,8 @@ C-------------------------------------------------------
      : primme_svds_op_none,
      : primme_svds_op_AtA,
      : primme_svds_op_AAt,
-     : primme_svds_op_augmented
+     : primme_svds_op_augmented,
+     : primme_svds_op_bidiag
 
       parameter(
      : primme_svds_largest = 0,
@@ -163,5 +168,6 @@ C-------------------------------------------------------
      : primme_svds_op_none = 0,
      : primme_svds_op_AtA = 1,
      : primme_svds_op_AAt = 2,
-     : primme_svds_op_augmented = 3
+     : primme_svds_op_augmented = 3,
+     : primme_svds_op_bidiag = 4
      :)
@@ -41,6 +41,14 @@
 #include "auxiliary_eigs.h"
 #include "wtime.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+#include <unistd.h>   /* sysconf */
+#include <sys/mman.h> /* madvise */
+#endif
+
 /******************************************************************************
  * Function Num_compute_residual - This subroutine performs the next operation
  *    in a cache-friendly way:
@@ -70,6 +78,66 @@ void Num_compute_residual_Sprimme(PRIMME_INT n, SCALAR eval, SCALAR *x,
 
 }
 
+/******************************************************************************
+ * Function Num_update_VWXR_num_threads - Return the number of threads used to
+ *    process the chunks of primme.cacheBlockSize rows of V and W in
+ *    Num_update_VWXR and Num_reset_update_VWXR. Without OpenMP this is one.
+ *
+ * mV          number of rows of V and W
+ * primme      Structure containing various solver parameters
+ *
+ ******************************************************************************/
+
+TEMPLATE_PLEASE
+int Num_update_VWXR_num_threads_Sprimme(PRIMME_INT mV, primme_params *primme) {
+
+#ifdef _OPENMP
+   int M = CACHE_BLOCK_SIZE(primme);
+   PRIMME_INT numChunks = (mV + M - 1)/M;
+
+   if (omp_in_parallel()) return 1;
+   return (int)max(1, min((PRIMME_INT)omp_get_max_threads(), numChunks));
+#else
+   (void)mV;
+   (void)primme;
+   return 1;
+#endif
+}
+
+/******************************************************************************
+ * Function Num_prefetch_rows - Tell the operating system that the rows of x
+ *    are going to be read soon. It only has effect if primme.outOfCoreDir
+ *    is set, when V, W, BV and Q are mapped from a file; then the kernels
+ *    that walk them by chunks of rows call it for the next chunk, so that
+ *    it is read from the file while the current one is processed.
+ *
+ * x           The matrix
+ * m, n, ld    Number of rows and columns and leading dimension of x
+ * primme      Structure containing various solver parameters
+ *
+ ******************************************************************************/
+
+TEMPLATE_PLEASE
+void Num_prefetch_rows_Sprimme(SCALAR *x, PRIMME_INT m, int n, PRIMME_INT ld,
+      primme_params *primme) {
+
+#if (defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))) \
+      && defined(MADV_WILLNEED)
+   size_t page, b, e;
+   int j;
+
+   if (!x || !primme || !primme->outOfCoreDir || m <= 0) return;
+   page = (size_t)sysconf(_SC_PAGESIZE);
+   for (j=0; j<n; j++) {
+      b = (size_t)&x[ld*j] & ~(page-1);
+      e = (size_t)&x[ld*j+m];
+      madvise((void*)b, e-b, MADV_WILLNEED);
+   }
+#else
+   (void)x; (void)m; (void)n; (void)ld; (void)primme;
+#endif
+}
+
 /******************************************************************************
  * Function Num_update_VWXR - This subroutine performs the next operations:
  *
@@ -81,10 +149,23 @@ void Num_compute_residual_Sprimme(PRIMME_INT n, SCALAR eval, SCALAR *x,
  *
  * NOTE: if Rnorms and rnorms are requested, nRb-nRe+nrb-nre < mV
  *
+ * If BV = B*V is given, for the generalized problem A*x = lambda*B*x, then
+ * also BX0 = BV*h(nX0b+1:nX0e) and BX1 = BV*h(nX1b+1:nX1e), and the
+ * residual vectors are W*h - BV*h*diag(hVals).
+ *
+ * If primme.globalSumRealStart is set, the columns involved in R and rnorms
+ * are computed first, and the reduction of the norms is overlapped with the
+ * computation of the rest of the columns.
+ *
+ * If PRIMME is compiled with OpenMP, the chunks of rows are distributed
+ * among threads. Every thread has its own piece of rwork for X and Y and
+ * its own partial sums of the norms, which are added up in thread order.
+ *
  * INPUT ARRAYS AND PARAMETERS
  * ---------------------------
  * V, W        input basis
- * mV,nV,ldV   number of rows and columns and leading dimension of V and W
+ * BV          B*V (optional)
+ * mV,nV,ldV   number of rows and columns and leading dimension of V, W and BV
  * h           input rotation matrix
  * nh          Number of columns of h
  * ldh         The leading dimension of h
@@ -105,6 +186,8 @@ void Num_compute_residual_Sprimme(PRIMME_INT n, SCALAR eval, SCALAR *x,
  * Rnorms      Output array with the norms of R (optional)
  * rnorms      Output array with the extra residual vector norms (optional)
  * nrb, nre    Columns of residual vector to compute the norm
+ * BX0         Output matrix BV*h(nX0b:nX0e-1) (optional, needs BV)
+ * BX1         Output matrix BV*h(nX1b:nX1e-1) (optional, needs BV)
  * 
  * NOTE: n*e, n*b are zero-base indices of ranges where the first value is
  *       included and the last isn't.
@@ -112,26 +195,34 @@ void Num_compute_residual_Sprimme(PRIMME_INT n, SCALAR eval, SCALAR *x,
  ******************************************************************************/
 
 TEMPLATE_PLEASE
-int Num_update_VWXR_Sprimme(SCALAR *V, SCALAR *W, PRIMME_INT mV, int nV,
-      PRIMME_INT ldV, SCALAR *h, int nh, int ldh, REAL *hVals,
+int Num_update_VWXR_Sprimme(SCALAR *V, SCALAR *W, SCALAR *BV, PRIMME_INT mV,
+      int nV, PRIMME_INT ldV, SCALAR *h, int nh, int ldh, REAL *hVals,
       SCALAR *X0, int nX0b, int nX0e, PRIMME_INT ldX0,
       SCALAR *X1, int nX1b, int nX1e, PRIMME_INT ldX1,
       SCALAR *X2, int nX2b, int nX2e, PRIMME_INT ldX2,
       SCALAR *Wo, int nWob, int nWoe, PRIMME_INT ldWo,
       SCALAR *R, int nRb, int nRe, PRIMME_INT ldR, REAL *Rnorms,
       REAL *rnorms, int nrb, int nre,
+      SCALAR *BX0, PRIMME_INT ldBX0, SCALAR *BX1, PRIMME_INT ldBX1,
       SCALAR *rwork, int lrwork, primme_params *primme) {
 
    PRIMME_INT i;     /* Loop variables */
-   int j;            /* Loop variables */
-   int m=min(PRIMME_BLOCK_SIZE, mV);   /* Number of rows in the cache */
-   int nXb, nXe, nYb, nYe, ldX, ldY;
-   SCALAR *X, *Y;
-   REAL *tmp, *tmp0;
+   int j, k, t;      /* Loop variables */
+   int m=min(CACHE_BLOCK_SIZE(primme), mV);   /* Number of rows in the cache */
+   int nXb, nXe, nYb, nYe;
+   int cb[3], ce[3], nw;   /* Ranges of columns computed in each pass */
+   int x0b, x0e, x1b, x1e, x2b, x2e, wob, woe, rb, re, r2b, r2e;
+   int numNorms, nR; /* Number of norms to reduce, and of them from R */
+   int nt;           /* Number of threads */
+   size_t sX, sXY;   /* Size of X and X+Y(+Z) for every thread */
+   REAL *tmp, *tmp0=NULL, *part=NULL;
+   void *request=NULL; /* Handle of the reduction of the norms */
 
    /* Return memory requirements */
    if (V == NULL) {
-      return 2*m*nV;
+      nt = Num_update_VWXR_num_threads_Sprimme(mV, primme);
+      return (primme->massMatrixMatvec ? 3 : 2)*m*nV*nt
+         + (nt > 1 ? 2*nV*nt : 0) + 4*nV;
    }
 
    /* R or Rnorms or rnorms imply W */
@@ -147,69 +238,181 @@ int Num_update_VWXR_Sprimme(SCALAR *V, SCALAR *W, PRIMME_INT mV, int nV,
    assert(nYe <= nh || nYb >= nYe); /* Check dimension */
    assert((nXe-nXb+nYe-nYb)*m <= lrwork); /* Check workspace for X and Y */
    assert(2*(nRe-nRb+nre-nrb) <= lrwork); /* Check workspace for tmp and tmp0 */
+   assert(!(BX0 || BX1) || BV);
+   assert((!BX0 || X0) && (!BX1 || X1));
+
+   /* If BV, Z = BV*h has the same columns as X and goes after Y */
 
-   X = rwork;
-   Y = rwork + m*(nXe-nXb);
-   ldX = ldY = m;
+   sX = (size_t)m*max(nXe-nXb, 0);
+   sXY = sX + (size_t)m*max(nYe-nYb, 0) + (BV ? sX : 0);
+   tmp = (REAL*)rwork;
 
    if (Rnorms) for (i=nRb; i<nRe; i++) Rnorms[i-nRb] = 0.0;
    if (rnorms) for (i=nrb; i<nre; i++) rnorms[i-nrb] = 0.0;
+   nR = R && Rnorms ? nRe-nRb : 0;
+   numNorms = nR + (rnorms ? nre-nrb : 0);
+
+   /* Use as many threads as fit in rwork. Besides X and Y, every thread */
+   /* has numNorms partial sums, and tmp and tmp0 go after all of them.  */
 
-   for (i=0; i < mV; i+=m, m=min(m,mV-i)) {
-      /* X = V*h(nXb:nXe-1) */
-      Num_gemm_Sprimme("N", "N", m, nXe-nXb, nV, 1.0,
-         &V[i], ldV, &h[nXb*ldh], ldh, 0.0, X, ldX);
-
-      /* X0 = X(nX0b-nXb:nX0e-nXb-1) */
-      if (X0) Num_copy_matrix_Sprimme(&X[ldX*(nX0b-nXb)], m, nX0e-nX0b,
-            ldX, &X0[i], ldX0);
-
-      /* X1 = X(nX1b-nXb:nX1e-nXb-1) */
-      if (X1) Num_copy_matrix_Sprimme(&X[ldX*(nX1b-nXb)], m, nX1e-nX1b,
-            ldX, &X1[i], ldX1);
-
-      /* X2 = X(nX2b-nXb:nX2e-nXb-1) */
-      if (X2) Num_copy_matrix_Sprimme(&X[ldX*(nX2b-nXb)], m, nX2e-nX2b,
-            ldX, &X2[i], ldX2);
-
-      /* Y = W*h(nYb:nYe-1) */
-      if (nYb < nYe) Num_gemm_Sprimme("N", "N", m, nYe-nYb, nV,
-            1.0, &W[i], ldV, &h[nYb*ldh], ldh, 0.0, Y, ldY);
-
-      /* Wo = Y(nWob-nYb:nWoe-nYb-1) */
-      if (Wo) Num_copy_matrix_Sprimme(&Y[ldY*(nWob-nYb)], m, nWoe-nWob,
-            ldY, &Wo[i], ldWo);
-
-      /* R = Y(nRb-nYb:nRe-nYb-1) - X(nRb-nYb:nRe-nYb-1)*diag(nRb:nRe-1) */
-      if (R) for (j=nRb; j<nRe; j++) {
-         Num_compute_residual_Sprimme(m, hVals[j], &X[ldX*(j-nXb)], &Y[ldY*(j-nYb)],
-               &R[i+ldR*(j-nRb)]);
-         if (Rnorms) {
-            Rnorms[j-nRb] +=
-               REAL_PART(Num_dot_Sprimme(m, &R[i+ldR*(j-nRb)], 1,
-                        &R[i+ldR*(j-nRb)], 1));
+   nt = Num_update_VWXR_num_threads_Sprimme(mV, primme);
+   while (nt > 1 && (sXY + numNorms)*nt + 2*numNorms > (size_t)lrwork) nt--;
+   if (nt > 1) {
+      part = (REAL*)(rwork + sXY*nt);
+      tmp = (REAL*)(rwork + (sXY + numNorms)*nt);
+   }
+
+   /* If the reduction of the norms can be overlapped, compute first the   */
+   /* columns involved in the residual vectors, start the reduction, and   */
+   /* then compute the rest of the columns. Otherwise do a single pass.    */
+
+   cb[0] = 0; ce[0] = INT_MAX; nw = 1;
+   if (primme->globalSumRealStart && primme->numProcs > 1 && numNorms > 0
+         && (nt > 1 || sXY + 2*numNorms <= (size_t)lrwork)) {
+      cb[0] = min(R&&Rnorms?nRb:INT_MAX, rnorms?nrb:INT_MAX);
+      ce[0] = max(R&&Rnorms?nRe:0, rnorms?nre:0);
+      cb[1] = 0; ce[1] = cb[0];
+      cb[2] = ce[0]; ce[2] = INT_MAX;
+      nw = 3;
+      if (nt <= 1) tmp = (REAL*)(rwork + sXY);
+   }
+
+   for (k=0; k<nw; k++) {
+
+      /* Restrict the ranges of columns to the current pass */
+
+      x0b = max(nX0b, cb[k]); x0e = min(nX0e, ce[k]);
+      x1b = max(nX1b, cb[k]); x1e = min(nX1e, ce[k]);
+      x2b = max(nX2b, cb[k]); x2e = min(nX2e, ce[k]);
+      wob = max(nWob, cb[k]); woe = min(nWoe, ce[k]);
+      rb = max(nRb, cb[k]); re = min(nRe, ce[k]);
+      r2b = max(nrb, cb[k]); r2e = min(nre, ce[k]);
+      nXb = min(min(min(min(X0&&x0b<x0e?x0b:INT_MAX, X1&&x1b<x1e?x1b:INT_MAX),
+                  X2&&x2b<x2e?x2b:INT_MAX), R&&rb<re?rb:INT_MAX),
+            rnorms&&r2b<r2e?r2b:INT_MAX);
+      nXe = max(max(max(max(X0&&x0b<x0e?x0e:0, X1&&x1b<x1e?x1e:0),
+                  X2&&x2b<x2e?x2e:0), R&&rb<re?re:0), rnorms&&r2b<r2e?r2e:0);
+      nYb = min(min(Wo&&wob<woe?wob:INT_MAX, R&&rb<re?rb:INT_MAX),
+            rnorms&&r2b<r2e?r2b:INT_MAX);
+      nYe = max(max(Wo&&wob<woe?woe:0, R&&rb<re?re:0), rnorms&&r2b<r2e?r2e:0);
+
+      if (nt > 1) for (j=0; j<numNorms*nt; j++) part[j] = 0.0;
+
+#ifdef _OPENMP
+      #pragma omp parallel num_threads(nt) if(nt > 1) private(i, j)
+#endif
+      {
+         int mi, it=0, nit=1;
+         PRIMME_INT numChunks, ib, ie;
+         SCALAR *X, *Y, *Z, *BX;
+         REAL *Rn, *rn;
+
+#ifdef _OPENMP
+         it = omp_get_thread_num();
+         nit = omp_get_num_threads();
+#endif
+
+         /* Every thread takes a contiguous range of chunks of rows */
+
+         numChunks = m > 0 ? (mV + m - 1)/m : 0;
+         ib = numChunks*it/nit*m;
+         ie = min(numChunks*(it+1)/nit*m, mV);
+         X = rwork + sXY*it;
+         Y = X + sX;
+         Z = Y + (size_t)m*max(nYe-nYb, 0);
+         BX = BV ? Z : X; /* B*X for the residual vectors */
+         Rn = nt > 1 ? &part[numNorms*it] : Rnorms;
+         rn = nt > 1 ? &part[numNorms*it + nR] : rnorms;
+
+         for (i=ib, mi=min(m, ie-ib); i < ie; i+=mi, mi=min(mi,ie-i)) {
+            /* Ask for the next chunk of V, W and BV if they are in a file */
+            if (i+mi < ie) {
+               PRIMME_INT mn = min((PRIMME_INT)m, ie-i-mi);
+               if (nXb < nXe) Num_prefetch_rows_Sprimme(&V[i+mi], mn, nV, ldV,
+                     primme);
+               if (BV && nXb < nXe) Num_prefetch_rows_Sprimme(&BV[i+mi], mn,
+                     nV, ldV, primme);
+               if (nYb < nYe) Num_prefetch_rows_Sprimme(&W[i+mi], mn, nV, ldV,
+                     primme);
+            }
+
+            /* X = V*h(nXb:nXe-1) */
+            if (nXb < nXe) Num_gemm_Sprimme("N", "N", mi, nXe-nXb, nV, 1.0,
+                  &V[i], ldV, &h[nXb*ldh], ldh, 0.0, X, m);
+
+            /* X0 = X(nX0b-nXb:nX0e-nXb-1) */
+            if (X0 && x0b < x0e) Num_copy_matrix_Sprimme(&X[m*(x0b-nXb)], mi,
+                  x0e-x0b, m, &X0[i+ldX0*(x0b-nX0b)], ldX0);
+
+            /* X1 = X(nX1b-nXb:nX1e-nXb-1) */
+            if (X1 && x1b < x1e) Num_copy_matrix_Sprimme(&X[m*(x1b-nXb)], mi,
+                  x1e-x1b, m, &X1[i+ldX1*(x1b-nX1b)], ldX1);
+
+            /* X2 = X(nX2b-nXb:nX2e-nXb-1) */
+            if (X2 && x2b < x2e) Num_copy_matrix_Sprimme(&X[m*(x2b-nXb)], mi,
+                  x2e-x2b, m, &X2[i+ldX2*(x2b-nX2b)], ldX2);
+
+            /* Z = BV*h(nXb:nXe-1), BX0 and BX1 as X0 and X1 */
+            if (BV && nXb < nXe) Num_gemm_Sprimme("N", "N", mi, nXe-nXb, nV,
+                  1.0, &BV[i], ldV, &h[nXb*ldh], ldh, 0.0, Z, m);
+            if (BX0 && x0b < x0e) Num_copy_matrix_Sprimme(&Z[m*(x0b-nXb)], mi,
+                  x0e-x0b, m, &BX0[i+ldBX0*(x0b-nX0b)], ldBX0);
+            if (BX1 && x1b < x1e) Num_copy_matrix_Sprimme(&Z[m*(x1b-nXb)], mi,
+                  x1e-x1b, m, &BX1[i+ldBX1*(x1b-nX1b)], ldBX1);
+
+            /* Y = W*h(nYb:nYe-1) */
+            if (nYb < nYe) Num_gemm_Sprimme("N", "N", mi, nYe-nYb, nV,
+                  1.0, &W[i], ldV, &h[nYb*ldh], ldh, 0.0, Y, m);
+
+            /* Wo = Y(nWob-nYb:nWoe-nYb-1) */
+            if (Wo && wob < woe) Num_copy_matrix_Sprimme(&Y[m*(wob-nYb)], mi,
+                  woe-wob, m, &Wo[i+ldWo*(wob-nWob)], ldWo);
+
+            /* R = Y(nRb-nYb:nRe-nYb-1) - X(nRb-nYb:nRe-nYb-1)*diag(nRb:nRe-1) */
+            if (R) for (j=rb; j<re; j++) {
+               Num_compute_residual_Sprimme(mi, hVals[j], &BX[m*(j-nXb)],
+                     &Y[m*(j-nYb)], &R[i+ldR*(j-nRb)]);
+               if (Rnorms) {
+                  Rn[j-nRb] +=
+                     REAL_PART(Num_dot_Sprimme(mi, &R[i+ldR*(j-nRb)], 1,
+                              &R[i+ldR*(j-nRb)], 1));
+               }
+            }
+
+            /* rnorms = Y(nrb-nYb:nre-nYb-1) - X(nrb-nYb:nre-nYb-1)*diag(nrb:nre-1) */
+            if (rnorms) for (j=r2b; j<r2e; j++) {
+               Num_compute_residual_Sprimme(mi, hVals[j], &BX[m*(j-nXb)],
+                     &Y[m*(j-nYb)], &Y[m*(j-nYb)]);
+               rn[j-nrb] += 
+                  REAL_PART(Num_dot_Sprimme(mi, &Y[m*(j-nYb)], 1,
+                           &Y[m*(j-nYb)], 1));
+            }
          }
       }
 
-      /* rnorms = Y(nrb-nYb:nre-nYb-1) - X(nrb-nYb:nre-nYb-1)*diag(nrb:nre-1) */
-      if (rnorms) for (j=nrb; j<nre; j++) {
-         Num_compute_residual_Sprimme(m, hVals[j], &X[ldX*(j-nXb)], &Y[ldY*(j-nYb)],
-               &Y[ldY*(j-nYb)]);
-         rnorms[j-nrb] += 
-            REAL_PART(Num_dot_Sprimme(m, &Y[ldY*(j-nYb)], 1,
-                     &Y[ldY*(j-nYb)], 1));
+      /* Add up the partial sums of the threads */
+
+      if (nt > 1) for (t=0; t<nt; t++) {
+         for (j=0; j<nR; j++) Rnorms[j] += part[numNorms*t+j];
+         for (j=nR; j<numNorms; j++) rnorms[j-nR] += part[numNorms*t+j];
+      }
+
+      /* Start the reduction of Rnorms and rnorms after the first pass */
+
+      if (k == 0 && primme->numProcs > 1) {
+         j = 0;
+         if (R && Rnorms) for (i=nRb; i<nRe; i++) tmp[j++] = Rnorms[i-nRb];
+         if (rnorms) for (i=nrb; i<nre; i++) tmp[j++] = rnorms[i-nrb];
+         tmp0 = tmp+j;
+         if (j) CHKERR(globalSumStart_Rprimme(tmp, tmp0, j, &request, primme),
+               -1);
       }
    }
 
-   /* Reduce Rnorms and rnorms and sqrt the results */
+   /* Finish the reduction of Rnorms and rnorms and sqrt the results */
 
    if (primme->numProcs > 1) {
-      tmp = (REAL*)rwork;
-      j = 0;
-      if (R && Rnorms) for (i=nRb; i<nRe; i++) tmp[j++] = Rnorms[i-nRb];
-      if (rnorms) for (i=nrb; i<nre; i++) tmp[j++] = rnorms[i-nrb];
-      tmp0 = tmp+j;
-      if (j) CHKERR(globalSum_Rprimme(tmp, tmp0, j, primme), -1);
+      CHKERR(globalSumWait_Rprimme(request, primme), -1);
       j = 0;
       if (R && Rnorms) for (i=nRb; i<nRe; i++) Rnorms[i-nRb] = sqrt(tmp0[j++]);
       if (rnorms) for (i=nrb; i<nre; i++) rnorms[i-nrb] = sqrt(tmp0[j++]);
@@ -248,7 +451,7 @@ int applyPreconditioner_Sprimme(SCALAR *V, PRIMME_INT nLocal, PRIMME_INT ldV,
    if (blockSize <= 0) return 0;
    assert(primme->nLocal == nLocal);
 
-   t0 = primme_wTimer(0);
+   t0 = primme_get_wtime();
 
    if (primme->correctionParams.precondition) {
       if (primme->ldOPs == 0
@@ -270,7 +473,51 @@ int applyPreconditioner_Sprimme(SCALAR *V, PRIMME_INT nLocal, PRIMME_INT ldV,
       Num_copy_matrix_Sprimme(V, nLocal, blockSize, ldV, W, ldW);
    }
 
-   primme->stats.timePrecond += primme_wTimer(0) - t0;
+   primme->stats.timePrecond += primme_get_wtime() - t0;
+
+   return 0;
+}
+
+/*******************************************************************************
+ * Subroutine monitor_Sprimme - wrapper around primme.monitorFun; report an
+ *    event of the solver. Phases are reported when they finish, with t0 the
+ *    value of primme_get_wtime() when they started.
+ *
+ * INPUT PARAMETERS
+ * ----------------
+ * event         The event
+ * t0            The time when the phase started
+ * basisSize     The size of the basis
+ * blockSize     The size of the block
+ * blockNorms    The residual norms of the block, or NULL if they are not
+ *               reported
+ * numConverged  The number of converged pairs
+ *
+ ******************************************************************************/
+
+TEMPLATE_PLEASE
+int monitor_Sprimme(primme_event event, double t0, int basisSize,
+      int blockSize, REAL *blockNorms, int numConverged,
+      primme_params *primme) {
+
+   int i, ierr=0;
+   double duration, *norms = NULL;
+
+   if (!primme->monitorFun) return 0;
+
+   duration = primme_get_wtime() - t0;
+
+   /* The monitor receives the norms in double precision */
+
+   if (blockNorms && blockSize > 0) {
+      CHKERR(MALLOC_PRIMME(blockSize, &norms), -1);
+      for (i=0; i<blockSize; i++) norms[i] = blockNorms[i];
+   }
+
+   primme->monitorFun(&event, &t0, &duration, &basisSize, &blockSize, norms,
+         &numConverged, primme, &ierr);
+   free(norms);
+   CHKERRM(ierr, -1, "Error returned by 'monitorFun' %d", ierr);
 
    return 0;
 }
@@ -41,20 +41,36 @@
 #endif
 void Num_compute_residual_dprimme(int64_t n, double eval, double *x,
    double *Ax, double *r);
+#if !defined(CHECK_TEMPLATE) && !defined(Num_update_VWXR_num_threads_Sprimme)
+#  define Num_update_VWXR_num_threads_Sprimme CONCAT(Num_update_VWXR_num_threads_,SCALAR_SUF)
+#endif
+#if !defined(CHECK_TEMPLATE) && !defined(Num_update_VWXR_num_threads_Rprimme)
+#  define Num_update_VWXR_num_threads_Rprimme CONCAT(Num_update_VWXR_num_threads_,REAL_SUF)
+#endif
+int Num_update_VWXR_num_threads_dprimme(int64_t mV, primme_params *primme);
+#if !defined(CHECK_TEMPLATE) && !defined(Num_prefetch_rows_Sprimme)
+#  define Num_prefetch_rows_Sprimme CONCAT(Num_prefetch_rows_,SCALAR_SUF)
+#endif
+#if !defined(CHECK_TEMPLATE) && !defined(Num_prefetch_rows_Rprimme)
+#  define Num_prefetch_rows_Rprimme CONCAT(Num_prefetch_rows_,REAL_SUF)
+#endif
+void Num_prefetch_rows_dprimme(double *x, int64_t m, int n, int64_t ld,
+      primme_params *primme);
 #if !defined(CHECK_TEMPLATE) && !defined(Num_update_VWXR_Sprimme)
 #  define Num_update_VWXR_Sprimme CONCAT(Num_update_VWXR_,SCALAR_SUF)
 #endif
 #if !defined(CHECK_TEMPLATE) && !defined(Num_update_VWXR_Rprimme)
 #  define Num_update_VWXR_Rprimme CONCAT(Num_update_VWXR_,REAL_SUF)
 #endif
-int Num_update_VWXR_dprimme(double *V, double *W, int64_t mV, int nV,
-      int64_t ldV, double *h, int nh, int ldh, double *hVals,
+int Num_update_VWXR_dprimme(double *V, double *W, double *BV, int64_t mV,
+      int nV, int64_t ldV, double *h, int nh, int ldh, double *hVals,
       double *X0, int nX0b, int nX0e, int64_t ldX0,
       double *X1, int nX1b, int nX1e, int64_t ldX1,
       double *X2, int nX2b, int nX2e, int64_t ldX2,
       double *Wo, int nWob, int nWoe, int64_t ldWo,
       double *R, int nRb, int nRe, int64_t ldR, double *Rnorms,
       double *rnorms, int nrb, int nre,
+      double *BX0, int64_t ldBX0, double *BX1, int64_t ldBX1,
       double *rwork, int lrwork, primme_params *primme);
 #if !defined(CHECK_TEMPLATE) && !defined(applyPreconditioner_Sprimme)
 #  define applyPreconditioner_Sprimme CONCAT(applyPreconditioner_,SCALAR_SUF)
@@ -64,6 +80,15 @@ int Num_update_VWXR_dprimme(double *V, double *W, int64_t mV, int nV,
 #endif
 int applyPreconditioner_dprimme(double *V, int64_t nLocal, int64_t ldV,
       double *W, int64_t ldW, int blockSize, primme_params *primme);
+#if !defined(CHECK_TEMPLATE) && !defined(monitor_Sprimme)
+#  define monitor_Sprimme CONCAT(monitor_,SCALAR_SUF)
+#endif
+#if !defined(CHECK_TEMPLATE) && !defined(monitor_Rprimme)
+#  define monitor_Rprimme CONCAT(monitor_,REAL_SUF)
+#endif
+int monitor_dprimme(primme_event event, double t0, int basisSize,
+      int blockSize, double *blockNorms, int numConverged,
+      primme_params *primme);
 #if !defined(CHECK_TEMPLATE) && !defined(convTestFun_Sprimme)
 #  define convTestFun_Sprimme CONCAT(convTestFun_,SCALAR_SUF)
 #endif
@@ -74,47 +99,68 @@ int convTestFun_dprimme(double eval, double *evec, double rNorm, int *isconv,
       struct primme_params *primme);
 void Num_compute_residual_zprimme(int64_t n, PRIMME_COMPLEX_DOUBLE eval, PRIMME_COMPLEX_DOUBLE *x,
    PRIMME_COMPLEX_DOUBLE *Ax, PRIMME_COMPLEX_DOUBLE *r);
-int Num_update_VWXR_zprimme(PRIMME_COMPLEX_DOUBLE *V, PRIMME_COMPLEX_DOUBLE *W, int64_t mV, int nV,
-      int64_t ldV, PRIMME_COMPLEX_DOUBLE *h, int nh, int ldh, double *hVals,
+int Num_update_VWXR_num_threads_zprimme(int64_t mV, primme_params *primme);
+void Num_prefetch_rows_zprimme(PRIMME_COMPLEX_DOUBLE *x, int64_t m, int n, int64_t ld,
+      primme_params *primme);
+int Num_update_VWXR_zprimme(PRIMME_COMPLEX_DOUBLE *V, PRIMME_COMPLEX_DOUBLE *W, PRIMME_COMPLEX_DOUBLE *BV, int64_t mV,
+      int nV, int64_t ldV, PRIMME_COMPLEX_DOUBLE *h, int nh, int ldh, double *hVals,
       PRIMME_COMPLEX_DOUBLE *X0, int nX0b, int nX0e, int64_t ldX0,
       PRIMME_COMPLEX_DOUBLE *X1, int nX1b, int nX1e, int64_t ldX1,
       PRIMME_COMPLEX_DOUBLE *X2, int nX2b, int nX2e, int64_t ldX2,
       PRIMME_COMPLEX_DOUBLE *Wo, int nWob, int nWoe, int64_t ldWo,
       PRIMME_COMPLEX_DOUBLE *R, int nRb, int nRe, int64_t ldR, double *Rnorms,
       double *rnorms, int nrb, int nre,
+      PRIMME_COMPLEX_DOUBLE *BX0, int64_t ldBX0, PRIMME_COMPLEX_DOUBLE *BX1, int64_t ldBX1,
       PRIMME_COMPLEX_DOUBLE *rwork, int lrwork, primme_params *primme);
 int applyPreconditioner_zprimme(PRIMME_COMPLEX_DOUBLE *V, int64_t nLocal, int64_t ldV,
       PRIMME_COMPLEX_DOUBLE *W, int64_t ldW, int blockSize, primme_params *primme);
+int monitor_zprimme(primme_event event, double t0, int basisSize,
+      int blockSize, double *blockNorms, int numConverged,
+      primme_params *primme);
 int convTestFun_zprimme(double eval, PRIMME_COMPLEX_DOUBLE *evec, double rNorm, int *isconv,
       struct primme_params *primme);
 void Num_compute_residual_sprimme(int64_t n, float eval, float *x,
    float *Ax, float *r);
-int Num_update_VWXR_sprimme(float *V, float *W, int64_t mV, int nV,
-      int64_t ldV, float *h, int nh, int ldh, float *hVals,
+int Num_update_VWXR_num_threads_sprimme(int64_t mV, primme_params *primme);
+void Num_prefetch_rows_sprimme(float *x, int64_t m, int n, int64_t ld,
+      primme_params *primme);
+int Num_update_VWXR_sprimme(float *V, float *W, float *BV, int64_t mV,
+      int nV, int64_t ldV, float *h, int nh, int ldh, float *hVals,
       float *X0, int nX0b, int nX0e, int64_t ldX0,
       float *X1, int nX1b, int nX1e, int64_t ldX1,
       float *X2, int nX2b, int nX2e, int64_t ldX2,
       float *Wo, int nWob, int nWoe, int64_t ldWo,
       float *R, int nRb, int nRe, int64_t ldR, float *Rnorms,
       float *rnorms, int nrb, int nre,
+      float *BX0, int64_t ldBX0, float *BX1, int64_t ldBX1,
       float *rwork, int lrwork, primme_params *primme);
 int applyPreconditioner_sprimme(float *V, int64_t nLocal, int64_t ldV,
       float *W, int64_t ldW, int blockSize, primme_params *primme);
+int monitor_sprimme(primme_event event, double t0, int basisSize,
+      int blockSize, float *blockNorms, int numConverged,
+      primme_params *primme);
 int convTestFun_sprimme(float eval, float *evec, float rNorm, int *isconv,
       struct primme_params *primme);
 void Num_compute_residual_cprimme(int64_t n, PRIMME_COMPLEX_FLOAT eval, PRIMME_COMPLEX_FLOAT *x,
    PRIMME_COMPLEX_FLOAT *Ax, PRIMME_COMPLEX_FLOAT *r);
-int Num_update_VWXR_cprimme(PRIMME_COMPLEX_FLOAT *V, PRIMME_COMPLEX_FLOAT *W, int64_t mV, int nV,
-      int64_t ldV, PRIMME_COMPLEX_FLOAT *h, int nh, int ldh, float *hVals,
+int Num_update_VWXR_num_threads_cprimme(int64_t mV, primme_params *primme);
+void Num_prefetch_rows_cprimme(PRIMME_COMPLEX_FLOAT *x, int64_t m, int n, int64_t ld,
+      primme_params *primme);
+int Num_update_VWXR_cprimme(PRIMME_COMPLEX_FLOAT *V, PRIMME_COMPLEX_FLOAT *W, PRIMME_COMPLEX_FLOAT *BV, int64_t mV,
+      int nV, int64_t ldV, PRIMME_COMPLEX_FLOAT *h, int nh, int ldh, float *hVals,
       PRIMME_COMPLEX_FLOAT *X0, int nX0b, int nX0e, int64_t ldX0,
       PRIMME_COMPLEX_FLOAT *X1, int nX1b, int nX1e, int64_t ldX1,
       PRIMME_COMPLEX_FLOAT *X2, int nX2b, int nX2e, int64_t ldX2,
       PRIMME_COMPLEX_FLOAT *Wo, int nWob, int nWoe, int64_t ldWo,
       PRIMME_COMPLEX_FLOAT *R, int nRb, int nRe, int64_t ldR, float *Rnorms,
       float *rnorms, int nrb, int nre,
+      PRIMME_COMPLEX_FLOAT *BX0, int64_t ldBX0, PRIMME_COMPLEX_FLOAT *BX1, int64_t ldBX1,
       PRIMME_COMPLEX_FLOAT *rwork, int lrwork, primme_params *primme);
 int applyPreconditioner_cprimme(PRIMME_COMPLEX_FLOAT *V, int64_t nLocal, int64_t ldV,
       PRIMME_COMPLEX_FLOAT *W, int64_t ldW, int blockSize, primme_params *primme);
+int monitor_cprimme(primme_event event, double t0, int basisSize,
+      int blockSize, float *blockNorms, int numConverged,
+      primme_params *primme);
 int convTestFun_cprimme(float eval, PRIMME_COMPLEX_FLOAT *evec, float rNorm, int *isconv,
       struct primme_params *primme);
 #endif
@@ -0,0 +1,211 @@
+/*******************************************************************************
+ * Copyright (c) 2016, College of William & Mary
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the College of William & Mary nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COLLEGE OF WILLIAM & MARY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * PRIMME: https://github.com/primme/primme
+ * Contact: Andreas Stathopoulos, a n d r e a s _at_ c s . w m . e d u
+ *******************************************************************************
+ * File: batch.c
+ *
+ * Purpose - Front end that solves many independent eigenproblems, reusing
+ *           the workspace from one solve to the next.
+ *
+ ******************************************************************************/
+
+#include <stdlib.h>   /* mallocs, free */
+#include <stdio.h>
+#include "const.h"
+#include "numerical.h"
+#include "primme_interface.h"
+
+#define MALLOC_FAILURE            -2
+#define BATCH_INVALID_INPUT       -45
+
+/* Workspace reused by the solves run by the same thread */
+
+typedef struct {
+   void *realWork;
+   size_t realWorkSize;
+   int *intWork;
+   int intWorkSize;
+} workspace_pool;
+
+static int solve_pooled(REAL *evals, SCALAR *evecs, REAL *resNorms,
+      primme_params *primme, workspace_pool *pool);
+
+
+/*******************************************************************************
+ * Subroutine Sprimme_batch - Solves numProblems independent eigenproblems,
+ *    each one described by an entry of the array primme, as Sprimme does.
+ *
+ *    Every thread keeps a workspace that is lent to the solves it runs and
+ *    that only grows when a problem needs more, so the workspace is
+ *    allocated a few times instead of once per problem. If PRIMME is
+ *    compiled with OpenMP and numProcs is one in all problems, the problems
+ *    are distributed dynamically among the threads, and the user callbacks
+ *    are called from several threads at once. Otherwise the problems are
+ *    solved one after another, in order.
+ *
+ *    The problems that provide their own realWork or intWork use it instead
+ *    of the shared workspace.
+ *
+ * INPUT PARAMETERS
+ * ----------------
+ * numProblems  The number of problems
+ *
+ * INPUT/OUTPUT ARRAYS AND PARAMETERS
+ * ----------------------------------
+ * evals, evecs, resNorms  Arrays of numProblems pointers; the i-th entries
+ *              are the arguments evals, evecs and resNorms of Sprimme for
+ *              the i-th problem
+ *
+ * primme       Array of numProblems structures with the parameters of every
+ *              problem. On output, every one has its stats and initSize set
+ *              as Sprimme does
+ *
+ * ierrs        If not NULL, array of numProblems elements that returns the
+ *              error code of every problem
+ *
+ * Return Value
+ * ------------
+ *  0 - Success
+ * -45 - Invalid numProblems or NULL arrays
+ *  Otherwise, the error code of the first problem that failed
+ *
+ ******************************************************************************/
+
+int Sprimme_batch(REAL **evals, SCALAR **evecs, REAL **resNorms,
+      int numProblems, primme_params *primme, int *ierrs) {
+
+   int i, ret=0, parallel=1;
+   int first;               /* First problem that failed */
+
+   if (numProblems < 0 || (numProblems > 0 && (evals == NULL || evecs == NULL
+               || resNorms == NULL || primme == NULL))) {
+      return BATCH_INVALID_INPUT;
+   }
+
+   /* Collective operations of several problems cannot be interleaved */
+
+   for (i=0; i<numProblems; i++) {
+      if (primme[i].numProcs > 1) parallel = 0;
+   }
+   first = numProblems;
+
+#ifdef _OPENMP
+   #pragma omp parallel if(parallel && numProblems > 1)
+#endif
+   {
+      workspace_pool pool = {NULL, 0, NULL, 0};
+      int j, ierr;
+
+#ifdef _OPENMP
+      #pragma omp for schedule(dynamic)
+#endif
+      for (j=0; j<numProblems; j++) {
+         ierr = solve_pooled(evals[j], evecs[j], resNorms[j], &primme[j],
+               &pool);
+         if (ierrs) ierrs[j] = ierr;
+         if (ierr != 0) {
+#ifdef _OPENMP
+            #pragma omp critical
+#endif
+            if (j < first) {
+               first = j;
+               ret = ierr;
+            }
+         }
+      }
+
+      free(pool.realWork);
+      free(pool.intWork);
+   }
+   (void)parallel;
+
+   return ret;
+}
+
+
+/*******************************************************************************
+ * Function solve_pooled - Calls Sprimme lending it the workspace of the pool,
+ *    which grows if the problem needs more. The workspace is removed from
+ *    primme before returning.
+ *
+ * INPUT/OUTPUT PARAMETERS
+ * -----------------------
+ * evals, evecs, resNorms, primme  The arguments of Sprimme
+ * pool         The workspace of the calling thread
+ *
+ * Return Value
+ * ------------
+ *  The value returned by Sprimme
+ *
+ ******************************************************************************/
+
+static int solve_pooled(REAL *evals, SCALAR *evecs, REAL *resNorms,
+      primme_params *primme, workspace_pool *pool) {
+
+   int ret;
+
+   /* Use the workspace provided by the user, if any */
+
+   if (primme->realWork != NULL || primme->intWork != NULL) {
+      return Sprimme(evals, evecs, resNorms, primme);
+   }
+
+   /* Query the workspace required and grow the pool if needed */
+
+   Sprimme(NULL, NULL, NULL, primme);
+   if (pool->realWorkSize < primme->realWorkSize) {
+      free(pool->realWork);
+      pool->realWorkSize = 0;
+      CHKERR(MALLOC_PRIMME(primme->realWorkSize, (char**)&pool->realWork),
+            MALLOC_FAILURE);
+      pool->realWorkSize = primme->realWorkSize;
+   }
+   if (pool->intWorkSize < primme->intWorkSize) {
+      free(pool->intWork);
+      pool->intWorkSize = 0;
+      CHKERR(MALLOC_PRIMME(primme->intWorkSize/sizeof(int) + 1,
+               &pool->intWork), MALLOC_FAILURE);
+      pool->intWorkSize = primme->intWorkSize;
+   }
+
+   /* Solve with the workspace of the pool */
+
+   primme->realWork = pool->realWork;
+   primme->realWorkSize = pool->realWorkSize;
+   primme->intWork = pool->intWork;
+   primme->intWorkSize = pool->intWorkSize;
+
+   ret = Sprimme(evals, evecs, resNorms, primme);
+
+   primme->realWork = NULL;
+   primme->realWorkSize = 0;
+   primme->intWork = NULL;
+   primme->intWorkSize = 0;
+
+   return ret;
+}
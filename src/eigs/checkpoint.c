@@ -0,0 +1,476 @@
+/*******************************************************************************
+ * Copyright (c) 2016, College of William & Mary
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the College of William & Mary nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COLLEGE OF WILLIAM & MARY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * PRIMME: https://github.com/primme/primme
+ * Contact: Andreas Stathopoulos, a n d r e a s _at_ c s . w m . e d u
+ *******************************************************************************
+ * File: checkpoint.c
+ *
+ * Purpose - Saves the state of main_iter after a restart, and restores it
+ *           to resume an interrupted solve.
+ *
+ *  Every process writes its own file, primme.checkpointFile if there is a
+ *  single process and primme.checkpointFile.<procID> otherwise, with the
+ *  rows of the vectors it holds. The file has the following sections, which
+ *  are all fixed-size, so every checkpoint rewrites the same bytes:
+ *
+ *    header      CHECKPOINT_HEADER_SIZE PRIMME_INT: type, version, sizes
+ *                and the state of the two slots (see below)
+ *    locked      numEvals columns with the locked eigenvectors. They never
+ *                change after locking, so only the vectors locked since the
+ *                last checkpoint are written.
+ *    slot 0, 1   the basis: basisSize and other counters, primme.stats,
+ *                evals, resNorms, perm, and the columns of V, W and B*V
+ *
+ *  A checkpoint goes into the slot that is not the last complete one, and
+ *  the header is updated after the slot has been flushed. So if the process
+ *  is killed while writing, the previous checkpoint is still valid.
+ *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "numerical.h"
+#include "checkpoint.h"
+#include "globalsum.h"
+#include "wtime.h"
+
+#define CHECKPOINT_VERSION     1
+#define CHECKPOINT_HEADER_SIZE 16
+#define CHECKPOINT_META_SIZE   16
+
+/* Fields in the header */
+#define H_TYPE          0  /* +/-sizeof(SCALAR), negative for complex     */
+#define H_VERSION       1
+#define H_N             2
+#define H_NLOCAL        3
+#define H_MAXBASISSIZE  4
+#define H_NUMEVALS      5
+#define H_NUMORTHOCONST 6
+#define H_LOCKING       7
+#define H_MASSMATRIX    8
+#define H_SLOT          9  /* last complete slot or -1                    */
+#define H_ID            10 /* H_ID+s is the id of slot s, -1 if invalid   */
+
+/* Fields in the slot metadata */
+#define M_BASISSIZE     0
+#define M_NUMLOCKED     1
+#define M_RESTARTSSINCERESET 2
+#define M_ISEED         3  /* four values */
+
+#ifdef USE_COMPLEX
+#  define CHECKPOINT_TYPE_SIZE (-(PRIMME_INT)sizeof(SCALAR))
+#else
+#  define CHECKPOINT_TYPE_SIZE ((PRIMME_INT)sizeof(SCALAR))
+#endif
+
+/*******************************************************************************
+ * Function checkpoint_open - Open the checkpoint file of this process
+ *
+ * INPUT PARAMETERS
+ * ----------------
+ * mode           Mode for fopen
+ *
+ * OUTPUT PARAMETERS
+ * -----------------
+ * f              The opened file
+ *
+ * Return Value
+ * ------------
+ * error code
+ ******************************************************************************/
+
+static int checkpoint_open(const char *mode, FILE **f, primme_params *primme) {
+
+   char *fileName;
+   size_t len = strlen(primme->checkpointFile) + 16;
+
+   *f = NULL;
+   CHKERRNOABORT(MALLOC_PRIMME(len, &fileName), -1);
+   if (primme->numProcs > 1) {
+      sprintf(fileName, "%s.%d", primme->checkpointFile, primme->procID);
+   }
+   else {
+      strcpy(fileName, primme->checkpointFile);
+   }
+   *f = fopen(fileName, mode);
+   if (*f == NULL && primme->printLevel > 0 && primme->outputFile) {
+      fprintf(primme->outputFile, "PRIMME: Could not open checkpoint file "
+            "'%s'\n", fileName);
+   }
+   free(fileName);
+   return *f ? 0 : -1;
+}
+
+/*******************************************************************************
+ * Functions checkpoint_write/read - fwrite/fread from the given offset. Offset
+ *    -1 continues at the current position.
+ ******************************************************************************/
+
+static int checkpoint_write(FILE *f, PRIMME_INT offset, const void *x,
+      size_t size, size_t n) {
+
+   if (n == 0) return 0;
+   if (offset >= 0 && fseek(f, (long)offset, SEEK_SET) != 0) return -1;
+   return fwrite(x, size, n, f) == n ? 0 : -1;
+}
+
+static int checkpoint_read(FILE *f, PRIMME_INT offset, void *x, size_t size,
+      size_t n) {
+
+   if (n == 0) return 0;
+   if (offset >= 0 && fseek(f, (long)offset, SEEK_SET) != 0) return -1;
+   return fread(x, size, n, f) == n ? 0 : -1;
+}
+
+/*******************************************************************************
+ * Functions checkpoint_*_offset - Offsets in bytes of the sections of the file
+ ******************************************************************************/
+
+static PRIMME_INT checkpoint_locked_offset(void) {
+   return (PRIMME_INT)sizeof(PRIMME_INT)*CHECKPOINT_HEADER_SIZE;
+}
+
+static PRIMME_INT checkpoint_slot_offset(int slot, PRIMME_INT *header,
+      size_t sizeofScalar, size_t sizeofReal) {
+
+   PRIMME_INT nLocal = header[H_NLOCAL], numEvals = header[H_NUMEVALS];
+   PRIMME_INT slotSize =
+      (PRIMME_INT)sizeof(PRIMME_INT)*CHECKPOINT_META_SIZE
+      + (PRIMME_INT)sizeof(primme_stats)
+      + (PRIMME_INT)(2*sizeofReal + sizeof(int))*numEvals
+      + (PRIMME_INT)sizeofScalar*nLocal*header[H_MAXBASISSIZE]
+           *(header[H_MASSMATRIX] ? 3 : 2);
+
+   return checkpoint_locked_offset()
+      + (PRIMME_INT)sizeofScalar*nLocal*numEvals + slotSize*slot;
+}
+
+/*******************************************************************************
+ * Subroutine write_checkpoint - Save the state of main_iter after a restart
+ *
+ * INPUT ARRAYS AND PARAMETERS
+ * ---------------------------
+ * V, W, BV          The basis, A*V and B*V (BV may be NULL)
+ * ldV               The leading dimension of V, W and BV
+ * basisSize         Number of columns in V
+ * evecs             The locked vectors are evecs(:,numOrthoConst:numOrthoConst+numLocked-1)
+ * ldevecs           The leading dimension of evecs
+ * evals, resNorms   The eigenvalues and residual norms of the locked pairs
+ * perm              The permutation of the locked pairs
+ * numLocked         Number of locked pairs
+ * restartsSinceReset Restarts since the last reset of V and W
+ *
+ * INPUT/OUTPUT PARAMETERS
+ * -----------------------
+ * slot              Last complete slot in the file; -1 if the file has not
+ *                   been written or read in this run
+ * numLockedSaved    Number of locked vectors already in the file
+ *
+ * Return Value
+ * ------------
+ * error code
+ ******************************************************************************/
+
+TEMPLATE_PLEASE
+int write_checkpoint_Sprimme(SCALAR *V, SCALAR *W, SCALAR *BV, PRIMME_INT ldV,
+      int basisSize, SCALAR *evecs, PRIMME_INT ldevecs, REAL *evals,
+      REAL *resNorms, int *perm, int numLocked, int restartsSinceReset,
+      int *slot, int *numLockedSaved, primme_params *primme) {
+
+   PRIMME_INT header[CHECKPOINT_HEADER_SIZE];
+   PRIMME_INT meta[CHECKPOINT_META_SIZE];
+   PRIMME_INT offset;
+   primme_stats stats;
+   FILE *f;
+   int i, s, ret=0;
+   PRIMME_INT nLocal = primme->nLocal;
+
+   /* Open the file; create it if it has not been used in this run */
+
+   CHKERRNOABORT(checkpoint_open(*slot < 0 ? "w+b" : "r+b", &f, primme), -1);
+
+   if (*slot < 0) {
+      for (i=0; i<CHECKPOINT_HEADER_SIZE; i++) header[i] = 0;
+      header[H_TYPE] = CHECKPOINT_TYPE_SIZE;
+      header[H_VERSION] = CHECKPOINT_VERSION;
+      header[H_N] = primme->n;
+      header[H_NLOCAL] = nLocal;
+      header[H_MAXBASISSIZE] = primme->maxBasisSize;
+      header[H_NUMEVALS] = primme->numEvals;
+      header[H_NUMORTHOCONST] = primme->numOrthoConst;
+      header[H_LOCKING] = primme->locking;
+      header[H_MASSMATRIX] = BV ? 1 : 0;
+      header[H_SLOT] = -1;
+      header[H_ID] = header[H_ID+1] = -1;
+      *numLockedSaved = 0;
+   }
+   else if (checkpoint_read(f, 0, header, sizeof(PRIMME_INT),
+            CHECKPOINT_HEADER_SIZE) != 0) {
+      ret = -1;
+   }
+   s = *slot < 0 ? 0 : 1 - *slot;
+
+   /* Invalidate the slot that is going to be written */
+
+   if (ret == 0) {
+      header[H_ID+s] = -1;
+      if (checkpoint_write(f, 0, header, sizeof(PRIMME_INT),
+               CHECKPOINT_HEADER_SIZE) != 0 || fflush(f) != 0) ret = -1;
+   }
+
+   /* Append the vectors locked since the last checkpoint */
+
+   for (i=*numLockedSaved; ret == 0 && i<numLocked; i++) {
+      if (checkpoint_write(f, checkpoint_locked_offset()
+               + (PRIMME_INT)sizeof(SCALAR)*nLocal*i,
+               &evecs[ldevecs*(primme->numOrthoConst+i)], sizeof(SCALAR),
+               nLocal) != 0) ret = -1;
+   }
+
+   /* Write the slot: metadata, stats, locked values and the basis. The */
+   /* columns are streamed from V, W and BV without extra copies.       */
+
+   if (ret == 0) {
+      for (i=0; i<CHECKPOINT_META_SIZE; i++) meta[i] = 0;
+      meta[M_BASISSIZE] = basisSize;
+      meta[M_NUMLOCKED] = numLocked;
+      meta[M_RESTARTSSINCERESET] = restartsSinceReset;
+      for (i=0; i<4; i++) meta[M_ISEED+i] = primme->iseed[i];
+      stats = primme->stats;
+      stats.elapsedTime += primme_wTimer(primme);
+
+      offset = checkpoint_slot_offset(s, header, sizeof(SCALAR), sizeof(REAL));
+      if (checkpoint_write(f, offset, meta, sizeof(PRIMME_INT),
+               CHECKPOINT_META_SIZE) != 0
+            || checkpoint_write(f, -1, &stats, sizeof(stats), 1) != 0
+            || checkpoint_write(f, -1, evals, sizeof(REAL),
+               primme->numEvals) != 0
+            || checkpoint_write(f, -1, resNorms, sizeof(REAL),
+               primme->numEvals) != 0
+            || checkpoint_write(f, -1, perm, sizeof(int),
+               primme->numEvals) != 0)
+         ret = -1;
+
+      offset = ftell(f);
+      for (i=0; ret == 0 && i<basisSize; i++) {
+         if (checkpoint_write(f, offset + (PRIMME_INT)sizeof(SCALAR)*nLocal*i,
+                  &V[ldV*i], sizeof(SCALAR), nLocal) != 0) ret = -1;
+      }
+      offset += (PRIMME_INT)sizeof(SCALAR)*nLocal*primme->maxBasisSize;
+      for (i=0; ret == 0 && i<basisSize; i++) {
+         if (checkpoint_write(f, offset + (PRIMME_INT)sizeof(SCALAR)*nLocal*i,
+                  &W[ldV*i], sizeof(SCALAR), nLocal) != 0) ret = -1;
+      }
+      offset += (PRIMME_INT)sizeof(SCALAR)*nLocal*primme->maxBasisSize;
+      for (i=0; ret == 0 && BV && i<basisSize; i++) {
+         if (checkpoint_write(f, offset + (PRIMME_INT)sizeof(SCALAR)*nLocal*i,
+                  &BV[ldV*i], sizeof(SCALAR), nLocal) != 0) ret = -1;
+      }
+      if (ret == 0 && fflush(f) != 0) ret = -1;
+   }
+
+   /* Mark the slot as the last complete checkpoint */
+
+   if (ret == 0) {
+      header[H_SLOT] = s;
+      header[H_ID+s] = primme->stats.numRestarts;
+      if (checkpoint_write(f, 0, header, sizeof(PRIMME_INT),
+               CHECKPOINT_HEADER_SIZE) != 0 || fflush(f) != 0) ret = -1;
+   }
+
+   if (fclose(f) != 0) ret = -1;
+   CHKERRNOABORTM(ret, -1, "Error writing the checkpoint file '%s'\n",
+         primme->checkpointFile);
+
+   *slot = s;
+   *numLockedSaved = numLocked;
+
+   if (primme->printLevel >= 3 && primme->procID == 0) {
+      fprintf(primme->outputFile, "Checkpoint saved at restart %" PRIMME_INT_P
+            " with basisSize %d and %d locked\n", primme->stats.numRestarts,
+            basisSize, numLocked);
+      fflush(primme->outputFile);
+   }
+
+   return 0;
+}
+
+/*******************************************************************************
+ * Subroutine read_checkpoint - Restore the state saved by write_checkpoint.
+ *    In parallel, if some processes completed the last checkpoint and other
+ *    did not, all processes restore the previous one.
+ *
+ * OUTPUT ARRAYS AND PARAMETERS
+ * ----------------------------
+ * V, W, BV          The basis, A*V and B*V (BV may be NULL)
+ * ldV               The leading dimension of V, W and BV
+ * basisSize         Number of columns in V
+ * evecs             The locked vectors are evecs(:,numOrthoConst:numOrthoConst+numLocked-1)
+ * ldevecs           The leading dimension of evecs
+ * evals, resNorms   The eigenvalues and residual norms of the locked pairs
+ * perm              The permutation of the locked pairs
+ * numLocked         Number of locked pairs
+ * restartsSinceReset Restarts since the last reset of V and W
+ * slot              The slot restored
+ * numLockedSaved    Number of locked vectors in the file
+ *
+ * Also primme.stats and primme.iseed are restored.
+ *
+ * Return Value
+ * ------------
+ * error code
+ ******************************************************************************/
+
+TEMPLATE_PLEASE
+int read_checkpoint_Sprimme(SCALAR *V, SCALAR *W, SCALAR *BV, PRIMME_INT ldV,
+      int *basisSize, SCALAR *evecs, PRIMME_INT ldevecs, REAL *evals,
+      REAL *resNorms, int *perm, int *numLocked, int *restartsSinceReset,
+      int *slot, int *numLockedSaved, primme_params *primme) {
+
+   PRIMME_INT header[CHECKPOINT_HEADER_SIZE];
+   PRIMME_INT meta[CHECKPOINT_META_SIZE];
+   PRIMME_INT offset;
+   primme_stats stats;
+   FILE *f = NULL;
+   int i, s=-1, ret=0;
+   double idAndError[2], idAndError0[2];
+   PRIMME_INT nLocal = primme->nLocal;
+
+   /* Read and check the header */
+
+   ret = checkpoint_open("rb", &f, primme);
+   if (ret == 0 && checkpoint_read(f, 0, header, sizeof(PRIMME_INT),
+            CHECKPOINT_HEADER_SIZE) != 0) ret = -1;
+   if (ret == 0 && (header[H_TYPE] != CHECKPOINT_TYPE_SIZE
+            || header[H_VERSION] != CHECKPOINT_VERSION
+            || header[H_N] != primme->n
+            || header[H_NLOCAL] != nLocal
+            || header[H_MAXBASISSIZE] != primme->maxBasisSize
+            || header[H_NUMEVALS] != primme->numEvals
+            || header[H_NUMORTHOCONST] != primme->numOrthoConst
+            || header[H_LOCKING] != primme->locking
+            || header[H_MASSMATRIX] != (BV ? 1 : 0))) {
+      if (primme->printLevel > 0 && primme->outputFile) {
+         fprintf(primme->outputFile, "PRIMME: the checkpoint file was written "
+               "with another precision or other values of n, nLocal, "
+               "maxBasisSize, numEvals, numOrthoConst, locking or "
+               "massMatrixMatvec\n");
+      }
+      ret = -1;
+   }
+   if (ret == 0 && (header[H_SLOT] < 0 || header[H_SLOT] > 1
+            || header[H_ID+header[H_SLOT]] < 0)) {
+      if (primme->printLevel > 0 && primme->outputFile) {
+         fprintf(primme->outputFile, "PRIMME: the checkpoint file has no "
+               "complete checkpoint\n");
+      }
+      ret = -1;
+   }
+   if (ret == 0) s = (int)header[H_SLOT];
+
+   /* Agree on the checkpoint among all processes. Every process has */
+   /* either the last one or the previous one as the complete slot.  */
+
+   if (primme->numProcs > 1) {
+      idAndError[0] = ret == 0 ? (double)header[H_ID+s] : 0.0;
+      idAndError[1] = ret == 0 ? 0.0 : 1.0;
+      CHKERR(globalSum_dprimme(idAndError, idAndError0, 2, primme), -1);
+      if (idAndError0[1] == 0.0 && idAndError0[0] != primme->numProcs
+            *(double)header[H_ID+s]
+            && (double)header[H_ID+s]*primme->numProcs > idAndError0[0]) {
+         s = 1 - s;
+         if (header[H_ID+s] < 0) ret = -1;
+      }
+      idAndError[0] = ret == 0 ? 0.0 : 1.0;
+      CHKERR(globalSum_dprimme(idAndError, idAndError0, 1, primme), -1);
+      if (idAndError0[0] != 0.0) ret = -1;
+   }
+
+   /* Read the slot */
+
+   if (ret == 0) {
+      offset = checkpoint_slot_offset(s, header, sizeof(SCALAR), sizeof(REAL));
+      if (checkpoint_read(f, offset, meta, sizeof(PRIMME_INT),
+               CHECKPOINT_META_SIZE) != 0
+            || checkpoint_read(f, -1, &stats, sizeof(stats), 1) != 0
+            || checkpoint_read(f, -1, evals, sizeof(REAL),
+               primme->numEvals) != 0
+            || checkpoint_read(f, -1, resNorms, sizeof(REAL),
+               primme->numEvals) != 0
+            || checkpoint_read(f, -1, perm, sizeof(int),
+               primme->numEvals) != 0)
+         ret = -1;
+   }
+   if (ret == 0 && (meta[M_BASISSIZE] <= 0
+            || meta[M_BASISSIZE] > primme->maxBasisSize
+            || meta[M_NUMLOCKED] < 0
+            || meta[M_NUMLOCKED] > primme->numEvals)) ret = -1;
+
+   if (ret == 0) {
+      *basisSize = (int)meta[M_BASISSIZE];
+      *numLocked = (int)meta[M_NUMLOCKED];
+      offset = ftell(f);
+      for (i=0; ret == 0 && i<*basisSize; i++) {
+         if (checkpoint_read(f, offset + (PRIMME_INT)sizeof(SCALAR)*nLocal*i,
+                  &V[ldV*i], sizeof(SCALAR), nLocal) != 0) ret = -1;
+      }
+      offset += (PRIMME_INT)sizeof(SCALAR)*nLocal*primme->maxBasisSize;
+      for (i=0; ret == 0 && i<*basisSize; i++) {
+         if (checkpoint_read(f, offset + (PRIMME_INT)sizeof(SCALAR)*nLocal*i,
+                  &W[ldV*i], sizeof(SCALAR), nLocal) != 0) ret = -1;
+      }
+      offset += (PRIMME_INT)sizeof(SCALAR)*nLocal*primme->maxBasisSize;
+      for (i=0; ret == 0 && BV && i<*basisSize; i++) {
+         if (checkpoint_read(f, offset + (PRIMME_INT)sizeof(SCALAR)*nLocal*i,
+                  &BV[ldV*i], sizeof(SCALAR), nLocal) != 0) ret = -1;
+      }
+      for (i=0; ret == 0 && i<*numLocked; i++) {
+         if (checkpoint_read(f, checkpoint_locked_offset()
+                  + (PRIMME_INT)sizeof(SCALAR)*nLocal*i,
+                  &evecs[ldevecs*(primme->numOrthoConst+i)], sizeof(SCALAR),
+                  nLocal) != 0) ret = -1;
+      }
+   }
+   if (f) fclose(f);
+   CHKERRNOABORTM(ret, -1, "Error reading the checkpoint file '%s'\n",
+         primme->checkpointFile);
+
+   *restartsSinceReset = (int)meta[M_RESTARTSSINCERESET];
+   for (i=0; i<4; i++) primme->iseed[i] = meta[M_ISEED+i];
+   primme->stats = stats;
+   *slot = s;
+   *numLockedSaved = *numLocked;
+
+   if (primme->printLevel >= 2 && primme->procID == 0) {
+      fprintf(primme->outputFile, "Resuming from the checkpoint at restart %"
+            PRIMME_INT_P " with basisSize %d and %d locked\n",
+            primme->stats.numRestarts, *basisSize, *numLocked);
+      fflush(primme->outputFile);
+   }
+
+   return 0;
+}
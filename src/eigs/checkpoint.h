@@ -0,0 +1,80 @@
+/*******************************************************************************
+ * Copyright (c) 2016, College of William & Mary
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the College of William & Mary nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COLLEGE OF WILLIAM & MARY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * PRIMME: https://github.com/primme/primme
+ * Contact: Andreas Stathopoulos, a n d r e a s _at_ c s . w m . e d u
+ *******************************************************************************
+ *   NOTE: THIS FILE IS AUTOMATICALLY GENERATED. PLEASE DON'T MODIFY
+ ******************************************************************************/
+
+
+#ifndef checkpoint_H
+#define checkpoint_H
+#if !defined(CHECK_TEMPLATE) && !defined(write_checkpoint_Sprimme)
+#  define write_checkpoint_Sprimme CONCAT(write_checkpoint_,SCALAR_SUF)
+#endif
+#if !defined(CHECK_TEMPLATE) && !defined(write_checkpoint_Rprimme)
+#  define write_checkpoint_Rprimme CONCAT(write_checkpoint_,REAL_SUF)
+#endif
+int write_checkpoint_dprimme(double *V, double *W, double *BV, int64_t ldV,
+      int basisSize, double *evecs, int64_t ldevecs, double *evals,
+      double *resNorms, int *perm, int numLocked, int restartsSinceReset,
+      int *slot, int *numLockedSaved, primme_params *primme);
+#if !defined(CHECK_TEMPLATE) && !defined(read_checkpoint_Sprimme)
+#  define read_checkpoint_Sprimme CONCAT(read_checkpoint_,SCALAR_SUF)
+#endif
+#if !defined(CHECK_TEMPLATE) && !defined(read_checkpoint_Rprimme)
+#  define read_checkpoint_Rprimme CONCAT(read_checkpoint_,REAL_SUF)
+#endif
+int read_checkpoint_dprimme(double *V, double *W, double *BV, int64_t ldV,
+      int *basisSize, double *evecs, int64_t ldevecs, double *evals,
+      double *resNorms, int *perm, int *numLocked, int *restartsSinceReset,
+      int *slot, int *numLockedSaved, primme_params *primme);
+int write_checkpoint_zprimme(PRIMME_COMPLEX_DOUBLE *V, PRIMME_COMPLEX_DOUBLE *W, PRIMME_COMPLEX_DOUBLE *BV, int64_t ldV,
+      int basisSize, PRIMME_COMPLEX_DOUBLE *evecs, int64_t ldevecs, double *evals,
+      double *resNorms, int *perm, int numLocked, int restartsSinceReset,
+      int *slot, int *numLockedSaved, primme_params *primme);
+int read_checkpoint_zprimme(PRIMME_COMPLEX_DOUBLE *V, PRIMME_COMPLEX_DOUBLE *W, PRIMME_COMPLEX_DOUBLE *BV, int64_t ldV,
+      int *basisSize, PRIMME_COMPLEX_DOUBLE *evecs, int64_t ldevecs, double *evals,
+      double *resNorms, int *perm, int *numLocked, int *restartsSinceReset,
+      int *slot, int *numLockedSaved, primme_params *primme);
+int write_checkpoint_sprimme(float *V, float *W, float *BV, int64_t ldV,
+      int basisSize, float *evecs, int64_t ldevecs, float *evals,
+      float *resNorms, int *perm, int numLocked, int restartsSinceReset,
+      int *slot, int *numLockedSaved, primme_params *primme);
+int read_checkpoint_sprimme(float *V, float *W, float *BV, int64_t ldV,
+      int *basisSize, float *evecs, int64_t ldevecs, float *evals,
+      float *resNorms, int *perm, int *numLocked, int *restartsSinceReset,
+      int *slot, int *numLockedSaved, primme_params *primme);
+int write_checkpoint_cprimme(PRIMME_COMPLEX_FLOAT *V, PRIMME_COMPLEX_FLOAT *W, PRIMME_COMPLEX_FLOAT *BV, int64_t ldV,
+      int basisSize, PRIMME_COMPLEX_FLOAT *evecs, int64_t ldevecs, float *evals,
+      float *resNorms, int *perm, int numLocked, int restartsSinceReset,
+      int *slot, int *numLockedSaved, primme_params *primme);
+int read_checkpoint_cprimme(PRIMME_COMPLEX_FLOAT *V, PRIMME_COMPLEX_FLOAT *W, PRIMME_COMPLEX_FLOAT *BV, int64_t ldV,
+      int *basisSize, PRIMME_COMPLEX_FLOAT *evecs, int64_t ldevecs, float *evals,
+      float *resNorms, int *perm, int *numLocked, int *restartsSinceReset,
+      int *slot, int *numLockedSaved, primme_params *primme);
+#endif
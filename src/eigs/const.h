@@ -48,7 +48,18 @@ enum conv_flags {
    PRACTICALLY_CONVERGED
 };
 
-/* Used in kernels in auxiliary_eigs.c, ortho.c and restart.c */
+/* Number of rows in the cache-blocked kernels in auxiliary_eigs.c, ortho.c, */
+/* locking.c and restart.c if primme.cacheBlockSize is not set and the     */
+/* cache size cannot be found out. See also autotune_cache_block_size.     */
 #define PRIMME_BLOCK_SIZE 512
 
+/* Range of primme.cacheBlockSize chosen by autotune_cache_block_size */
+#define PRIMME_MIN_CACHE_BLOCK_SIZE 64
+#define PRIMME_MAX_CACHE_BLOCK_SIZE 4096
+
+/* Number of rows in the cache-blocked kernels for a primme_params; Sprimme */
+/* sets ctx.cacheBlockSize to primme.cacheBlockSize or the autotuned value  */
+#define CACHE_BLOCK_SIZE(primme) ((primme) && (primme)->ctx.cacheBlockSize > 0 ? \
+      (primme)->ctx.cacheBlockSize : PRIMME_BLOCK_SIZE)
+
 #endif /* CONST_H */
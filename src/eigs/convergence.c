@@ -98,8 +98,9 @@ int check_convergence_Sprimme(SCALAR *X, PRIMME_INT nLocal, PRIMME_INT ldX,
    /* -------------------------- */
 
    if (flags == NULL) {
-      if (R) check_practical_convergence(NULL, 0, 0, NULL, numLocked, 0, left,
-            NULL, right-left, NULL, NULL, 0, NULL, rworkSize, primme);
+      if (primme->locking) check_practical_convergence(NULL, nLocal, 0, NULL,
+            primme->numOrthoConst+numLocked, 0, left, NULL, right-left, NULL,
+            NULL, 0, NULL, rworkSize, primme);
       *iwork = max(*iwork, right-left); /* for toProject */
       return 0;
    }
@@ -157,11 +158,13 @@ int check_convergence_Sprimme(SCALAR *X, PRIMME_INT nLocal, PRIMME_INT ldX,
       /* If locking there may be an accuracy problem close to convergence. */
       /* Check if there is danger if R is provided. If the Ritz vector was */
       /* flagged practically converged before and R is not provided then   */
-      /* consider converged still.                                         */
+      /* consider converged still. In the generalized problem the locked   */
+      /* vectors are B-orthonormal and I - evecs*evecs' is not a projector,*/
+      /* so R is not projected there.                                      */
       /* ----------------------------------------------------------------- */
 
       else if (primme->locking && numLocked > 0 && blockNorms[i-left] < attainableTol ) {
-         if (R) {
+         if (R && !primme->massMatrixMatvec) {
             toProject[numToProject++] = i-left;
          }
          else if (flags[i] != PRACTICALLY_CONVERGED) {
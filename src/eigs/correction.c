@@ -40,6 +40,7 @@
 #include "numerical.h"
 #include "correction.h"
 #include "inner_solve.h"
+#include "update_W.h"
 #include "globalsum.h"
 #include "auxiliary_eigs.h"
 
@@ -54,23 +55,37 @@ static void mergeSort(REAL *lockedEvals, int numLocked, REAL *ritzVals,
 static int Olsen_preconditioner_block(SCALAR *r, PRIMME_INT ldr, SCALAR *x,
       PRIMME_INT ldx, int blockSize, SCALAR *rwork, primme_params *primme);
 
-static int setup_JD_projectors(SCALAR *x, SCALAR *evecs, PRIMME_INT ldevecs,
-      SCALAR *evecsHat, PRIMME_INT ldevecsHat, SCALAR *Kinvx, SCALAR *xKinvx, 
+static int filter_interval(REAL *ritzVals, int basisSize, int *iev,
+      int blockSize, int numLocked, double *lo, double *hi, double *center,
+      primme_params *primme);
+
+static int polynomial_filter(SCALAR *x, PRIMME_INT ldx, int blockSize,
+      double lo, double hi, double center, int interior, SCALAR *rwork,
+      primme_params *primme);
+
+static int setup_JD_projectors(SCALAR *x, PRIMME_INT ldx, int blockSize,
+      SCALAR *evecs, PRIMME_INT ldevecs, SCALAR *evecsHat,
+      PRIMME_INT ldevecsHat, SCALAR *Kinvx, PRIMME_INT ldKinvx, SCALAR *xKinvx,
       SCALAR **Lprojector, PRIMME_INT *ldLprojector, SCALAR **RprojectorQ,
       PRIMME_INT *ldRprojectorQ, SCALAR **RprojectorX,
-      PRIMME_INT *ldRprojectorX,  int *sizeLprojector, int *sizeRprojectorQ,
-      int *sizeRprojectorX, int numLocked, int numConverged,
-      primme_params *primme);
+      PRIMME_INT *ldRprojectorX, int *sizeLprojectorQ, int *sizeLprojectorX,
+      int *sizeRprojectorQ, int *sizeRprojectorX, int numLocked,
+      int numConverged, SCALAR *rwork, primme_params *primme);
 
 
 /*******************************************************************************
  * Subroutine solve_correction - This routine solves the correction equation
- *    for each Ritz vector and residual in the block.
+ *    for each Ritz vector and residual in the block. JDQMR solves all the
+ *    correction equations of the block together.
  *
  * INPUT ARRAYS AND PARAMETERS
  * ---------------------------
  * W              The last blockSize vectors of W contain the residuals
  *
+ * BV             For the generalized problem, the last blockSize vectors
+ *                of BV contain B times the Ritz vectors; otherwise NULL.
+ *                Only supported without inner iterations
+ *
  * evecs          The converged Ritz vectors.  Array is of dimension numLocked.
  *
  * evecsHat       K^{-1}evecs given a preconditioner K. 
@@ -105,11 +120,13 @@ static int setup_JD_projectors(SCALAR *x, SCALAR *evecs, PRIMME_INT ldevecs,
  * rwork          Real workspace of size          
  *                3*maxEvecsSize + 2*primme->maxBlockSize 
  *                + (primme->numEvals+primme->maxBasisSize)
+ *                + 3*primme->ldOPs*primme->maxBlockSize  if filterDegree > 0
  *                        *----------------------------------------------------*
  *                        | The following are optional and mutually exclusive: |
  *                        *------------------------------+                     |
- *                + 4*primme->nLocal + primme->nLocal    | For QMR work and sol|
- *                + primme->nLocal*primme->maxBlockSize  | OLSEN for Kinvx     |
+ *                + inner_solve workspace                | For QMR work and sol|
+ *                + primme->ldOPs*primme->maxBlockSize   | for all the block   |
+ *                + primme->ldOPs*primme->maxBlockSize   | OLSEN for Kinvx     |
  *                                                       *---------------------*
  *
  * rworkSize      the size of rwork. If less than needed, func returns needed.
@@ -146,7 +163,7 @@ static int setup_JD_projectors(SCALAR *x, SCALAR *evecs, PRIMME_INT ldevecs,
  
 TEMPLATE_PLEASE
 int solve_correction_Sprimme(SCALAR *V, PRIMME_INT ldV, SCALAR *W,
-      PRIMME_INT ldW, SCALAR *evecs, PRIMME_INT ldevecs, SCALAR *evecsHat,
+      PRIMME_INT ldW, SCALAR *BV, SCALAR *evecs, PRIMME_INT ldevecs, SCALAR *evecsHat,
       PRIMME_INT ldevecsHat, SCALAR *UDU, int *ipivot, REAL *lockedEvals, 
       int numLocked, int numConvergedStored, REAL *ritzVals, 
       REAL *prevRitzVals, int *numPrevRitzVals, int *flags, int basisSize, 
@@ -164,16 +181,19 @@ int solve_correction_Sprimme(SCALAR *V, PRIMME_INT ldV, SCALAR *W,
    int *ilev;              /* Array of size blockSize.  Maps the target Ritz */
                            /* values to their positions in the sortedEvals   */
                            /* array.                                         */
-   int sizeLprojector;     /* Sizes of the various left/right projectors     */
-   int sizeRprojectorQ;    /* These will be 0/1/or numOrthConstr+numLocked   */
-   int sizeRprojectorX;    /* or numOrthConstr+numConvergedStored w/o locking*/
+   int sizeLprojectorQ;    /* Sizes of the various left/right projectors     */
+   int sizeLprojectorX;    /* These will be 0/1/or numOrthConstr+numLocked   */
+   int sizeRprojectorQ;    /* or numOrthConstr+numConvergedStored w/o locking*/
+   int sizeRprojectorX;
 
    SCALAR *r, *x, *sol;  /* Residual, Ritz vector, and correction.         */
+   SCALAR *Bx;           /* B*x for the generalized problem, x otherwise.  */
    SCALAR *linSolverRWork;/* Workspace needed by linear solver.            */
    REAL *sortedRitzVals; /* Sorted array of current and converged Ritz     */
                            /* values.  Size of array is numLocked+basisSize. */
    double *blockOfShifts;  /* Shifts for (A-shiftI) or (if needed) (K-shiftI)*/
    REAL *approxOlsenEps; /* Shifts for approximate Olsen implementation    */
+   REAL *blockOfEvals;   /* Ritz values of the block vectors               */
    SCALAR *Kinvx;         /* Workspace to store K^{-1}x                     */
    SCALAR *Lprojector;   /* Q pointer for (I-Q*Q'). Usually points to evecs*/
    SCALAR *RprojectorQ;  /* May point to evecs/evecsHat depending on skewQ */
@@ -181,10 +201,12 @@ int solve_correction_Sprimme(SCALAR *V, PRIMME_INT ldV, SCALAR *W,
    PRIMME_INT ldLprojector;  /* The leading dimension of Lprojector     */
    PRIMME_INT ldRprojectorQ; /* The leading dimension of RprojectorQ    */
    PRIMME_INT ldRprojectorX; /* The leading dimension of RprojectorL    */
+   SCALAR *filterWork;   /* Workspace for the polynomial filter            */
+   double filterLo, filterHi, filterCenter; /* Filter interval and target  */
 
 
-   SCALAR xKinvx;                        /* Stores x'*K^{-1}x if needed    */
-   REAL eval, shift, robustShift;       /* robust shift values.           */
+   SCALAR *xKinvx;                       /* Stores x'*K^{-1}x if needed    */
+   REAL eval, robustShift;               /* robust shift values.           */
 
    /*------------------------------------------------------------*/
    /* Subdivide the workspace with pointers, and figure out      */
@@ -193,42 +215,50 @@ int solve_correction_Sprimme(SCALAR *V, PRIMME_INT ldV, SCALAR *W,
 
    /* needed worksize */
    neededRsize = 0;
-   Kinvx       = rwork;
+   filterWork  = rwork;
+   if (primme->correctionParams.filterDegree > 0) {
+      Kinvx = filterWork + 3*primme->ldOPs*blockSize;
+      neededRsize = neededRsize + 3*primme->ldOPs*blockSize;
+   }
+   else {
+      Kinvx = filterWork + 0;
+   }
    /* Kinvx will have nonzero size if precond and both RightX and SkewX */
+   /* Both OLSEN's method and JDQMR process the whole block at once     */
    if (primme->correctionParams.projectors.RightX &&  
        primme->correctionParams.projectors.SkewX ) { 
 
-      /* OLSEN's method requires a block, but JDQMR is vector by vector */
-      if (primme->correctionParams.maxInnerIterations == 0) {    
-         sol = Kinvx + primme->ldOPs*blockSize;
-         neededRsize = neededRsize + primme->ldOPs*blockSize;
-      }
-      else {
-         sol = Kinvx + primme->nLocal;
-         neededRsize = neededRsize + primme->nLocal;
-      }
+      sol = Kinvx + primme->ldOPs*blockSize;
+      neededRsize = neededRsize + primme->ldOPs*blockSize;
    }
    else {
       sol = Kinvx + 0;
    }
    if (primme->correctionParams.maxInnerIterations == 0) {    
-      linSolverRWork = sol + 0;                   /* sol not needed for GD */
+      xKinvx = sol + 0;                           /* sol not needed for GD */
+      linSolverRWork = sol + 0;
       linSolverRWorkSize = 0;                     /* No inner solver used  */
    }
    else {
-      linSolverRWork = sol + primme->nLocal;      /* sol needed in innerJD */
-      neededRsize = neededRsize + primme->nLocal;
-      linSolverRWorkSize =                        /* Inner solver worksize */
-              4*primme->nLocal + 2*(primme->numOrthoConst+primme->numEvals);
+      xKinvx = sol + primme->ldOPs*blockSize;     /* sol needed in innerJD */
+      linSolverRWork = xKinvx + blockSize;
+      neededRsize = neededRsize + primme->ldOPs*blockSize + blockSize;
+      linSolverRWorkSize = 0;                     /* Inner solver worksize */
+      CHKERR(inner_solve_Sprimme(blockSize, NULL, 0, NULL, 0, NULL, NULL, 0,
+               NULL, NULL, NULL, NULL, 0, NULL, 0, NULL, 0,
+               primme->numOrthoConst+primme->numEvals, 1,
+               primme->numOrthoConst+primme->numEvals, 1, NULL, 0, NULL, NULL,
+               0.0, NULL, &linSolverRWorkSize, primme), -1);
       neededRsize = neededRsize + linSolverRWorkSize;
    }
    sortedRitzVals = (REAL *)(linSolverRWork + linSolverRWorkSize);
    #define ALIGN(ptr,T) (((uintptr_t)(ptr)+sizeof(T)-1) & -sizeof(T))
    blockOfShifts  = (double*)ALIGN(sortedRitzVals + (numLocked+basisSize), double);
    approxOlsenEps = (REAL*)ALIGN(blockOfShifts  + blockSize, REAL);
+   blockOfEvals   = approxOlsenEps + blockSize;
    #undef ALIGN
    neededRsize = neededRsize + numLocked+basisSize
-      + blockSize*(1+sizeof(double)/sizeof(REAL)) + 2;
+      + blockSize*(2+sizeof(double)/sizeof(REAL)) + 2;
 
    /* Return memory requirements */
    if (V == NULL) {
@@ -379,6 +409,22 @@ int solve_correction_Sprimme(SCALAR *V, PRIMME_INT ldV, SCALAR *W,
 
    primme->ShiftsForPreconditioner = blockOfShifts;
 
+   /*------------------------------------------------------------ */
+   /*  Polynomial filter -- the corrections are p(A) times the     */
+   /*  Ritz vectors. Use the other variants while the estimated    */
+   /*  spectrum is too narrow to build the filter.                 */
+   /*------------------------------------------------------------ */
+   if (primme->correctionParams.filterDegree > 0 &&
+         filter_interval(ritzVals, basisSize, iev, blockSize, numLocked,
+            &filterLo, &filterHi, &filterCenter, primme)) {
+
+      CHKERR(polynomial_filter(&V[ldV*basisSize], ldV, blockSize, filterLo,
+               filterHi, filterCenter,
+               primme->target != primme_smallest &&
+               primme->target != primme_largest, filterWork, primme), -1);
+      return 0;
+   }
+
    /*------------------------------------------------------------ */
    /*  Generalized Davidson variants -- No inner iterations       */
    /*------------------------------------------------------------ */
@@ -388,13 +434,20 @@ int solve_correction_Sprimme(SCALAR *V, PRIMME_INT ldV, SCALAR *W,
       
       r = &W[ldW*basisSize];    /* All the block residuals    */
       x = &V[ldV*basisSize];    /* All the block Ritz vectors */
+
+      /* For the generalized problem the projectors are built with B*x,  */
+      /* the residuals are orthogonal to x and not to B*x                */
+
+      Bx = BV ? &BV[ldV*basisSize] : x;
       
       if ( primme->correctionParams.projectors.RightX &&
            primme->correctionParams.projectors.SkewX    ) {    
            /* Compute exact Olsen's projected preconditioner. This is */
           /* expensive and rarely improves anything! Included for completeness*/
           
-          Olsen_preconditioner_block(r, ldW, x, ldV, blockSize, Kinvx, primme);
+          Olsen_preconditioner_block(r, ldW, Bx, ldV, blockSize, Kinvx, primme);
+          if (BV) Num_copy_matrix_Sprimme(Bx, primme->nLocal, blockSize, ldV,
+                x, ldV);
       }
       else {
          if ( primme->correctionParams.projectors.RightX ) {   
@@ -402,9 +455,9 @@ int solve_correction_Sprimme(SCALAR *V, PRIMME_INT ldV, SCALAR *W,
             /*is approximated by e: Kinvr-e*Kinvx=Kinv(r-e*x)=Kinv(I-ct*x*x')r*/
 
             for (blockIndex = 0; blockIndex < blockSize; blockIndex++) {
-               /* Compute r_i = r_i - err_i * x_i */
+               /* Compute r_i = r_i - err_i * Bx_i */
                Num_axpy_Sprimme(primme->nLocal, -approxOlsenEps[blockIndex],
-               &x[ldV*blockIndex],1,&r[ldW*blockIndex],1);
+               &Bx[ldV*blockIndex],1,&r[ldW*blockIndex],1);
             } /* for */
          }
 
@@ -419,43 +472,40 @@ int solve_correction_Sprimme(SCALAR *V, PRIMME_INT ldV, SCALAR *W,
    /* ------------------------------------------------------------ */
    else {  /* maxInnerIterations > 0  We perform inner-outer JDQMR */
 
-      /* Solve the correction for each block vector. */
-
-      for (blockIndex = 0; blockIndex < blockSize; blockIndex++) {
+      /* Solve the correction for all block vectors at once. */
 
-         r = &W[ldW*(basisSize+blockIndex)];
-         x = &V[ldV*(basisSize+blockIndex)];
+      r = &W[ldW*basisSize];    /* All the block residuals    */
+      x = &V[ldV*basisSize];    /* All the block Ritz vectors */
 
-         /* Set up the left/right/skew projectors for JDQMR.        */
-         /* The pointers Lprojector, Rprojector(Q/X) point to the   */
-         /* appropriate arrays for use in the projection step       */
+      /* Set up the left/right/skew projectors for JDQMR.        */
+      /* The pointers Lprojector, Rprojector(Q/X) point to the   */
+      /* appropriate arrays for use in the projection step       */
 
-         CHKERR(setup_JD_projectors(x, evecs, ldevecs, evecsHat, ldevecsHat,
-                  Kinvx, &xKinvx, &Lprojector, &ldLprojector, &RprojectorQ,
-                  &ldRprojectorQ, &RprojectorX, &ldRprojectorX, &sizeLprojector,
-                  &sizeRprojectorQ, &sizeRprojectorX, numLocked,
-                  numConvergedStored, primme), -1);
+      CHKERR(setup_JD_projectors(x, ldV, blockSize, evecs, ldevecs, evecsHat,
+               ldevecsHat, Kinvx, primme->ldOPs, xKinvx, &Lprojector,
+               &ldLprojector, &RprojectorQ, &ldRprojectorQ, &RprojectorX,
+               &ldRprojectorX, &sizeLprojectorQ, &sizeLprojectorX,
+               &sizeRprojectorQ, &sizeRprojectorX, numLocked,
+               numConvergedStored, linSolverRWork, primme), -1);
 
-         /* Map the index of the block vector to its corresponding eigenvalue */
-         /* index, and the shift for the correction equation. Also make the   */
-         /* shift available to primme, in case (K-shift I)^-1 is needed       */
+      /* Map the index of each block vector to its corresponding eigenvalue */
 
+      for (blockIndex = 0; blockIndex < blockSize; blockIndex++) {
          ritzIndex = iev[blockIndex];
-         shift = blockOfShifts[blockIndex];
-         primme->ShiftsForPreconditioner = &blockOfShifts[blockIndex];
+         blockOfEvals[blockIndex] = ritzVals[ritzIndex];
+      }
 
-         CHKERR(inner_solve_Sprimme(x, r, &blockNorms[blockIndex], evecs,
-                  ldevecs, UDU, ipivot, &xKinvx,
-                  Lprojector, ldLprojector, RprojectorQ, ldRprojectorQ,
-                  RprojectorX, ldRprojectorX, sizeLprojector, sizeRprojectorQ,
-                  sizeRprojectorX, sol, ritzVals[ritzIndex], shift,
-                  machEps, linSolverRWork, linSolverRWorkSize,
-                  primme), -1);
+      CHKERR(inner_solve_Sprimme(blockSize, x, ldV, r, ldW, blockNorms, evecs,
+               ldevecs, UDU, ipivot, xKinvx, Lprojector, ldLprojector,
+               RprojectorQ, ldRprojectorQ, RprojectorX, ldRprojectorX,
+               sizeLprojectorQ, sizeLprojectorX, sizeRprojectorQ,
+               sizeRprojectorX, sol, primme->ldOPs, blockOfEvals,
+               blockOfShifts, machEps, linSolverRWork, &linSolverRWorkSize,
+               primme), -1);
 
-         Num_copy_Sprimme(primme->nLocal, sol, 1, 
-            &V[ldV*(basisSize+blockIndex)], 1);
+      Num_copy_matrix_Sprimme(sol, primme->nLocal, blockSize, primme->ldOPs,
+            &V[ldV*basisSize], ldV);
 
-      } /* end for each block vector */
    } /* JDqmr variants */
 
    return 0;
@@ -762,11 +812,13 @@ static int Olsen_preconditioner_block(SCALAR *r, PRIMME_INT ldr, SCALAR *x,
  *
  *  INPUT
  *  -----
- *   x                The Ritz vector
+ *   x                The Ritz vectors in the block
+ *   blockSize        The number of vectors in x
  *   evecs            Converged locked eigenvectors (denoted as Q herein)
  *   evecsHat         K^{-1}*evecs
  *   numLocked        Number of locked eigenvectors (if locking)
  *   numConverged     Number of converged e-vectors copied in evecs (no locking)
+ *   rwork            Workspace of size blockSize
  *   primme           The main data structures that contains the choices for
  *
  *       primme->LeftQ  : evecs in the left projector
@@ -779,10 +831,12 @@ static int Olsen_preconditioner_block(SCALAR *r, PRIMME_INT ldr, SCALAR *x,
  *  OUTPUT
  *  ------
  *  *Kinvx            The result of K^{-1}x (if needed, otherwise NULL)
- * **Lprojector       Pointer to the left projector for [Q x] (could be NULL)
+ *  *xKinvx           The values x_i'*K^{-1}x_i (or 1 if not needed)
+ * **Lprojector       Pointer to the left projector for Q (could be NULL)
  * **RprojectorQ      Pointer to the right projector for Q (could be NULL)
  * **RprojectorX      Pointer to the right projector for X (could be NULL)
- *   sizeLprojector   Size of the left projector(numConverged/numLocked)/+1 or 0
+ *   sizeLprojectorQ  Size of the Q left projector (numConverged/numLocked or 0)
+ *   sizeLprojectorX  Size of the X left projector (1 or 0)
  *   sizeRprojectorQ  Size of the Q right projectr (numConverged/numLocked or 0)
  *   sizeRprojectorX  Size of the X right projectr (1 or 0)
  *
@@ -823,26 +877,27 @@ static int Olsen_preconditioner_block(SCALAR *r, PRIMME_INT ldr, SCALAR *x,
  *                    Researchers can experiment with other projection schemes,
  *                    although our experience says they are rarely beneficial
  *
- * The left orthogonal projector for x and Q can be performed as one block
- * containing [Q x]. However, the right projections (if either is skew)
- * are performed separately for Q and x. There are memory reasons for 
+ * The left orthogonal projector for x and Q is performed with a single
+ * global reduction of the overlaps with [Q x]. However, the right
+ * projections (if either is skew) are performed separately for Q and x. There are memory reasons for 
  * doing so, but also we do not have to factor (Q'KQ) at every outer step;
  * only when an eval converges. 
  *
  ******************************************************************************/
 
-static int setup_JD_projectors(SCALAR *x, SCALAR *evecs, PRIMME_INT ldevecs,
-      SCALAR *evecsHat, PRIMME_INT ldevecsHat, SCALAR *Kinvx, SCALAR *xKinvx, 
+static int setup_JD_projectors(SCALAR *x, PRIMME_INT ldx, int blockSize,
+      SCALAR *evecs, PRIMME_INT ldevecs, SCALAR *evecsHat,
+      PRIMME_INT ldevecsHat, SCALAR *Kinvx, PRIMME_INT ldKinvx, SCALAR *xKinvx,
       SCALAR **Lprojector, PRIMME_INT *ldLprojector, SCALAR **RprojectorQ,
       PRIMME_INT *ldRprojectorQ, SCALAR **RprojectorX,
-      PRIMME_INT *ldRprojectorX,  int *sizeLprojector, int *sizeRprojectorQ,
-      int *sizeRprojectorX, int numLocked, int numConverged,
-      primme_params *primme) {
+      PRIMME_INT *ldRprojectorX, int *sizeLprojectorQ, int *sizeLprojectorX,
+      int *sizeRprojectorQ, int *sizeRprojectorX, int numLocked,
+      int numConverged, SCALAR *rwork, primme_params *primme) {
 
-   int n, sizeEvecs;
-   SCALAR xKinvx_local;
+   int i, sizeEvecs;
 
-   *sizeLprojector  = 0;
+   *sizeLprojectorQ = 0;
+   *sizeLprojectorX = 0;
    *sizeRprojectorQ = 0;
    *sizeRprojectorX = 0;
    *ldLprojector  = 0;
@@ -852,32 +907,24 @@ static int setup_JD_projectors(SCALAR *x, SCALAR *evecs, PRIMME_INT ldevecs,
    *RprojectorQ = NULL;
    *RprojectorX = NULL;
 
-   n = primme->nLocal;
    if (primme->locking) 
       sizeEvecs = primme->numOrthoConst+numLocked;
    else
       sizeEvecs = primme->numOrthoConst+numConverged;
    
    /* --------------------------------------------------------*/
-   /* Set up the left projector arrays. Make x adjacent to Q. */
+   /* Set up the left projector arrays. x is applied together */
+   /* with Q.                                                 */
    /* --------------------------------------------------------*/
    
    if (primme->correctionParams.projectors.LeftQ) {
    
-         *sizeLprojector = sizeEvecs;
+         *sizeLprojectorQ = sizeEvecs;
          *Lprojector = evecs;
          *ldLprojector = ldevecs;
-         if (primme->correctionParams.projectors.LeftX) {
-            Num_copy_Sprimme(n, x, 1, &evecs[sizeEvecs*ldevecs], 1);
-            *sizeLprojector = *sizeLprojector + 1;
-         }
    }
-   else {
-      if (primme->correctionParams.projectors.LeftX) {
-         *Lprojector = x;
-         *ldLprojector = n;
-         *sizeLprojector = 1;
-      }
+   if (primme->correctionParams.projectors.LeftX) {
+      *sizeLprojectorX = 1;
    }
       
    /* --------------------------------------------------------*/
@@ -914,26 +961,210 @@ static int setup_JD_projectors(SCALAR *x, SCALAR *evecs, PRIMME_INT ldevecs,
    
       if (primme->correctionParams.precondition   &&
           primme->correctionParams.projectors.SkewX) {
-         CHKERR(applyPreconditioner_Sprimme(x, primme->nLocal, primme->nLocal,
-                  Kinvx, primme->nLocal, 1, primme), -1);
-         primme->stats.numPreconds += 1;
+         CHKERR(applyPreconditioner_Sprimme(x, primme->nLocal, ldx,
+                  Kinvx, ldKinvx, blockSize, primme), -1);
          *RprojectorX  = Kinvx;
-         xKinvx_local = Num_dot_Sprimme(primme->nLocal, x, 1, Kinvx, 1);
-         CHKERR(globalSum_Sprimme(&xKinvx_local, xKinvx, 1, primme), -1);
+         *ldRprojectorX  = ldKinvx;
+         for (i=0; i<blockSize; i++) {
+            rwork[i] = Num_dot_Sprimme(primme->nLocal, &x[ldx*i], 1,
+                  &Kinvx[ldKinvx*i], 1);
+         }
+         CHKERR(globalSum_Sprimme(rwork, xKinvx, blockSize, primme), -1);
       }      
       else {
          *RprojectorX = x;
-         *xKinvx = 1.0;
+         *ldRprojectorX  = ldx;
+         for (i=0; i<blockSize; i++) xKinvx[i] = 1.0;
       }
       *sizeRprojectorX = 1;
-      *ldRprojectorX  = n;
    }
    else { 
          *RprojectorX = NULL;
          *sizeRprojectorX = 0;
-         *xKinvx = 1.0;
+         for (i=0; i<blockSize; i++) xKinvx[i] = 1.0;
    }
 
    return 0;
 
 } /* setup_JD_projectors */
+
+/*******************************************************************************
+ * Function filter_interval - Sets the interval that the polynomial filter
+ *    damps and the point where the filter is normalized or peaks, from the
+ *    spectral bounds estimated so far (stats.estimateMinEVal and
+ *    stats.estimateMaxEVal) and the current Ritz values.
+ *
+ *    For primme_smallest the damped interval goes from the median of the
+ *    Ritz values (or the largest Ritz value in the block, if larger) to
+ *    estimateMaxEVal, and the filter is one at estimateMinEVal; primme_largest
+ *    is symmetric. For interior targets the interval is the whole estimated
+ *    spectrum and the filter peaks at the current target shift. The ends
+ *    of the spectrum are enlarged by 1% of its width, because the estimates
+ *    come from Ritz values and they are inside the true spectrum.
+ *
+ * INPUT PARAMETERS
+ * ----------------
+ * ritzVals    The Ritz values, sorted as primme.target
+ * basisSize   The number of Ritz values
+ * iev         The indices in ritzVals of the block vectors
+ * blockSize   The number of vectors in the block
+ * numLocked   The number of locked pairs
+ *
+ * OUTPUT PARAMETERS
+ * -----------------
+ * lo, hi      The interval damped by the filter
+ * center      The point where the filter is one or peaks
+ *
+ * Return Value
+ * ------------
+ * int  1 if the interval is valid, 0 otherwise (e.g., for primme_largest_abs
+ *      or before the estimated spectrum has a nonzero width)
+ ******************************************************************************/
+
+static int filter_interval(REAL *ritzVals, int basisSize, int *iev,
+      int blockSize, int numLocked, double *lo, double *hi, double *center,
+      primme_params *primme) {
+
+   int i;
+   double minEVal, maxEVal, margin;
+
+   minEVal = primme->stats.estimateMinEVal;
+   maxEVal = primme->stats.estimateMaxEVal;
+   if (!(minEVal < maxEVal) || basisSize < 2) return 0;
+   margin = (maxEVal - minEVal)*.01;
+
+   switch(primme->target) {
+   case primme_smallest:
+      *lo = ritzVals[basisSize/2];
+      for (i=0; i<blockSize; i++) *lo = max(*lo, ritzVals[iev[i]]);
+      *hi = maxEVal + margin;
+      *center = minEVal;
+      return *center < *lo && *lo < *hi;
+
+   case primme_largest:
+      *lo = minEVal - margin;
+      *hi = ritzVals[basisSize/2];
+      for (i=0; i<blockSize; i++) *hi = min(*hi, ritzVals[iev[i]]);
+      *center = maxEVal;
+      return *lo < *hi && *hi < *center;
+
+   case primme_closest_geq:
+   case primme_closest_leq:
+   case primme_closest_abs:
+      *lo = minEVal - margin;
+      *hi = maxEVal + margin;
+      *center = primme->targetShifts[
+         min(primme->numTargetShifts-1, numLocked)];
+      return 1;
+
+   default:
+      return 0;
+   }
+}
+
+/*******************************************************************************
+ * Subroutine polynomial_filter - Replaces the block vectors x by p(A)*x,
+ *    where p is a polynomial of degree primme.correctionParams.filterDegree.
+ *
+ *    If interior is zero, p is the Chebyshev polynomial on [lo,hi] scaled so
+ *    that p(center) = 1, computed with the three-term recurrence of Zhou
+ *    and Saad that avoids overflow. Otherwise p is the Chebyshev expansion
+ *    of a Dirac delta at center with Jackson damping, which peaks at center
+ *    without the oscillations (Gibbs effect) of the plain truncated series.
+ *
+ *    The products with A are done on the whole block and they are counted
+ *    in primme.stats.numMatvecs.
+ *
+ * INPUT PARAMETERS
+ * ----------------
+ * ldx        The leading dimension of x
+ * blockSize  The number of vectors in x
+ * lo, hi     The interval mapped onto [-1,1]
+ * center     The point where p is one (interior == 0) or peaks
+ * interior   Whether to use the damped delta expansion
+ * rwork      SCALAR work array of size 3*primme.ldOPs*blockSize
+ *
+ * INPUT/OUTPUT ARRAYS
+ * -------------------
+ * x          The vectors to filter
+ *
+ * Return Value
+ * ------------
+ * int  Error code: 0 upon success, -1 if a matrix-vector product failed
+ ******************************************************************************/
+
+static int polynomial_filter(SCALAR *x, PRIMME_INT ldx, int blockSize,
+      double lo, double hi, double center, int interior, SCALAR *rwork,
+      primme_params *primme) {
+
+   int i, k, m = primme->correctionParams.filterDegree;
+   PRIMME_INT nLocal = primme->nLocal, ldw = primme->ldOPs;
+   SCALAR *prev, *cur, *next, *aux;  /* T_{k-1}(A)*x, T_k(A)*x, T_{k+1}(A)*x */
+   double e, c;             /* Half width and center of [lo,hi]            */
+   double sigma1, sigma, sigmaNew; /* Scaling factors of the recurrence    */
+   double pi, theta=0.0, coef;
+
+   prev = rwork;
+   cur = prev + ldw*blockSize;
+   next = cur + ldw*blockSize;
+   e = (hi - lo)/2.0;
+   c = (hi + lo)/2.0;
+   pi = acos(-1.0);
+
+   /* For the delta expansion the recurrence is not scaled, and the       */
+   /* coefficient of T_k is 2*cos(k*theta) times the Jackson damping      */
+   /* g_k = ((m+2-k)cos(pi*k/(m+2)) + sin(pi*k/(m+2))cot(pi/(m+2)))/(m+2) */
+
+   if (interior) {
+      sigma1 = 1.0;
+      theta = acos(max(-1.0, min(1.0, (center - c)/e)));
+   }
+   else {
+      sigma1 = e/(center - c);
+   }
+   sigma = sigma1;
+
+   /* prev = x; cur = sigma1/e*(A - c*I)*x */
+
+   Num_copy_matrix_Sprimme(x, nLocal, blockSize, ldx, prev, ldw);
+   CHKERR(matrixMatvec_Sprimme(prev, nLocal, ldw, cur, ldw, 0, blockSize,
+            primme), -1);
+   for (i=0; i<blockSize; i++) {
+      Num_axpy_Sprimme(nLocal, -c, &prev[ldw*i], 1, &cur[ldw*i], 1);
+      Num_scal_Sprimme(nLocal, sigma1/e, &cur[ldw*i], 1);
+   }
+
+   for (k=1; k<=m; k++) {
+
+      /* x += coef_k*T_k(A)*x for the delta expansion (T_0 term is x) */
+
+      if (interior) {
+         coef = 2.0*cos(k*theta)*((m+2-k)*cos(pi*k/(m+2))
+               + sin(pi*k/(m+2))/tan(pi/(m+2)))/(m+2);
+         for (i=0; i<blockSize; i++) {
+            Num_axpy_Sprimme(nLocal, coef, &cur[ldw*i], 1, &x[ldx*i], 1);
+         }
+      }
+      if (k == m) break;
+
+      /* next = 2*sigmaNew/e*(A - c*I)*cur - sigma*sigmaNew*prev */
+
+      sigmaNew = 1.0/(2.0/sigma1 - sigma);
+      CHKERR(matrixMatvec_Sprimme(cur, nLocal, ldw, next, ldw, 0, blockSize,
+               primme), -1);
+      for (i=0; i<blockSize; i++) {
+         Num_axpy_Sprimme(nLocal, -c, &cur[ldw*i], 1, &next[ldw*i], 1);
+         Num_scal_Sprimme(nLocal, 2.0*sigmaNew/e, &next[ldw*i], 1);
+         Num_axpy_Sprimme(nLocal, -sigma*sigmaNew, &prev[ldw*i], 1,
+               &next[ldw*i], 1);
+      }
+      aux = prev; prev = cur; cur = next; next = aux;
+      sigma = sigmaNew;
+   }
+
+   if (!interior) {
+      Num_copy_matrix_Sprimme(cur, nLocal, blockSize, ldw, x, ldx);
+   }
+
+   return 0;
+}
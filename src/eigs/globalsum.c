@@ -29,7 +29,8 @@
  **********************************************************************
  * File: globalsum.c
  *
- * Purpose - Wrappers around primme->globalSumDouble
+ * Purpose - Wrappers around primme->globalSumReal and the split-phase
+ *           primme->globalSumRealStart/globalSumRealWait
  *
  ******************************************************************************/
 
@@ -44,8 +45,11 @@ int globalSum_Sprimme(SCALAR *sendBuf, SCALAR *recvBuf, int count,
    int ierr;
    double t0=0.0;
 
+   /* Count the reductions also when running on a single process */
+   if (primme) primme->stats.numGlobalSum++;
+
    if (primme && primme->globalSumReal) {
-      t0 = primme_wTimer(0);
+      t0 = primme_get_wtime();
 
       /* If it is a complex type, count real and imaginary part */
 #ifdef USE_COMPLEX
@@ -55,7 +59,7 @@ int globalSum_Sprimme(SCALAR *sendBuf, SCALAR *recvBuf, int count,
                ierr), -1,
             "Error returned by 'globalSumReal' %d", ierr);
 
-      primme->stats.timeGlobalSum += primme_wTimer(0) - t0;
+      primme->stats.timeGlobalSum += primme_get_wtime() - t0;
       primme->stats.volumeGlobalSum += count;
    }
    else {
@@ -64,3 +68,75 @@ int globalSum_Sprimme(SCALAR *sendBuf, SCALAR *recvBuf, int count,
 
    return 0;
 }
+
+/*******************************************************************************
+ * Function globalSumStart - Starts the reduction of sendBuf into recvBuf
+ *    with primme->globalSumRealStart, so that local work can be done while the
+ *    reduction is in flight. The buffers must not be accessed until
+ *    globalSumWait is called with the returned request.
+ *
+ *    If the split-phase functions are not set, it calls globalSum and the
+ *    reduction is completed on return.
+ *
+ * Output Parameters
+ * -----------------
+ * request  Handle to pass to globalSumWait; NULL if the reduction has been
+ *          completed already
+ *
+ ******************************************************************************/
+
+TEMPLATE_PLEASE
+int globalSumStart_Sprimme(SCALAR *sendBuf, SCALAR *recvBuf, int count, 
+      void **request, primme_params *primme) {
+
+   int ierr;
+   double t0=0.0;
+
+   *request = NULL;
+
+   if (primme && primme->globalSumRealStart && primme->globalSumRealWait) {
+      t0 = primme_get_wtime();
+      primme->stats.numGlobalSum++;
+
+      /* If it is a complex type, count real and imaginary part */
+#ifdef USE_COMPLEX
+      count *= 2;
+#endif
+      CHKERRM((primme->globalSumRealStart(sendBuf, recvBuf, &count, primme,
+                  request, &ierr), ierr), -1,
+            "Error returned by 'globalSumRealStart' %d", ierr);
+
+      primme->stats.timeGlobalSum += primme_get_wtime() - t0;
+      primme->stats.volumeGlobalSum += count;
+   }
+   else {
+      CHKERR(globalSum_Sprimme(sendBuf, recvBuf, count, primme), -1);
+   }
+
+   return 0;
+}
+
+/*******************************************************************************
+ * Function globalSumWait - Completes a reduction started by globalSumStart
+ *
+ * Input Parameters
+ * ----------------
+ * request  The handle returned by globalSumStart
+ *
+ ******************************************************************************/
+
+TEMPLATE_PLEASE
+int globalSumWait_Sprimme(void *request, primme_params *primme) {
+
+   int ierr;
+   double t0=0.0;
+
+   if (request == NULL) return 0;
+
+   t0 = primme_get_wtime();
+   CHKERRM((primme->globalSumRealWait(request, primme, &ierr), ierr), -1,
+         "Error returned by 'globalSumRealWait' %d", ierr);
+   primme->stats.timeGlobalSum += primme_get_wtime() - t0;
+
+   return 0;
+}
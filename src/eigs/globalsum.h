@@ -41,10 +41,34 @@
 #endif
 int globalSum_dprimme(double *sendBuf, double *recvBuf, int count,
       primme_params *primme);
+#if !defined(CHECK_TEMPLATE) && !defined(globalSumStart_Sprimme)
+#  define globalSumStart_Sprimme CONCAT(globalSumStart_,SCALAR_SUF)
+#endif
+#if !defined(CHECK_TEMPLATE) && !defined(globalSumStart_Rprimme)
+#  define globalSumStart_Rprimme CONCAT(globalSumStart_,REAL_SUF)
+#endif
+int globalSumStart_dprimme(double *sendBuf, double *recvBuf, int count,
+      void **request, primme_params *primme);
+#if !defined(CHECK_TEMPLATE) && !defined(globalSumWait_Sprimme)
+#  define globalSumWait_Sprimme CONCAT(globalSumWait_,SCALAR_SUF)
+#endif
+#if !defined(CHECK_TEMPLATE) && !defined(globalSumWait_Rprimme)
+#  define globalSumWait_Rprimme CONCAT(globalSumWait_,REAL_SUF)
+#endif
+int globalSumWait_dprimme(void *request, primme_params *primme);
 int globalSum_zprimme(PRIMME_COMPLEX_DOUBLE *sendBuf, PRIMME_COMPLEX_DOUBLE *recvBuf, int count,
       primme_params *primme);
+int globalSumStart_zprimme(PRIMME_COMPLEX_DOUBLE *sendBuf, PRIMME_COMPLEX_DOUBLE *recvBuf, int count,
+      void **request, primme_params *primme);
+int globalSumWait_zprimme(void *request, primme_params *primme);
 int globalSum_sprimme(float *sendBuf, float *recvBuf, int count,
       primme_params *primme);
+int globalSumStart_sprimme(float *sendBuf, float *recvBuf, int count,
+      void **request, primme_params *primme);
+int globalSumWait_sprimme(void *request, primme_params *primme);
 int globalSum_cprimme(PRIMME_COMPLEX_FLOAT *sendBuf, PRIMME_COMPLEX_FLOAT *recvBuf, int count,
       primme_params *primme);
+int globalSumStart_cprimme(PRIMME_COMPLEX_FLOAT *sendBuf, PRIMME_COMPLEX_FLOAT *recvBuf, int count,
+      void **request, primme_params *primme);
+int globalSumWait_cprimme(void *request, primme_params *primme);
 #endif
@@ -46,8 +46,14 @@
 #include "auxiliary_eigs.h"
 #include "wtime.h"                       /* Needed for CostModel */
 
+#ifdef USE_COMPLEX
+#  define WARM_START_TYPE_SIZE (-(int)sizeof(SCALAR))
+#else
+#  define WARM_START_TYPE_SIZE ((int)sizeof(SCALAR))
+#endif
+
 static int init_block_krylov(SCALAR *V, PRIMME_INT nLocal, PRIMME_INT ldV,
-      SCALAR *W, PRIMME_INT ldW, int dv1, int dv2, SCALAR *locked,
+      SCALAR *W, PRIMME_INT ldW, SCALAR *BV, int dv1, int dv2, SCALAR *locked,
       PRIMME_INT ldlocked, int numLocked, double machEps, SCALAR *rwork,
       size_t *rworkSize, primme_params *primme);
 
@@ -73,6 +79,11 @@ static int init_block_krylov(SCALAR *V, PRIMME_INT nLocal, PRIMME_INT ldV,
  *          A Krylov subspace of dimension restartSize - initSize vectors
  *          is created so that restartSize initial vectors will be available.
  * 
+ *  III. primme.warmStart is set and the previous call kept its basis in
+ *       primme.warmStartState. Up to minRestartSize of the kept vectors are
+ *       used instead of the initial guesses, as in case II, and W is
+ *       recomputed with the current matrix.
+ *
  *
  * INPUT ARRAYS AND PARAMETERS
  * ---------------------------
@@ -109,6 +120,9 @@ static int init_block_krylov(SCALAR *V, PRIMME_INT nLocal, PRIMME_INT ldV,
  *
  * W            A*V
  *
+ * BV           B*V for the generalized problem, or NULL. Then V is
+ *              B-orthonormal
+ *
  * evecsHat     K^{-1}*evecs, given a preconditioner K
  *
  * M            evecs'*evecsHat.  Its dimension is as large as 
@@ -125,7 +139,7 @@ static int init_block_krylov(SCALAR *V, PRIMME_INT nLocal, PRIMME_INT ldV,
 
 TEMPLATE_PLEASE
 int init_basis_Sprimme(SCALAR *V, PRIMME_INT nLocal, PRIMME_INT ldV,
-      SCALAR *W, PRIMME_INT ldW, SCALAR *evecs, PRIMME_INT ldevecs,
+      SCALAR *W, PRIMME_INT ldW, SCALAR *BV, SCALAR *evecs, PRIMME_INT ldevecs,
       SCALAR *evecsHat, PRIMME_INT ldevecsHat, SCALAR *M, int ldM, SCALAR *UDU,
       int ldUDU, int *ipivot, double machEps, SCALAR *rwork, size_t *rworkSize,
       int *basisSize, int *nextGuess, int *numGuesses, primme_params *primme) {
@@ -133,6 +147,7 @@ int init_basis_Sprimme(SCALAR *V, PRIMME_INT nLocal, PRIMME_INT ldV,
    int i;
    int initSize;
    int random;
+   primme_warm_start *warm;    /* Basis kept by the previous call */
 
    /* Return memory requirement */
 
@@ -147,6 +162,8 @@ int init_basis_Sprimme(SCALAR *V, PRIMME_INT nLocal, PRIMME_INT ldV,
       ortho_Sprimme(NULL, 0, NULL, 0, 0, *basisSize-1, 
             NULL, 0, primme->numOrthoConst, nLocal, 
             NULL, 0.0, NULL, rworkSize, primme);
+      Bortho_Sprimme(NULL, 0, NULL, 0, 0, *basisSize-1, NULL, 0, NULL, 0, 0,
+            nLocal, NULL, 0.0, NULL, rworkSize, primme);
       return 0;
    }
 
@@ -184,20 +201,41 @@ int init_basis_Sprimme(SCALAR *V, PRIMME_INT nLocal, PRIMME_INT ldV,
    }  /* if numOrthoCont >0 */
 
 
+   /* Start from the basis kept by the previous call if warmStart is set */
+   /* and the basis is compatible; then the initial guesses are ignored  */
+
+   warm = primme->warmStart ? primme->warmStartState : NULL;
+   if (warm && (warm->type != WARM_START_TYPE_SIZE || warm->nLocal != nLocal
+            || warm->basisSize <= 0)) {
+      warm = NULL;
+   }
+
+   if (warm) {
+      /* Leave room to expand the basis, as after a restart */
+      initSize = min(primme->minRestartSize, warm->basisSize);
+      *numGuesses = 0;
+      *nextGuess = primme->numOrthoConst;
+
+      Num_copy_matrix_Sprimme((SCALAR*)warm->V, nLocal, initSize, nLocal, V,
+            ldV);
+   }
+
    /* Handle case when some or all initial guesses are provided by */ 
    /* the user                                                     */
-   if (!primme->locking) {
-      initSize = min(primme->maxBasisSize, primme->initSize);
-   }
    else {
-      initSize = min(primme->minRestartSize, primme->initSize);
-   }
-   *numGuesses = primme->initSize - initSize;
-   *nextGuess = primme->numOrthoConst + initSize;
+      if (!primme->locking) {
+         initSize = min(primme->maxBasisSize, primme->initSize);
+      }
+      else {
+         initSize = min(primme->minRestartSize, primme->initSize);
+      }
+      *numGuesses = primme->initSize - initSize;
+      *nextGuess = primme->numOrthoConst + initSize;
 
-   /* Copy over the initial guesses provided by the user */
-   Num_copy_matrix_Sprimme(&evecs[primme->numOrthoConst*ldevecs],
-         nLocal, initSize, ldevecs, V, ldV);
+      /* Copy over the initial guesses provided by the user */
+      Num_copy_matrix_Sprimme(&evecs[primme->numOrthoConst*ldevecs],
+            nLocal, initSize, ldevecs, V, ldV);
+   }
 
    switch(primme->initBasisMode) {
    case primme_init_krylov:
@@ -219,15 +257,23 @@ int init_basis_Sprimme(SCALAR *V, PRIMME_INT nLocal, PRIMME_INT ldV,
    *basisSize = initSize + random;
 
    /* Orthonormalize the guesses provided by the user */ 
-   CHKERR(ortho_Sprimme(V, ldV, NULL, 0, 0, *basisSize-1, 
-         evecs, ldevecs, primme->numOrthoConst, nLocal, 
-         primme->iseed, machEps, rwork, rworkSize, primme), -1)
+   if (BV) {
+      CHKERR(Bortho_Sprimme(V, ldV, BV, ldV, 0, *basisSize-1, NULL, 0, NULL,
+               0, 0, nLocal, primme->iseed, machEps, rwork, rworkSize, primme),
+            -1);
+   }
+   else {
+      CHKERR(ortho_Sprimme(V, ldV, NULL, 0, 0, *basisSize-1, 
+            evecs, ldevecs, primme->numOrthoConst, nLocal, 
+            primme->iseed, machEps, rwork, rworkSize, primme), -1)
+   }
 
    CHKERR(matrixMatvec_Sprimme(V, nLocal, ldV, W, ldW, 0, *basisSize,
             primme), -1);
 
-   if (primme->initBasisMode == primme_init_krylov) {
-      CHKERR(init_block_krylov(V, nLocal, ldV, W, ldW, *basisSize,
+   if (primme->initBasisMode == primme_init_krylov
+         && *basisSize < primme->minRestartSize) {
+      CHKERR(init_block_krylov(V, nLocal, ldV, W, ldW, BV, *basisSize,
             primme->minRestartSize-1, evecs, ldevecs, primme->numOrthoConst,
             machEps, rwork, rworkSize, primme), -1); 
 
@@ -238,6 +284,70 @@ int init_basis_Sprimme(SCALAR *V, PRIMME_INT nLocal, PRIMME_INT ldV,
 }
 
 
+/*******************************************************************************
+ * Subroutine save_warm_start - Keeps a copy of the final basis in
+ *    primme.warmStartState for the next call, if primme.warmStart is set.
+ *    The kept basis is the locked vectors, if any, followed by the columns
+ *    of V, up to maxBasisSize vectors.
+ *
+ * INPUT ARRAYS AND PARAMETERS
+ * ---------------------------
+ * V            The basis
+ * basisSize    The number of columns in V
+ * locked       The locked vectors
+ * numLocked    The number of locked vectors
+ * primme       Structure containing various solver parameters
+ *
+ * Return value
+ * ------------
+ *  error code
+ ******************************************************************************/
+
+TEMPLATE_PLEASE
+int save_warm_start_Sprimme(SCALAR *V, PRIMME_INT ldV, int basisSize,
+      SCALAR *locked, PRIMME_INT ldlocked, int numLocked,
+      primme_params *primme) {
+
+   primme_warm_start *warm;
+   PRIMME_INT nLocal = primme->nLocal;
+   size_t size;
+
+   if (!primme->warmStart) return 0;
+
+   numLocked = min(numLocked, primme->maxBasisSize);
+   basisSize = min(basisSize, primme->maxBasisSize - numLocked);
+   size = sizeof(SCALAR)*(size_t)nLocal*(size_t)(numLocked + basisSize);
+
+   /* Allocate the state, or grow it if it is too small */
+
+   if (primme->warmStartState == NULL) {
+      CHKERR(MALLOC_PRIMME(1, &primme->warmStartState), -1);
+      primme->warmStartState->V = NULL;
+      primme->warmStartState->size = 0;
+   }
+   warm = primme->warmStartState;
+   warm->basisSize = 0;
+   if (warm->size < size) {
+      free(warm->V);
+      warm->size = 0;
+      CHKERR(MALLOC_PRIMME(size, (char**)&warm->V), -1);
+      warm->size = size;
+   }
+
+   /* Copy the locked vectors and then the basis */
+
+   Num_copy_matrix_Sprimme(locked, nLocal, numLocked, ldlocked,
+         (SCALAR*)warm->V, nLocal);
+   Num_copy_matrix_Sprimme(V, nLocal, basisSize, ldV,
+         &((SCALAR*)warm->V)[nLocal*numLocked], nLocal);
+   warm->nLocal = nLocal;
+   warm->basisSize = numLocked + basisSize;
+   warm->type = WARM_START_TYPE_SIZE;
+
+   return 0;
+}
+
+
 /*******************************************************************************
  * Subroutine init_block_krylov - Initializes the basis as an orthonormal 
  *    block Krylov subspace.  
@@ -263,6 +373,8 @@ int init_basis_Sprimme(SCALAR *V, PRIMME_INT nLocal, PRIMME_INT ldV,
  * 
  * W  A*V
  *
+ * BV B*V for the generalized problem, or NULL
+ *
  * Return value
  * ------------
  * int -  0 upon success
@@ -271,7 +383,7 @@ int init_basis_Sprimme(SCALAR *V, PRIMME_INT nLocal, PRIMME_INT ldV,
  ******************************************************************************/
 
 static int init_block_krylov(SCALAR *V, PRIMME_INT nLocal, PRIMME_INT ldV,
-      SCALAR *W, PRIMME_INT ldW, int dv1, int dv2, SCALAR *locked,
+      SCALAR *W, PRIMME_INT ldW, SCALAR *BV, int dv1, int dv2, SCALAR *locked,
       PRIMME_INT ldlocked, int numLocked, double machEps, SCALAR *rwork,
       size_t *rworkSize, primme_params *primme) {
 
@@ -298,9 +410,16 @@ static int init_block_krylov(SCALAR *V, PRIMME_INT nLocal, PRIMME_INT ldV,
          Num_larnv_Sprimme(2, primme->iseed, nLocal, &V[ldV*i]);
       }
    }
-   CHKERR(ortho_Sprimme(V, ldV, NULL, 0, dv1, 
-            dv1+blockSize-1, locked, ldlocked, numLocked, 
-            nLocal, primme->iseed, machEps, rwork, rworkSize, primme), -1);
+   if (BV) {
+      CHKERR(Bortho_Sprimme(V, ldV, BV, ldV, dv1, dv1+blockSize-1, NULL, 0,
+               NULL, 0, 0, nLocal, primme->iseed, machEps, rwork, rworkSize,
+               primme), -1);
+   }
+   else {
+      CHKERR(ortho_Sprimme(V, ldV, NULL, 0, dv1, 
+               dv1+blockSize-1, locked, ldlocked, numLocked, 
+               nLocal, primme->iseed, machEps, rwork, rworkSize, primme), -1);
+   }
 
    /* Generate the remaining vectors in the sequence */
 
@@ -311,9 +430,16 @@ static int init_block_krylov(SCALAR *V, PRIMME_INT nLocal, PRIMME_INT ldV,
       Num_copy_Sprimme(nLocal, &V[ldV*i], 1,
          &W[ldW*(i-blockSize)], 1);
 
-      CHKERR(ortho_Sprimme(V, ldV, NULL, 0, i, i, locked, 
-               ldlocked, numLocked, nLocal, primme->iseed, machEps,
-               rwork, rworkSize, primme), -1);
+      if (BV) {
+         CHKERR(Bortho_Sprimme(V, ldV, BV, ldV, i, i, NULL, 0, NULL, 0, 0,
+                  nLocal, primme->iseed, machEps, rwork, rworkSize, primme),
+               -1);
+      }
+      else {
+         CHKERR(ortho_Sprimme(V, ldV, NULL, 0, i, i, locked, 
+                  ldlocked, numLocked, nLocal, primme->iseed, machEps,
+                  rwork, rworkSize, primme), -1);
+      }
    }
 
    CHKERR(matrixMatvec_Sprimme(V, nLocal, ldV, W, ldW, dv2-blockSize+1,
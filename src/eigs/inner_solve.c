@@ -45,102 +45,162 @@
 #include "globalsum.h"
 #include "auxiliary_eigs.h"
 
-static int apply_projected_preconditioner(SCALAR *v, SCALAR *Q, PRIMME_INT ldQ,
-      SCALAR *RprojectorQ, PRIMME_INT ldRprojectorQ, SCALAR *x,
-      SCALAR *RprojectorX,  PRIMME_INT ldRprojectorX, int sizeRprojectorQ,
-      int sizeRprojectorX, SCALAR *xKinvx, SCALAR *UDU, int *ipivot,
-      SCALAR *result, SCALAR *rwork, primme_params *primme);
+/* State of the QMR recurrences of a single block vector */
+
+typedef struct {
+   REAL alpha_prev, beta, rho_prev, rho;
+   REAL Theta_prev, Theta, c, sigma_prev, tau_init, tau_prev, tau;
+   REAL Beta, Delta, Psi, Beta_prev, Delta_prev, Psi_prev, eta;
+   REAL dot_sol, eval, eval_updated, eval_prev, eres_updated;
+   REAL Gamma_prev, Phi_prev, Gamma, Phi, gamma;
+   REAL ETolerance, shift;
+   int col;           /* Index of the vector in the input block              */
+   int stop;          /* Nonzero if the vector has exited the inner loop     */
+} qmr_state;
+
+static int apply_projected_preconditioner(SCALAR *v, PRIMME_INT ldv, int n,
+      qmr_state *st, SCALAR *Q, PRIMME_INT ldQ, SCALAR *RprojectorQ,
+      PRIMME_INT ldRprojectorQ, int sizeRprojectorQ, SCALAR *UDU, int *ipivot,
+      SCALAR *x, PRIMME_INT ldx, SCALAR *RprojectorX, PRIMME_INT ldRprojectorX,
+      int sizeRprojectorX, SCALAR *xKinvx, SCALAR *result,
+      PRIMME_INT ldresult, SCALAR *rwork, primme_params *primme);
 
 static int apply_skew_projector(SCALAR *Q, PRIMME_INT ldQ, SCALAR *Qhat,
       PRIMME_INT ldQhat, SCALAR *UDU, int *ipivot, int numCols, SCALAR *v,
+      PRIMME_INT ldv, int n, SCALAR *rwork, primme_params *primme);
+
+static int apply_skew_projector_x(SCALAR *x, PRIMME_INT ldx, SCALAR *xhat,
+      PRIMME_INT ldxhat, SCALAR *xKinvx, qmr_state *st, SCALAR *v,
+      PRIMME_INT ldv, int n, SCALAR *rwork, primme_params *primme);
+
+static int apply_projected_matrix(SCALAR *v, PRIMME_INT ldv, int n,
+      qmr_state *st, SCALAR *Q, PRIMME_INT ldQ, int dimQ, SCALAR *x,
+      PRIMME_INT ldx, int dimX, SCALAR *result, PRIMME_INT ldresult,
       SCALAR *rwork, primme_params *primme);
 
-static int apply_projected_matrix(SCALAR *v, REAL shift, SCALAR *Q, 
-      PRIMME_INT ldQ, int dimQ, SCALAR *result, SCALAR *rwork,
+static int apply_projector(SCALAR *Q, PRIMME_INT ldQ, int numCols, SCALAR *x,
+      PRIMME_INT ldx, int numColsX, qmr_state *st, SCALAR *v, PRIMME_INT ldv,
+      int n, SCALAR *rwork, primme_params *primme);
+
+static int dist_dots_real(SCALAR *x, PRIMME_INT ldx, SCALAR *y,
+      PRIMME_INT ldy, int n, REAL *result, SCALAR *rwork,
+      primme_params *primme);
+
+static int apply_projected_matrix_fused(SCALAR *v, PRIMME_INT ldv, int n,
+      qmr_state *st, SCALAR *Q, PRIMME_INT ldQ, int dimQ, SCALAR *x,
+      PRIMME_INT ldx, int dimX, SCALAR *result, PRIMME_INT ldresult,
+      REAL *sigma, SCALAR *rwork, primme_params *primme);
+
+static int fused_sums(SCALAR *g, SCALAR *d, SCALAR *delta, SCALAR *w,
+      PRIMME_INT ld, int n, qmr_state *st, SCALAR *sol, PRIMME_INT ldsol,
+      SCALAR *Q, PRIMME_INT ldQ, SCALAR *RprojectorQ,
+      PRIMME_INT ldRprojectorQ, int dimQ, SCALAR *x, PRIMME_INT ldx,
+      SCALAR *RprojectorX, PRIMME_INT ldRprojectorX, int dimX, SCALAR *sums,
+      primme_params *primme);
+
+static int fused_projected_preconditioner(SCALAR *w, qmr_state *s,
+      SCALAR *sums, SCALAR *RprojectorQ, PRIMME_INT ldRprojectorQ, int dimQ,
+      SCALAR *UDU, int *ipivot, SCALAR *QhatTx, SCALAR *RprojectorX,
+      PRIMME_INT ldRprojectorX, int dimX, SCALAR *xKinvx, SCALAR *rwork,
       primme_params *primme);
 
-static int apply_projector(SCALAR *Q, PRIMME_INT ldQ, int numCols, SCALAR *v, 
-   SCALAR *rwork, primme_params *primme);
+static int compact_block(qmr_state *st, double *shifts, int n, SCALAR *g,
+      SCALAR *d, SCALAR *w, PRIMME_INT ld, primme_params *primme);
 
-static int dist_dot(SCALAR *x, int incx,
-   SCALAR *y, int incy, primme_params *primme, SCALAR *result);
+#define ALIGN(ptr,T) (((uintptr_t)(ptr)+sizeof(T)-1) & -sizeof(T))
 
-static int dist_dot_real(SCALAR *x, int incx,
-   SCALAR *y, int incy, primme_params *primme, REAL *result);
+/* Position of the inner products packed after the projector overlaps in  */
+/* every column of the fused reduction computed by fused_sums             */
 
+enum { FUSED_GW, FUSED_GG, FUSED_SS, FUSED_SDELTA, FUSED_SD, FUSED_DELTADELTA,
+       FUSED_DELTAD, FUSED_DD, FUSED_NUM };
 
 /*******************************************************************************
- * Function inner_solve - This subroutine solves the correction equation
- *    
- *           (I-QQ')(I-xx')(A-shift*I)(I-xx')(I-QQ')sol = -r 
+ * Function inner_solve - This subroutine solves the correction equations
  *
- *    with Q = evecs, using hermitian simplified QMR.
+ *           (I-QQ')(I-x_ix_i')(A-shift_i*I)(I-x_ix_i')(I-QQ')sol_i = -r_i
+ *
+ *    for i=0:blockSize-1 with Q = evecs, using hermitian simplified QMR.
  *    A preconditioner may be applied to this system to accelerate convergence.
  *    The preconditioner is assumed to approximate (A-shift*I)^{-1}.  The
- *    classical JD method as described in Templates for the Solution of 
- *    Eigenvalue Problems by Bai, et. al. requires that the preconditioner is 
- *    computed orthogonally to x and evecs. This code implements all 
+ *    classical JD method as described in Templates for the Solution of
+ *    Eigenvalue Problems by Bai, et. al. requires that the preconditioner is
+ *    computed orthogonally to x and evecs. This code implements all
  *    possible variations for projectors as defined by user parameters
  *    and setup_JD_projectors(). The QMR transparently calls the resulting
  *    projected matrix and preconditioner.
  *
+ *    The QMR recurrences of all block vectors advance in lockstep: every
+ *    inner step calls matrixMatvec and applyPreconditioner once with all
+ *    the vectors that have not stopped yet, and the inner products of all
+ *    vectors are reduced together. A vector that satisfies its stopping
+ *    criterion is removed from the active block.
+ *
+ *    If primme.correctionParams.fuseGlobalSums is set, the projections and
+ *    inner products of an inner step are computed with two global
+ *    reductions: one after the matvec (projector overlaps and sigma), and
+ *    one after the preconditioner (projector overlaps, rho, the residual
+ *    norm and the norm of the updated solution). The preconditioner is
+ *    applied before knowing if the vector will stop at that step.
+ *
  *
  * Input parameters
  * ----------------
- * x           The current Ritz vector for which the correction is being solved.
+ * blockSize   The number of correction equations to solve
  *
- * r           The residual with respect to the Ritz vector.
+ * x           The current Ritz vectors for which the corrections are solved.
  *
- * evecs       The converged Ritz vectors
+ * r           The residuals with respect to the Ritz vectors.
  *
- * evecsHat    K^{-1}*evecs where K is a hermitian preconditioner.
+ * evecs       The converged Ritz vectors
  *
- * UDU         The factors of the hermitian projection (evecs'*evecsHat). 
+ * UDU         The factors of the hermitian projection (evecs'*evecsHat).
  *
  * ipivot      The pivoting for the UDU factorization
  *
- * xKinvx      The value x'*Kinv*x needed if skew-X projection
+ * xKinvx      The values x_i'*Kinv*x_i needed if skew-X projection
  *
- * Lprojector  Points to an array that includes all the left projector.
- *             Can be any combination of [evecs x], [evecs], [x], NULL.
+ * Lprojector  Points to an array that includes the left projector with Q.
+ *             Can be [evecs] or NULL.
  *
  * RprojectorQ Points to an array that includes the right skew projector for Q:
  *             It can be [evecsHat] or Null
  *
  * RprojectorX Points to an array that includes the right skew projector for x:
- *             It can be [Kinvx] or Null
+ *             It can be [Kinvx], [x] or Null
  *
- * sizeLprojector   Number of colums of Lprojector
+ * sizeLprojectorQ  Number of colums of Lprojector
+ *
+ * sizeLprojectorX  1 if x_i is included in the left projector, 0 otherwise
  *
  * sizeRprojectorQ  Number of colums of RprojectorQ
  *
- * sizeRprojectorX  Number of colums of LprojectorX
+ * sizeRprojectorX  1 if RprojectorX is applied, 0 otherwise
  *
- * eval        The current Ritz value 
+ * eval        The current Ritz values
  *
- * shift       Correction eq. shift. The closer the shift is to the target 
+ * shift       Correction eq. shifts. The closer the shift is to the target
  *             eigenvalue, the more accurate the correction will be.
  *
  * machEps     machine precision
  *
- * rwork       Real workspace of size 
- *             4*primme->nLocal + 2*(primme->numOrthoConst+primme->numEvals)
+ * rwork       Real workspace
  *
- * rworkSize   Size of the rwork array
+ * rworkSize   Size of the rwork array. If r is NULL, it returns the needed size
  *
  * primme      Structure containing various solver parameters
  *
  *
  * Input/Output parameters
  * -----------------------
- * r       The residual with respect to the Ritz vector.  May be altered upon
+ * r       The residuals with respect to the Ritz vectors.  May be altered upon
  *         return.
- * rnorm   On input, the 2 norm of r. No need to recompute it initially.
- *         On output, the estimated 2 norm of the updated eigenvalue residual
- * 
+ * rnorm   On input, the 2 norms of r. No need to recompute them initially.
+ *         On output, the estimated 2 norms of the updated eigenvalue residuals
+ *
  * Output parameters
  * -----------------
- * sol   The solution (correction) of the correction equation
+ * sol   The solutions (corrections) of the correction equations
  *
  * Return Value
  * ------------
@@ -150,61 +210,84 @@ static int dist_dot_real(SCALAR *x, int incx,
  ******************************************************************************/
 
 TEMPLATE_PLEASE
-int inner_solve_Sprimme(SCALAR *x, SCALAR *r, REAL *rnorm, SCALAR *evecs,
-      PRIMME_INT ldevecs, SCALAR *UDU, int *ipivot, SCALAR *xKinvx,
-      SCALAR *Lprojector, PRIMME_INT ldLprojector, SCALAR *RprojectorQ,
-      PRIMME_INT ldRprojectorQ, SCALAR *RprojectorX, PRIMME_INT ldRprojectorX,
-      int sizeLprojector, int sizeRprojectorQ, int sizeRprojectorX, SCALAR *sol,
-      REAL eval, REAL shift, double machEps, SCALAR *rwork, size_t rworkSize,
+int inner_solve_Sprimme(int blockSize, SCALAR *x, PRIMME_INT ldx, SCALAR *r,
+      PRIMME_INT ldr, REAL *rnorm, SCALAR *evecs, PRIMME_INT ldevecs,
+      SCALAR *UDU, int *ipivot, SCALAR *xKinvx, SCALAR *Lprojector,
+      PRIMME_INT ldLprojector, SCALAR *RprojectorQ, PRIMME_INT ldRprojectorQ,
+      SCALAR *RprojectorX, PRIMME_INT ldRprojectorX, int sizeLprojectorQ,
+      int sizeLprojectorX, int sizeRprojectorQ, int sizeRprojectorX,
+      SCALAR *sol, PRIMME_INT ldsol, REAL *eval, double *shift,
+      double machEps, SCALAR *rwork, size_t *rworkSize,
       primme_params *primme) {
 
-   int i;             /* loop variable                                       */
+   int i, j;          /* loop variables                                      */
+   int n;             /* Number of vectors still iterating                   */
    int numIts;        /* Number of inner iterations                          */
    int maxIterations; /* The maximum # iterations allowed. Depends on primme */
+   int sizeQ;         /* Maximum number of columns of the Q projectors       */
+   PRIMME_INT ld;     /* Leading dimension of g, d, delta and w              */
+   size_t neededRsize;/* Needed size for rwork                               */
 
-   SCALAR *workSpace; /* Workspace needed by UDU routine */
+   SCALAR *workSpace; /* Workspace needed by the projectors and dots */
 
    /* QMR parameters */
 
    SCALAR *g, *d, *delta, *w, *ptmp;
-   REAL alpha_prev, beta, rho_prev, rho;
-   REAL Theta_prev, Theta, c, sigma_prev, tau_init, tau_prev, tau; 
-
-   /* Parameters used to dynamically update eigenpair */
-   REAL Beta=0.0, Delta=0.0, Psi=0.0, Beta_prev, Delta_prev, Psi_prev, eta;
-   REAL dot_sol, eval_updated, eval_prev, eres2_updated, eres_updated=0.0, R;
-   REAL Gamma_prev, Phi_prev;
-   REAL Gamma=0.0, Phi=0.0;
-   REAL gamma;
-
-   REAL LTolerance, ETolerance, LTolerance_factor, ETolerance_factor;
-   int isConv;
+   qmr_state *st;     /* State of the recurrences of each block vector */
+   double *blockShifts;/* Shifts for the preconditioner of each active vector */
+   REAL *dots;        /* Reduced inner products of the block vectors */
+   REAL eres2_updated, R;
+
+   REAL LTolerance, LTolerance_factor, ETolerance_factor;
+   int isConv, adaptive;
+   int fused;         /* If nonzero, use two reductions per inner step */
+   int ldsums;        /* Leading dimension of the fused reduction      */
+   SCALAR *sums;      /* Result of the fused reduction                 */
+   SCALAR *QhatTx;    /* RprojectorQ'*x, used by the fused projection  */
    double aNorm;
 
    /* -------------------------------------------*/
    /* Subdivide the workspace into needed arrays */
    /* -------------------------------------------*/
 
+   ld = primme->ldOPs;
+   fused = primme->correctionParams.fuseGlobalSums;
+   sizeQ = max(sizeLprojectorQ, sizeRprojectorQ);
+   ldsums = fused ? 2*sizeQ + 2 + FUSED_NUM : sizeQ + 1;
+   neededRsize = (size_t)ld*blockSize*4                /* g, d, delta, w    */
+      + (size_t)ldsums*blockSize*2                     /* workSpace         */
+      + (fused ? (size_t)sizeRprojectorQ*blockSize : 0)/* QhatTx            */
+      + (size_t)blockSize                              /* dots              */
+      + (sizeof(qmr_state)+sizeof(double))*(blockSize+2)/sizeof(SCALAR) + 1;
+
+   /* Return memory requirements */
+   if (r == NULL) {
+      *rworkSize = max(*rworkSize, neededRsize);
+      return 0;
+   }
+   assert(*rworkSize >= neededRsize);
+
    g      = rwork;
-   d      = g + primme->nLocal;
-   delta  = d + primme->nLocal;
-   w      = delta + primme->nLocal;
-   workSpace = w + primme->nLocal; /* This needs at least 2*numOrth+NumEvals) */
-   assert(rworkSize >= (size_t)primme->nLocal*4
-                       + 2*(primme->numOrthoConst+primme->numEvals));
+   d      = g + ld*blockSize;
+   delta  = d + ld*blockSize;
+   w      = delta + ld*blockSize;
+   workSpace = w + ld*blockSize; /* This needs ldsums*blockSize*2 */
+   sums   = workSpace;
+   QhatTx = workSpace + ldsums*blockSize*2;
+   dots   = (REAL*)(QhatTx + (fused ? sizeRprojectorQ*blockSize : 0));
+   st     = (qmr_state*)ALIGN(dots + blockSize, double);
+   blockShifts = (double*)ALIGN(st + blockSize, double);
 
    /* -----------------------------------------*/
    /* Set up convergence criteria by Tolerance */
    /* -----------------------------------------*/
 
    aNorm = max(primme->stats.estimateLargestSVal, primme->aNorm);
-   tau_prev = tau_init = *rnorm;       /* Assumes zero initial guess */
 
    /* NOTE: In any case stop when linear system residual is less than         */
    /*       max(machEps,eps)*aNorm.                                           */
    LTolerance = machEps*aNorm;
    LTolerance_factor = 1.0;
-   ETolerance = 0.0;
    ETolerance_factor = 0.0;
 
    switch(primme->correctionParams.convTest) {
@@ -217,7 +300,7 @@ int inner_solve_Sprimme(SCALAR *x, SCALAR *r, REAL *rnorm, SCALAR *evecs,
       /* TODO: probably 'its' should be the number of outer iterations this   */
       /* pair has been targeted, instead of the total number of iterations.   */
       LTolerance = max(LTolerance,
-            pow(primme->correctionParams.relTolBase, 
+            pow(primme->correctionParams.relTolBase,
                (double)-primme->stats.numOuterIterations));
       break;
    case primme_adaptive:
@@ -228,23 +311,24 @@ int inner_solve_Sprimme(SCALAR *x, SCALAR *r, REAL *rnorm, SCALAR *evecs,
       /* residual norm is less than aNorm*eps/1.8.                            */
       LTolerance_factor = 1.0/1.8;
       ETolerance_factor = 1.0/1.8;
-      break; 
+      break;
    case primme_adaptive_ETolerance:
       /* Besides the primme_adaptive criteria, stop when estimate eigenvalue  */
-      /* residual norm is less than tau_init*0.1                              */
+      /* residual norm is less than tau_init*0.1 (see ETolerance below)       */
       LTolerance_factor = 1.0/1.8;
       ETolerance_factor = 1.0/1.8;
-      ETolerance = tau_init*0.1;
      }
-   
+
    /* --------------------------------------------------------*/
    /* Set up convergence criteria by max number of iterations */
    /* --------------------------------------------------------*/
 
-   /* compute first total number of remaining matvecs */
+   /* compute first total number of remaining matvecs; every inner     */
+   /* iteration performs up to blockSize matvecs                       */
 
    if (primme->maxMatvecs > 0) {
-      maxIterations = primme->maxMatvecs - primme->stats.numMatvecs;
+      maxIterations = (primme->maxMatvecs - primme->stats.numMatvecs
+            + blockSize - 1)/blockSize;
    }
    else {
       maxIterations = INT_MAX;
@@ -253,7 +337,7 @@ int inner_solve_Sprimme(SCALAR *x, SCALAR *r, REAL *rnorm, SCALAR *evecs,
    /* Perform primme.maxInnerIterations, but do not exceed total remaining */
    if (primme->correctionParams.maxInnerIterations > 0) {
 
-      maxIterations = min(primme->correctionParams.maxInnerIterations, 
+      maxIterations = min(primme->correctionParams.maxInnerIterations,
                           maxIterations);
    }
 
@@ -261,281 +345,448 @@ int inner_solve_Sprimme(SCALAR *x, SCALAR *r, REAL *rnorm, SCALAR *evecs,
    /* Rest of initializations                                 */
    /* --------------------------------------------------------*/
 
+   for (j=0; j < blockSize; j++) {
+      st[j].col = j;
+      st[j].stop = 0;
+      st[j].tau_prev = st[j].tau_init = rnorm[j];  /* Assumes zero initial guess */
+      st[j].ETolerance = primme->correctionParams.convTest ==
+         primme_adaptive_ETolerance ? st[j].tau_init*0.1 : 0.0;
+      st[j].eval = st[j].eval_prev = eval[j];
+      st[j].shift = shift[j];
+      st[j].Theta_prev = 0.0L;
+      st[j].eres_updated = 0.0;
+
+      /* Initialize recurrences used to dynamically update the eigenpair */
+
+      st[j].Beta = st[j].Delta = st[j].Psi = 0.0L;
+      st[j].Gamma = st[j].Phi = 0.0L;
+      st[j].Beta_prev = st[j].Delta_prev = st[j].Psi_prev = 0.0L;
+      st[j].Gamma_prev = st[j].Phi_prev = 0.0L;
+
+      blockShifts[j] = shift[j];
+   }
+   adaptive = ETolerance_factor > 0.0;
+   n = blockSize;
+
+   /* Make the shift of each active vector available to primme, in case */
+   /* (K-shift I)^-1 is needed                                          */
+
+   primme->ShiftsForPreconditioner = blockShifts;
+
    /* Assume zero initial guess */
-   Num_copy_Sprimme(primme->nLocal, r, 1, g, 1);
+   Num_copy_matrix_Sprimme(r, primme->nLocal, n, ldr, g, ld);
 
-   CHKERR(apply_projected_preconditioner(g, evecs, ldevecs, RprojectorQ,
-           ldRprojectorQ, x, RprojectorX, ldRprojectorX, sizeRprojectorQ,
-           sizeRprojectorX, xKinvx, UDU, ipivot, d, workSpace, primme), -1);
+   CHKERR(apply_projected_preconditioner(g, ld, n, st, evecs, ldevecs,
+           RprojectorQ, ldRprojectorQ, sizeRprojectorQ, UDU, ipivot, x, ldx,
+           RprojectorX, ldRprojectorX, sizeRprojectorX, xKinvx, d, ld,
+           workSpace, primme), -1);
 
-   Theta_prev = 0.0L;
-   eval_prev = eval;
-   CHKERR(dist_dot_real(g, 1, d, 1, primme, &rho_prev), -1);
+   CHKERR(dist_dots_real(g, ld, d, ld, n, dots, workSpace, primme), -1);
+   for (j=0; j < n; j++) st[j].rho_prev = dots[j];
 
-   /* Initialize recurrences used to dynamically update the eigenpair */
+   /* The fused projection needs x_i'*Qhat */
 
-   Beta_prev = Delta_prev = Psi_prev = 0.0L;
-   Gamma_prev = Phi_prev = 0.0L;
+   if (fused && sizeRprojectorQ > 0 && sizeRprojectorX > 0) {
+      Num_gemm_Sprimme("C", "N", sizeRprojectorQ, n, primme->nLocal, 1.0,
+            RprojectorQ, ldRprojectorQ, x, ldx, 0.0, workSpace,
+            sizeRprojectorQ);
+      CHKERR(globalSum_Sprimme(workSpace, QhatTx, sizeRprojectorQ*n, primme),
+            -1);
+   }
 
    /* other initializations */
-   for (i = 0; i < primme->nLocal; i++) {
-      delta[i] = 0.0;
-      sol[i] = 0.0;
-   }
+   Num_zero_matrix_Sprimme(delta, primme->nLocal, n, ld);
+   Num_zero_matrix_Sprimme(sol, primme->nLocal, n, ldsol);
 
    numIts = 0;
-      
+
    /*----------------------------------------------------------------------*/
    /*------------------------ Begin Inner Loop ----------------------------*/
    /*----------------------------------------------------------------------*/
 
-   while (numIts < maxIterations) {
+   while (numIts < maxIterations && n > 0) {
+
+      if (fused) {
+         CHKERR(apply_projected_matrix_fused(d, ld, n, st, Lprojector,
+                  ldLprojector, sizeLprojectorQ, x, ldx, sizeLprojectorX, w,
+                  ld, dots, workSpace, primme), -1);
+      }
+      else {
+         CHKERR(apply_projected_matrix(d, ld, n, st, Lprojector, ldLprojector,
+                  sizeLprojectorQ, x, ldx, sizeLprojectorX, w, ld, workSpace,
+                  primme), -1);
+         CHKERR(dist_dots_real(d, ld, w, ld, n, dots, workSpace, primme), -1);
+      }
+
+      for (j=0; j < n; j++) {
+         qmr_state *s = &st[j];
 
-      CHKERR(apply_projected_matrix(d, shift, Lprojector, ldLprojector,
-               sizeLprojector, w, workSpace, primme), -1);
-      CHKERR(dist_dot_real(d, 1, w, 1, primme, &sigma_prev), -1);
+         s->sigma_prev = dots[j];
 
-      if (sigma_prev == 0.0L) {
-         if (primme->printLevel >= 5 && primme->procID == 0) {
-            fprintf(primme->outputFile,"Exiting because SIGMA %e\n",sigma_prev);
+         if (s->sigma_prev == 0.0L) {
+            if (primme->printLevel >= 5 && primme->procID == 0) {
+               fprintf(primme->outputFile,"Exiting because SIGMA %e\n",
+                     s->sigma_prev);
+            }
+            /* sol = r if first iteration */
+            if (numIts == 0) {
+               Num_copy_Sprimme(primme->nLocal, &r[ldr*s->col], 1,
+                     &sol[ldsol*s->col], 1);
+            }
+            s->stop = 1;
+            continue;
          }
-         /* sol = r if first iteration */
-         if (numIts == 0) {
-            Num_copy_Sprimme(primme->nLocal, r, 1, sol, 1);
+
+         s->alpha_prev = s->rho_prev/s->sigma_prev;
+         if (fabs(s->alpha_prev) < machEps
+               || fabs(s->alpha_prev) > 1.0L/machEps){
+            if (primme->printLevel >= 5 && primme->procID == 0) {
+               fprintf(primme->outputFile,"Exiting because ALPHA %e\n",
+                     s->alpha_prev);
+            }
+            /* sol = r if first iteration */
+            if (numIts == 0) {
+               Num_copy_Sprimme(primme->nLocal, &r[ldr*s->col], 1,
+                     &sol[ldsol*s->col], 1);
+            }
+            s->stop = 1;
+            continue;
          }
-         break;
+
+         Num_axpy_Sprimme(primme->nLocal, -s->alpha_prev, &w[ld*j], 1,
+               &g[ld*j], 1);
       }
 
-      alpha_prev = rho_prev/sigma_prev;
-      if (fabs(alpha_prev) < machEps || fabs(alpha_prev) > 1.0L/machEps){
-         if (primme->printLevel >= 5 && primme->procID == 0) {
-            fprintf(primme->outputFile,"Exiting because ALPHA %e\n",alpha_prev);
+      n = compact_block(st, blockShifts, n, g, d, w, ld, primme);
+      if (n == 0) break;
+
+      if (fused) {
+         /* Apply the preconditioner to g before the stopping criteria are */
+         /* checked, so that its projection is reduced with the rest of    */
+         /* the inner products of this step                                */
+
+         int precond = numIts+1 < maxIterations;
+         if (precond) {
+            CHKERR(applyPreconditioner_Sprimme(g, primme->nLocal, ld, w, ld,
+                     n, primme), -1);
          }
-         /* sol = r if first iteration */
-         if (numIts == 0) {
-            Num_copy_Sprimme(primme->nLocal, r, 1, sol, 1);
+         ldsums = 2*(precond ? sizeRprojectorQ + sizeRprojectorX : 0)
+            + FUSED_NUM;
+         CHKERR(fused_sums(g, d, delta, precond ? w : NULL, ld, n, st, sol,
+                  ldsol, evecs, ldevecs, RprojectorQ, ldRprojectorQ,
+                  precond ? sizeRprojectorQ : 0, x, ldx, RprojectorX,
+                  ldRprojectorX, precond ? sizeRprojectorX : 0, sums,
+                  primme), -1);
+         for (j=0; j < n; j++) {
+            dots[j] = REAL_PART(sums[ldsums*(j+1)-FUSED_NUM+FUSED_GG]);
          }
-         break;
+      }
+      else {
+         CHKERR(dist_dots_real(g, ld, g, ld, n, dots, workSpace, primme), -1);
       }
 
-      Num_axpy_Sprimme(primme->nLocal, -alpha_prev, w, 1, g, 1);
-
-      CHKERR(dist_dot_real(g, 1, g, 1, primme, &Theta), -1);
-      Theta = sqrt(Theta);
-      Theta = Theta/tau_prev;
-      c = 1.0L/sqrt(1+Theta*Theta);
-      tau = tau_prev*Theta*c;
-
-      gamma = c*c*Theta_prev*Theta_prev;
-      eta = alpha_prev*c*c;
-      for (i = 0; i < primme->nLocal; i++) {
-          delta[i] = gamma*delta[i] + eta*d[i];
-          sol[i] = delta[i]+sol[i];
+      for (j=0; j < n; j++) {
+         qmr_state *s = &st[j];
+         SCALAR *deltaj = &delta[ld*s->col], *dj = &d[ld*j];
+         SCALAR *solj = &sol[ldsol*s->col];
+
+         s->Theta = sqrt(dots[j]);
+         s->Theta = s->Theta/s->tau_prev;
+         s->c = 1.0L/sqrt(1+s->Theta*s->Theta);
+         s->tau = s->tau_prev*s->Theta*s->c;
+
+         s->gamma = s->c*s->c*s->Theta_prev*s->Theta_prev;
+         s->eta = s->alpha_prev*s->c*s->c;
+         for (i = 0; i < primme->nLocal; i++) {
+             deltaj[i] = s->gamma*deltaj[i] + s->eta*dj[i];
+             solj[i] = deltaj[i]+solj[i];
+         }
       }
       numIts++;
 
-      if (fabs(rho_prev) == 0.0L ) {
-         if (primme->printLevel >= 5 && primme->procID == 0) {
-            fprintf(primme->outputFile,"Exiting because abs(rho) %e\n",
-               fabs(rho_prev));
+      /* Compute all the norms of the updated solutions at once. The fused */
+      /* reduction has the norms of the previous solutions, deltas and d's */
+      /* and their inner products, which sol = sol + gamma*delta + eta*d   */
+      /* expands to.                                                       */
+
+      if (adaptive && fused) {
+         for (j=0; j < n; j++) {
+            qmr_state *s = &st[j];
+            SCALAR *p = &sums[ldsums*(j+1)-FUSED_NUM];
+            s->dot_sol = REAL_PART(p[FUSED_SS])
+               + s->gamma*s->gamma*REAL_PART(p[FUSED_DELTADELTA])
+               + s->eta*s->eta*REAL_PART(p[FUSED_DD])
+               + 2.0L*s->gamma*REAL_PART(p[FUSED_SDELTA])
+               + 2.0L*s->eta*REAL_PART(p[FUSED_SD])
+               + 2.0L*s->gamma*s->eta*REAL_PART(p[FUSED_DELTAD]);
          }
-         break;
       }
-      
-      if (numIts > 1 && tau < LTolerance) {
-         if (primme->printLevel >= 5 && primme->procID == 0) {
-            fprintf(primme->outputFile, " tau < LTol %e %e\n",tau, LTolerance);
+      else if (adaptive) {
+         for (j=0; j < n; j++) {
+            workSpace[j] = Num_dot_Sprimme(primme->nLocal,
+                  &sol[ldsol*st[j].col], 1, &sol[ldsol*st[j].col], 1);
          }
-         break;
+         CHKERR(globalSum_Sprimme(workSpace, &workSpace[n], n, primme), -1);
+         for (j=0; j < n; j++) st[j].dot_sol = REAL_PART(workSpace[n+j]);
       }
-      if (ETolerance > 0.0 || ETolerance_factor > 0.0) {
-         /* --------------------------------------------------------*/
-         /* Adaptive stopping based on dynamic monitoring of eResid */
-         /* --------------------------------------------------------*/
-
-         /* Update the Ritz value and eigenresidual using the */
-         /* following recurrences.                            */
-      
-         Delta = gamma*Delta_prev + eta*rho_prev;
-         Beta = Beta_prev - Delta;
-         Phi = gamma*gamma*Phi_prev + eta*eta*sigma_prev;
-         Psi = gamma*Psi_prev + gamma*Phi_prev;
-         Gamma = Gamma_prev + 2.0L*Psi + Phi;
-        
-         /* Perform the update: update the eigenvalue and the square of the  */
-         /* residual norm.                                                   */
-         
-         CHKERR(dist_dot_real(sol, 1, sol, 1, primme, &dot_sol), -1);
-         eval_updated = shift + (eval - shift + 2*Beta + Gamma)/(1 + dot_sol);
-         eres2_updated = (tau*tau)/(1 + dot_sol) + 
-            ((eval - shift + Beta)*(eval - shift + Beta))/(1 + dot_sol) - 
-            (eval_updated - shift)*(eval_updated - shift);
-
-         /* If numerical problems, let eres about the same as tau */
-         if (eres2_updated < 0){
-            eres_updated = sqrt( (tau*tau)/(1 + dot_sol) );
-         }
-         else 
-            eres_updated = sqrt(eres2_updated);
 
-         /* --------------------------------------------------------*/
-         /* Stopping criteria                                       */
-         /* --------------------------------------------------------*/
+      for (j=0; j < n; j++) {
+         qmr_state *s = &st[j];
 
-         R = max(0.9878, sqrt(tau/tau_prev))*sqrt(1+dot_sol);
-        
-         if (numIts > 1 && (tau <= R*eres_updated || eres_updated <= tau*R) ) {
+         if (fabs(s->rho_prev) == 0.0L ) {
             if (primme->printLevel >= 5 && primme->procID == 0) {
-               fprintf(primme->outputFile, " tau < R eres \n");
+               fprintf(primme->outputFile,"Exiting because abs(rho) %e\n",
+                  fabs(s->rho_prev));
             }
-            break;
+            s->stop = 1;
+            continue;
          }
 
-         if (primme->target == primme_smallest && eval_updated > eval_prev) {
+         if (numIts > 1 && s->tau < LTolerance) {
             if (primme->printLevel >= 5 && primme->procID == 0) {
-               fprintf(primme->outputFile, "eval_updated > eval_prev\n");
+               fprintf(primme->outputFile, " tau < LTol %e %e\n",s->tau,
+                     LTolerance);
             }
-            break;
+            s->stop = 1;
+            continue;
          }
-         else if (primme->target == primme_largest && eval_updated < eval_prev){
-            if (primme->printLevel >= 5 && primme->procID == 0) {
-               fprintf(primme->outputFile, "eval_updated < eval_prev\n");
+         if (adaptive) {
+            /* --------------------------------------------------------*/
+            /* Adaptive stopping based on dynamic monitoring of eResid */
+            /* --------------------------------------------------------*/
+
+            /* Update the Ritz value and eigenresidual using the */
+            /* following recurrences.                            */
+
+            s->Delta = s->gamma*s->Delta_prev + s->eta*s->rho_prev;
+            s->Beta = s->Beta_prev - s->Delta;
+            s->Phi = s->gamma*s->gamma*s->Phi_prev
+               + s->eta*s->eta*s->sigma_prev;
+            s->Psi = s->gamma*s->Psi_prev + s->gamma*s->Phi_prev;
+            s->Gamma = s->Gamma_prev + 2.0L*s->Psi + s->Phi;
+
+            /* Perform the update: update the eigenvalue and the square of the  */
+            /* residual norm.                                                   */
+
+            s->eval_updated = s->shift + (s->eval - s->shift + 2*s->Beta
+                  + s->Gamma)/(1 + s->dot_sol);
+            eres2_updated = (s->tau*s->tau)/(1 + s->dot_sol) +
+               ((s->eval - s->shift + s->Beta)*(s->eval - s->shift + s->Beta))
+                  /(1 + s->dot_sol)
+               - (s->eval_updated - s->shift)*(s->eval_updated - s->shift);
+
+            /* If numerical problems, let eres about the same as tau */
+            if (eres2_updated < 0){
+               s->eres_updated = sqrt( (s->tau*s->tau)/(1 + s->dot_sol) );
             }
-            break;
-         }
-         
-         if (numIts > 1 && eres_updated < ETolerance) {
-            if (primme->printLevel >= 5 && primme->procID == 0) {
-               fprintf(primme->outputFile, "eres < eresTol %e \n",eres_updated);
+            else
+               s->eres_updated = sqrt(eres2_updated);
+
+            /* --------------------------------------------------------*/
+            /* Stopping criteria                                       */
+            /* --------------------------------------------------------*/
+
+            R = max(0.9878, sqrt(s->tau/s->tau_prev))*sqrt(1+s->dot_sol);
+
+            if (numIts > 1 && (s->tau <= R*s->eres_updated
+                     || s->eres_updated <= s->tau*R) ) {
+               if (primme->printLevel >= 5 && primme->procID == 0) {
+                  fprintf(primme->outputFile, " tau < R eres \n");
+               }
+               s->stop = 1;
+               continue;
             }
-            break;
-         }
 
-         /* Check if some of the next conditions is satisfied:                */
-         /* a) estimate eigenvalue residual norm (eres_updated) is less       */
-         /*    than eps*aNorm*Etolerance_factor                               */
-         /* b) linear system residual norm is less                            */
-         /*    than eps*aNorm*LTolerance_factor                               */
-         /* The result is to check if eps*aNorm is less than                  */
-         /* max(tau/LTolerance_factor, eres_updated/ETolerance_factor).       */
-
-         double tol = min(tau/LTolerance_factor, eres_updated/ETolerance_factor);
-         CHKERR(convTestFun_Sprimme(eval_updated, NULL, tol, &isConv, primme),
-               -1);
+            if (primme->target == primme_smallest
+                  && s->eval_updated > s->eval_prev) {
+               if (primme->printLevel >= 5 && primme->procID == 0) {
+                  fprintf(primme->outputFile, "eval_updated > eval_prev\n");
+               }
+               s->stop = 1;
+               continue;
+            }
+            else if (primme->target == primme_largest
+                  && s->eval_updated < s->eval_prev){
+               if (primme->printLevel >= 5 && primme->procID == 0) {
+                  fprintf(primme->outputFile, "eval_updated < eval_prev\n");
+               }
+               s->stop = 1;
+               continue;
+            }
 
-         if (numIts > 1 && isConv) {
-            if (primme->printLevel >= 5 && primme->procID == 0) {
-               fprintf(primme->outputFile, " eigenvalue and residual norm "
-                     "passed convergence criterion \n");
+            if (numIts > 1 && s->eres_updated < s->ETolerance) {
+               if (primme->printLevel >= 5 && primme->procID == 0) {
+                  fprintf(primme->outputFile, "eres < eresTol %e \n",
+                        s->eres_updated);
+               }
+               s->stop = 1;
+               continue;
             }
-            break;
-         }
 
-         eval_prev = eval_updated;
+            /* Check if some of the next conditions is satisfied:                */
+            /* a) estimate eigenvalue residual norm (eres_updated) is less       */
+            /*    than eps*aNorm*Etolerance_factor                               */
+            /* b) linear system residual norm is less                            */
+            /*    than eps*aNorm*LTolerance_factor                               */
+            /* The result is to check if eps*aNorm is less than                  */
+            /* max(tau/LTolerance_factor, eres_updated/ETolerance_factor).       */
+
+            double tol = min(s->tau/LTolerance_factor,
+                  s->eres_updated/ETolerance_factor);
+            CHKERR(convTestFun_Sprimme(s->eval_updated, NULL, tol, &isConv,
+                     primme), -1);
+
+            if (numIts > 1 && isConv) {
+               if (primme->printLevel >= 5 && primme->procID == 0) {
+                  fprintf(primme->outputFile, " eigenvalue and residual norm "
+                        "passed convergence criterion \n");
+               }
+               s->stop = 1;
+               continue;
+            }
 
-         if (primme->printLevel >= 4 && primme->procID == 0) {
-            fprintf(primme->outputFile,
-                  "INN MV %" PRIMME_INT_P " Sec %e Eval %e Lin|r| %.3e EV|r| %.3e\n",
-                  primme->stats.numMatvecs, primme_wTimer(0), eval_updated,
-                  tau, eres_updated);
-            fflush(primme->outputFile);
-         }
+            s->eval_prev = s->eval_updated;
 
-        /* --------------------------------------------------------*/
-      } /* End of if adaptive JDQMR section                        */
-        /* --------------------------------------------------------*/
-      else {
-         /* Check if the linear system residual norm (tau) is less            */
-         /* than eps*aNorm*LTolerance_factor                                  */
+            if (primme->printLevel >= 4 && primme->procID == 0) {
+               fprintf(primme->outputFile,
+                     "INN MV %" PRIMME_INT_P " Sec %e Eval %e Lin|r| %.3e EV|r| %.3e\n",
+                     primme->stats.numMatvecs, primme_wTimer(primme),
+                     s->eval_updated, s->tau, s->eres_updated);
+               fflush(primme->outputFile);
+            }
 
-         CHKERR(convTestFun_Sprimme(eval, NULL, tau/LTolerance_factor, &isConv,
-                  primme), -1);
+           /* --------------------------------------------------------*/
+         } /* End of if adaptive JDQMR section                        */
+           /* --------------------------------------------------------*/
+         else {
+            /* Check if the linear system residual norm (tau) is less            */
+            /* than eps*aNorm*LTolerance_factor                                  */
+
+            CHKERR(convTestFun_Sprimme(s->eval, NULL, s->tau/LTolerance_factor,
+                     &isConv, primme), -1);
+
+            if (numIts > 1 && isConv) {
+               if (primme->printLevel >= 5 && primme->procID == 0) {
+                  fprintf(primme->outputFile, " eigenvalue and residual norm "
+                        "passed convergence criterion \n");
+               }
+               s->stop = 1;
+               continue;
+            }
 
-         if (numIts > 1 && isConv) {
-            if (primme->printLevel >= 5 && primme->procID == 0) {
-               fprintf(primme->outputFile, " eigenvalue and residual norm "
-                     "passed convergence criterion \n");
+            else if (primme->printLevel >= 4 && primme->procID == 0) {
+               /* Report for non adaptive inner iterations */
+               fprintf(primme->outputFile,
+                     "INN MV %" PRIMME_INT_P " Sec %e Lin|r| %e\n",
+                     primme->stats.numMatvecs, primme_wTimer(primme),s->tau);
+               fflush(primme->outputFile);
             }
-            break;
          }
+      }
 
-         else if (primme->printLevel >= 4 && primme->procID == 0) {
-            /* Report for non adaptive inner iterations */
-            fprintf(primme->outputFile,
-                  "INN MV %" PRIMME_INT_P " Sec %e Lin|r| %e\n",
-                  primme->stats.numMatvecs, primme_wTimer(0),tau);
-            fflush(primme->outputFile);
+      /* Finish the projection of the preconditioned g of the vectors that */
+      /* keep iterating with the overlaps from the fused reduction         */
+
+      if (fused && numIts < maxIterations) {
+         for (j=0; j < n; j++) {
+            if (st[j].stop) continue;
+            CHKERR(fused_projected_preconditioner(&w[ld*j], &st[j],
+                     &sums[ldsums*j], RprojectorQ, ldRprojectorQ,
+                     sizeRprojectorQ, UDU, ipivot, QhatTx, RprojectorX,
+                     ldRprojectorX, sizeRprojectorX, xKinvx,
+                     &workSpace[ldsums*n], primme), -1);
          }
       }
 
-      if (numIts < maxIterations) {
+      n = compact_block(st, blockShifts, n, g, d, w, ld, primme);
 
-         CHKERR(apply_projected_preconditioner(g, evecs, ldevecs, RprojectorQ, 
-            ldRprojectorQ, x, RprojectorX, ldRprojectorX, sizeRprojectorQ,
-            sizeRprojectorX, xKinvx, UDU, ipivot, w, workSpace, primme), -1);
+      if (numIts < maxIterations && n > 0) {
+
+         if (!fused) {
+            CHKERR(apply_projected_preconditioner(g, ld, n, st, evecs,
+                     ldevecs, RprojectorQ, ldRprojectorQ, sizeRprojectorQ, UDU,
+                     ipivot, x, ldx, RprojectorX, ldRprojectorX,
+                     sizeRprojectorX, xKinvx, w, ld, workSpace, primme), -1);
+
+            CHKERR(dist_dots_real(g, ld, w, ld, n, dots, workSpace, primme),
+                  -1);
+            for (j=0; j < n; j++) st[j].rho = dots[j];
+         }
+
+         for (j=0; j < n; j++) {
+            qmr_state *s = &st[j];
+
+            s->beta = s->rho/s->rho_prev;
+            Num_axpy_Sprimme(primme->nLocal, s->beta, &d[ld*j], 1, &w[ld*j],
+                  1);
+
+            s->rho_prev = s->rho;
+            s->tau_prev = s->tau;
+            s->Theta_prev = s->Theta;
+
+            s->Delta_prev = s->Delta;
+            s->Beta_prev = s->Beta;
+            s->Phi_prev = s->Phi;
+            s->Psi_prev = s->Psi;
+            s->Gamma_prev = s->Gamma;
+         }
 
-         CHKERR(dist_dot_real(g, 1, w, 1, primme, &rho), -1);
-         beta = rho/rho_prev;
-         Num_axpy_Sprimme(primme->nLocal, beta, d, 1, w, 1);
          /* Alternate between w and d buffers in successive iterations
           * This saves a memory copy. */
          ptmp = d; d = w; w = ptmp;
-      
-         rho_prev = rho; 
-         tau_prev = tau;
-         Theta_prev = Theta;
-
-         Delta_prev = Delta;
-         Beta_prev = Beta;
-         Phi_prev = Phi;
-         Psi_prev = Psi;
-         Gamma_prev = Gamma;
       }
 
      /* --------------------------------------------------------*/
    } /* End of QMR main while loop                              */
      /* --------------------------------------------------------*/
 
-   *rnorm = eres_updated;
+   for (j=0; j < blockSize; j++) {
+      rnorm[st[j].col] = st[j].eres_updated;
+   }
+
    return 0;
 }
-   
+
 
 /*******************************************************************************
  * Function apply_projected_preconditioner - This routine applies the
- *    projected preconditioner to a vector v by computing:
+ *    projected preconditioner to the block vectors v by computing:
  *
- *         result = (I-Kinvx/xKinvx*x') (I - Qhat (Q'*Qhat)^{-1}Q') Kinv*v
+ *    result_i = (I-Kinvx_i/xKinvx_i*x_i') (I - Qhat (Q'*Qhat)^{-1}Q') Kinv*v_i
  *
- *    First we apply the preconditioner Kinv*v, and then the two projectors 
+ *    First we apply the preconditioner Kinv*v, and then the two projectors
  *    are computed one after the other.
- *    
+ *
  * Input Parameters
  * ----------------
- * v      The vector the projected preconditioner will be applied to.
+ * v      The vectors the projected preconditioner will be applied to.
+ *
+ * n      The number of vectors in v
+ *
+ * st     The states of the vectors in v
  *
  * Q      The matrix evecs where evecs are the locked/converged eigenvectors
  *
  * RprojectorQ     The matrix K^{-1}Q (often called Qhat), Q, or nothing,
  *                 as determined by setup_JD_projectors.
  *
- * x               The current Ritz vector.
- *
- * RprojectorX     The matrix K^{-1}x (if needed)
- *
  * sizeRprojectorQ The number of columns in RprojectorQ
  *
- * sizeRprojectorX The number of columns in RprojectorX
- *
- * xKinvx The value x^T (Kinv*x). It is computed in the setup_JD_projectors
- *
  * UDU    The UDU decomposition of (Q'*K^{-1}*Q).  See LAPACK routine dsytrf
  *        for more details
  *
  * ipivot Permutation array indicating how the rows of the UDU decomposition
  *        have been pivoted.
  *
- * rwork  Real work array of size 2*sizeRprojectorQ=(2*orthoConst+2*numEvals)
+ * x               The current Ritz vectors.
+ *
+ * RprojectorX     The matrix K^{-1}x (if needed)
+ *
+ * sizeRprojectorX 1 if the right projector for x is applied, 0 otherwise
+ *
+ * xKinvx The values x_i^T (Kinv*x_i). They are computed in setup_JD_projectors
+ *
+ * rwork  Real work array of size 2*(sizeRprojectorQ+1)*n
  *
  * primme   Structure containing various solver parameters.
  *
@@ -546,36 +797,39 @@ int inner_solve_Sprimme(SCALAR *x, SCALAR *r, REAL *rnorm, SCALAR *evecs,
  *
  ******************************************************************************/
 
-static int apply_projected_preconditioner(SCALAR *v, SCALAR *Q, PRIMME_INT ldQ,
-      SCALAR *RprojectorQ, PRIMME_INT ldRprojectorQ, SCALAR *x,
-      SCALAR *RprojectorX,  PRIMME_INT ldRprojectorX, int sizeRprojectorQ,
-      int sizeRprojectorX, SCALAR *xKinvx, SCALAR *UDU, int *ipivot,
-      SCALAR *result, SCALAR *rwork, primme_params *primme) {  
+static int apply_projected_preconditioner(SCALAR *v, PRIMME_INT ldv, int n,
+      qmr_state *st, SCALAR *Q, PRIMME_INT ldQ, SCALAR *RprojectorQ,
+      PRIMME_INT ldRprojectorQ, int sizeRprojectorQ, SCALAR *UDU, int *ipivot,
+      SCALAR *x, PRIMME_INT ldx, SCALAR *RprojectorX, PRIMME_INT ldRprojectorX,
+      int sizeRprojectorX, SCALAR *xKinvx, SCALAR *result,
+      PRIMME_INT ldresult, SCALAR *rwork, primme_params *primme) {
 
    /* Place K^{-1}v in result */
-   CHKERR(applyPreconditioner_Sprimme(v, primme->nLocal, primme->nLocal, result,
-            primme->nLocal, 1, primme), -1);
+   CHKERR(applyPreconditioner_Sprimme(v, primme->nLocal, ldv, result,
+            ldresult, n, primme), -1);
 
    CHKERR(apply_skew_projector(Q, ldQ, RprojectorQ, ldRprojectorQ, UDU, ipivot,
-            sizeRprojectorQ, result, rwork, primme), -1);
+            sizeRprojectorQ, result, ldresult, n, rwork, primme), -1);
 
-   CHKERR(apply_skew_projector(x, primme->nLocal, RprojectorX, ldRprojectorX,
-            xKinvx, ipivot, sizeRprojectorX, result, rwork, primme), -1);
+   if (sizeRprojectorX > 0) {
+      CHKERR(apply_skew_projector_x(x, ldx, RprojectorX, ldRprojectorX, xKinvx,
+               st, result, ldresult, n, rwork, primme), -1);
+   }
 
    return 0;
 }
 
 /*******************************************************************************
- * Subroutine apply_skew_projector - Apply the skew projector to a vector v:
+ * Subroutine apply_skew_projector - Apply the skew projector to the vectors v:
  *
  *     v = (I-Qhat*inv(Q'Qhat)*Q') v
  *
- *   The result is placed back in v.  Q is the matrix of converged Ritz 
- *   vectors or the current Ritz vector.
+ *   The result is placed back in v.  Q is the matrix of converged Ritz
+ *   vectors.
  *
  * Input Parameters
  * ----------------
- * Q       The matrix of converged Ritz vectors and the current Ritz vector
+ * Q       The matrix of converged Ritz vectors
  *
  * Qhat    The matrix of K^{-1}Q
  *
@@ -585,94 +839,144 @@ static int apply_projected_preconditioner(SCALAR *v, SCALAR *Q, PRIMME_INT ldQ,
  *
  * numCols Number of columns of Q and Qhat
  *
- * rwork   Work array of size 2*numCols
+ * n       Number of vectors in v
+ *
+ * rwork   Work array of size 2*numCols*n
  *
  * Input/Output Parameters
  * -----------------------
- * v       The vector to be skewed orthogonalized 
- * 
+ * v       The vectors to be skewed orthogonalized
+ *
  ******************************************************************************/
 
 static int apply_skew_projector(SCALAR *Q, PRIMME_INT ldQ, SCALAR *Qhat,
       PRIMME_INT ldQhat, SCALAR *UDU, int *ipivot, int numCols, SCALAR *v,
-      SCALAR *rwork, primme_params *primme) {
+      PRIMME_INT ldv, int n, SCALAR *rwork, primme_params *primme) {
 
-   if (numCols > 0) {    /* there is a projector to be applied */
+   int j;
+   SCALAR *overlaps;  /* overlaps of v with columns of Q   */
+   SCALAR *workSpace; /* Used for computing local overlaps */
 
-      SCALAR *overlaps;  /* overlaps of v with columns of Q   */
-      SCALAR *workSpace; /* Used for computing local overlaps */
+   if (numCols <= 0) return 0;    /* there is no projector to be applied */
 
-      overlaps = rwork;
-      workSpace = overlaps + numCols;
+   overlaps = rwork;
+   workSpace = overlaps + numCols*n;
+
+   /* Compute workspace = Q'*v */
+   Num_gemm_Sprimme("C", "N", numCols, n, primme->nLocal, 1.0, Q, ldQ, v, ldv,
+         0.0, workSpace, numCols);
+
+   /* Global sum: overlaps = Q'*v */
+   CHKERR(globalSum_Sprimme(workSpace, overlaps, numCols*n, primme), -1);
+
+   /* --------------------------------------------*/
+   /* Backsolve only if there is a skew projector */
+   /* --------------------------------------------*/
+   if (UDU != NULL) {
+      /* Solve (Q'Qhat)^{-1}*workSpace = overlaps = Q'*v for alpha by */
+      /* backsolving  with the UDU decomposition.                 */
+
+      CHKERRM(numCols == 1 && ABS(UDU[0]) == 0.0, -1,
+            "Failure factorizing UDU.");
+      for (j=0; j < n; j++) {
+         CHKERR(UDUSolve_Sprimme(UDU, ipivot, numCols, &overlaps[numCols*j],
+                  &workSpace[numCols*j], primme), -1);
+      }
 
-      /* --------------------------------------------------------*/
-      /* Treat the one vector case with BLAS 1 calls             */
-      /* --------------------------------------------------------*/
-      if (numCols == 1) {
-         /* Compute workspace = Q'*v */
-         CHKERR(dist_dot(Q, 1, v, 1, primme, &overlaps[0]), -1);
+      /* Compute v=v-Qhat*workspace */
+      Num_gemm_Sprimme("N", "N", primme->nLocal, n, numCols, -1.0, Qhat,
+            ldQhat, workSpace, numCols, 1.0, v, ldv);
+   }
+   else  {
+      /* Compute v=v-Qhat*overlaps  */
+      Num_gemm_Sprimme("N", "N", primme->nLocal, n, numCols, -1.0, Qhat,
+            ldQhat, overlaps, numCols, 1.0, v, ldv);
+   } /* UDU==null */
 
-         /* Backsolve only if there is a skew projector */
-         if (UDU != NULL) {
-            CHKERRM(ABS(UDU[0]) == 0.0, -1, "Failure factorizing UDU.");
-            overlaps[0] = overlaps[0]/UDU[0];
-         }
-         /* Compute v=v-Qhat*overlaps */
-         Num_axpy_Sprimme(primme->nLocal, -overlaps[0], Qhat, 1, v, 1);
-      }
-      else {
-         /* ------------------------------------------------------*/
-         /* More than one vectors. Use BLAS 2.                    */
-         /* ------------------------------------------------------*/
-         /* Compute workspace = Q'*v */
-         Num_gemv_Sprimme("C", primme->nLocal, numCols, 1.0, Q, ldQ, v, 1, 0.0,
-               workSpace, 1);
-
-         /* Global sum: overlaps = Q'*v */
-         CHKERR(globalSum_Sprimme(workSpace, overlaps, numCols, primme), -1);
-
-         /* --------------------------------------------*/
-         /* Backsolve only if there is a skew projector */
-         /* --------------------------------------------*/
-         if (UDU != NULL) {
-            /* Solve (Q'Qhat)^{-1}*workSpace = overlaps = Q'*v for alpha by */
-            /* backsolving  with the UDU decomposition.                 */
-   
-            CHKERR(UDUSolve_Sprimme(UDU, ipivot, numCols, overlaps,
-                     workSpace, primme), -1);
-
-            /* Compute v=v-Qhat*workspace */
-            Num_gemv_Sprimme("N", primme->nLocal, numCols, -1.0, Qhat, ldQhat,
-                  workSpace, 1, 1.0, v, 1);
-         }
-         else  {
-            /* Compute v=v-Qhat*overlaps  */
-            Num_gemv_Sprimme("N", primme->nLocal, numCols, -1.0, Qhat, ldQhat,
-                  overlaps, 1, 1.0, v, 1);
-         } /* UDU==null */
-      } /* numCols != 1 */
-   } /* numCols > 0 */
+   return 0;
+}
+
+/*******************************************************************************
+ * Subroutine apply_skew_projector_x - Apply the skew projector with the
+ *   Ritz vector x_i to each vector v_i:
+ *
+ *     v_i = (I-xhat_i*inv(x_i'xhat_i)*x_i') v_i
+ *
+ *   The result is placed back in v.
+ *
+ * Input Parameters
+ * ----------------
+ * x       The current Ritz vectors
+ *
+ * xhat    The matrix of K^{-1}x or x
+ *
+ * xKinvx  The values x_i'*xhat_i
+ *
+ * st      The states of the vectors in v; st[i].col is the column of x and
+ *         xhat corresponding to v_i
+ *
+ * n       Number of vectors in v
+ *
+ * rwork   Work array of size 2*n
+ *
+ * Input/Output Parameters
+ * -----------------------
+ * v       The vectors to be skewed orthogonalized
+ *
+ ******************************************************************************/
+
+static int apply_skew_projector_x(SCALAR *x, PRIMME_INT ldx, SCALAR *xhat,
+      PRIMME_INT ldxhat, SCALAR *xKinvx, qmr_state *st, SCALAR *v,
+      PRIMME_INT ldv, int n, SCALAR *rwork, primme_params *primme) {
+
+   int j;
+   SCALAR *overlaps;  /* overlaps of v_i with x_i          */
+   SCALAR *workSpace; /* Used for computing local overlaps */
+
+   overlaps = rwork;
+   workSpace = overlaps + n;
+
+   /* Compute workspace_i = x_i'*v_i */
+   for (j=0; j < n; j++) {
+      workSpace[j] = Num_dot_Sprimme(primme->nLocal, &x[ldx*st[j].col], 1,
+            &v[ldv*j], 1);
+   }
+   CHKERR(globalSum_Sprimme(workSpace, overlaps, n, primme), -1);
+
+   /* Compute v_i=v_i-xhat_i*overlaps_i/xKinvx_i */
+   for (j=0; j < n; j++) {
+      CHKERRM(ABS(xKinvx[st[j].col]) == 0.0, -1, "Failure factorizing UDU.");
+      Num_axpy_Sprimme(primme->nLocal, -overlaps[j]/xKinvx[st[j].col],
+            &xhat[ldxhat*st[j].col], 1, &v[ldv*j], 1);
+   }
 
    return 0;
 }
 
 
 /*******************************************************************************
- * Subroutine apply_projected_matrix - This subroutine applies the 
- *    projected matrix (I-Q*Q')*(A-shift*I) to a vector v by computing 
- *    (A-shift*I)v then orthogonalizing the result with Q.
+ * Subroutine apply_projected_matrix - This subroutine applies the
+ *    projected matrix (I-Q*Q')*(I-x_i*x_i')*(A-shift_i*I) to the vectors v_i
+ *    by computing (A-shift_i*I)v_i then orthogonalizing the result with Q
+ *    and x_i.
  *
  * Input Parameters
  * ----------------
- * v      The vector the projected matrix will be applied to
+ * v      The vectors the projected matrix will be applied to
  *
- * shift  The amount the matrix is shifted by.
+ * n      The number of vectors in v
  *
- * Q      The converged Ritz vectors and the current Ritz vector
+ * st     The states of the vectors in v, with the shifts
+ *
+ * Q      The converged Ritz vectors
  *
  * dimQ   The number of columns of Q
- * 
- * rwork  Workspace of size 2*dimQ
+ *
+ * x      The current Ritz vectors
+ *
+ * dimX   1 if x_i is in the projector, 0 otherwise
+ *
+ * rwork  Workspace of size 2*(dimQ+dimX)*n
  *
  * primme   Structure containing various solver parameters
  *
@@ -683,120 +987,446 @@ static int apply_skew_projector(SCALAR *Q, PRIMME_INT ldQ, SCALAR *Qhat,
  *
  ******************************************************************************/
 
-static int apply_projected_matrix(SCALAR *v, REAL shift, SCALAR *Q, 
-      PRIMME_INT ldQ, int dimQ, SCALAR *result, SCALAR *rwork,
-      primme_params *primme) {
+static int apply_projected_matrix(SCALAR *v, PRIMME_INT ldv, int n,
+      qmr_state *st, SCALAR *Q, PRIMME_INT ldQ, int dimQ, SCALAR *x,
+      PRIMME_INT ldx, int dimX, SCALAR *result, PRIMME_INT ldresult,
+      SCALAR *rwork, primme_params *primme) {
+
+   int j;
 
-   CHKERR(matrixMatvec_Sprimme(v, primme->nLocal, primme->nLocal, result,
-         primme->nLocal, 0, 1, primme), -1);
-   Num_axpy_Sprimme(primme->nLocal, -shift, v, 1, result, 1); 
-   if (dimQ > 0)
-      CHKERR(apply_projector(Q, ldQ, dimQ, result, rwork, primme), -1);
+   CHKERR(matrixMatvec_Sprimme(v, primme->nLocal, ldv, result, ldresult, 0, n,
+            primme), -1);
+   for (j=0; j < n; j++) {
+      Num_axpy_Sprimme(primme->nLocal, -st[j].shift, &v[ldv*j], 1,
+            &result[ldresult*j], 1);
+   }
+   if (dimQ + dimX > 0) {
+      CHKERR(apply_projector(Q, ldQ, dimQ, x, ldx, dimX, st, result, ldresult,
+               n, rwork, primme), -1);
+   }
 
    return 0;
 }
-   
+
 
 /*******************************************************************************
- * Subroutine apply_projector - Apply the projector (I-Q*Q') to a vector v and
- *   place the result in v.  Q is the matrix of converged Ritz vectors and the
- *   current Ritz vector.
+ * Subroutine apply_projector - Apply the projector (I-[Q x_i]*[Q x_i]') to
+ *   each vector v_i and place the result in v.  Q is the matrix of converged
+ *   Ritz vectors and x_i is the current Ritz vector. The overlaps with Q
+ *   and x_i are reduced together.
  *
  * Input Parameters
  * ----------------
- * Q       The matrix of converged Ritz vectors and the current Ritz vector
+ * Q        The matrix of converged Ritz vectors
+ *
+ * numCols  Number of columns of Q
+ *
+ * x        The current Ritz vectors
+ *
+ * numColsX 1 if x_i is in the projector, 0 otherwise
+ *
+ * st       The states of the vectors in v
  *
- * nLocal  The number of rows of Q and v the process has
- * 
- * numCols Number of columns of Q
+ * n        The number of vectors in v
  *
- * rwork   Work array of size 2*numCols
+ * rwork    Work array of size 2*(numCols+numColsX)*n
  *
  * Input/Output Parameters
  * -----------------------
- * v       The vector to be orthogonalized against Q
- * 
+ * v       The vectors to be orthogonalized against Q and x
+ *
  ******************************************************************************/
 
-static int apply_projector(SCALAR *Q, PRIMME_INT ldQ, int numCols, SCALAR *v, 
-   SCALAR *rwork, primme_params *primme) {
+static int apply_projector(SCALAR *Q, PRIMME_INT ldQ, int numCols, SCALAR *x,
+      PRIMME_INT ldx, int numColsX, qmr_state *st, SCALAR *v, PRIMME_INT ldv,
+      int n, SCALAR *rwork, primme_params *primme) {
 
+   int j;
+   int ldo = numCols + numColsX;   /* Leading dimension of overlaps */
    SCALAR *overlaps;  /* overlaps of v with columns of Q   */
    SCALAR *workSpace; /* Used for computing local overlaps */
 
    overlaps = rwork;
-   workSpace = overlaps + numCols;
+   workSpace = overlaps + ldo*n;
 
-   Num_gemv_Sprimme("C", primme->nLocal, numCols, 1.0, Q, ldQ, v, 1, 0.0,
-         workSpace, 1);
-   CHKERR(globalSum_Sprimme(workSpace, overlaps, numCols, primme), -1);
-   Num_gemv_Sprimme("N", primme->nLocal, numCols, -1.0, Q, ldQ, overlaps,
-         1, 1.0, v, 1);
+   if (numCols > 0) {
+      Num_gemm_Sprimme("C", "N", numCols, n, primme->nLocal, 1.0, Q, ldQ, v,
+            ldv, 0.0, workSpace, ldo);
+   }
+   if (numColsX > 0) {
+      for (j=0; j < n; j++) {
+         workSpace[ldo*j+numCols] = Num_dot_Sprimme(primme->nLocal,
+               &x[ldx*st[j].col], 1, &v[ldv*j], 1);
+      }
+   }
+   CHKERR(globalSum_Sprimme(workSpace, overlaps, ldo*n, primme), -1);
+   if (numCols > 0) {
+      Num_gemm_Sprimme("N", "N", primme->nLocal, n, numCols, -1.0, Q, ldQ,
+            overlaps, ldo, 1.0, v, ldv);
+   }
+   if (numColsX > 0) {
+      for (j=0; j < n; j++) {
+         Num_axpy_Sprimme(primme->nLocal, -overlaps[ldo*j+numCols],
+               &x[ldx*st[j].col], 1, &v[ldv*j], 1);
+      }
+   }
 
    return 0;
 }
 
 
 /*******************************************************************************
- * Function dist_dot - Computes dot products in parallel.
+ * Function dist_dots_real - Computes the dot products x_i'*y_i in parallel
+ *    for i=0:n-1 with a single global reduction, and return the real parts.
  *
  * Input Parameters
  * ----------------
- * x, y  Operands of the dot product operation
+ * x, y  Operands of the dot product operations
+ *
+ * ldx   The leading dimension of x
+ *
+ * ldy   The leading dimension of y
  *
- * incx  Array increment for x.  A value of 1 implies the elements are
- *       contiguous in memory.
+ * n     The number of columns of x and y
  *
- * incy  Array increment for y.  A value of 1 implies the elements are
- *       contiguous in memory.
+ * rwork Work array of size 2*n
  *
  * primme  Structure containing various solver parameters
  *
- * result The inner product
+ * Output Parameter
+ * ----------------
+ * result The real part of the inner products
  *
  ******************************************************************************/
 
-static int dist_dot(SCALAR *x, int incx,
-   SCALAR *y, int incy, primme_params *primme, SCALAR *result) {
-                                                                                
-   SCALAR temp;
-                                                                                
-   temp = Num_dot_Sprimme(primme->nLocal, x, incx, y, incy);
-   CHKERR(globalSum_Sprimme(&temp, result, 1, primme), -1);
+static int dist_dots_real(SCALAR *x, PRIMME_INT ldx, SCALAR *y,
+      PRIMME_INT ldy, int n, REAL *result, SCALAR *rwork,
+      primme_params *primme) {
+
+   int j;
+
+   for (j=0; j < n; j++) {
+      rwork[j] = Num_dot_Sprimme(primme->nLocal, &x[ldx*j], 1, &y[ldy*j], 1);
+   }
+   CHKERR(globalSum_Sprimme(rwork, &rwork[n], n, primme), -1);
+   for (j=0; j < n; j++) {
+      result[j] = REAL_PART(rwork[n+j]);
+   }
 
    return 0;
 }
 
 /*******************************************************************************
- * Function dist_dot_real - Computes dot products in parallel and return the
- *    real part.
-*
+ * Subroutine apply_projected_matrix_fused - This subroutine computes the same
+ *    as apply_projected_matrix followed by dist_dots_real(v, result), but
+ *    with a single global reduction. The overlaps [Q x_i]'*(A-shift_i*I)v_i,
+ *    [Q x_i]'*v_i and v_i'*(A-shift_i*I)v_i are reduced together, and then
+ *
+ *    sigma_i = v_i'*(A-shift_i*I)*v_i - (v_i'*[Q x_i])*([Q x_i]'*(A-shift_i*I)v_i)
+ *
  * Input Parameters
  * ----------------
- * x, y  Operands of the dot product operation
+ * v      The vectors the projected matrix will be applied to
  *
- * incx  Array increment for x.  A value of 1 implies the elements are
- *       contiguous in memory.
+ * n      The number of vectors in v
  *
- * incy  Array increment for y.  A value of 1 implies the elements are
- *       contiguous in memory.
+ * st     The states of the vectors in v, with the shifts
  *
- * primme  Structure containing various solver parameters
+ * Q      The converged Ritz vectors
  *
- * Output Parameter
+ * dimQ   The number of columns of Q
+ *
+ * x      The current Ritz vectors
+ *
+ * dimX   1 if x_i is in the projector, 0 otherwise
+ *
+ * rwork  Workspace of size 2*(2*(dimQ+dimX)+1)*n
+ *
+ * primme   Structure containing various solver parameters
+ *
+ *
+ * Output Parameters
+ * -----------------
+ * result The result of the application.
+ *
+ * sigma  The real part of v_i'*result_i
+ *
+ ******************************************************************************/
+
+static int apply_projected_matrix_fused(SCALAR *v, PRIMME_INT ldv, int n,
+      qmr_state *st, SCALAR *Q, PRIMME_INT ldQ, int dimQ, SCALAR *x,
+      PRIMME_INT ldx, int dimX, SCALAR *result, PRIMME_INT ldresult,
+      REAL *sigma, SCALAR *rwork, primme_params *primme) {
+
+   int i, j;
+   int ldo = 2*(dimQ+dimX)+1;   /* Leading dimension of overlaps */
+   SCALAR *overlaps;  /* overlaps of v and result with columns of Q and x */
+   SCALAR *workSpace; /* Used for computing local overlaps */
+   SCALAR *o, sig;
+
+   overlaps = rwork;
+   workSpace = overlaps + ldo*n;
+
+   CHKERR(matrixMatvec_Sprimme(v, primme->nLocal, ldv, result, ldresult, 0, n,
+            primme), -1);
+   for (j=0; j < n; j++) {
+      Num_axpy_Sprimme(primme->nLocal, -st[j].shift, &v[ldv*j], 1,
+            &result[ldresult*j], 1);
+   }
+
+   /* Pack [Q x_i]'*result_i, [Q x_i]'*v_i and v_i'*result_i */
+
+   if (dimQ > 0) {
+      Num_gemm_Sprimme("C", "N", dimQ, n, primme->nLocal, 1.0, Q, ldQ, result,
+            ldresult, 0.0, workSpace, ldo);
+      Num_gemm_Sprimme("C", "N", dimQ, n, primme->nLocal, 1.0, Q, ldQ, v, ldv,
+            0.0, &workSpace[dimQ+dimX], ldo);
+   }
+   for (j=0; j < n; j++) {
+      o = &workSpace[ldo*j];
+      if (dimX > 0) {
+         o[dimQ] = Num_dot_Sprimme(primme->nLocal, &x[ldx*st[j].col], 1,
+               &result[ldresult*j], 1);
+         o[2*dimQ+dimX] = Num_dot_Sprimme(primme->nLocal, &x[ldx*st[j].col], 1,
+               &v[ldv*j], 1);
+      }
+      o[ldo-1] = Num_dot_Sprimme(primme->nLocal, &v[ldv*j], 1,
+            &result[ldresult*j], 1);
+   }
+   CHKERR(globalSum_Sprimme(workSpace, overlaps, ldo*n, primme), -1);
+
+   /* result_i = result_i - [Q x_i]*([Q x_i]'*result_i) */
+
+   if (dimQ > 0) {
+      Num_gemm_Sprimme("N", "N", primme->nLocal, n, dimQ, -1.0, Q, ldQ,
+            overlaps, ldo, 1.0, result, ldresult);
+   }
+   for (j=0; j < n; j++) {
+      o = &overlaps[ldo*j];
+      if (dimX > 0) {
+         Num_axpy_Sprimme(primme->nLocal, -o[dimQ], &x[ldx*st[j].col], 1,
+               &result[ldresult*j], 1);
+      }
+      sig = o[ldo-1];
+      for (i=0; i < dimQ+dimX; i++) {
+         sig -= CONJ(o[dimQ+dimX+i])*o[i];
+      }
+      sigma[j] = REAL_PART(sig);
+   }
+
+   return 0;
+}
+
+
+/*******************************************************************************
+ * Function fused_sums - Computes with a single global reduction the overlaps
+ *    needed to project the preconditioned vectors w_i and all the inner
+ *    products of an inner step. Every column i of sums has:
+ *
+ *    [Q'*w_i; x_i'*w_i; Qhat'*g_i; xhat_i'*g_i] followed by
+ *    g_i'*w_i, g_i'*g_i, sol_i'*sol_i, sol_i'*delta_i, sol_i'*d_i,
+ *    delta_i'*delta_i, delta_i'*d_i and d_i'*d_i (see the FUSED_* positions).
+ *
+ * Input Parameters
+ * ----------------
+ * g, d, w  The QMR vectors; w is the preconditioned g, or NULL
+ *
+ * delta    The delta vectors, indexed by st[i].col
+ *
+ * ld       The leading dimension of g, d, delta and w
+ *
+ * n        The number of vectors in g, d and w
+ *
+ * st       The states of the vectors
+ *
+ * sol      The current solutions, indexed by st[i].col
+ *
+ * Q, RprojectorQ, dimQ  The matrix evecs, Qhat and their number of columns
+ *
+ * x, RprojectorX, dimX  The Ritz vectors, xhat and 1 if the projector with x
+ *                       is applied, 0 otherwise
+ *
+ * primme   Structure containing various solver parameters
+ *
+ * Output Parameters
+ * -----------------
+ * sums     Array of size 2*(2*(dimQ+dimX)+FUSED_NUM)*n; the first half has
+ *          the reduced values, and the second half is used as workspace
+ *
+ ******************************************************************************/
+
+static int fused_sums(SCALAR *g, SCALAR *d, SCALAR *delta, SCALAR *w,
+      PRIMME_INT ld, int n, qmr_state *st, SCALAR *sol, PRIMME_INT ldsol,
+      SCALAR *Q, PRIMME_INT ldQ, SCALAR *RprojectorQ,
+      PRIMME_INT ldRprojectorQ, int dimQ, SCALAR *x, PRIMME_INT ldx,
+      SCALAR *RprojectorX, PRIMME_INT ldRprojectorX, int dimX, SCALAR *sums,
+      primme_params *primme) {
+
+   int j;
+   int ldo = 2*(dimQ+dimX)+FUSED_NUM;   /* Leading dimension of sums */
+   SCALAR *workSpace; /* Used for computing local values */
+   SCALAR *o, *p, *solj, *deltaj, *dj, *gj;
+   PRIMME_INT nLocal = primme->nLocal;
+
+   workSpace = sums + ldo*n;
+
+   if (dimQ > 0) {
+      Num_gemm_Sprimme("C", "N", dimQ, n, nLocal, 1.0, Q, ldQ, w, ld, 0.0,
+            workSpace, ldo);
+      Num_gemm_Sprimme("C", "N", dimQ, n, nLocal, 1.0, RprojectorQ,
+            ldRprojectorQ, g, ld, 0.0, &workSpace[dimQ+dimX], ldo);
+   }
+   for (j=0; j < n; j++) {
+      o = &workSpace[ldo*j];
+      p = &o[ldo-FUSED_NUM];
+      gj = &g[ld*j];
+      dj = &d[ld*j];
+      deltaj = &delta[ld*st[j].col];
+      solj = &sol[ldsol*st[j].col];
+      if (dimX > 0) {
+         o[dimQ] = Num_dot_Sprimme(nLocal, &x[ldx*st[j].col], 1, &w[ld*j], 1);
+         o[2*dimQ+dimX] = Num_dot_Sprimme(nLocal,
+               &RprojectorX[ldRprojectorX*st[j].col], 1, gj, 1);
+      }
+      p[FUSED_GW] = w ? Num_dot_Sprimme(nLocal, gj, 1, &w[ld*j], 1) : 0.0;
+      p[FUSED_GG] = Num_dot_Sprimme(nLocal, gj, 1, gj, 1);
+      p[FUSED_SS] = Num_dot_Sprimme(nLocal, solj, 1, solj, 1);
+      p[FUSED_SDELTA] = Num_dot_Sprimme(nLocal, solj, 1, deltaj, 1);
+      p[FUSED_SD] = Num_dot_Sprimme(nLocal, solj, 1, dj, 1);
+      p[FUSED_DELTADELTA] = Num_dot_Sprimme(nLocal, deltaj, 1, deltaj, 1);
+      p[FUSED_DELTAD] = Num_dot_Sprimme(nLocal, deltaj, 1, dj, 1);
+      p[FUSED_DD] = Num_dot_Sprimme(nLocal, dj, 1, dj, 1);
+   }
+   CHKERR(globalSum_Sprimme(workSpace, sums, ldo*n, primme), -1);
+
+   return 0;
+}
+
+
+/*******************************************************************************
+ * Function fused_projected_preconditioner - Finishes the application of the
+ *    projected preconditioner to the vector w = Kinv*g with the overlaps
+ *    computed by fused_sums, and computes rho = g'*w without communication:
+ *
+ *    y = (Q'*Qhat)^{-1}*Q'*w,   w = w - Qhat*y,
+ *    z = x'*w/xKinvx,           w = w - xhat*z,
+ *    rho = g'*w - (g'*Qhat)*y - (g'*xhat)*z,
+ *
+ *    where x'*w after the first projection is x'*w - (x'*Qhat)*y.
+ *
+ * Input Parameters
  * ----------------
- * result The real part of the inner product
+ * s        The state of the vector; rho is set on output
+ *
+ * sums     The column of the fused reduction for the vector
+ *
+ * RprojectorQ, dimQ  The matrix Qhat and its number of columns
+ *
+ * UDU, ipivot  The factorization of Q'*Qhat, or NULL
+ *
+ * QhatTx   The values Qhat'*x
+ *
+ * RprojectorX, dimX  The matrix xhat and 1 if the projector with x is
+ *                    applied, 0 otherwise
+ *
+ * xKinvx   The values x_i'*xhat_i
+ *
+ * rwork    Work array of size dimQ
+ *
+ * Input/Output Parameters
+ * -----------------------
+ * w        The vector to be projected
  *
  ******************************************************************************/
 
-static int dist_dot_real(SCALAR *x, int incx,
-   SCALAR *y, int incy, primme_params *primme, REAL *result) {
-                                                                                
-   SCALAR temp, product;
-                                                                                
-   temp = Num_dot_Sprimme(primme->nLocal, x, incx, y, incy);
-   CHKERR(globalSum_Sprimme(&temp, &product, 1, primme), -1);
-   *result = REAL_PART(product);
+static int fused_projected_preconditioner(SCALAR *w, qmr_state *s,
+      SCALAR *sums, SCALAR *RprojectorQ, PRIMME_INT ldRprojectorQ, int dimQ,
+      SCALAR *UDU, int *ipivot, SCALAR *QhatTx, SCALAR *RprojectorX,
+      PRIMME_INT ldRprojectorX, int dimX, SCALAR *xKinvx, SCALAR *rwork,
+      primme_params *primme) {
+
+   int i;
+   SCALAR *y = sums, *gQhat = &sums[dimQ+dimX], xw, z, rho;
+
+   rho = sums[2*(dimQ+dimX)+FUSED_GW];
+
+   if (dimQ > 0) {
+      if (UDU != NULL) {
+         CHKERRM(dimQ == 1 && ABS(UDU[0]) == 0.0, -1,
+               "Failure factorizing UDU.");
+         CHKERR(UDUSolve_Sprimme(UDU, ipivot, dimQ, sums, rwork, primme), -1);
+         y = rwork;
+      }
+      Num_gemv_Sprimme("N", primme->nLocal, dimQ, -1.0, RprojectorQ,
+            ldRprojectorQ, y, 1, 1.0, w, 1);
+      for (i=0; i < dimQ; i++) {
+         rho -= CONJ(gQhat[i])*y[i];
+      }
+   }
+
+   if (dimX > 0) {
+      xw = sums[dimQ];
+      for (i=0; i < dimQ; i++) {
+         xw -= CONJ(QhatTx[dimQ*s->col+i])*y[i];
+      }
+      CHKERRM(ABS(xKinvx[s->col]) == 0.0, -1, "Failure factorizing UDU.");
+      z = xw/xKinvx[s->col];
+      Num_axpy_Sprimme(primme->nLocal, -z,
+            &RprojectorX[ldRprojectorX*s->col], 1, w, 1);
+      rho -= CONJ(gQhat[dimQ])*z;
+   }
+
+   s->rho = REAL_PART(rho);
 
    return 0;
 }
+
+/*******************************************************************************
+ * Function compact_block - Moves the vectors that have stopped iterating to
+ *    the end of the active block, so that the remaining ones are contiguous
+ *    in g, d and w.
+ *
+ * Input Parameters
+ * ----------------
+ * n     The number of vectors in the active block
+ *
+ * ld    The leading dimension of g, d and w
+ *
+ * Input/Output Parameters
+ * -----------------------
+ * st      The states of the vectors
+ *
+ * shifts  The preconditioner shifts of the vectors
+ *
+ * g, d, w The QMR vectors
+ *
+ * Return Value
+ * ------------
+ * The number of vectors that keep iterating
+ *
+ ******************************************************************************/
+
+static int compact_block(qmr_state *st, double *shifts, int n, SCALAR *g,
+      SCALAR *d, SCALAR *w, PRIMME_INT ld, primme_params *primme) {
+
+   int j;
+   qmr_state s;
+   double shift;
+
+   for (j=0; j < n; ) {
+      if (!st[j].stop) {
+         j++;
+         continue;
+      }
+      n--;
+      if (j < n) {
+         s = st[j]; st[j] = st[n]; st[n] = s;
+         shift = shifts[j]; shifts[j] = shifts[n]; shifts[n] = shift;
+         Num_swap_Sprimme(primme->nLocal, &g[ld*j], 1, &g[ld*n], 1);
+         Num_swap_Sprimme(primme->nLocal, &d[ld*j], 1, &d[ld*n], 1);
+         Num_swap_Sprimme(primme->nLocal, &w[ld*j], 1, &w[ld*n], 1);
+      }
+   }
+
+   return n;
+}
@@ -43,6 +43,7 @@
 #include "convergence.h"
 #include "auxiliary_eigs.h"
 #include "restart.h"
+#include "ortho.h"
 
 static void insertionSort(REAL newVal, REAL *evals, REAL newNorm,
    REAL *resNorms, int *perm, int numLocked, primme_params *primme);
@@ -51,7 +52,9 @@ static int compute_residual_columns(PRIMME_INT m, REAL *evals, SCALAR *x,
       int n, int *p, PRIMME_INT ldx, SCALAR *Ax, PRIMME_INT ldAx,
       SCALAR *xo, int no, PRIMME_INT ldxo, int io0, SCALAR *ro, PRIMME_INT ldro,
       SCALAR *xd, int nd, int *pd, PRIMME_INT ldxd, SCALAR *rd, PRIMME_INT ldrd,
-      SCALAR *rwork, PRIMME_INT lrwork);
+      SCALAR *Bx, PRIMME_INT ldBx, SCALAR *bxo, PRIMME_INT ldbxo, SCALAR *bxd,
+      PRIMME_INT ldbxd, SCALAR *rwork, PRIMME_INT lrwork,
+      primme_params *primme);
 
 /*******************************************************************************
  * Subroutine: restart_locking - This routine is only called when locking and
@@ -107,6 +110,9 @@ static int compute_residual_columns(PRIMME_INT m, REAL *evals, SCALAR *x,
  *
  * W                A*V
  *
+ * BV               B*V for the generalized problem, or NULL. After restart,
+ *                  the columns after the restarted basis have B*X
+ *
  * X                Reference to the Ritz vectors of the eigenpairs in the block
  *
  * R                Reference to the residual vectors of the eigenpairs in the block
@@ -128,6 +134,8 @@ static int compute_residual_columns(PRIMME_INT m, REAL *evals, SCALAR *x,
  *
  * evecs            The converged Ritz vectors
  *
+ * Bevecs           B*evecs for the generalized problem, or NULL
+ *
  * numConverged     The number of converged eigenpairs
  *
  * numLocked        The number of eigenpairs to be locked
@@ -164,10 +172,10 @@ static int compute_residual_columns(PRIMME_INT m, REAL *evals, SCALAR *x,
  
 TEMPLATE_PLEASE
 int restart_locking_Sprimme(int *restartSize, SCALAR *V, SCALAR *W, 
-      PRIMME_INT nLocal, int basisSize, PRIMME_INT ldV, SCALAR **X, SCALAR **R,
-      SCALAR *hVecs, int ldhVecs, int *restartPerm, REAL *hVals, int *flags,
-      int *iev, int *ievSize, REAL *blockNorms, SCALAR *evecs,
-      PRIMME_INT ldevecs, REAL *evals, int *numConverged, int *numLocked,
+      SCALAR *BV, PRIMME_INT nLocal, int basisSize, PRIMME_INT ldV, SCALAR **X,
+      SCALAR **R, SCALAR *hVecs, int ldhVecs, int *restartPerm, REAL *hVals,
+      int *flags, int *iev, int *ievSize, REAL *blockNorms, SCALAR *evecs,
+      PRIMME_INT ldevecs, SCALAR *Bevecs, PRIMME_INT ldBevecs, REAL *evals, int *numConverged, int *numLocked,
       REAL *resNorms, int *evecsperm, int numPrevRetained,
       int *indexOfPreviousVecs, int *hVecsPerm, int reset, double machEps,
       SCALAR *rwork, size_t *rworkSize, int *iwork, int iworkSize,
@@ -196,16 +204,23 @@ int restart_locking_Sprimme(int *restartSize, SCALAR *V, SCALAR *W,
       *rworkSize = max(*rworkSize, (size_t)
             compute_residual_columns(nLocal, NULL, NULL,
                basisSize, NULL, 0, NULL, 0, NULL, primme->maxBlockSize, 0, 0,
-               NULL, 0, NULL, primme->maxBlockSize, NULL, 0, NULL, 0, NULL, 0));
-      CHKERR(Num_reset_update_VWXR_Sprimme(NULL, NULL, nLocal, basisSize,
-               0, NULL, *restartSize, 0, NULL,
+               NULL, 0, NULL, primme->maxBlockSize, NULL, 0, NULL, 0, NULL, 0,
+               NULL, 0, NULL, 0, NULL, 0, primme));
+      CHKERR(Num_reset_update_VWXR_Sprimme(NULL, NULL, NULL, nLocal,
+               basisSize, 0, NULL, *restartSize, 0, NULL,
                &t, 0, *restartSize+*numLocked, 0,
                &t, 0, *ievSize, 0,
                &t, 0, *restartSize, *restartSize+*numLocked, 0,
                &t, 0, *restartSize, 0,
                &t, 0, *ievSize, 0, &d,
                &d, *restartSize, *numLocked,
+               NULL, 0, NULL, 0, NULL, 0,
                0, 0.0, NULL, rworkSize, primme), -1);
+      if (primme->massMatrixMatvec) {
+         CHKERR(Bortho_Sprimme(NULL, 0, NULL, 0, 0, *restartSize-1, NULL, 0,
+                  NULL, 0, primme->numOrthoConst+*numLocked, nLocal, NULL,
+                  0.0, NULL, rworkSize, primme), -1);
+      }
       CHKERR(check_convergence_Sprimme(NULL, nLocal, 0, NULL, 0, NULL,
                *numLocked, 0, *restartSize, *restartSize+*numLocked, NULL, NULL,
                NULL, NULL, 0.0, NULL, rworkSize, iwork, 0, primme), -1);
@@ -301,7 +316,7 @@ int restart_locking_Sprimme(int *restartSize, SCALAR *V, SCALAR *W,
    }
    *X = &V[*restartSize*ldV];
    *R = &W[*restartSize*ldV];
-   CHKERR(Num_reset_update_VWXR_Sprimme(V, W, nLocal, basisSize, ldV,
+   CHKERR(Num_reset_update_VWXR_Sprimme(V, W, BV, nLocal, basisSize, ldV,
             hVecs, *restartSize, ldhVecs, hVals,
             V, 0, *restartSize, ldV,
             *X, 0, sizeBlockNorms, ldV,
@@ -310,6 +325,7 @@ int restart_locking_Sprimme(int *restartSize, SCALAR *V, SCALAR *W,
             W, 0, *restartSize, ldV,
             *R, 0, sizeBlockNorms, ldV, blockNorms,
             lockedResNorms, left, *restartSize,
+            BV, ldV, BV?&BV[*restartSize*ldV]:NULL, ldV, Bevecs, ldBevecs,
             reset, machEps, rwork, &rworkSize0, primme), -1);
  
    /* -------------------------------------------------------------- */
@@ -336,6 +352,9 @@ int restart_locking_Sprimme(int *restartSize, SCALAR *V, SCALAR *W,
             Num_copy_matrix_Sprimme(&V[i*ldV], nLocal, 1, ldV,
                   &evecs[(*numLocked+primme->numOrthoConst+j)*ldevecs],
                   ldevecs);
+            if (Bevecs) Num_copy_matrix_Sprimme(&BV[i*ldV], nLocal, 1, ldV,
+                  &Bevecs[(*numLocked+primme->numOrthoConst+j)*ldBevecs],
+                  ldBevecs);
          }
          evals[*numLocked+j++] = hVals[i];
       }
@@ -423,7 +442,10 @@ int restart_locking_Sprimme(int *restartSize, SCALAR *V, SCALAR *W,
             &V[left*ldV], failed, ifailed, ldV, &W[left*ldV], ldV, *X,
             sizeBlockNorms, ldV, 0, *R, ldV,
             &V[(left+failed)*ldV], maxBlockSize, hVecsPerm, ldV,
-            &W[(left+failed)*ldV], ldV, rwork, TO_INT(rworkSize0));
+            &W[(left+failed)*ldV], ldV,
+            BV?&BV[left*ldV]:NULL, ldV, BV?&BV[*restartSize*ldV]:NULL, ldV,
+            BV?&BV[(left+failed)*ldV]:NULL, ldV, rwork, TO_INT(rworkSize0),
+            primme);
    }
    else {
       /* The failed pairs are not rearranged with the rest of           */
@@ -440,6 +462,8 @@ int restart_locking_Sprimme(int *restartSize, SCALAR *V, SCALAR *W,
             ifailed, &V[left*ldV], ldV, 0);
       Num_compact_vecs_Sprimme(&W[left*ldV], nLocal, failed, ldV,
             ifailed, &W[left*ldV], ldV, 0);
+      if (BV) Num_compact_vecs_Sprimme(&BV[left*ldV], nLocal, failed, ldV,
+            ifailed, &BV[left*ldV], ldV, 0);
 
       /* Copy X and R after the failed vectors */
 
@@ -447,6 +471,8 @@ int restart_locking_Sprimme(int *restartSize, SCALAR *V, SCALAR *W,
             &V[(left+failed)*ldV], ldV);
       Num_copy_matrix_Sprimme(*R, nLocal, sizeBlockNorms, ldV,
             &W[(left+failed)*ldV], ldV);
+      if (BV) Num_copy_matrix_Sprimme(&BV[*restartSize*ldV], nLocal,
+            sizeBlockNorms, ldV, &BV[(left+failed)*ldV], ldV);
    }
 
    /* Modify hVals, hVecs and restartPerm to add the pairs failed to */
@@ -476,6 +502,11 @@ int restart_locking_Sprimme(int *restartSize, SCALAR *V, SCALAR *W,
                   &evecs[(numLocked0+i-left+primme->numOrthoConst)*ldevecs],
                   nLocal, 1, ldevecs,
                   &evecs[(*numLocked+primme->numOrthoConst)*ldevecs], ldevecs);
+            if (Bevecs) Num_copy_matrix_Sprimme(
+                  &Bevecs[(numLocked0+i-left+primme->numOrthoConst)*ldBevecs],
+                  nLocal, 1, ldBevecs,
+                  &Bevecs[(*numLocked+primme->numOrthoConst)*ldBevecs],
+                  ldBevecs);
          }
          insertionSort(eval, evals, resNorm, resNorms, evecsperm,
             *numLocked, primme);
@@ -490,7 +521,7 @@ int restart_locking_Sprimme(int *restartSize, SCALAR *V, SCALAR *W,
             fprintf(primme->outputFile, 
                   "Lock epair[ %d ]= %e norm %.4e Mvecs %" PRIMME_INT_P " Time %.4e Flag %d\n",
                   *numLocked, eval, resNorm, 
-                  primme->stats.numMatvecs, primme_wTimer(0), flags[i]);
+                  primme->stats.numMatvecs, primme_wTimer(primme), flags[i]);
             fflush(primme->outputFile);
          }
       }
@@ -640,6 +671,10 @@ static void insertionSort(REAL newVal, REAL *evals, REAL newNorm,
  *       end if
  *    end for
  *
+ *    If Bx = B*X is given, it is rearranged as X into Bx and BXD, taking
+ *    the columns from BXO as XD from XO, and the residual vectors are
+ *    AX(p(k)) - evals(p(k))*Bx(p(k)).
+ *
  *           n        nd             no
  * X:  [-----|-------------]           (input/output)
  * XO:                      [--------| (input)
@@ -672,8 +707,15 @@ static void insertionSort(REAL newVal, REAL *evals, REAL newNorm,
  * ldxd        The leading dimension of xd
  * rd          The matrix that will have columns from r and ro
  * ldrd        The leading dimension of rd
+ * Bx          B*x (optional)
+ * ldBx        The leading dimension of Bx
+ * bxo         B*xo (required if Bx)
+ * ldbxo       The leading dimension of bxo
+ * bxd         The matrix that will have columns from Bx and bxo (required if Bx)
+ * ldbxd       The leading dimension of bxd
  * rwork       Workspace
  * lrwork      The size of rwork
+ * primme      Structure containing various solver parameters
  *
  ******************************************************************************/
 
@@ -681,15 +723,17 @@ static int compute_residual_columns(PRIMME_INT m, REAL *evals, SCALAR *x,
       int n, int *p, PRIMME_INT ldx, SCALAR *Ax, PRIMME_INT ldAx,
       SCALAR *xo, int no, PRIMME_INT ldxo, int io0, SCALAR *ro, PRIMME_INT ldro,
       SCALAR *xd, int nd, int *pd, PRIMME_INT ldxd, SCALAR *rd, PRIMME_INT ldrd,
-      SCALAR *rwork, PRIMME_INT lrwork) {
+      SCALAR *Bx, PRIMME_INT ldBx, SCALAR *bxo, PRIMME_INT ldbxo, SCALAR *bxd,
+      PRIMME_INT ldbxd, SCALAR *rwork, PRIMME_INT lrwork,
+      primme_params *primme) {
 
-   int i, id, k, io, M=min(m,PRIMME_BLOCK_SIZE);
-   SCALAR *X0, *R0;
+   int i, id, k, io, M=min(m,CACHE_BLOCK_SIZE(primme));
+   SCALAR *X0, *R0, *BX0;
 
    /* Return memory requirement */
 
    if (evals == NULL) {
-      return nd*M*2;
+      return nd*M*(primme->massMatrixMatvec ? 3 : 2);
    }
 
    /* Quick exit */
@@ -697,27 +741,37 @@ static int compute_residual_columns(PRIMME_INT m, REAL *evals, SCALAR *x,
    if (n == 0) {
       Num_copy_matrix_Sprimme(xo, m, min(no,nd), ldxo, xd, ldxd);
       Num_copy_matrix_Sprimme(ro, m, min(no,nd), ldro, rd, ldrd);
+      if (Bx) Num_copy_matrix_Sprimme(bxo, m, min(no,nd), ldbxo, bxd, ldbxd);
       return 0;
    }
 
    X0 = rwork;
    R0 = X0+nd*M;
-   assert(nd*M*2 <= lrwork);
+   BX0 = R0+nd*M;
+   assert(nd*M*(Bx ? 3 : 2) <= lrwork);
 
    for (k=0; k<m; k+=M, M=min(M,m-k)) {
       for (i=id=io=0; i < n || id < nd; id++) {
          if (id < nd && io < no && pd[id] == io+io0) {
             Num_copy_matrix_Sprimme(&xo[io*ldxo+k], M, 1, ldxo, &X0[id*M], M);
             Num_copy_matrix_Sprimme(&ro[io*ldro+k], M, 1, ldro, &R0[id*M], M);
+            if (Bx) Num_copy_matrix_Sprimme(&bxo[io*ldbxo+k], M, 1, ldbxo,
+                  &BX0[id*M], M);
             io++;
          }
          else {
             assert(id >= nd || i < n);
             Num_copy_matrix_Sprimme(&x[p[i]*ldx+k],   M, 1, ldx,  &x[i*ldx +k],  ldx);
             Num_copy_matrix_Sprimme(&Ax[p[i]*ldAx+k], M, 1, ldAx, &Ax[i*ldAx+k], ldAx);
+            if (Bx) Num_copy_matrix_Sprimme(&Bx[p[i]*ldBx+k], M, 1, ldBx,
+                  &Bx[i*ldBx+k], ldBx);
             if (id < nd) {
                Num_copy_matrix_Sprimme(&x[p[i]*ldx+k], M, 1, ldx, &X0[id*M], M);
-               Num_compute_residual_Sprimme(M, evals[p[i]], &x[p[i]*ldx+k], &Ax[p[i]*ldAx+k], &R0[id*M]);
+               Num_compute_residual_Sprimme(M, evals[p[i]],
+                     Bx ? &Bx[p[i]*ldBx+k] : &x[p[i]*ldx+k],
+                     &Ax[p[i]*ldAx+k], &R0[id*M]);
+               if (Bx) Num_copy_matrix_Sprimme(&Bx[p[i]*ldBx+k], M, 1, ldBx,
+                     &BX0[id*M], M);
             }
             i++;
          }
@@ -725,6 +779,7 @@ static int compute_residual_columns(PRIMME_INT m, REAL *evals, SCALAR *x,
       assert(id >= nd);
       Num_copy_matrix_Sprimme(X0, M, nd, M, &xd[k], ldxd);
       Num_copy_matrix_Sprimme(R0, M, nd, M, &rd[k], ldrd);
+      if (Bx) Num_copy_matrix_Sprimme(BX0, M, nd, M, &bxd[k], ldbxd);
    }
 
    return 0;
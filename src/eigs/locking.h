@@ -40,37 +40,37 @@
 #  define restart_locking_Rprimme CONCAT(restart_locking_,REAL_SUF)
 #endif
 int restart_locking_dprimme(int *restartSize, double *V, double *W,
-      int64_t nLocal, int basisSize, int64_t ldV, double **X, double **R,
-      double *hVecs, int ldhVecs, int *restartPerm, double *hVals, int *flags,
-      int *iev, int *ievSize, double *blockNorms, double *evecs,
-      int64_t ldevecs, double *evals, int *numConverged, int *numLocked,
+      double *BV, int64_t nLocal, int basisSize, int64_t ldV, double **X,
+      double **R, double *hVecs, int ldhVecs, int *restartPerm, double *hVals,
+      int *flags, int *iev, int *ievSize, double *blockNorms, double *evecs,
+      int64_t ldevecs, double *Bevecs, int64_t ldBevecs, double *evals, int *numConverged, int *numLocked,
       double *resNorms, int *evecsperm, int numPrevRetained,
       int *indexOfPreviousVecs, int *hVecsPerm, int reset, double machEps,
       double *rwork, size_t *rworkSize, int *iwork, int iworkSize,
       primme_params *primme);
 int restart_locking_zprimme(int *restartSize, PRIMME_COMPLEX_DOUBLE *V, PRIMME_COMPLEX_DOUBLE *W,
-      int64_t nLocal, int basisSize, int64_t ldV, PRIMME_COMPLEX_DOUBLE **X, PRIMME_COMPLEX_DOUBLE **R,
-      PRIMME_COMPLEX_DOUBLE *hVecs, int ldhVecs, int *restartPerm, double *hVals, int *flags,
-      int *iev, int *ievSize, double *blockNorms, PRIMME_COMPLEX_DOUBLE *evecs,
-      int64_t ldevecs, double *evals, int *numConverged, int *numLocked,
+      PRIMME_COMPLEX_DOUBLE *BV, int64_t nLocal, int basisSize, int64_t ldV, PRIMME_COMPLEX_DOUBLE **X,
+      PRIMME_COMPLEX_DOUBLE **R, PRIMME_COMPLEX_DOUBLE *hVecs, int ldhVecs, int *restartPerm, double *hVals,
+      int *flags, int *iev, int *ievSize, double *blockNorms, PRIMME_COMPLEX_DOUBLE *evecs,
+      int64_t ldevecs, PRIMME_COMPLEX_DOUBLE *Bevecs, int64_t ldBevecs, double *evals, int *numConverged, int *numLocked,
       double *resNorms, int *evecsperm, int numPrevRetained,
       int *indexOfPreviousVecs, int *hVecsPerm, int reset, double machEps,
       PRIMME_COMPLEX_DOUBLE *rwork, size_t *rworkSize, int *iwork, int iworkSize,
       primme_params *primme);
 int restart_locking_sprimme(int *restartSize, float *V, float *W,
-      int64_t nLocal, int basisSize, int64_t ldV, float **X, float **R,
-      float *hVecs, int ldhVecs, int *restartPerm, float *hVals, int *flags,
-      int *iev, int *ievSize, float *blockNorms, float *evecs,
-      int64_t ldevecs, float *evals, int *numConverged, int *numLocked,
+      float *BV, int64_t nLocal, int basisSize, int64_t ldV, float **X,
+      float **R, float *hVecs, int ldhVecs, int *restartPerm, float *hVals,
+      int *flags, int *iev, int *ievSize, float *blockNorms, float *evecs,
+      int64_t ldevecs, float *Bevecs, int64_t ldBevecs, float *evals, int *numConverged, int *numLocked,
       float *resNorms, int *evecsperm, int numPrevRetained,
       int *indexOfPreviousVecs, int *hVecsPerm, int reset, double machEps,
       float *rwork, size_t *rworkSize, int *iwork, int iworkSize,
       primme_params *primme);
 int restart_locking_cprimme(int *restartSize, PRIMME_COMPLEX_FLOAT *V, PRIMME_COMPLEX_FLOAT *W,
-      int64_t nLocal, int basisSize, int64_t ldV, PRIMME_COMPLEX_FLOAT **X, PRIMME_COMPLEX_FLOAT **R,
-      PRIMME_COMPLEX_FLOAT *hVecs, int ldhVecs, int *restartPerm, float *hVals, int *flags,
-      int *iev, int *ievSize, float *blockNorms, PRIMME_COMPLEX_FLOAT *evecs,
-      int64_t ldevecs, float *evals, int *numConverged, int *numLocked,
+      PRIMME_COMPLEX_FLOAT *BV, int64_t nLocal, int basisSize, int64_t ldV, PRIMME_COMPLEX_FLOAT **X,
+      PRIMME_COMPLEX_FLOAT **R, PRIMME_COMPLEX_FLOAT *hVecs, int ldhVecs, int *restartPerm, float *hVals,
+      int *flags, int *iev, int *ievSize, float *blockNorms, PRIMME_COMPLEX_FLOAT *evecs,
+      int64_t ldevecs, PRIMME_COMPLEX_FLOAT *Bevecs, int64_t ldBevecs, float *evals, int *numConverged, int *numLocked,
       float *resNorms, int *evecsperm, int numPrevRetained,
       int *indexOfPreviousVecs, int *hVecsPerm, int reset, double machEps,
       PRIMME_COMPLEX_FLOAT *rwork, size_t *rworkSize, int *iwork, int iworkSize,
@@ -52,12 +52,24 @@
 #include "update_W.h"
 #include "globalsum.h"
 #include "auxiliary_eigs.h"
+#include "checkpoint.h"
+#include "factorize.h"
 
 static int verify_norms(SCALAR *V, PRIMME_INT ldV, SCALAR *W, PRIMME_INT ldW,
-      REAL *hVals, int basisSize, REAL *resNorms, int *flags, int *converged,
+      SCALAR *BV, REAL *hVals, int basisSize, REAL *convNorms, REAL *convVals,
+      int numConvNorms, REAL *resNorms, int *flags, int *converged,
       double machEps, SCALAR *rwork, size_t *rworkSize, int *iwork,
       int iworkSize, primme_params *primme);
 
+static int estimate_norms(SCALAR *H, int ldH, SCALAR *WtW, int ldWtW,
+      SCALAR *hVecs, int ldhVecs, REAL *hVals, int basisSize, int n,
+      double orthoLoss, double machEps, REAL *norms, SCALAR *rwork,
+      size_t rworkSize, primme_params *primme);
+
+static int measure_ortho_loss(SCALAR *V, PRIMME_INT ldV, PRIMME_INT nLocal,
+      int basisSize, double *loss, SCALAR *rwork, size_t rworkSize,
+      primme_params *primme);
+
 static void print_residuals(REAL *ritzValues, REAL *blockNorms,
    int numConverged, int numLocked, int *iev, int blockSize, 
    primme_params *primme);
@@ -108,6 +120,8 @@ static void print_residuals(REAL *ritzValues, REAL *blockNorms,
  *
  * realWork SCALAR work array
  *
+ * basis    Space for V, W, BV and Q, or NULL to take them from realWork
+ *
  * INPUT/OUTPUT arrays and parameters
  * ----------------------------------
  * evecs    Stores initial guesses. Upon return, it contains the converged Ritz
@@ -139,7 +153,7 @@ static void print_residuals(REAL *ritzValues, REAL *blockNorms,
 TEMPLATE_PLEASE
 int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
    REAL *resNorms, double machEps, int *intWork, void *realWork, 
-   primme_params *primme) {
+   SCALAR *basis, primme_params *primme) {
          
    int i;                   /* Loop variable                                 */
    int blockSize;           /* Current block size                            */
@@ -166,6 +180,8 @@ int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
    size_t rworkSize;        /* Size of rwork array                           */
    int iworkSize;           /* Size of iwork array                           */
    int numPrevRitzVals = 0; /* Size of the prevRitzVals updated in correction*/
+   int numConvNorms = 0;    /* Number of residual norms kept by restart      */
+   int modelBlockSize;      /* Block size chosen by the dynamic block size   */
    int ret;                 /* Return value                                  */
 
    int *iwork;              /* Integer workspace pointer                     */
@@ -177,6 +193,10 @@ int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
    PRIMME_INT ldV;          /* The leading dimension of V                    */
    SCALAR *W;               /* Work space storing A*V                        */
    PRIMME_INT ldW;          /* The leading dimension of W                    */
+   SCALAR *BV = NULL;       /* B*V for the generalized problem; it has the   */
+                            /* leading dimension of V                        */
+   SCALAR *Bevecs = NULL;   /* B*evecs for the generalized problem with      */
+                            /* locking; its leading dimension is nLocal      */
    SCALAR *H;               /* Upper triangular portion of V'*A*V            */
    SCALAR *M = NULL;        /* The projection Q'*K*Q, where Q = [evecs, x]   */
                             /* x is the current Ritz vector and K is a       */
@@ -185,6 +205,7 @@ int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
    SCALAR *evecsHat = NULL; /* K^{-1}evecs                                   */
    PRIMME_INT ldevecsHat=0; /* The leading dimension of evecsHat             */
    SCALAR *rwork;           /* Real work space.                              */
+   SCALAR *bwork;           /* Space for V, W, BV and Q                      */
    SCALAR *hVecs;           /* Eigenvectors of H                             */
    SCALAR *hU=NULL;         /* Left singular vectors of R                    */
    SCALAR *previousHVecs;   /* Coefficient vectors retained by               */
@@ -196,6 +217,12 @@ int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
    SCALAR *R = NULL;        /* projection: (A-target[i])*V = QR              */
    SCALAR *QtV = NULL;      /* Q'*V                                          */
    SCALAR *hVecsRot=NULL;   /* transformation of hVecs in arbitrary vectors  */
+   SCALAR *WtW = NULL;      /* W'*W, updated by the pipelined ortho          */
+   int sizeWtW = 0;         /* Number of columns of W in WtW                 */
+   int pipelined;           /* Use the pipelined ortho in this iteration     */
+   int projected;           /* The pipelined ortho has updated H             */
+   double orthoLoss = 0.0;  /* Bound of ||V'*V - I|| with the pipelined ortho*/
+   double loss;             /* orthoLoss after this iteration                */
 
    REAL *hVals;           /* Eigenvalues of H                              */
    REAL *hSVals=NULL;     /* Singular values of R                          */
@@ -203,15 +230,21 @@ int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
                             /* by robust shifting algorithm in correction.c  */
    REAL *blockNorms;      /* Residual norms corresponding to current block */
                             /* vectors.                                      */
+   REAL *convNorms;       /* Residual norms of the converged pairs computed*/
+                            /* in the last restart                           */
+   REAL *convVals;        /* Values used to compute convNorms              */
    double smallestResNorm;  /* the smallest residual norm in the block       */
    int reset=0;             /* Flag to reset V and W                         */
    int restartsSinceReset=0;/* Restart since last reset of V and W           */
    int wholeSpace=0;        /* search subspace reach max size                */
+   int checkpointSlot=-1;   /* Last complete slot in the checkpoint file     */
+   int numLockedSaved=0;    /* Locked vectors already in the checkpoint file */
 
    /* Runtime measurement variables for dynamic method switching             */
    primme_CostModel CostModel; /* Structure holding the runtime estimates of */
                             /* the parameters of the model.Only visible here */
    double tstart=0.0;       /* Timing variable for accumulative time spent   */
+   double tmon;             /* Start of the phase reported to the monitor    */
 
    /* -------------------------------------------------------------- */
    /* Subdivide the workspace                                        */
@@ -229,10 +262,17 @@ int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
 
    ldV = ldW = ldQ = primme->ldOPs;
    rwork         = (SCALAR *) realWork;
-   V             = rwork; rwork += primme->ldOPs*primme->maxBasisSize;
-   W             = rwork; rwork += primme->ldOPs*primme->maxBasisSize;
+   bwork         = basis ? basis : rwork;
+   V             = bwork; bwork += primme->ldOPs*primme->maxBasisSize;
+   W             = bwork; bwork += primme->ldOPs*primme->maxBasisSize;
+   if (primme->massMatrixMatvec) {
+      BV         = bwork; bwork += primme->ldOPs*primme->maxBasisSize;
+   }
+   if (numQR > 0) {
+      Q          = bwork; bwork += primme->ldOPs*primme->maxBasisSize*numQR;
+   }
+   if (!basis) rwork = bwork;
    if (numQR > 0) {
-      Q          = rwork; rwork += primme->ldOPs*primme->maxBasisSize*numQR;
       R          = rwork; rwork += primme->maxBasisSize*primme->maxBasisSize*numQR;
       hU         = rwork; rwork += primme->maxBasisSize*primme->maxBasisSize*numQR;
    }
@@ -246,6 +286,9 @@ int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
        || primme->projectionParams.projection == primme_proj_harmonic) {
       hVecsRot   = rwork; rwork += primme->maxBasisSize*primme->maxBasisSize*numQR;
    }
+   if (primme->orth == primme_orth_pipelined) {
+      WtW        = rwork; rwork += primme->maxBasisSize*primme->maxBasisSize;
+   }
 
    if (primme->correctionParams.precondition && 
          primme->correctionParams.maxInnerIterations != 0 &&
@@ -256,6 +299,9 @@ int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
       M          = rwork; rwork += maxEvecsSize*maxEvecsSize;
       UDU        = rwork; rwork += maxEvecsSize*maxEvecsSize;
    }
+   if (primme->massMatrixMatvec && primme->locking) {
+      Bevecs     = rwork; rwork += primme->nLocal*maxEvecsSize;
+   }
 
    #ifndef USE_COMPLEX
    #  define TO_REAL(X) X
@@ -268,6 +314,8 @@ int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
    }
    prevRitzVals  = (REAL *)rwork; rwork += TO_REAL(primme->maxBasisSize+primme->numEvals);
    blockNorms    = (REAL *)rwork; rwork += TO_REAL(primme->maxBlockSize);
+   convNorms     = (REAL *)rwork; rwork += TO_REAL(primme->maxBasisSize);
+   convVals      = (REAL *)rwork; rwork += TO_REAL(primme->maxBasisSize);
    #undef TO_REAL
 
    rworkSize     = primme->realWorkSize/sizeof(SCALAR) - (rwork - (SCALAR*)realWork);
@@ -293,6 +341,7 @@ int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
    primme->stats.timePrecond = 0.0;
    primme->stats.timeOrtho = 0.0;
    primme->stats.timeGlobalSum = 0.0;
+   primme->stats.numGlobalSum = 0;
    primme->stats.volumeGlobalSum = 0.0;
    primme->stats.numOrthoInnerProds = 0.0;
    primme->stats.estimateMaxEVal   = -HUGE_VAL;
@@ -300,6 +349,7 @@ int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
    primme->stats.estimateLargestSVal = -HUGE_VAL;
    primme->stats.maxConvTol        = 0.0L;
    primme->stats.estimateResidualError = 0.0L;
+   primme->stats.avgBlockSize      = 0.0;
 
    numLocked = 0;
    converged = FALSE;
@@ -320,6 +370,13 @@ int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
             W, ldW, 0, 1, primme), -1);
       evals[0] = REAL_PART(W[0]);
       V[0] = 1.0;
+      if (BV) {
+         /* A*x = lambda*B*x with x B-normalized */
+         CHKERR(massMatrixMatvec_Sprimme(&evecs[0], primme->nLocal, ldevecs,
+               BV, ldV, 0, 1, primme), -1);
+         evals[0] /= REAL_PART(BV[0]);
+         evecs[0] = V[0] = 1.0/sqrt(REAL_PART(BV[0]));
+      }
 
       resNorms[0] = 0.0L;
       primme->stats.numMatvecs++;
@@ -336,14 +393,59 @@ int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
       primme->restartingParams.maxPrevRetain = 0;
    }
 
-   /* -------------------- */
-   /* Initialize the basis */
-   /* -------------------- */
+   /* ------------------------------------------------------ */
+   /* Initialize the basis, or restore it from the checkpoint */
+   /* ------------------------------------------------------ */
+
+   tmon = primme_get_wtime();
+   if (!primme->checkpointResume) {
+      CHKERR(init_basis_Sprimme(V, primme->nLocal, ldV, W, ldW, BV, evecs,
+               ldevecs, evecsHat, primme->nLocal, M, maxEvecsSize, UDU, 0,
+               ipivot, machEps, rwork, &rworkSize, &basisSize, &nextGuess,
+               &numGuesses, primme), -1);
+   }
+   else {
+      /* Orthonormalize the constraints as init_basis does. The initial */
+      /* guesses are not used.                                          */
+
+      if (primme->numOrthoConst > 0) {
+         CHKERR(ortho_Sprimme(evecs, ldevecs, NULL, 0, 0,
+                  primme->numOrthoConst - 1, NULL, 0, 0, primme->nLocal,
+                  primme->iseed, machEps, rwork, &rworkSize, primme), -1);
+      }
+      CHKERRNOABORT(read_checkpoint_Sprimme(V, W, BV, ldV, &basisSize, evecs,
+               ldevecs, evals, resNorms, perm, &numLocked,
+               &restartsSinceReset, &checkpointSlot, &numLockedSaved, primme),
+            -1);
+      nextGuess = numGuesses = 0;
+
+      /* The checkpoint has the locked vectors but not B times them */
+
+      if (Bevecs && numLocked > 0) {
+         CHKERR(massMatrixMatvec_Sprimme(evecs, primme->nLocal, ldevecs,
+                  Bevecs, primme->nLocal, primme->numOrthoConst, numLocked,
+                  primme), -1);
+      }
 
-   CHKERR(init_basis_Sprimme(V, primme->nLocal, ldV, W, ldW, evecs, ldevecs,
-            evecsHat, primme->nLocal, M, maxEvecsSize, UDU, 0, ipivot, machEps,
-            rwork, &rworkSize, &basisSize, &nextGuess, &numGuesses, primme),
-         -1);
+      /* Initialize evecsHat, M and UDU with the constraints and the */
+      /* locked vectors                                              */
+
+      if (UDU && primme->numOrthoConst+numLocked > 0) {
+         CHKERR(applyPreconditioner_Sprimme(evecs, primme->nLocal, ldevecs,
+                  evecsHat, ldevecsHat, primme->numOrthoConst+numLocked,
+                  primme), -1);
+         CHKERR(update_projection_Sprimme(evecs, ldevecs, evecsHat,
+                  ldevecsHat, M, maxEvecsSize, primme->nLocal, 0,
+                  primme->numOrthoConst+numLocked, rwork, &rworkSize,
+                  1/*symmetric*/, primme), -1);
+         CHKERR(UDUDecompose_Sprimme(M, maxEvecsSize, UDU, maxEvecsSize,
+                  ipivot, primme->numOrthoConst+numLocked, rwork, &rworkSize,
+                  primme), -1);
+      }
+   }
+
+   CHKERR(monitor_Sprimme(primme_event_init, tmon, basisSize, 0, NULL,
+            numLocked, primme), -1);
 
    /* Now initSize will store the number of converged pairs */
    primme->initSize = 0;
@@ -362,6 +464,15 @@ int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
       primme->correctionParams.maxInnerIterations = 0; 
    }
 
+   /* ----------------------------------------------------------- */
+   /* Dynamic block size means that the block size is chosen at   */
+   /* every outer iteration based on runtime measurements         */
+   /* ----------------------------------------------------------- */
+   modelBlockSize = primme->maxBlockSize;
+   if (primme->dynamicBlockSize && primme->maxBlockSize > 1) {
+      initializeBlockModel(&CostModel, primme);
+   }
+
    /* ---------------------------------------------------------------------- */
    /* Outer most loop                                                        */
    /* Without locking, restarting can cause converged Ritz values to become  */
@@ -373,15 +484,17 @@ int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
           ( primme->maxOuterIterations == 0 ||
             primme->stats.numOuterIterations < primme->maxOuterIterations) ) {
 
-      /* Reset convergence flags. This may only reoccur without locking */
+      /* Reset convergence flags. This may only reoccur without locking. */
+      /* numLocked is nonzero only when resuming from a checkpoint.      */
 
-      primme->initSize = numConverged = numConvergedStored = 0;
+      primme->initSize = numConverged = numConvergedStored = numLocked;
       for (i=0; i<primme->maxBasisSize; i++)
          flags[i] = UNCONVERGED;
+      numConvNorms = sizeWtW = 0;
 
       /* Compute the initial H and solve for its eigenpairs */
 
-      targetShiftIndex = 0;
+      targetShiftIndex = max(0, min(primme->numTargetShifts-1, numLocked));
       if (Q) CHKERR(update_Q_Sprimme(V, primme->nLocal, ldV, W, ldW, Q, ldQ, R,
                primme->maxBasisSize, primme->targetShifts[targetShiftIndex], 0,
                basisSize, rwork, &rworkSize, machEps, primme), -1);
@@ -437,7 +550,7 @@ int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
                maxRecentlyConverged = numConverged-numLocked+1;
             }
             else {
-               availableBlockSize = primme->maxBlockSize;
+               availableBlockSize = modelBlockSize;
                maxRecentlyConverged = primme->numEvals-numConverged;
             }
 
@@ -454,12 +567,34 @@ int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
             availableBlockSize = min(availableBlockSize, 
                   primme->n - basisSize - numLocked - primme->numOrthoConst);
 
+            /* Drop the candidates computed in restart that do not fit in a */
+            /* block smaller than the one chosen before restarting          */
+
+            blockSize = min(blockSize, max(availableBlockSize, 0));
+
+            /* The pipelined ortho needs W'*W, which is not updated by */
+            /* restart. It doesn't support B-orthonormalization or     */
+            /* orthogonalizing against evecs, and it isn't used on     */
+            /* filtered corrections, which are almost in the span of V */
+
+            pipelined = WtW && !BV
+               && primme->numOrthoConst + numLocked == 0
+               && primme->correctionParams.filterDegree == 0;
+            if (pipelined && sizeWtW != basisSize) {
+               CHKERR(update_projection_Sprimme(W, ldW, W, ldW, WtW,
+                        primme->maxBasisSize, primme->nLocal, 0, basisSize,
+                        rwork, &rworkSize, 1/*symmetric*/, primme), -1);
+               sizeWtW = basisSize;
+            }
+
             /* Set the block with the first unconverged pairs */
+            tmon = primme_get_wtime();
             if (availableBlockSize > 0) {
-               prepare_candidates_Sprimme(V, ldV, W, ldW, primme->nLocal, H,
-                  primme->maxBasisSize, basisSize,
+               prepare_candidates_Sprimme(V, ldV, W, ldW, BV, primme->nLocal,
+                  H, primme->maxBasisSize, pipelined?WtW:NULL,
+                  primme->maxBasisSize, orthoLoss, basisSize,
                   &V[basisSize*ldV], &W[basisSize*ldW],
-                  hVecs, basisSize, hVals, hSVals, flags,
+                  BV?&BV[basisSize*ldV]:NULL, hVecs, basisSize, hVals, hSVals, flags,
                   maxRecentlyConverged, blockNorms, blockSize,
                   availableBlockSize, evecs, numLocked, ldevecs, evals,
                   resNorms, targetShiftIndex, machEps, iev, &blockSize,
@@ -470,6 +605,15 @@ int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
             else {
                blockSize = recentlyConverged = 0;
             }
+            CHKERR(monitor_Sprimme(primme_event_prepare_candidates, tmon,
+                     basisSize, blockSize, NULL, numConverged, primme), -1);
+
+            /* Choose the block size for the next iteration */
+
+            if (primme->dynamicBlockSize && primme->maxBlockSize > 1) {
+               modelBlockSize = update_block_size(&CostModel, primme,
+                     blockSize > 0 ? blockNorms[0] : -1.0, recentlyConverged);
+            }
 
             /* print residuals */
             print_residuals(hVals, blockNorms, numConverged, numLocked, iev, blockSize,
@@ -485,6 +629,10 @@ int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
 
             numConverged += recentlyConverged;
 
+            CHKERR(monitor_Sprimme(primme_event_iteration, primme_get_wtime(),
+                     basisSize, blockSize, blockNorms, numConverged, primme),
+                  -1);
+
             if (numConverged >= primme->numEvals ||
                 (primme->locking && recentlyConverged > 0
                   && primme->target != primme_smallest
@@ -511,6 +659,7 @@ int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
                blockSize = availableBlockSize;
                Num_scal_Sprimme(blockSize*primme->nLocal, 0.0,
                   &V[ldV*basisSize], 1);
+               pipelined = 0;
             }
             else {
 
@@ -520,7 +669,7 @@ int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
                /* - - - - - - - - - - - - - - - - - - - - - - - - - - -  */
                /* If dynamic method switching, time the inner method     */
                if (primme->dynamicMethodSwitch > 0) {
-                  tstart = primme_wTimer(0); /* accumulate correction time */
+                  tstart = primme_wTimer(primme); /* accumulate correction time */
 
                   if (CostModel.resid_0 == -1.0L)       /* remember the very */
                      CostModel.resid_0 = blockNorms[0]; /* first residual */
@@ -547,34 +696,90 @@ int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
                } /* dynamic switching */
                /* - - - - - - - - - - - - - - - - - - - - - - - - - - -  */
 
-               CHKERR(solve_correction_Sprimme(V, ldV, W, ldW, evecs, ldevecs,
+               tmon = primme_get_wtime();
+               CHKERR(solve_correction_Sprimme(V, ldV, W, ldW, BV, evecs,
+                        ldevecs,
                         evecsHat, ldevecsHat, UDU, ipivot, evals, numLocked,
                         numConvergedStored, hVals, prevRitzVals,
                         &numPrevRitzVals, flags, basisSize, blockNorms, iev,
                         blockSize, machEps, rwork, &rworkSize, iwork, iworkSize,
                         primme), -1);
+               CHKERR(monitor_Sprimme(primme_event_correction, tmon, basisSize,
+                        blockSize, NULL, numConverged, primme), -1);
 
                /* ------------------------------------------------------ */
                /* If dynamic method switch, accumulate inner method time */
                /* ------------------------------------------------------ */
                if (primme->dynamicMethodSwitch > 0) 
-                  CostModel.time_in_inner += primme_wTimer(0) - tstart;
+                  CostModel.time_in_inner += primme_wTimer(primme) - tstart;
 
               
             } /* end of else blocksize=0 */
 
-            /* Orthogonalize the corrections with respect to each other */
-            /* and the current basis.                                   */
-            CHKERR(ortho_Sprimme(V, ldV, NULL, 0, basisSize, 
-               basisSize+blockSize-1, evecs, ldevecs, 
-               primme->numOrthoConst+numLocked, primme->nLocal, primme->iseed, 
-               machEps, rwork, &rworkSize, primme), -1);
+            primme->stats.avgBlockSize += (blockSize
+                  - primme->stats.avgBlockSize)
+               / primme->stats.numOuterIterations;
+
+            /* With the pipelined ortho, compute W = A*V for the         */
+            /* corrections first; then orthonormalizing them, updating W */
+            /* and the new columns of H and W'*W take one global sum.    */
+
+            projected = 0;
+            if (pipelined) {
+               tmon = primme_get_wtime();
+               CHKERR(matrixMatvec_Sprimme(V, primme->nLocal, ldV, W, ldW,
+                        basisSize, blockSize, primme), -1);
+               CHKERR(monitor_Sprimme(primme_event_matvec, tmon, basisSize,
+                        blockSize, NULL, numConverged, primme), -1);
+
+               tmon = primme_get_wtime();
+               loss = orthoLoss;
+               ret = ortho_pipelined_Sprimme(V, ldV, W, ldW, H,
+                     primme->maxBasisSize, WtW, primme->maxBasisSize,
+                     primme->nLocal, basisSize, blockSize, machEps, &loss,
+                     rwork, &rworkSize, primme);
+               CHKERR(ret < 0, -1);
+               CHKERR(monitor_Sprimme(primme_event_ortho, tmon, basisSize,
+                        blockSize, NULL, numConverged, primme), -1);
+               if (ret == 0) {
+                  projected = 1;
+                  orthoLoss = loss;
+                  sizeWtW = basisSize + blockSize;
+               }
+            }
 
-            /* Compute W = A*V for the orthogonalized corrections */
+            if (!projected) {
+               sizeWtW = 0;
+
+               /* Orthogonalize the corrections with respect to each other */
+               /* and the current basis.                                   */
+               tmon = primme_get_wtime();
+               if (BV) {
+                  CHKERR(Bortho_Sprimme(V, ldV, BV, ldV, basisSize,
+                           basisSize+blockSize-1, evecs, ldevecs, Bevecs,
+                           primme->nLocal, primme->numOrthoConst+numLocked,
+                           primme->nLocal, primme->iseed, machEps, rwork,
+                           &rworkSize, primme), -1);
+               }
+               else {
+                  CHKERR(ortho_Sprimme(V, ldV, NULL, 0, basisSize, 
+                     basisSize+blockSize-1, evecs, ldevecs, 
+                     primme->numOrthoConst+numLocked, primme->nLocal,
+                     primme->iseed, machEps, rwork, &rworkSize, primme), -1);
+               }
+               CHKERR(monitor_Sprimme(primme_event_ortho, tmon, basisSize,
+                        blockSize, NULL, numConverged, primme), -1);
 
-            CHKERR(matrixMatvec_Sprimme(V, primme->nLocal, ldV, W, ldW,
-                     basisSize, blockSize, primme), -1);
+               /* Compute W = A*V for the orthogonalized corrections */
+
+               tmon = primme_get_wtime();
+               CHKERR(matrixMatvec_Sprimme(V, primme->nLocal, ldV, W, ldW,
+                        basisSize, blockSize, primme), -1);
+               CHKERR(monitor_Sprimme(primme_event_matvec, tmon, basisSize,
+                        blockSize, NULL, numConverged, primme), -1);
+            }
 
+            tmon = primme_get_wtime();
             if (Q) CHKERR(update_Q_Sprimme(V, primme->nLocal, ldV, W, ldW, Q,
                      ldQ, R, primme->maxBasisSize,
                      primme->targetShifts[targetShiftIndex], basisSize,
@@ -583,13 +788,15 @@ int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
             /* Extend H by blockSize columns and rows and solve the */
             /* eigenproblem for the new H.                          */
 
-            if (H) CHKERR(update_projection_Sprimme(V, ldV, W, ldW, H,
-                     primme->maxBasisSize, primme->nLocal, basisSize, blockSize,
-                     rwork, &rworkSize, 1/*symmetric*/, primme), -1);
+            if (H && !projected) CHKERR(update_projection_Sprimme(V, ldV, W,
+                     ldW, H, primme->maxBasisSize, primme->nLocal, basisSize,
+                     blockSize, rwork, &rworkSize, 1/*symmetric*/, primme), -1);
 
             if (QtV) CHKERR(update_projection_Sprimme(Q, ldQ, V, ldV, QtV,
                      primme->maxBasisSize, primme->nLocal, basisSize, blockSize,
                      rwork, &rworkSize, 0/*unsymmetric*/, primme), -1);
+            CHKERR(monitor_Sprimme(primme_event_update_projection, tmon,
+                     basisSize, blockSize, NULL, numConverged, primme), -1);
 
             if (basisSize+blockSize >= primme->maxBasisSize) {
                CHKERR(retain_previous_coefficients_Sprimme(hVecs,
@@ -603,10 +810,13 @@ int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
             basisSize += blockSize;
             blockSize = 0;
 
+            tmon = primme_get_wtime();
             CHKERR(solve_H_Sprimme(H, basisSize, primme->maxBasisSize, R,
                      primme->maxBasisSize, QtV, primme->maxBasisSize, hU,
                      basisSize, hVecs, basisSize, hVals, hSVals, numConverged,
                      machEps, &rworkSize, rwork, iworkSize, iwork, primme), -1);
+            CHKERR(monitor_Sprimme(primme_event_solve_H, tmon, basisSize, 0,
+                     NULL, numConverged, primme), -1);
 
             numArbitraryVecs = 0;
 
@@ -681,7 +891,7 @@ int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
 
                /* Limit blockSize to vacant vectors in the basis */
 
-               availableBlockSize = min(primme->maxBlockSize, primme->maxBasisSize-(numConverged-numLocked));
+               availableBlockSize = min(modelBlockSize, primme->maxBasisSize-(numConverged-numLocked));
 
                /* Limit blockSize to remaining values to converge plus one */
 
@@ -709,9 +919,9 @@ int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
                dummySmallestResNorm = &smallestResNorm;
             }
 
-            prepare_candidates_Sprimme(V, ldV, W, ldW, primme->nLocal, H,
-                  primme->maxBasisSize, basisSize,
-                  NULL, NULL,
+            prepare_candidates_Sprimme(V, ldV, W, ldW, BV, primme->nLocal,
+                  H, primme->maxBasisSize, NULL, 0, 0.0, basisSize,
+                  NULL, NULL, NULL,
                   hVecs, basisSize, hVals, hSVals, flags,
                   maxRecentlyConverged, blockNorms, blockSize,
                   availableBlockSize, evecs, numLocked, ldevecs, evals,
@@ -771,9 +981,26 @@ int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
          /* Restart the basis  */
          /* ------------------ */
 
+         /* Reorthogonalize V and recompute W at this restart if the  */
+         /* orthogonality lost by the pipelined ortho may perturb the */
+         /* residual norms as much as the convergence tolerance. The  */
+         /* bound is pessimistic, so measure the loss first           */
+
+         if (orthoLoss > primme->eps/2) {
+            CHKERR(measure_ortho_loss(V, ldV, primme->nLocal, basisSize,
+                     &orthoLoss, rwork, rworkSize, primme), -1);
+            if (orthoLoss > primme->eps/2) {
+               reset = 2;
+               orthoLoss = 0.0;
+            }
+         }
+
          assert(ldV == ldW); /* this function assumes ldV == ldW */
-         restart_Sprimme(V, W, primme->nLocal, basisSize, ldV, hVals, hSVals,
-               flags, iev, &blockSize, blockNorms, evecs, ldevecs, perm,
+         tmon = primme_get_wtime();
+         restart_Sprimme(V, W, BV, primme->nLocal, basisSize, ldV, hVals,
+               hSVals,
+               flags, iev, &blockSize, blockNorms, convNorms, convVals,
+               &numConvNorms, evecs, ldevecs, Bevecs, primme->nLocal, perm,
                evals, resNorms, evecsHat, primme->nLocal, M, maxEvecsSize, UDU,
                0, ipivot, &numConverged, &numLocked, &numConvergedStored,
                previousHVecs, &numPrevRetained, primme->maxBasisSize,
@@ -783,12 +1010,18 @@ int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
                &basisSize, &targetShiftIndex, &numArbitraryVecs, hVecsRot,
                primme->maxBasisSize, &restartsSinceReset, &reset, machEps,
                rwork, &rworkSize, iwork, iworkSize, primme);
+         CHKERR(monitor_Sprimme(primme_event_restart, tmon, basisSize,
+                  blockSize, NULL, numConverged, primme), -1);
+         sizeWtW = 0;
 
          /* If there are any initial guesses remaining, then copy it */
-         /* into the basis.                                          */
+         /* into the basis. Don't exceed the dimension of the space  */
+         /* left by the constraints and the locked vectors.          */
 
          if (numGuesses > 0) {
-            int numNew = max(0, min(primme->minRestartSize-basisSize, numGuesses));
+            int numNew = max(0, min(min(primme->minRestartSize-basisSize,
+                        numGuesses), (int)min(primme->n, INT_MAX)
+                     - primme->numOrthoConst - numLocked - basisSize));
 
             Num_copy_matrix_Sprimme(&evecs[nextGuess*ldevecs], primme->nLocal,
                   numNew, ldevecs, &V[basisSize*ldV], ldV);
@@ -796,9 +1029,24 @@ int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
             nextGuess += numNew;
             numGuesses -= numNew;
 
-            CHKERR(ortho_Sprimme(V, ldV, NULL, 0, basisSize, basisSize+numNew-1,
-                     evecs, ldevecs, numLocked, primme->nLocal, primme->iseed,
-                     machEps, rwork, &rworkSize, primme), -1);
+            /* The new vectors overwrite the candidates X and R computed */
+            /* in restart, and they change the projected problem.        */
+
+            if (numNew > 0) blockSize = 0;
+
+            if (BV) {
+               CHKERR(Bortho_Sprimme(V, ldV, BV, ldV, basisSize,
+                        basisSize+numNew-1, evecs, ldevecs, Bevecs,
+                        primme->nLocal, primme->numOrthoConst+numLocked,
+                        primme->nLocal, primme->iseed, machEps, rwork,
+                        &rworkSize, primme), -1);
+            }
+            else {
+               CHKERR(ortho_Sprimme(V, ldV, NULL, 0, basisSize,
+                        basisSize+numNew-1, evecs, ldevecs, numLocked,
+                        primme->nLocal, primme->iseed, machEps, rwork,
+                        &rworkSize, primme), -1);
+            }
 
             /* Compute W = A*V for the orthogonalized corrections */
 
@@ -831,13 +1079,24 @@ int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
 
          primme->initSize = numConverged;
 
+         /* Save the state every checkpointInterval restarts. If the */
+         /* checkpoint fails, keep iterating; the file still has the */
+         /* previous checkpoint.                                     */
+
+         if (primme->checkpointFile && primme->checkpointInterval > 0 &&
+               primme->stats.numRestarts % primme->checkpointInterval == 0) {
+            write_checkpoint_Sprimme(V, W, BV, ldV, basisSize, evecs, ldevecs,
+                  evals, resNorms, perm, numLocked, restartsSinceReset,
+                  &checkpointSlot, &numLockedSaved, primme);
+         }
+
          /* ------------------------------------------------------------- */
          /* If dynamic method switching == 1, update model parameters and */
          /* evaluate whether to switch from GD+k to JDQMR. This is after  */
          /* restart. GD+k is also evaluated if a pair converges.          */
          /* ------------------------------------------------------------- */
          if (primme->dynamicMethodSwitch == 1 ) {
-            tstart = primme_wTimer(0);
+            tstart = primme_wTimer(primme);
             CostModel.MV = primme->stats.timeMatvec/primme->stats.numMatvecs;
             ret = update_statistics(&CostModel, primme, tstart, 0, 1,
                numConverged, blockNorms[0], primme->stats.estimateMaxEVal); 
@@ -872,6 +1131,12 @@ int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
          /* Return flag showing if there has been a locking problem */
          intWork[0] = LockingProblem;
 
+         /* Keep the locked vectors and the Ritz vectors in the basis, */
+         /* without the previous vectors, for the next call            */
+         CHKERR(save_warm_start_Sprimme(V, ldV, basisSize-numPrevRetained,
+                  &evecs[primme->numOrthoConst*ldevecs], ldevecs, numLocked,
+                  primme), -1);
+
          /* If all of the target eigenvalues have been computed, */
          /* then return success, else return with a failure.     */
  
@@ -900,9 +1165,10 @@ int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
          /* converged state.                                           */
          /* ---------------------------------------------------------- */
 
-         CHKERR(verify_norms(V, ldV, W, ldW, hVals, numConverged, resNorms,
-                  flags, &converged, machEps, rwork, &rworkSize, iwork,
-                  iworkSize, primme), -1);
+         CHKERR(verify_norms(V, ldV, W, ldW, BV, hVals, numConverged,
+                  convNorms, convVals, numConvNorms, resNorms, flags,
+                  &converged, machEps, rwork, &rworkSize, iwork, iworkSize,
+                  primme), -1);
 
          /* ---------------------------------------------------------- */
          /* If the convergence limit is reached or the target vectors  */
@@ -936,6 +1202,11 @@ int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
                   primme->dynamicMethodSwitch = -3;  /* Close call.Use dynamic*/
             }
 
+            /* Keep the Ritz vectors in the basis, without the previous */
+            /* vectors, for the next call                               */
+            CHKERR(save_warm_start_Sprimme(V, ldV, basisSize-numPrevRetained,
+                     NULL, 0, 0, primme), -1);
+
             if (converged) {
                if (primme->aNorm <= 0.0L) primme->aNorm = primme->stats.estimateLargestSVal;
                return 0;
@@ -950,10 +1221,19 @@ int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
             /* Reorthogonalize the basis, recompute W=AV, and continue the  */
             /* outer while loop, resolving the epairs. Slow, but robust!    */
             /* ------------------------------------------------------------ */
-            CHKERR(ortho_Sprimme(V, ldV, NULL, 0, 0,
-                     basisSize-1, evecs, ldevecs,
-                     primme->numOrthoConst+numLocked, primme->nLocal,
-                     primme->iseed, machEps, rwork, &rworkSize, primme), -1);
+            if (BV) {
+               CHKERR(Bortho_Sprimme(V, ldV, BV, ldV, 0, basisSize-1, evecs,
+                        ldevecs, Bevecs, primme->nLocal,
+                        primme->numOrthoConst+numLocked, primme->nLocal,
+                        primme->iseed, machEps, rwork, &rworkSize, primme),
+                     -1);
+            }
+            else {
+               CHKERR(ortho_Sprimme(V, ldV, NULL, 0, 0,
+                        basisSize-1, evecs, ldevecs,
+                        primme->numOrthoConst+numLocked, primme->nLocal,
+                        primme->iseed, machEps, rwork, &rworkSize, primme), -1);
+            }
             CHKERR(matrixMatvec_Sprimme(V, primme->nLocal, ldV, W, ldW, 0,
                      basisSize, primme), -1);
 
@@ -1000,7 +1280,11 @@ int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
  * ---------------------------
  * V              The orthonormal basis
  * W              A*V
+ * BV             B*V for the generalized problem, or NULL
  * nLocal         Local length of vectors in the basis
+ * H, ldH         The projection V'*A*V and its leading dimension
+ * WtW, ldWtW     W'*W and its leading dimension (optional)
+ * orthoLoss      Estimation of the orthogonality lost by V
  * basisSize      Size of the basis V and W
  * ldV            The leading dimension of V, W, X and R
  * hVecs          The projected vectors
@@ -1021,6 +1305,7 @@ int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
  * ----------------------------------
  * X             The eigenvectors put in the block
  * R             The residual vectors put in the block
+ * BX            B*X if BV (optional)
  * flags         Array indicating which eigenvectors have converged     
  * iev           indicates which eigenvalue each block vector corresponds to
  * blockNorms    Residual norms of the Ritz vectors being computed during the
@@ -1036,8 +1321,8 @@ int main_iter_Sprimme(REAL *evals, int *perm, SCALAR *evecs, PRIMME_INT ldevecs,
 
 TEMPLATE_PLEASE
 int prepare_candidates_Sprimme(SCALAR *V, PRIMME_INT ldV, SCALAR *W,
-      PRIMME_INT ldW, PRIMME_INT nLocal, SCALAR *H, int ldH, int basisSize,
-      SCALAR *X, SCALAR *R, SCALAR *hVecs, int ldhVecs, REAL *hVals,
+      PRIMME_INT ldW, SCALAR *BV, PRIMME_INT nLocal, SCALAR *H, int ldH,
+      SCALAR *WtW, int ldWtW, double orthoLoss, int basisSize, SCALAR *X, SCALAR *R, SCALAR *BX, SCALAR *hVecs, int ldhVecs, REAL *hVals,
       REAL *hSVals, int *flags, int remainedEvals, REAL *blockNorms,
       int blockNormsSize, int maxBlockSize, SCALAR *evecs, int numLocked,
       PRIMME_INT ldevecs, REAL *evals, REAL *resNorms, int targetShiftIndex,
@@ -1054,6 +1339,7 @@ int prepare_candidates_Sprimme(SCALAR *V, PRIMME_INT ldV, SCALAR *W,
    SCALAR *hVecsBlock0; /* workspace for hVecsBlock */
    double targetShift;  /* current target shift */
    size_t rworkSize0;   /* current size of rwork */
+   int estimated;       /* whether blockNorms are estimated from WtW */
 
    /* -------------------------- */
    /* Return memory requirements */
@@ -1069,17 +1355,22 @@ int prepare_candidates_Sprimme(SCALAR *V, PRIMME_INT ldV, SCALAR *W,
                numLocked, 0, basisSize-maxBlockSize, basisSize, NULL, NULL,
                NULL, NULL, 0.0, NULL, &lrw, &liw, 0, primme), -1);
       lrw = max(lrw,
-            (size_t)Num_update_VWXR_Sprimme(NULL, NULL, nLocal, basisSize,
-               0, NULL, 0, 0, NULL, &t, basisSize-maxBlockSize, basisSize, 0,
+            (size_t)Num_update_VWXR_Sprimme(NULL, NULL, NULL, nLocal,
+               basisSize, 0, NULL, 0, 0, NULL,
+               &t, basisSize-maxBlockSize, basisSize, 0,
                NULL, 0, 0, 0,
                NULL, 0, 0, 0,
                NULL, 0, 0, 0,
                &t, basisSize-maxBlockSize, basisSize, 0, &d,
                NULL, 0, 0,
+               NULL, 0, NULL, 0,
                NULL, 0, primme));
       CHKERR(prepare_vecs_Sprimme(basisSize, 0, maxBlockSize, NULL, 0,
                NULL, NULL, NULL, 0, 0, NULL, 0.0, NULL, 0, NULL, 0, 0.0, &lrw,
                NULL, 0, &liw, primme), -1);
+      if (primme->orth == primme_orth_pipelined) {
+         lrw = max(lrw, (size_t)2*basisSize*maxBlockSize); /* estimate_norms */
+      }
       *rworkSize = max(*rworkSize,
             (size_t)maxBlockSize+(size_t)maxBlockSize*(size_t)basisSize+lrw);
       *iwork = max(*iwork, liw + basisSize);
@@ -1161,7 +1452,7 @@ int prepare_candidates_Sprimme(SCALAR *V, PRIMME_INT ldV, SCALAR *W,
                         "#Converged %d eval[ %d ]= %e norm %e Mvecs %" PRIMME_INT_P " Time %g\n",
                         iev[blki]-*blockSize, iev[blki], hVals[iev[blki]],
                         blockNorms[blki], primme->stats.numMatvecs,
-                        primme_wTimer(0));
+                        primme_wTimer(primme));
                evals[iev[blki]] = hVals[iev[blki]];
                resNorms[iev[blki]] = blockNorms[blki];
                primme->stats.maxConvTol = max(primme->stats.maxConvTol, blockNorms[blki]);
@@ -1188,6 +1479,8 @@ int prepare_candidates_Sprimme(SCALAR *V, PRIMME_INT ldV, SCALAR *W,
                   &X[(*blockSize)*ldV], ldV);
             if (R) Num_copy_matrix_Sprimme(&R[blki*ldV], nLocal, 1, ldV,
                   &R[(*blockSize)*ldV], ldV);
+            if (BX) Num_copy_matrix_Sprimme(&BX[blki*ldV], nLocal, 1, ldV,
+                  &BX[(*blockSize)*ldV], ldV);
             (*blockSize)++;
          }
 
@@ -1223,26 +1516,150 @@ int prepare_candidates_Sprimme(SCALAR *V, PRIMME_INT ldV, SCALAR *W,
       hVecsBlock = Num_compact_vecs_Sprimme(hVecs, basisSize, blockNormsSize, ldhVecs, &iev[*blockSize],
          hVecsBlock0, ldhVecs, 1 /* avoid copy */);
 
+      /* If W'*W is given, try to estimate the residual norms without a */
+      /* global sum                                                     */
+
+      estimated = 0;
+      if (WtW) {
+         estimated = estimate_norms(H, ldH, WtW, ldWtW, hVecsBlock, ldhVecs,
+               hValsBlock, basisSize, blockNormsSize, orthoLoss, machEps,
+               &blockNorms[*blockSize], rwork, rworkSize0, primme);
+      }
+
       /* Compute X, R and residual norms for the next candidates                                   */
       /* X(basisSize:) = V*hVecs(*blockSize:*blockSize+blockNormsize)                              */
       /* R(basisSize:) = W*hVecs(*blockSize:*blockSize+blockNormsize) - X(basisSize:)*diag(hVals)  */
-      /* blockNorms(basisSize:) = norms(R(basisSize:))                                             */
+      /* blockNorms(basisSize:) = norms(R(basisSize:)), if not estimated                           */
+      /* If BV, BX(basisSize:) = BV*hVecs(...) replaces X(basisSize:) in R                          */
 
       assert(ldV == ldW); /* This functions only works in this way */
-      CHKERR(Num_update_VWXR_Sprimme(V, W, nLocal, basisSize, ldV,
+      CHKERR(Num_update_VWXR_Sprimme(V, W, BV, nLocal, basisSize, ldV,
                hVecsBlock, basisSize, ldhVecs, hValsBlock,
                X?&X[(*blockSize)*ldV]:NULL, 0, blockNormsSize, ldV,
                NULL, 0, 0, 0,
                NULL, 0, 0, 0,
                NULL, 0, 0, 0,
-               R?&R[(*blockSize)*ldV]:NULL, 0, blockNormsSize, ldV, &blockNorms[*blockSize],
-               !R?&blockNorms[*blockSize]:NULL, 0, blockNormsSize,
+               R?&R[(*blockSize)*ldV]:NULL, 0, blockNormsSize, ldV,
+               estimated?NULL:&blockNorms[*blockSize],
+               !R&&!estimated?&blockNorms[*blockSize]:NULL, 0, blockNormsSize,
+               BX?&BX[(*blockSize)*ldV]:NULL, ldV, NULL, 0,
                rwork, rworkSize0, primme), -1);
    }
 
    return 0;
 }
 
+/*******************************************************************************
+ * Function estimate_norms - Estimates the residual norms of the Ritz pairs
+ *    (hVals(i), V*hVecs(:,i)) from the projected matrices without a global
+ *    sum, using
+ *
+ *    ||W*h - hVal*V*h||^2 = h'*WtW*h - 2*hVal*Re(h'*H*h) + hVal^2*h'*h,
+ *
+ *    which holds if V is orthonormal. The absolute error of the right-hand
+ *    side is about max(orthoLoss, machEps*basisSize)*||W||^2, so the
+ *    estimates are only given if all of them are at least 100 times that
+ *    error, and they are far from the convergence tolerance.
+ *
+ * INPUT ARRAYS AND PARAMETERS
+ * ---------------------------
+ * H, ldH         The projection V'*W and its leading dimension
+ * WtW, ldWtW     The projection W'*W and its leading dimension
+ * hVecs, ldhVecs The coefficient vectors and their leading dimension
+ * hVals          The Ritz values
+ * basisSize      The number of rows of hVecs
+ * n              The number of pairs
+ * orthoLoss      Estimation of the orthogonality lost by V
+ * machEps        Machine precision
+ * rwork          Workspace of size 2*basisSize*n
+ *
+ * OUTPUT ARRAYS AND PARAMETERS
+ * ----------------------------
+ * norms          The estimated residual norms, if the function returns 1
+ *
+ * Return value
+ * ------------
+ * 1 if the estimates are accurate enough, and 0 otherwise
+ *
+ ******************************************************************************/
+
+static int estimate_norms(SCALAR *H, int ldH, SCALAR *WtW, int ldWtW,
+      SCALAR *hVecs, int ldhVecs, REAL *hVals, int basisSize, int n,
+      double orthoLoss, double machEps, REAL *norms, SCALAR *rwork,
+      size_t rworkSize, primme_params *primme) {
+
+   int i;
+   SCALAR *Hh = rwork;                  /* H*hVecs */
+   SCALAR *Gh = &rwork[basisSize*n];    /* WtW*hVecs */
+   double WNorm2, err, tol, e;
+
+   if (rworkSize < (size_t)2*basisSize*n) return 0;
+
+   /* ||W||^2 is at least the largest squared norm of a column of W */
+
+   WNorm2 = max(primme->stats.estimateLargestSVal, primme->aNorm);
+   WNorm2 *= WNorm2;
+   for (i=0; i<basisSize; i++) {
+      WNorm2 = max(WNorm2, REAL_PART(WtW[ldWtW*i+i]));
+   }
+   err = max(orthoLoss, machEps*basisSize)*WNorm2;
+   tol = 10.0*primme->eps*sqrt(WNorm2);
+
+   Num_hemm_Sprimme("L", "U", basisSize, n, 1.0, H, ldH, hVecs, ldhVecs, 0.0,
+         Hh, basisSize);
+   Num_hemm_Sprimme("L", "U", basisSize, n, 1.0, WtW, ldWtW, hVecs, ldhVecs,
+         0.0, Gh, basisSize);
+   for (i=0; i<n; i++) {
+      SCALAR *h = &hVecs[ldhVecs*i];
+      e = REAL_PART(Num_dot_Sprimme(basisSize, h, 1, &Gh[basisSize*i], 1))
+         - 2.0*hVals[i]*REAL_PART(Num_dot_Sprimme(basisSize, h, 1,
+                  &Hh[basisSize*i], 1))
+         + hVals[i]*hVals[i]*REAL_PART(Num_dot_Sprimme(basisSize, h, 1, h, 1));
+      if (e < 100.0*err || e < tol*tol) return 0;
+      norms[i] = sqrt(e);
+   }
+
+   return 1;
+}
+
+/*******************************************************************************
+ * Function measure_ortho_loss - Computes ||V'*V - I||, taking one global sum.
+ *
+ * INPUT ARRAYS AND PARAMETERS
+ * ---------------------------
+ * V              The basis
+ * ldV            The leading dimension of V
+ * nLocal         Number of rows of V stored on this node
+ * basisSize      Number of columns of V
+ * rwork          Workspace of size 2*basisSize*basisSize
+ *
+ * OUTPUT PARAMETERS
+ * -----------------
+ * loss           The largest entry in absolute value of V'*V - I
+ *
+ ******************************************************************************/
+
+static int measure_ortho_loss(SCALAR *V, PRIMME_INT ldV, PRIMME_INT nLocal,
+      int basisSize, double *loss, SCALAR *rwork, size_t rworkSize,
+      primme_params *primme) {
+
+   int i, j;
+   SCALAR *VtV = &rwork[basisSize*basisSize];
+
+   assert(rworkSize >= (size_t)2*basisSize*basisSize);
+
+   Num_gemm_Sprimme("C", "N", basisSize, basisSize, nLocal, 1.0, V, ldV, V,
+         ldV, 0.0, rwork, basisSize);
+   CHKERR(globalSum_Sprimme(rwork, VtV, basisSize*basisSize, primme), -1);
+   for (i=0, *loss=0.0; i<basisSize; i++) {
+      for (j=0; j<basisSize; j++) {
+         *loss = max(*loss, ABS(VtV[basisSize*i+j] - (i == j ? 1.0 : 0.0)));
+      }
+   }
+
+   return 0;
+}
+
 /*******************************************************************************
  * Function verify_norms - This subroutine computes the residual norms of the 
  *    target eigenvectors before the Davidson-type main iteration terminates. 
@@ -1253,16 +1670,32 @@ int prepare_candidates_Sprimme(SCALAR *V, PRIMME_INT ldV, SCALAR *W,
  * Note: This routine assumes it is called immediately after a call to the 
  *       restart subroutine.
  *
+ *    The restart computes the residual norms of the converged pairs in the
+ *    same pass that updates V and W. As the columns of V and W haven't
+ *    changed since then, ||W(i) - hVals(i)*V(i)|| is bounded by
+ *    convNorms(i) + |hVals(i) - convVals(i)|. The residual vector is formed
+ *    only for the pairs without a norm from restart or whose bound isn't
+ *    small enough to flag them converged. With B*V the bound also depends
+ *    on ||B*V(i)||, so the norm from restart is only used if the values are
+ *    the same.
+ *
  * INPUT ARRAYS AND PARAMETERS
  * ---------------------------
  * V            The orthonormal basis
  *
  * W            A*V
  *
+ * BV           B*V for the generalized problem, or NULL
+ *
  * hVals        The eigenvalues of V'*A*V
  *
  * basisSize    Size of the basis V
  *
+ * convNorms    The residual norms of the first numConvNorms columns of V and
+ *              W computed in restart with the values convVals
+ *
+ * numConvNorms The number of valid entries in convNorms and convVals
+ *
  * rworkSize    Length of rwork
  *
  * INPUT/OUTPUT ARRAYS
@@ -1281,31 +1714,54 @@ int prepare_candidates_Sprimme(SCALAR *V, PRIMME_INT ldV, SCALAR *W,
  ******************************************************************************/
    
 static int verify_norms(SCALAR *V, PRIMME_INT ldV, SCALAR *W, PRIMME_INT ldW,
-      REAL *hVals, int basisSize, REAL *resNorms, int *flags, int *converged,
+      SCALAR *BV, REAL *hVals, int basisSize, REAL *convNorms, REAL *convVals,
+      int numConvNorms, REAL *resNorms, int *flags, int *converged,
       double machEps, SCALAR *rwork, size_t *rworkSize, int *iwork,
       int iworkSize, primme_params *primme) {
 
-   int i;         /* Loop variable                                     */
+   int i, j;      /* Loop variables                                    */
+   int nr;        /* Number of residual vectors to compute             */
+   int *toCompute = iwork; /* Indices of the residual vectors to compute */
    REAL *dwork = (REAL *) rwork; /* pointer to cast rwork to REAL*/
    int reset;    /* doomy variable */
 
-   /* Compute the residual vectors */
+   assert(iworkSize >= basisSize+1);
+
+   /* Check the convergence with the bound from the norms of restart, and */
+   /* compute the residual vectors of the rest of pairs                   */
 
-   for (i=0; i < basisSize; i++) {
-      Num_axpy_Sprimme(primme->nLocal, -hVals[i], &V[ldV*i], 1, &W[ldW*i], 1);
-      dwork[i] = REAL_PART(Num_dot_Sprimme(primme->nLocal, &W[ldW*i],
+   for (i=nr=0; i < basisSize; i++) {
+      if (i < numConvNorms && (!BV || hVals[i] == convVals[i])) {
+         resNorms[i] = convNorms[i] + fabs(hVals[i] - convVals[i]);
+         CHKERR(check_convergence_Sprimme(&V[ldV*i], primme->nLocal, ldV,
+                  NULL, 0, NULL, 0, 0, i, i+1, flags, &resNorms[i], hVals,
+                  &reset, machEps, rwork, rworkSize, &iwork[basisSize],
+                  iworkSize-basisSize, primme), -1);
+         if (flags[i] != UNCONVERGED) continue;
+      }
+      Num_axpy_Sprimme(primme->nLocal, -hVals[i], BV?&BV[ldV*i]:&V[ldV*i], 1,
+            &W[ldW*i], 1);
+      dwork[nr] = REAL_PART(Num_dot_Sprimme(primme->nLocal, &W[ldW*i],
                1, &W[ldW*i], 1));
+      toCompute[nr++] = i;
    }
-      
-   CHKERR(globalSum_Rprimme(dwork, resNorms, basisSize, primme), -1);
-   for (i=0; i < basisSize; i++)
-      resNorms[i] = sqrt(resNorms[i]);
 
-   /* Check for convergence of the residual norms. */
+   /* The bounds are the same in all processes, and so is nr */
+
+   if (nr > 0) {
+      CHKERR(globalSum_Rprimme(dwork, &dwork[nr], nr, primme), -1);
+   }
+   for (j=0; j < nr; j++) {
+      i = toCompute[j];
+      resNorms[i] = sqrt(dwork[nr+j]);
+
+      /* Check for convergence of the residual norms. */
 
-   CHKERR(check_convergence_Sprimme(V, primme->nLocal, ldV, W, ldW, NULL, 0,
-            0, 0, basisSize, flags, resNorms, hVals, &reset, machEps, rwork,
-            rworkSize, iwork, iworkSize, primme), -1);
+      CHKERR(check_convergence_Sprimme(&V[ldV*i], primme->nLocal, ldV,
+               &W[ldW*i], ldW, NULL, 0, 0, i, i+1, flags, &resNorms[i], hVals,
+               &reset, machEps, rwork, rworkSize, &iwork[basisSize],
+               iworkSize-basisSize, primme), -1);
+   }
 
    /* Set converged to 1 if the first basisSize pairs are converged */
 
@@ -1352,7 +1808,7 @@ static void print_residuals(REAL *ritzValues, REAL *blockNorms,
          fprintf(primme->outputFile, 
             "OUT %" PRIMME_INT_P " conv %d blk %d MV %" PRIMME_INT_P " Sec %E EV %13E |r| %.3E\n",
          primme->stats.numOuterIterations, found, i, primme->stats.numMatvecs,
-         primme_wTimer(0), ritzValues[iev[i]], (double)blockNorms[i]);
+         primme_wTimer(primme), ritzValues[iev[i]], (double)blockNorms[i]);
       }
 
       fflush(primme->outputFile);
@@ -1900,7 +2356,7 @@ static void initializeModel(primme_CostModel *model, primme_params *primme) {
 
    model->numMV_0 = primme->stats.numMatvecs;
    model->numIt_0 = primme->stats.numOuterIterations+1;
-   model->timer_0 = primme_wTimer(0);
+   model->timer_0 = primme_wTimer(primme);
    model->time_in_inner  = 0.0L;
    model->resid_0        = -1.0L;
 
@@ -1909,6 +2365,132 @@ static void initializeModel(primme_CostModel *model, primme_params *primme) {
    model->accum_jdq_gdk  = 1.0L;
 }
 
+/******************************************************************************
+ * Function initializeBlockModel - Initializes the dynamic block size. The
+ *    first block size is maxBlockSize.
+ *
+ * INPUT
+ * -----
+ * primme           Structure containing the solver parameters
+ *
+ * OUTPUT
+ * ------
+ * model            The model with the dynamic block size initialized
+ *
+ ******************************************************************************/
+
+static void initializeBlockModel(primme_CostModel *model,
+      primme_params *primme) {
+
+   int i;
+
+   model->bs_maxLevel = 0;
+   while ((1 << model->bs_maxLevel) < primme->maxBlockSize
+         && model->bs_maxLevel < BS_LEVELS-1) {
+      model->bs_maxLevel++;
+   }
+   model->bs_level = model->bs_prevLevel = model->bs_maxLevel;
+   model->bs_samples = 0;
+   model->bs_stays = 0;
+   for (i=0; i<BS_LEVELS; i++) model->bs_rate[i] = 0.0;
+   model->bs_resid = -1.0;
+   model->bs_time = primme_wTimer(primme);
+}
+
+/******************************************************************************
+ * Function update_block_size - Measures the convergence rate of the current
+ *    block size and returns the block size for the next outer iteration.
+ *
+ *    The rate is the reduction of the residual norm of the first pair in
+ *    the block per second, log(|r_prev|/|r|)/time, averaged over the last
+ *    outer iterations that used the same block size. As the time includes
+ *    the matrix-vector products and the rest of the outer iteration, the
+ *    rate improves with the block size while the products of several
+ *    vectors are cheaper per vector than of one, and it worsens when the
+ *    additional vectors in the block barely help the first pair.
+ *
+ *    After BS_SAMPLES measurements with the same size, the size moves to
+ *    the one with the best rate among the current size and the sizes twice
+ *    and half as large; a neighbor without measurements is tried first.
+ *    After BS_STAYS decisions without moving, the rates of the neighbors are
+ *    forgotten, so that they are measured again as the convergence changes.
+ *
+ * INPUT
+ * -----
+ * primme           Structure containing the solver parameters
+ * currentResNorm   Residual norm of the first pair in the block, or negative
+ *                  if the block is empty
+ * recentConv       Number of pairs converged in this iteration
+ *
+ * INPUT/OUTPUT
+ * ------------
+ * model            The model parameters updated
+ *
+ * Return Value
+ * ------------
+ * The block size for the next outer iteration
+ *
+ ******************************************************************************/
+
+#define BS_SAMPLES 3
+#define BS_STAYS   4
+
+static int update_block_size(primme_CostModel *model, primme_params *primme,
+      double currentResNorm, int recentConv) {
+
+   double now = primme_wTimer(primme), rate;
+   int l, best;
+   int m = model->bs_prevLevel;  /* Level of the block measured now */
+
+   /* The time since the last call was spent mostly on the block of the  */
+   /* previous iteration, whose size was chosen two calls ago. Add the   */
+   /* measurement, unless the first pair changed because of convergence */
+   /* or the block is empty.                                            */
+
+   if (model->bs_resid > 0.0 && currentResNorm > 0.0 && recentConv == 0
+         && now > model->bs_time) {
+      rate = log(model->bs_resid/currentResNorm)/(now - model->bs_time);
+      if (model->bs_rate[m] == 0.0) {
+         model->bs_rate[m] = rate;
+      }
+      else {
+         model->bs_rate[m] = .5*model->bs_rate[m] + .5*rate;
+      }
+      if (m == model->bs_level) model->bs_samples++;
+   }
+   model->bs_resid = currentResNorm;
+   model->bs_time = now;
+   model->bs_prevLevel = model->bs_level;
+
+   /* Decide the next block size */
+
+   if (model->bs_samples >= BS_SAMPLES) {
+      best = model->bs_level;
+      for (l=max(0, model->bs_level-1);
+            l<=min(model->bs_maxLevel, model->bs_level+1); l++) {
+         if (l == model->bs_level) continue;
+         if (model->bs_rate[l] == 0.0) {
+            best = l;
+            break;
+         }
+         if (model->bs_rate[l] > model->bs_rate[best]) best = l;
+      }
+      if (best == model->bs_level && ++model->bs_stays >= BS_STAYS) {
+         for (l=0; l<=model->bs_maxLevel; l++) {
+            if (l != model->bs_level) model->bs_rate[l] = 0.0;
+         }
+         model->bs_stays = 0;
+      }
+      else if (best != model->bs_level) {
+         model->bs_stays = 0;
+      }
+      model->bs_level = best;
+      model->bs_samples = 0;
+   }
+
+   return min(1 << model->bs_level, primme->maxBlockSize);
+}
+
 #if 0
 /******************************************************************************
  *
@@ -41,7 +41,7 @@
 #endif
 int main_iter_dprimme(double *evals, int *perm, double *evecs, int64_t ldevecs,
    double *resNorms, double machEps, int *intWork, void *realWork,
-   primme_params *primme);
+   double *basis, primme_params *primme);
 #if !defined(CHECK_TEMPLATE) && !defined(prepare_candidates_Sprimme)
 #  define prepare_candidates_Sprimme CONCAT(prepare_candidates_,SCALAR_SUF)
 #endif
@@ -49,8 +49,8 @@ int main_iter_dprimme(double *evals, int *perm, double *evecs, int64_t ldevecs,
 #  define prepare_candidates_Rprimme CONCAT(prepare_candidates_,REAL_SUF)
 #endif
 int prepare_candidates_dprimme(double *V, int64_t ldV, double *W,
-      int64_t ldW, int64_t nLocal, double *H, int ldH, int basisSize,
-      double *X, double *R, double *hVecs, int ldhVecs, double *hVals,
+      int64_t ldW, double *BV, int64_t nLocal, double *H, int ldH,
+      double *WtW, int ldWtW, double orthoLoss, int basisSize, double *X, double *R, double *BX, double *hVecs, int ldhVecs, double *hVals,
       double *hSVals, int *flags, int remainedEvals, double *blockNorms,
       int blockNormsSize, int maxBlockSize, double *evecs, int numLocked,
       int64_t ldevecs, double *evals, double *resNorms, int targetShiftIndex,
@@ -60,10 +60,10 @@ int prepare_candidates_dprimme(double *V, int64_t ldV, double *W,
       int iworkSize, primme_params *primme);
 int main_iter_zprimme(double *evals, int *perm, PRIMME_COMPLEX_DOUBLE *evecs, int64_t ldevecs,
    double *resNorms, double machEps, int *intWork, void *realWork,
-   primme_params *primme);
+   PRIMME_COMPLEX_DOUBLE *basis, primme_params *primme);
 int prepare_candidates_zprimme(PRIMME_COMPLEX_DOUBLE *V, int64_t ldV, PRIMME_COMPLEX_DOUBLE *W,
-      int64_t ldW, int64_t nLocal, PRIMME_COMPLEX_DOUBLE *H, int ldH, int basisSize,
-      PRIMME_COMPLEX_DOUBLE *X, PRIMME_COMPLEX_DOUBLE *R, PRIMME_COMPLEX_DOUBLE *hVecs, int ldhVecs, double *hVals,
+      int64_t ldW, PRIMME_COMPLEX_DOUBLE *BV, int64_t nLocal, PRIMME_COMPLEX_DOUBLE *H, int ldH,
+      PRIMME_COMPLEX_DOUBLE *WtW, int ldWtW, double orthoLoss, int basisSize, PRIMME_COMPLEX_DOUBLE *X, PRIMME_COMPLEX_DOUBLE *R, PRIMME_COMPLEX_DOUBLE *BX, PRIMME_COMPLEX_DOUBLE *hVecs, int ldhVecs, double *hVals,
       double *hSVals, int *flags, int remainedEvals, double *blockNorms,
       int blockNormsSize, int maxBlockSize, PRIMME_COMPLEX_DOUBLE *evecs, int numLocked,
       int64_t ldevecs, double *evals, double *resNorms, int targetShiftIndex,
@@ -73,10 +73,10 @@ int prepare_candidates_zprimme(PRIMME_COMPLEX_DOUBLE *V, int64_t ldV, PRIMME_COM
       int iworkSize, primme_params *primme);
 int main_iter_sprimme(float *evals, int *perm, float *evecs, int64_t ldevecs,
    float *resNorms, double machEps, int *intWork, void *realWork,
-   primme_params *primme);
+   float *basis, primme_params *primme);
 int prepare_candidates_sprimme(float *V, int64_t ldV, float *W,
-      int64_t ldW, int64_t nLocal, float *H, int ldH, int basisSize,
-      float *X, float *R, float *hVecs, int ldhVecs, float *hVals,
+      int64_t ldW, float *BV, int64_t nLocal, float *H, int ldH,
+      float *WtW, int ldWtW, double orthoLoss, int basisSize, float *X, float *R, float *BX, float *hVecs, int ldhVecs, float *hVals,
       float *hSVals, int *flags, int remainedEvals, float *blockNorms,
       int blockNormsSize, int maxBlockSize, float *evecs, int numLocked,
       int64_t ldevecs, float *evals, float *resNorms, int targetShiftIndex,
@@ -86,10 +86,10 @@ int prepare_candidates_sprimme(float *V, int64_t ldV, float *W,
       int iworkSize, primme_params *primme);
 int main_iter_cprimme(float *evals, int *perm, PRIMME_COMPLEX_FLOAT *evecs, int64_t ldevecs,
    float *resNorms, double machEps, int *intWork, void *realWork,
-   primme_params *primme);
+   PRIMME_COMPLEX_FLOAT *basis, primme_params *primme);
 int prepare_candidates_cprimme(PRIMME_COMPLEX_FLOAT *V, int64_t ldV, PRIMME_COMPLEX_FLOAT *W,
-      int64_t ldW, int64_t nLocal, PRIMME_COMPLEX_FLOAT *H, int ldH, int basisSize,
-      PRIMME_COMPLEX_FLOAT *X, PRIMME_COMPLEX_FLOAT *R, PRIMME_COMPLEX_FLOAT *hVecs, int ldhVecs, float *hVals,
+      int64_t ldW, PRIMME_COMPLEX_FLOAT *BV, int64_t nLocal, PRIMME_COMPLEX_FLOAT *H, int ldH,
+      PRIMME_COMPLEX_FLOAT *WtW, int ldWtW, double orthoLoss, int basisSize, PRIMME_COMPLEX_FLOAT *X, PRIMME_COMPLEX_FLOAT *R, PRIMME_COMPLEX_FLOAT *BX, PRIMME_COMPLEX_FLOAT *hVecs, int ldhVecs, float *hVals,
       float *hSVals, int *flags, int remainedEvals, float *blockNorms,
       int blockNormsSize, int maxBlockSize, PRIMME_COMPLEX_FLOAT *evecs, int numLocked,
       int64_t ldevecs, float *evals, float *resNorms, int targetShiftIndex,
@@ -36,6 +36,10 @@
 #ifndef MAIN_ITER_PRIVATE_H
 #define MAIN_ITER_PRIVATE_H
 
+/* Maximum number of block sizes considered by the dynamic block size; the */
+/* sizes are 1, 2, 4, ... and maxBlockSize                                  */
+#define BS_LEVELS 16
+
 /*----------------------------------------------------------------------------*
  * The following are needed for the Dynamic Method Switching
  *----------------------------------------------------------------------------*/
@@ -83,6 +87,19 @@ typedef struct {
    double accum_jdq;      /* Accumulates jdq_times += ratio*(gdk+MV+PR)       */
    double accum_gdk;      /* Accumulates gdk_times += gdk+MV+PR               */
 
+   /* Dynamic block size. Every block size has its measured rate of         */
+   /* convergence per second, log(|r_prev|/|r|)/time, where r is the residual */
+   /* of the first pair in the block. Larger blocks amortize the matvecs,  */
+   /* and smaller ones waste fewer matvecs on pairs far from converging.   */
+   int    bs_level;       /* Current block size is min(2^bs_level,maxBlockSize)*/
+   int    bs_prevLevel;   /* Level of the block of the previous iteration     */
+   int    bs_maxLevel;    /* Level of maxBlockSize                            */
+   int    bs_samples;     /* Measurements taken with the current size         */
+   int    bs_stays;       /* Decisions that kept the current size             */
+   double bs_rate[BS_LEVELS]; /* Rate for every level, 0 if unknown           */
+   double bs_resid;       /* Residual norm of the first pair in the last block*/
+   double bs_time;        /* Time when bs_resid was measured                  */
+
 } primme_CostModel;
 
 static void initializeModel(primme_CostModel *model, primme_params *primme);
@@ -94,6 +111,10 @@ static int update_statistics(primme_CostModel *model, primme_params *primme,
 static double ratio_JDQMR_GDpk(primme_CostModel *CostModel, int numLocked,
    double estimate_slowdown, double estimate_ratio_outer_MV);
 static void update_slowdown(primme_CostModel *model);
+static void initializeBlockModel(primme_CostModel *model,
+      primme_params *primme);
+static int update_block_size(primme_CostModel *model, primme_params *primme,
+      double currentResNorm, int recentConv);
 
 #if 0
 static void displayModel(primme_CostModel *model);
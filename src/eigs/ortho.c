@@ -60,6 +60,15 @@
  *           vector is replaced by a random vector. Otherwise the vector is
  *           zeroed.
  *
+ * Note on block orthogonalization
+ *           If primme.orth is primme_orth_block or primme_orth_pipelined and R
+ *           is not requested, the whole block is first orthonormalized with
+ *           two passes of block CGS followed by Cholesky QR (BCGS2 +
+ *           CholQR2), see ortho_block.
+ *           Every pass takes one global sum. If some vector loses too much
+ *           of its norm or the Cholesky factorization fails, the block is
+ *           orthonormalized vector by vector as described above.
+ *
  ******************************************************************************/
 
 #include <stdlib.h>
@@ -70,7 +79,17 @@
 #include "ortho.h"
 #include "const.h"
 #include "globalsum.h"
+#include "auxiliary_eigs.h"
+#include "update_W.h"
 #include "wtime.h"
+
+static int ortho_block_Sprimme(SCALAR *basis, PRIMME_INT ldBasis, int b1,
+      int b2, SCALAR *locked, PRIMME_INT ldLocked, int numLocked,
+      PRIMME_INT nLocal, double machEps, SCALAR *rwork, primme_params *primme);
+
+/* Largest reduction of the squared norm of a vector that ortho_pipelined */
+/* accepts without projecting the block a second time                    */
+
  
 
 /**********************************************************************
@@ -126,6 +145,7 @@ int ortho_Sprimme(SCALAR *basis, PRIMME_INT ldBasis, SCALAR *R,
               
    int i, j;                /* Loop indices */
    size_t minWorkSize;         
+   size_t blockWorkSize;    /* Workspace required by ortho_block */
    int nOrth, reorth;
    int randomizations;
    int messages = 0;        /* messages = 1 prints the intermediate results */
@@ -145,9 +165,14 @@ int ortho_Sprimme(SCALAR *basis, PRIMME_INT ldBasis, SCALAR *R,
          && primme->outputFile);
 
    minWorkSize = 2*(numLocked + b2 + 1);
+   blockWorkSize = (size_t)2*(numLocked + b2 + 1)*(b2 - b1 + 1) + b2 - b1 + 1;
 
    /* Return memory requirement */
    if (basis == NULL) {
+      if (primme && (primme->orth == primme_orth_block
+               || primme->orth == primme_orth_pipelined)) {
+         minWorkSize = max(minWorkSize, blockWorkSize);
+      }
       *rworkSize = max(*rworkSize, minWorkSize);
       return 0;
    }
@@ -171,7 +196,22 @@ int ortho_Sprimme(SCALAR *basis, PRIMME_INT ldBasis, SCALAR *R,
    /* main loop to orthogonalize new vectors one by one */
    /*---------------------------------------------------*/
 
-   t0 = primme_wTimer(0);
+   t0 = primme_get_wtime();
+
+   /* Try to orthonormalize the whole block at once */
+
+   if (primme && (primme->orth == primme_orth_block
+            || primme->orth == primme_orth_pipelined) && R == NULL && b2 > b1
+         && *rworkSize >= blockWorkSize) {
+      int ret = ortho_block_Sprimme(basis, ldBasis, b1, b2, locked, ldLocked,
+            numLocked, nLocal, machEps, rwork, primme);
+      CHKERR(ret < 0, -1);
+      if (ret == 0) b1 = b2+1;
+      else if (messages) {
+         fprintf(primme->outputFile, "Block ortho broke down in vectors %d "
+               "to %d; orthogonalizing them one by one\n", b1, b2);
+      }
+   }
 
    for(i=b1; i <= b2; i++) {
     
@@ -296,7 +336,7 @@ int ortho_Sprimme(SCALAR *basis, PRIMME_INT ldBasis, SCALAR *R,
       }
    }
 
-   if (primme) primme->stats.timeOrtho += primme_wTimer(0) - t0;
+   if (primme) primme->stats.timeOrtho += primme_get_wtime() - t0;
 
    /* Check orthogonality */
    /*
@@ -334,6 +374,508 @@ int ortho_Sprimme(SCALAR *basis, PRIMME_INT ldBasis, SCALAR *R,
    return 0;
 }
 
+/**********************************************************************
+ * Function Bortho - This routine B-orthonormalizes a block of vectors
+ * (from b1 to including b2 in basis) against the vectors from 0 to b1-1
+ * in basis, the locked vectors and themselves, where B is the matrix
+ * primme.massMatrixMatvec. It also updates B*basis in Bbasis, so it takes
+ * one product with B per vector (plus one per randomization) and no
+ * factorization of B.
+ *
+ * The procedure is the same as in ortho for a single vector v, but
+ * with the B-inner product, being Q = [basis(:,0:i-1) locked] and
+ * BQ = [Bbasis(:,0:i-1) Blocked]:
+ *
+ *    [c; s] = [BQ v]'*v                 (one global sum)
+ *    v = v - Q*c,  Bv = Bv - BQ*c
+ *
+ * The B-norm of the resulting vector is computed implicitly as
+ * sqrt(s - c'*c) and explicitly as sqrt(v'*Bv) when needed. Daniel's
+ * test decides whether to reorthogonalize.
+ *
+ * INPUT ARRAYS AND PARAMETERS
+ * ---------------------------
+ * ldBasis    Leading dimension of the basis
+ * ldBbasis   Leading dimension of Bbasis
+ * b1, b2     Range of indices of vectors to be orthonormalized
+ * locked     Array that holds locked vectors if they are in-core
+ * ldLocked   Leading dimension of locked
+ * Blocked    B*locked
+ * ldBlocked  Leading dimension of Blocked
+ * numLocked  Number of vectors in locked
+ * nLocal     Number of rows of each vector stored on this node
+ * machEps    Double machine precision
+ *
+ * rworkSize  Length of rwork array
+ * primme     Primme struct. Contains globalSumDouble and Parallelism info
+ *
+ * INPUT/OUTPUT ARRAYS AND PARAMETERS
+ * ----------------------------------
+ * basis   Basis vectors stored in core memory
+ * Bbasis  B*basis; the columns from 0 to b1-1 are input and the columns
+ *         from b1 to b2 are output
+ * iseed   Seeds used to generate random vectors
+ * rwork   Contains buffers and other necessary work arrays
+ *
+ * Return Value
+ * ------------
+ *  0  - success
+ * -1  - error in the product with B or in a global sum
+ * -3  - A limit number of randomizations has been performed without
+ *       yielding an orthogonal direction
+ *
+ **********************************************************************/
+
+TEMPLATE_PLEASE
+int Bortho_Sprimme(SCALAR *basis, PRIMME_INT ldBasis, SCALAR *Bbasis,
+      PRIMME_INT ldBbasis, int b1, int b2, SCALAR *locked,
+      PRIMME_INT ldLocked, SCALAR *Blocked, PRIMME_INT ldBlocked,
+      int numLocked, PRIMME_INT nLocal, PRIMME_INT *iseed, double machEps,
+      SCALAR *rwork, size_t *rworkSize, primme_params *primme) {
+
+   int i;                   /* Loop index */
+   int nq;                  /* Number of vectors to orthogonalize against */
+   int nOrth, reorth;
+   int randomizations;
+   int messages;            /* messages = 1 prints the intermediate results */
+   int maxNumOrthos = 3;    /* We let 2 reorthogonalizations before randomize */
+   int maxNumRandoms = 10;  /* We do not allow more than 10 randomizations */
+   double tol = sqrt(2.0L)/2.0L; /* We set Daniel et al. test to .707 */
+   REAL s0=0.0, s02=0.0, s1=0.0, s12=0.0, s00=0.0;
+   REAL temp;
+   SCALAR *overlaps;
+   double t0;
+
+   /* Return memory requirement */
+   if (basis == NULL) {
+      *rworkSize = max(*rworkSize, (size_t)2*(b2 + 1 + numLocked));
+      return 0;
+   }
+
+   assert(nLocal >= 0 && *rworkSize >= (size_t)2*(b2 + 1 + numLocked) &&
+          ldBasis >= nLocal && ldBbasis >= nLocal &&
+          (numLocked == 0 || (ldLocked >= nLocal && ldBlocked >= nLocal)));
+
+   messages = (primme->procID == 0 && primme->printLevel >= 3
+         && primme->outputFile);
+
+   t0 = primme_get_wtime();
+
+   for(i=b1; i <= b2; i++) {
+
+      nOrth = 0;
+      reorth = 1;
+      randomizations = 0;
+      nq = i + numLocked;
+
+      CHKERR(massMatrixMatvec_Sprimme(basis, nLocal, ldBasis, Bbasis,
+               ldBbasis, i, 1, primme), -1);
+
+      while (reorth) {
+
+         if (nOrth >= maxNumOrthos) {
+            if (randomizations >= maxNumRandoms) {
+               return -3;
+            }
+            if (messages){
+               fprintf(primme->outputFile, "Randomizing in Bortho: %d, vector size of %" PRIMME_INT_P "\n", i, nLocal);
+            }
+
+            Num_larnv_Sprimme(2, iseed, nLocal, &basis[ldBasis*i]);
+            CHKERR(massMatrixMatvec_Sprimme(basis, nLocal, ldBasis, Bbasis,
+                     ldBbasis, i, 1, primme), -1);
+            randomizations++;
+            nOrth = 0;
+         }
+
+         nOrth++;
+
+         if (nOrth == 1) {
+            s02 = REAL_PART(Num_dot_Sprimme(nLocal, &basis[ldBasis*i], 1,
+                     &Bbasis[ldBbasis*i], 1));
+            primme->stats.numOrthoInnerProds += 1;
+         }
+
+         if (i > 0) {
+            Num_gemv_Sprimme("C", nLocal, i, 1.0, Bbasis, ldBbasis,
+               &basis[ldBasis*i], 1, 0.0, rwork, 1);
+            primme->stats.numOrthoInnerProds += i;
+         }
+
+         if (numLocked > 0) {
+            Num_gemv_Sprimme("C", nLocal, numLocked, 1.0, Blocked, ldBlocked,
+               &basis[ldBasis*i], 1, 0.0, &rwork[i], 1);
+            primme->stats.numOrthoInnerProds += numLocked;
+         }
+
+         rwork[nq] = s02;
+         overlaps = &rwork[nq+1];
+         CHKERR(globalSum_Sprimme(rwork, overlaps, nq + 1, primme), -1);
+
+         if (i > 0) {
+            Num_gemv_Sprimme("N", nLocal, i, -1.0, basis, ldBasis,
+               overlaps, 1, 1.0, &basis[ldBasis*i], 1);
+            Num_gemv_Sprimme("N", nLocal, i, -1.0, Bbasis, ldBbasis,
+               overlaps, 1, 1.0, &Bbasis[ldBbasis*i], 1);
+            primme->stats.numOrthoInnerProds += i;
+         }
+
+         if (numLocked > 0) {
+            Num_gemv_Sprimme("N", nLocal, numLocked, -1.0, locked, ldLocked,
+               &overlaps[i], 1, 1.0, &basis[ldBasis*i], 1);
+            Num_gemv_Sprimme("N", nLocal, numLocked, -1.0, Blocked, ldBlocked,
+               &overlaps[i], 1, 1.0, &Bbasis[ldBbasis*i], 1);
+            primme->stats.numOrthoInnerProds += numLocked;
+         }
+
+         if (nOrth == 1) {
+            s00 = s0 = sqrt(s02 = max(0.0L, REAL_PART(overlaps[nq])));
+         }
+
+         /* Compute the B-norm of the resulting vector implicitly */
+
+         temp = REAL_PART(Num_dot_Sprimme(nq, overlaps, 1, overlaps, 1));
+         s1 = sqrt(s12 = max(0.0L, s02-temp));
+
+         /* s1 decreased too much. Numerical problems expected   */
+         /* with its implicit computation. Compute s1 explicitly */
+
+         if (s1 < s0*sqrt(machEps) || nOrth > 1) {
+            temp = REAL_PART(Num_dot_Sprimme(nLocal, &basis[ldBasis*i], 1,
+                                           &Bbasis[ldBbasis*i], 1));
+            primme->stats.numOrthoInnerProds += 1;
+            CHKERR(globalSum_Rprimme(&temp, &s12, 1, primme), -1);
+            s1 = sqrt(s12 = max(0.0L, s12));
+         }
+
+         if (s1 <= machEps*s00) {
+            if (messages) {
+               fprintf(primme->outputFile,
+                 "Vector %d lost all significant digits in Bortho\n", i-b1);
+            }
+            nOrth = maxNumOrthos;
+         }
+         else if (s1 <= tol*s0) {
+            /* No numerical benefit in normalizing the vector before reortho */
+            s0 = s1;
+            s02 = s12;
+         }
+         else {
+            Num_scal_Sprimme(nLocal, 1.0/s1, &basis[ldBasis*i], 1);
+            Num_scal_Sprimme(nLocal, 1.0/s1, &Bbasis[ldBbasis*i], 1);
+            reorth = 0;
+         }
+      }
+   }
+
+   primme->stats.timeOrtho += primme_get_wtime() - t0;
+
+   return 0;
+}
+
+/**********************************************************************
+ * Function ortho_block - Orthonormalizes the vectors from b1 to b2 in
+ *    basis against the vectors 0 to b1-1 in basis, the locked vectors and
+ *    themselves with two passes of the next procedure (BCGS2 + CholQR2):
+ *
+ *    [C; G] = [Q X]'*X                    (one global sum)
+ *    G = G - C'*C                         (Pythagorean identity)
+ *    X = (X - Q*C)/chol(G)
+ *
+ *    where Q = [basis(:,0:b1-1) locked] and X = basis(:,b1:b2).
+ *
+ * INPUT ARRAYS AND PARAMETERS
+ * ---------------------------
+ * ldBasis    Leading dimension of the basis
+ * b1, b2     Range of indices of vectors to be orthonormalized
+ * locked     Array that holds locked vectors if they are in-core
+ * ldLocked   Leading dimension of locked
+ * numLocked  Number of vectors in locked
+ * nLocal     Number of rows of each vector stored on this node
+ * machEps    Double machine precision
+ * rwork      Workspace of size 2*(b2+1+numLocked)*(b2-b1+1) + b2-b1+1
+ *
+ * INPUT/OUTPUT ARRAYS AND PARAMETERS
+ * ----------------------------------
+ * basis      Basis vectors stored in core memory
+ *
+ * Return Value
+ * ------------
+ *  0  - success
+ *  1  - a vector lost too much of its norm or the Cholesky factorization
+ *       failed. The span of basis(:,0:b2) has not changed, but the block
+ *       should be orthonormalized vector by vector
+ * -1  - error in a global sum
+ *
+ **********************************************************************/
+
+static int ortho_block_Sprimme(SCALAR *basis, PRIMME_INT ldBasis, int b1,
+      int b2, SCALAR *locked, PRIMME_INT ldLocked, int numLocked,
+      PRIMME_INT nLocal, double machEps, SCALAR *rwork, primme_params *primme) {
+
+   int i, pass, info;
+   int nX = b2 - b1 + 1;            /* Number of vectors in the block */
+   int nQ = b1 + numLocked;         /* Number of vectors to project out */
+   int ldH = nQ + nX;               /* Leading dimension of H */
+   SCALAR *X = &basis[ldBasis*b1];  /* The block of vectors */
+   SCALAR *H = rwork;               /* Local [Q X]'*X */
+   SCALAR *C = &rwork[ldH*nX];      /* Global [Q X]'*X; C(nQ:ldH-1,:) is G */
+   SCALAR *G = &C[nQ];
+   SCALAR *norms2 = &C[ldH*nX];     /* Squared norms of X before projecting */
+   double tol = sqrt(machEps);
+
+   for (pass=0; pass<2; pass++) {
+
+      /* H = [Q X]'*X and reduce it */
+
+      if (b1 > 0) {
+         Num_gemm_Sprimme("C", "N", b1, nX, nLocal, 1.0, basis, ldBasis, X,
+               ldBasis, 0.0, H, ldH);
+      }
+      if (numLocked > 0) {
+         Num_gemm_Sprimme("C", "N", numLocked, nX, nLocal, 1.0, locked,
+               ldLocked, X, ldBasis, 0.0, &H[b1], ldH);
+      }
+      Num_gemm_Sprimme("C", "N", nX, nX, nLocal, 1.0, X, ldBasis, X, ldBasis,
+            0.0, &H[nQ], ldH);
+      primme->stats.numOrthoInnerProds += ldH*nX;
+      CHKERR(globalSum_Sprimme(H, C, ldH*nX, primme), -1);
+
+      /* G = G - C'*C */
+
+      for (i=0; i<nX; i++) norms2[i] = G[ldH*i+i];
+      if (nQ > 0) {
+         Num_gemm_Sprimme("C", "N", nX, nX, nQ, -1.0, C, ldH, C, ldH, 1.0, G,
+               ldH);
+      }
+
+      /* Give up if some vector is almost in the span of Q; G is not */
+      /* accurate enough                                              */
+
+      for (i=0; i<nX; i++) {
+         if (REAL_PART(G[ldH*i+i]) <= tol*REAL_PART(norms2[i])) return 1;
+      }
+
+      /* G = U'*U; give up if U is numerically singular */
+
+      Num_potrf_Sprimme("U", nX, G, ldH, &info);
+      if (info != 0) return 1;
+      for (i=0; i<nX; i++) {
+         REAL u = REAL_PART(G[ldH*i+i]);
+         if (u*u <= tol*REAL_PART(norms2[i])) return 1;
+      }
+
+      /* X = (X - Q*C)/U */
+
+      if (numLocked > 0) {
+         Num_gemm_Sprimme("N", "N", nLocal, nX, numLocked, -1.0, locked,
+               ldLocked, &C[b1], ldH, 1.0, X, ldBasis);
+      }
+      if (b1 > 0) {
+         Num_gemm_Sprimme("N", "N", nLocal, nX, b1, -1.0, basis, ldBasis, C,
+               ldH, 1.0, X, ldBasis);
+      }
+      primme->stats.numOrthoInnerProds += nQ*nX;
+      Num_trsm_Sprimme("R", "U", "N", "N", nLocal, nX, 1.0, G, ldH, X,
+            ldBasis);
+   }
+
+   return 0;
+}
+
+/**********************************************************************
+ * Function ortho_pipelined - Orthonormalizes the new columns X =
+ *    V(:,numCols:numCols+blockSize-1) against the previous columns of V and
+ *    among themselves, and updates the new columns Y of W and of the
+ *    projections H = V'*W and G = W'*W, taking a single global sum. On
+ *    input Y should be A*X.
+ *
+ *    The global sum reduces [V X]'*X, [V X]'*Y and [W Y]'*Y. With
+ *    C = V'*X and U the Cholesky factor of X'*X - C'*C,
+ *
+ *    X = (X - V*C)/U,   Y = (Y - W*C)/U,
+ *    H(0:numCols-1,new) = (V'*Y - H*C)/U,
+ *    H(new,new) = U'\(X'*Y - C'*V'*Y - (V'*Y)'*C + C'*H*C)/U,
+ *
+ *    and G is updated in the same way with W'*Y and Y'*Y. The formulas
+ *    assume that V is orthonormal and W = A*V with A Hermitian. As X is
+ *    projected only once, the orthogonality already lost by V is amplified
+ *    in the new columns by up to ||C||*||inv(U)||, and the pass adds about
+ *    machEps*||X||^2*||inv(U)||^2, after scaling the columns of X to unit
+ *    norm. That bound of ||V'*V - I|| is updated in loss, and the caller
+ *    should check V when it is too large.
+ *
+ * INPUT ARRAYS AND PARAMETERS
+ * ---------------------------
+ * ldV, ldW   The leading dimensions of V and W
+ * ldH, ldG   The leading dimensions of H and G
+ * nLocal     Number of rows of each vector stored on this node
+ * numCols    Number of columns of V already orthonormalized
+ * blockSize  Number of new columns
+ * machEps    Double machine precision
+ *
+ * INPUT/OUTPUT ARRAYS AND PARAMETERS
+ * ----------------------------------
+ * V, W       The basis and A*V
+ * H, G       The upper triangular parts of V'*W and W'*W
+ * loss       Bound of ||V'*V - I||
+ * rwork      Workspace
+ * lrwork     Size of rwork
+ *
+ * Return Value
+ * ------------
+ *  0  - success
+ *  1  - a vector is almost in the span of the previous ones or the
+ *       Cholesky factorization failed. V and W = A*V span the same spaces,
+ *       but the new columns should be orthonormalized with ortho, and W,
+ *       H and G recomputed
+ * -1  - error in a global sum
+ *
+ **********************************************************************/
+
+TEMPLATE_PLEASE
+int ortho_pipelined_Sprimme(SCALAR *V, PRIMME_INT ldV, SCALAR *W,
+      PRIMME_INT ldW, SCALAR *H, int ldH, SCALAR *G, int ldG,
+      PRIMME_INT nLocal, int numCols, int blockSize, double machEps,
+      double *loss, SCALAR *rwork, size_t *lrwork, primme_params *primme) {
+
+   int i, j, info;
+   int m = numCols + blockSize;     /* Rows of [V X]'*X */
+   int mb = m*blockSize;            /* Size of [V X]'*X */
+   SCALAR *X = &V[ldV*numCols];     /* The new columns of V */
+   SCALAR *Y = &W[ldW*numCols];     /* The new columns of W */
+   SCALAR *C = &rwork[3*mb];        /* Global [V X]'*X; C(numCols:m-1,:) is S */
+   SCALAR *S = &C[numCols];
+   SCALAR *VY = &C[mb];             /* Global [V X]'*Y */
+   SCALAR *WY = &C[2*mb];           /* Global [W Y]'*Y */
+   SCALAR *T = &C[3*mb];            /* H*C or G*C */
+   SCALAR *B = &T[numCols*blockSize]; /* Projection of the new columns */
+   SCALAR *norms2 = &B[blockSize*blockSize]; /* Norms of X before projecting */
+   SCALAR *P, *XP;                  /* H or G, and V'*Y or W'*Y */
+   int ldP;                         /* The leading dimension of P */
+   double tol = sqrt(machEps), c2, k2;
+
+   /* Return memory requirement */
+
+   if (V == NULL) {
+      *lrwork = max(*lrwork, (size_t)6*mb + (size_t)numCols*blockSize
+            + (size_t)blockSize*blockSize + (size_t)blockSize);
+      return 0;
+   }
+
+   assert(*lrwork >= (size_t)6*mb + (size_t)numCols*blockSize
+         + (size_t)blockSize*blockSize + (size_t)blockSize);
+
+   /* [[V X]'*X, [V X]'*Y, [W Y]'*Y] and reduce them */
+
+   Num_gemm_Sprimme("C", "N", m, blockSize, nLocal, 1.0, V, ldV, X, ldV,
+         0.0, rwork, m);
+   Num_gemm_Sprimme("C", "N", m, blockSize, nLocal, 1.0, V, ldV, Y, ldW,
+         0.0, &rwork[mb], m);
+   Num_gemm_Sprimme("C", "N", m, blockSize, nLocal, 1.0, W, ldW, Y, ldW,
+         0.0, &rwork[2*mb], m);
+   primme->stats.numOrthoInnerProds += mb;
+   CHKERR(globalSum_Sprimme(rwork, C, 3*mb, primme), -1);
+
+   /* S = S - C'*C */
+
+   for (i=0; i<blockSize; i++) norms2[i] = S[m*i+i];
+   if (numCols > 0) {
+      Num_gemm_Sprimme("C", "N", blockSize, blockSize, numCols, -1.0, C, m,
+            C, m, 1.0, S, m);
+   }
+
+   /* Give up if some vector is almost in the span of V or if S is */
+   /* numerically singular                                         */
+
+   for (i=0, c2=0.0; i<blockSize; i++) {
+      if (REAL_PART(S[m*i+i]) <= tol*REAL_PART(norms2[i])) return 1;
+      c2 += 1.0 - REAL_PART(S[m*i+i])/REAL_PART(norms2[i]);
+   }
+   Num_potrf_Sprimme("U", blockSize, S, m, &info);
+   if (info != 0) return 1;
+   for (i=0; i<blockSize; i++) {
+      REAL u = REAL_PART(S[m*i+i]);
+      if (u*u <= tol*REAL_PART(norms2[i])) return 1;
+   }
+
+   /* With D = diag(||X(:,i)||), c2 = ||C*inv(D)||^2 and k2 =          */
+   /* ||D*inv(U)||^2, with the Frobenius norm; k2 is about the squared   */
+   /* condition number of X after projecting out V                     */
+
+   Num_zero_matrix_Sprimme(B, blockSize, blockSize, blockSize);
+   for (i=0; i<blockSize; i++) B[blockSize*i+i] = 1.0;
+   Num_trsm_Sprimme("L", "U", "N", "N", blockSize, blockSize, 1.0, S, m,
+         B, blockSize);
+   for (i=0, k2=0.0; i<blockSize; i++) {
+      for (j=0; j<=i; j++) {
+         k2 += REAL_PART(norms2[j])
+            *REAL_PART(CONJ(B[blockSize*i+j])*B[blockSize*i+j]);
+      }
+   }
+   if (k2*tol >= 1.0) return 1;
+
+   /* Update the new columns of H and G */
+
+   for (j=0; j<2; j++) {
+      P = j == 0 ? H : G;
+      ldP = j == 0 ? ldH : ldG;
+      XP = j == 0 ? VY : WY;
+
+      /* T = P*C; B = X'*Y - C'*XP - XP'*C + C'*T */
+
+      Num_copy_matrix_Sprimme(&XP[numCols], blockSize, blockSize, m, B,
+            blockSize);
+      if (numCols > 0) {
+         Num_hemm_Sprimme("L", "U", numCols, blockSize, 1.0, P, ldP, C, m,
+               0.0, T, numCols);
+         Num_gemm_Sprimme("C", "N", blockSize, blockSize, numCols, -1.0, C,
+               m, XP, m, 1.0, B, blockSize);
+         Num_gemm_Sprimme("C", "N", blockSize, blockSize, numCols, -1.0, XP,
+               m, C, m, 1.0, B, blockSize);
+         Num_gemm_Sprimme("C", "N", blockSize, blockSize, numCols, 1.0, C, m,
+               T, numCols, 1.0, B, blockSize);
+      }
+
+      /* P(0:numCols-1,new) = (XP - T)/U */
+
+      for (i=0; i<blockSize; i++) {
+         Num_copy_Sprimme(numCols, &XP[m*i], 1, &P[ldP*(numCols+i)], 1);
+         Num_axpy_Sprimme(numCols, -1.0, &T[numCols*i], 1,
+               &P[ldP*(numCols+i)], 1);
+      }
+      Num_trsm_Sprimme("R", "U", "N", "N", numCols, blockSize, 1.0, S, m,
+            &P[ldP*numCols], ldP);
+
+      /* P(new,new) = U'\B/U */
+
+      Num_trsm_Sprimme("L", "U", "C", "N", blockSize, blockSize, 1.0, S, m,
+            B, blockSize);
+      Num_trsm_Sprimme("R", "U", "N", "N", blockSize, blockSize, 1.0, S, m,
+            B, blockSize);
+      Num_copy_matrix_Sprimme(B, blockSize, blockSize, blockSize,
+            &P[ldP*numCols+numCols], ldP);
+   }
+
+   /* X = (X - V*C)/U and Y = (Y - W*C)/U */
+
+   if (numCols > 0) {
+      Num_gemm_Sprimme("N", "N", nLocal, blockSize, numCols, -1.0, V, ldV,
+            C, m, 1.0, X, ldV);
+      Num_gemm_Sprimme("N", "N", nLocal, blockSize, numCols, -1.0, W, ldW,
+            C, m, 1.0, Y, ldW);
+   }
+   primme->stats.numOrthoInnerProds += numCols*blockSize;
+   Num_trsm_Sprimme("R", "U", "N", "N", nLocal, blockSize, 1.0, S, m, X,
+         ldV);
+   Num_trsm_Sprimme("R", "U", "N", "N", nLocal, blockSize, 1.0, S, m, Y,
+         ldW);
+
+   *loss = max(*loss, *loss*sqrt(c2*k2) + machEps*k2);
+
+   return 0;
+}
+
 /**********************************************************************
  * Function ortho_single_iteration -- This function orthogonalizes
  *    applies ones the projector (I-QQ') on X. Optionally returns
@@ -352,6 +894,10 @@ int ortho_Sprimme(SCALAR *basis, PRIMME_INT ldBasis, SCALAR *R,
  * rwork           Auxiliary space
  * lrwork          Available rwork
  *
+ * If primme.globalSumRealStart is set, the columns of X are processed in two
+ * groups so that the reductions of one group overlap with the local products
+ * of the other.
+ *
  ****************************************************************************/
 
 TEMPLATE_PLEASE
@@ -360,23 +906,25 @@ int ortho_single_iteration_Sprimme(SCALAR *Q, PRIMME_INT mQ, PRIMME_INT nQ,
       REAL *overlaps, REAL *norms, SCALAR *rwork, size_t *lrwork,
       primme_params *primme) {
 
-   int i, j, M=PRIMME_BLOCK_SIZE, m=min(M, mQ);
-   SCALAR *y, *y0, *X0;
+   int i, j, k, M=CACHE_BLOCK_SIZE(primme), m=min(M, mQ);
+   int ng;                 /* Number of groups of columns of X */
+   int gb[2], ge[2];       /* First and last+1 columns of each group */
+   void *reqy[2], *reqn[2];/* Handles of the reductions of y and norms0 */
+   SCALAR *y, *y0, *X0, *Xk;
    REAL *norms0;
 
    /* Return memory requirement */
    if (Q == NULL) {
-      *lrwork = max(*lrwork, (size_t)nQ*nX*2 + (size_t)M*nX);
+      *lrwork = max(*lrwork, (size_t)nQ*nX*2 + (size_t)M*nX + nX);
       return 0;
    }
 
-   assert((size_t)nQ*nX*2 + (size_t)m*nX <= *lrwork);
+   assert((size_t)nQ*nX*2 + (size_t)m*nX + nX <= *lrwork);
 
-   /* Warning: norms0 and y overlap, so don't use them at the same time */
-   norms0 = (REAL*)rwork;
    y = rwork;
    y0 = y + nQ*nX;
    X0 = y0 + nQ*nX;
+   norms0 = (REAL*)(X0 + m*nX);
 
    /* Check if the indices of inX are contiguous */
 
@@ -388,48 +936,81 @@ int ortho_single_iteration_Sprimme(SCALAR *Q, PRIMME_INT mQ, PRIMME_INT nQ,
       }
    }
 
-   /* y = Q'*X */
-   if (!inX) {
-      Num_gemm_Sprimme("C", "N", nQ, nX, mQ, 1.0, Q, ldQ, X, ldX, 0.0, y, nQ);
-   }
-   else {
-      Num_zero_matrix_Sprimme(y, nQ, nX, nQ);
-      for (i=0, m=min(M,mQ); i < mQ; i+=m, m=min(m,mQ-i)) {
-         Num_copy_matrix_columns_Sprimme(&X[i], m, inX, nX, ldX, X0, NULL, m);
-         Num_gemm_Sprimme("C", "N", nQ, nX, m, 1.0, &Q[i], ldQ, X0, m, 1.0,
-               y, nQ);
+   /* If the reductions can be overlapped, process the columns of X in two */
+   /* groups, so that the local products of one group are computed while   */
+   /* the reduction of the other is in flight.                             */
+
+   ng = (primme && primme->globalSumRealStart && primme->numProcs > 1
+         && nX > 1) ? 2 : 1;
+   gb[0] = 0; ge[0] = gb[1] = nX/ng; ge[1] = nX;
+
+   for (k=0; k<ng; k++) {
+      int nk = ge[k] - gb[k];
+
+      /* y(:,g) = Q'*X(:,g) */
+      if (!inX) {
+         Num_gemm_Sprimme("C", "N", nQ, nk, mQ, 1.0, Q, ldQ, &X[ldX*gb[k]],
+               ldX, 0.0, &y[nQ*gb[k]], nQ);
+      }
+      else {
+         Num_zero_matrix_Sprimme(&y[nQ*gb[k]], nQ, nk, nQ);
+         for (i=0, m=min(M,mQ); i < mQ; i+=m, m=min(m,mQ-i)) {
+            Num_copy_matrix_columns_Sprimme(&X[i], m, &inX[gb[k]], nk, ldX,
+                  X0, NULL, m);
+            Num_gemm_Sprimme("C", "N", nQ, nk, m, 1.0, &Q[i], ldQ, X0, m,
+                  1.0, &y[nQ*gb[k]], nQ);
+         }
       }
-   }
 
-   /* Store the reduction of y in y0 */
-   CHKERR(globalSum_Sprimme(y, y0, nQ*nX, primme), -1);
-   
-   /* overlaps(i) = norm(y0(:,i))^2 */
-   for (i=0; i<nX; i++) {
-      overlaps[i] =
-         sqrt(REAL_PART(Num_dot_Sprimme(nQ, &y0[nQ*i], 1, &y0[nQ*i], 1)));
+      /* Start the reduction of y(:,g) into y0(:,g) */
+      CHKERR(globalSumStart_Sprimme(&y[nQ*gb[k]], &y0[nQ*gb[k]], nQ*nk,
+               &reqy[k], primme), -1);
    }
 
-   /* X = X - Q*y0; norms0(i) = norms(X(i))^2 */
-   if (norms) for (i=0; i<nX; i++) norms0[i] = 0.0;
-   for (i=0, m=min(M,mQ); i < mQ; i+=m, m=min(m,mQ-i)) {
-      if (inX) {
-         Num_copy_matrix_columns_Sprimme(&X[i], m, inX, nX, ldX, X0, NULL, m);
+   for (k=0; k<ng; k++) {
+      int nk = ge[k] - gb[k];
+
+      CHKERR(globalSumWait_Sprimme(reqy[k], primme), -1);
+   
+      /* overlaps(i) = norm(y0(:,i))^2 */
+      for (i=gb[k]; i<ge[k]; i++) {
+         overlaps[i] =
+            sqrt(REAL_PART(Num_dot_Sprimme(nQ, &y0[nQ*i], 1, &y0[nQ*i], 1)));
       }
-      Num_gemm_Sprimme("N", "N", m, nX, nQ, -1.0, &Q[i], ldQ, y0, nQ, 1.0,
-            inX?X0:&X[i], inX?m:ldX);
-      if (inX) {
-         Num_copy_matrix_columns_Sprimme(X0, m, NULL, nX, m, &X[i], inX, ldX);
+
+      /* X(:,g) = X(:,g) - Q*y0(:,g); norms0(i) = norms(X(i))^2 */
+      if (norms) for (i=gb[k]; i<ge[k]; i++) norms0[i] = 0.0;
+      for (i=0, m=min(M,mQ); i < mQ; i+=m, m=min(m,mQ-i)) {
+         if (i+m < mQ) Num_prefetch_rows_Sprimme(&Q[i+m], min(m, mQ-i-m),
+               nQ, ldQ, primme);
+         if (inX) {
+            Num_copy_matrix_columns_Sprimme(&X[i], m, &inX[gb[k]], nk, ldX,
+                  X0, NULL, m);
+         }
+         Xk = inX ? X0 : &X[i+ldX*gb[k]];
+         Num_gemm_Sprimme("N", "N", m, nk, nQ, -1.0, &Q[i], ldQ,
+               &y0[nQ*gb[k]], nQ, 1.0, Xk, inX?m:ldX);
+         if (inX) {
+            Num_copy_matrix_columns_Sprimme(X0, m, NULL, nk, m, &X[i],
+                  &inX[gb[k]], ldX);
+         }
+         if (norms) for (j=0; j<nk; j++) {
+            SCALAR *v = &Xk[j*(inX?m:ldX)];
+            norms0[gb[k]+j] += REAL_PART(Num_dot_Sprimme(m, v, 1, v, 1));
+         }
       }
-      if (norms) for (j=0; j<nX; j++) {
-         SCALAR *v = inX ? &X0[j*m] : &X[j*ldX+i];
-         norms0[j] += REAL_PART(Num_dot_Sprimme(m, v, 1, v, 1));
+
+      /* Start the reduction of norms0(g) into norms(g) */
+      if (norms) {
+         CHKERR(globalSumStart_Rprimme(&norms0[gb[k]], &norms[gb[k]], nk,
+                  &reqn[k], primme), -1);
       }
    }
 
    if (norms) {
-      /* Store the reduction of norms0 in norms */
-      CHKERR(globalSum_Rprimme(norms0, norms, nX, primme), -1);
+      for (k=0; k<ng; k++) {
+         CHKERR(globalSumWait_Rprimme(reqn[k], primme), -1);
+      }
  
       for (i=0; i<nX; i++) norms[i] = sqrt(norms[i]);
    }
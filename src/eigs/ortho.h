@@ -43,6 +43,27 @@ int ortho_dprimme(double *basis, int64_t ldBasis, double *R,
       int64_t ldR, int b1, int b2, double *locked, int64_t ldLocked,
       int numLocked, int64_t nLocal, int64_t *iseed, double machEps,
       double *rwork, size_t *rworkSize, primme_params *primme);
+#if !defined(CHECK_TEMPLATE) && !defined(Bortho_Sprimme)
+#  define Bortho_Sprimme CONCAT(Bortho_,SCALAR_SUF)
+#endif
+#if !defined(CHECK_TEMPLATE) && !defined(Bortho_Rprimme)
+#  define Bortho_Rprimme CONCAT(Bortho_,REAL_SUF)
+#endif
+int Bortho_dprimme(double *basis, int64_t ldBasis, double *Bbasis,
+      int64_t ldBbasis, int b1, int b2, double *locked,
+      int64_t ldLocked, double *Blocked, int64_t ldBlocked,
+      int numLocked, int64_t nLocal, int64_t *iseed, double machEps,
+      double *rwork, size_t *rworkSize, primme_params *primme);
+#if !defined(CHECK_TEMPLATE) && !defined(ortho_pipelined_Sprimme)
+#  define ortho_pipelined_Sprimme CONCAT(ortho_pipelined_,SCALAR_SUF)
+#endif
+#if !defined(CHECK_TEMPLATE) && !defined(ortho_pipelined_Rprimme)
+#  define ortho_pipelined_Rprimme CONCAT(ortho_pipelined_,REAL_SUF)
+#endif
+int ortho_pipelined_dprimme(double *V, int64_t ldV, double *W,
+      int64_t ldW, double *H, int ldH, double *G, int ldG,
+      int64_t nLocal, int numCols, int blockSize, double machEps,
+      double *loss, double *rwork, size_t *lrwork, primme_params *primme);
 #if !defined(CHECK_TEMPLATE) && !defined(ortho_single_iteration_Sprimme)
 #  define ortho_single_iteration_Sprimme CONCAT(ortho_single_iteration_,SCALAR_SUF)
 #endif
@@ -57,6 +78,15 @@ int ortho_zprimme(PRIMME_COMPLEX_DOUBLE *basis, int64_t ldBasis, PRIMME_COMPLEX_
       int64_t ldR, int b1, int b2, PRIMME_COMPLEX_DOUBLE *locked, int64_t ldLocked,
       int numLocked, int64_t nLocal, int64_t *iseed, double machEps,
       PRIMME_COMPLEX_DOUBLE *rwork, size_t *rworkSize, primme_params *primme);
+int Bortho_zprimme(PRIMME_COMPLEX_DOUBLE *basis, int64_t ldBasis, PRIMME_COMPLEX_DOUBLE *Bbasis,
+      int64_t ldBbasis, int b1, int b2, PRIMME_COMPLEX_DOUBLE *locked,
+      int64_t ldLocked, PRIMME_COMPLEX_DOUBLE *Blocked, int64_t ldBlocked,
+      int numLocked, int64_t nLocal, int64_t *iseed, double machEps,
+      PRIMME_COMPLEX_DOUBLE *rwork, size_t *rworkSize, primme_params *primme);
+int ortho_pipelined_zprimme(PRIMME_COMPLEX_DOUBLE *V, int64_t ldV, PRIMME_COMPLEX_DOUBLE *W,
+      int64_t ldW, PRIMME_COMPLEX_DOUBLE *H, int ldH, PRIMME_COMPLEX_DOUBLE *G, int ldG,
+      int64_t nLocal, int numCols, int blockSize, double machEps,
+      double *loss, PRIMME_COMPLEX_DOUBLE *rwork, size_t *lrwork, primme_params *primme);
 int ortho_single_iteration_zprimme(PRIMME_COMPLEX_DOUBLE *Q, int64_t mQ, int64_t nQ,
       int64_t ldQ, PRIMME_COMPLEX_DOUBLE *X, int *inX, int nX, int64_t ldX,
       double *overlaps, double *norms, PRIMME_COMPLEX_DOUBLE *rwork, size_t *lrwork,
@@ -65,6 +95,15 @@ int ortho_sprimme(float *basis, int64_t ldBasis, float *R,
       int64_t ldR, int b1, int b2, float *locked, int64_t ldLocked,
       int numLocked, int64_t nLocal, int64_t *iseed, double machEps,
       float *rwork, size_t *rworkSize, primme_params *primme);
+int Bortho_sprimme(float *basis, int64_t ldBasis, float *Bbasis,
+      int64_t ldBbasis, int b1, int b2, float *locked,
+      int64_t ldLocked, float *Blocked, int64_t ldBlocked,
+      int numLocked, int64_t nLocal, int64_t *iseed, double machEps,
+      float *rwork, size_t *rworkSize, primme_params *primme);
+int ortho_pipelined_sprimme(float *V, int64_t ldV, float *W,
+      int64_t ldW, float *H, int ldH, float *G, int ldG,
+      int64_t nLocal, int numCols, int blockSize, double machEps,
+      double *loss, float *rwork, size_t *lrwork, primme_params *primme);
 int ortho_single_iteration_sprimme(float *Q, int64_t mQ, int64_t nQ,
       int64_t ldQ, float *X, int *inX, int nX, int64_t ldX,
       float *overlaps, float *norms, float *rwork, size_t *lrwork,
@@ -73,6 +112,15 @@ int ortho_cprimme(PRIMME_COMPLEX_FLOAT *basis, int64_t ldBasis, PRIMME_COMPLEX_F
       int64_t ldR, int b1, int b2, PRIMME_COMPLEX_FLOAT *locked, int64_t ldLocked,
       int numLocked, int64_t nLocal, int64_t *iseed, double machEps,
       PRIMME_COMPLEX_FLOAT *rwork, size_t *rworkSize, primme_params *primme);
+int Bortho_cprimme(PRIMME_COMPLEX_FLOAT *basis, int64_t ldBasis, PRIMME_COMPLEX_FLOAT *Bbasis,
+      int64_t ldBbasis, int b1, int b2, PRIMME_COMPLEX_FLOAT *locked,
+      int64_t ldLocked, PRIMME_COMPLEX_FLOAT *Blocked, int64_t ldBlocked,
+      int numLocked, int64_t nLocal, int64_t *iseed, double machEps,
+      PRIMME_COMPLEX_FLOAT *rwork, size_t *rworkSize, primme_params *primme);
+int ortho_pipelined_cprimme(PRIMME_COMPLEX_FLOAT *V, int64_t ldV, PRIMME_COMPLEX_FLOAT *W,
+      int64_t ldW, PRIMME_COMPLEX_FLOAT *H, int ldH, PRIMME_COMPLEX_FLOAT *G, int ldG,
+      int64_t nLocal, int numCols, int blockSize, double machEps,
+      double *loss, PRIMME_COMPLEX_FLOAT *rwork, size_t *lrwork, primme_params *primme);
 int ortho_single_iteration_cprimme(PRIMME_COMPLEX_FLOAT *Q, int64_t mQ, int64_t nQ,
       int64_t ldQ, PRIMME_COMPLEX_FLOAT *X, int *inX, int nX, int64_t ldX,
       float *overlaps, float *norms, PRIMME_COMPLEX_FLOAT *rwork, size_t *lrwork,
@@ -56,6 +56,11 @@
 
 #include <stdlib.h>   /* mallocs, free */
 #include <stdio.h>    
+#include <string.h>   /* strlen */
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+#include <unistd.h>   /* sysconf, ftruncate, unlink */
+#include <sys/mman.h> /* mmap */
+#endif
 #include "const.h"
 #include "wtime.h"
 #include "numerical.h"
@@ -66,13 +71,37 @@
 #include "restart.h"
 #include "correction.h"
 #include "update_projection.h"
+#include "auxiliary_eigs.h"
 #include "primme_interface.h"
 
 #define ALLOCATE_WORKSPACE_FAILURE -1
 #define MALLOC_FAILURE             -2
 #define MAIN_ITER_FAILURE          -3
+#define OUT_OF_CORE_FAILURE        -46
+
+/* Single precision counterparts of SCALAR and Sprimme used by the single */
+/* precision presolve, see solve_mixed_precision                           */
+#if defined(USE_DOUBLE)
+#  define LSCALAR float
+#  define Lprimme sprimme
+#elif defined(USE_DOUBLECOMPLEX)
+#  define LSCALAR PRIMME_COMPLEX_FLOAT
+#  define Lprimme cprimme
+#endif
+
+/* Residual tolerance relative to aNorm at which the single precision    */
+/* presolve stops and the double precision solver takes over             */
+#define MIXED_PRECISION_SWITCH_TOL (1000*FLT_EPSILON)
 
 static int allocate_workspace(primme_params *primme, int allocate);
+static size_t basis_size(primme_params *primme);
+static int map_basis(primme_params *primme, SCALAR **basis, size_t *size);
+#ifdef LSCALAR
+static int solve_mixed_precision(REAL *evals, SCALAR *evecs, REAL *resNorms,
+      primme_params *primme);
+#endif
+static int autotune_cache_block_size(primme_params *primme);
+static long get_l2_cache_size(void);
 static int check_input(REAL *evals, SCALAR *evecs, REAL *resNorms,
                        primme_params *primme);
 static void convTestFunAbsolute(double *eval, void *evec, double *rNorm, int *isConv,
@@ -112,6 +141,7 @@ static void convTestFunAbsolute(double *eval, void *evec, double *rNorm, int *is
  * -3 - main_iter encountered a problem
  * -4 ...-32 - Invalid input (parameters or primme struct) returned 
  *             by check_input()
+ * -46 - Failure to create or map the file in outOfCoreDir
  *
  ******************************************************************************/
  
@@ -121,11 +151,27 @@ int Sprimme(REAL *evals, SCALAR *evecs, REAL *resNorms,
    int ret;
    int *perm;
    double machEps;
+   SCALAR *basis = NULL;    /* V, W, BV and Q if they are stored in a file */
+   size_t basisSize = 0;    /* Size of basis in bytes                      */
 
-   /* ------------------ */
-   /* zero out the timer */
-   /* ------------------ */
-   primme_wTimer(1);
+#ifdef LSCALAR
+   /* --------------------------------------------------------- */
+   /* Presolve in single precision if mixedPrecision is set.    */
+   /* When resuming, the checkpoint is from the second stage,   */
+   /* and when warm starting, the kept basis is from it too.    */
+   /* --------------------------------------------------------- */
+   if (primme->mixedPrecision && !primme->checkpointResume
+         && !(primme->warmStart && primme->warmStartState) && evals && evecs
+         && resNorms) {
+      return solve_mixed_precision(evals, evecs, resNorms, primme);
+   }
+#endif
+
+   /* ------------------------------------------------------------ */
+   /* zero out the timer; it is kept in primme so that concurrent  */
+   /* solves with different primme_params do not interfere         */
+   /* ------------------------------------------------------------ */
+   primme->ctx.timerStart = primme_get_wtime();
 
    /* ----------------------- */
    /*  Find machine precision */
@@ -136,6 +182,8 @@ int Sprimme(REAL *evals, SCALAR *evecs, REAL *resNorms,
    /* Set some defaults  */
    /* ------------------ */
    primme_set_defaults(primme);
+   primme->ctx.cacheBlockSize = primme->cacheBlockSize > 0 ?
+         primme->cacheBlockSize : autotune_cache_block_size(primme);
 
    /* -------------------------------------------------------------- */
    /* If needed, we are ready to estimate required memory and return */
@@ -180,6 +228,14 @@ int Sprimme(REAL *evals, SCALAR *evecs, REAL *resNorms,
 
    CHKERRNOABORT(allocate_workspace(primme, TRUE), ALLOCATE_WORKSPACE_FAILURE);
 
+   /* --------------------------------------------------------- */
+   /* Map the basis into a file in outOfCoreDir, if it is set   */
+   /* --------------------------------------------------------- */
+   if (primme->outOfCoreDir) {
+      CHKERRNOABORT(map_basis(primme, &basis, &basisSize),
+            OUT_OF_CORE_FAILURE);
+   }
+
    /* --------------------------------------------------------- */
    /* Allocate workspace that will be needed locally by Sprimme */
    /* --------------------------------------------------------- */
@@ -189,9 +245,19 @@ int Sprimme(REAL *evals, SCALAR *evecs, REAL *resNorms,
    /* Call the solver                                                      */
    /*----------------------------------------------------------------------*/
 
-   CHKERRNOABORT(main_iter_Sprimme(evals, perm, evecs, primme->ldevecs,
-            resNorms, machEps, primme->intWork, primme->realWork, primme),
-         MAIN_ITER_FAILURE);
+   CHKERRNOABORT(monitor_Sprimme(primme_event_start, primme->ctx.timerStart,
+            0, 0, NULL, 0, primme), MAIN_ITER_FAILURE);
+
+   ret = main_iter_Sprimme(evals, perm, evecs, primme->ldevecs, resNorms,
+         machEps, primme->intWork, primme->realWork, basis, primme);
+
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+   if (basis) munmap(basis, basisSize);
+#endif
+
+   CHKERRNOABORT(monitor_Sprimme(primme_event_finish, primme->ctx.timerStart,
+            0, 0, NULL, primme->initSize, primme), MAIN_ITER_FAILURE);
+   CHKERRNOABORT(ret, MAIN_ITER_FAILURE);
 
    /*----------------------------------------------------------------------*/
    /* If locking is engaged, the converged Ritz vectors are stored in the  */
@@ -207,11 +273,417 @@ int Sprimme(REAL *evals, SCALAR *evecs, REAL *resNorms,
 
    free(perm);
 
-   primme->stats.elapsedTime = primme_wTimer(0);
+   /* Add the time before the checkpoint if the run was resumed */
+   primme->stats.elapsedTime += primme_wTimer(primme);
    return(0);
 }
 
 
+#ifdef LSCALAR
+
+/******************************************************************************
+ * Single precision presolve (primme.mixedPrecision)
+ *
+ * The eigenproblem is solved first with the single precision solver until
+ * the residual norms are MIXED_PRECISION_SWITCH_TOL*aNorm (or the requested
+ * tolerance, if larger). Then the resulting eigenvectors are the initial
+ * guesses of the double precision solver, which refines them up to the
+ * requested tolerance. The first stage is a complete single precision
+ * solve, projected problem included, while the user callbacks are called
+ * in double precision through the wrappers below. The workspace of the
+ * first stage is freed before the second stage allocates its own, so the
+ * peak memory is the same as without the presolve.
+ *
+ ******************************************************************************/
+
+typedef struct {
+   primme_params primme;   /* Parameters of the single precision solver  */
+                           /* NOTE: it should be the first member         */
+   primme_params *primme0; /* Parameters of the caller                    */
+   SCALAR *buf;            /* Buffer for the vectors in double precision  */
+   size_t bufSize;         /* Number of elements in buf                   */
+} mixed_params;
+
+static int mixed_buffer(mixed_params *mp, size_t size) {
+
+   if (mp->bufSize >= size) return 0;
+   free(mp->buf);
+   mp->bufSize = 0;
+   if (MALLOC_PRIMME(size, &mp->buf) != 0) return 1;
+   mp->bufSize = size;
+   return 0;
+}
+
+static void copy_to_double(LSCALAR *x, PRIMME_INT ldx, SCALAR *y,
+      PRIMME_INT ldy, PRIMME_INT m, int n) {
+
+   int i;
+   PRIMME_INT j;
+
+   for (i=0; i<n; i++)
+      for (j=0; j<m; j++)
+         y[ldy*i+j] = x[ldx*i+j];
+}
+
+static void copy_to_single(SCALAR *x, PRIMME_INT ldx, LSCALAR *y,
+      PRIMME_INT ldy, PRIMME_INT m, int n) {
+
+   int i;
+   PRIMME_INT j;
+
+   for (i=0; i<n; i++)
+      for (j=0; j<m; j++)
+         y[ldy*i+j] = (LSCALAR)x[ldx*i+j];
+}
+
+typedef void (*mixed_operator)(void *x, PRIMME_INT *ldx, void *y,
+      PRIMME_INT *ldy, int *blockSize, primme_params *primme, int *ierr);
+
+static void mixed_apply(mixed_operator op, void *x, PRIMME_INT *ldx, void *y,
+      PRIMME_INT *ldy, int *blockSize, primme_params *primme, int *ierr) {
+
+   mixed_params *mp = (mixed_params*)primme;
+   PRIMME_INT nLocal = primme->nLocal;
+   SCALAR *xd, *yd;
+
+   if (mixed_buffer(mp, (size_t)nLocal*(*blockSize)*2)) {
+      *ierr = 1;
+      return;
+   }
+   xd = mp->buf;
+   yd = xd + nLocal*(*blockSize);
+   copy_to_double((LSCALAR*)x, *ldx, xd, nLocal, nLocal, *blockSize);
+   mp->primme0->ShiftsForPreconditioner = primme->ShiftsForPreconditioner;
+   op(xd, &nLocal, yd, &nLocal, blockSize, mp->primme0, ierr);
+   copy_to_single(yd, nLocal, (LSCALAR*)y, *ldy, nLocal, *blockSize);
+}
+
+static void mixed_matrixMatvec(void *x, PRIMME_INT *ldx, void *y,
+      PRIMME_INT *ldy, int *blockSize, primme_params *primme, int *ierr) {
+
+   mixed_apply(((mixed_params*)primme)->primme0->matrixMatvec, x, ldx, y, ldy,
+         blockSize, primme, ierr);
+}
+
+static void mixed_applyPreconditioner(void *x, PRIMME_INT *ldx, void *y,
+      PRIMME_INT *ldy, int *blockSize, primme_params *primme, int *ierr) {
+
+   mixed_apply(((mixed_params*)primme)->primme0->applyPreconditioner, x, ldx,
+         y, ldy, blockSize, primme, ierr);
+}
+
+static void mixed_massMatrixMatvec(void *x, PRIMME_INT *ldx, void *y,
+      PRIMME_INT *ldy, int *blockSize, primme_params *primme, int *ierr) {
+
+   mixed_apply(((mixed_params*)primme)->primme0->massMatrixMatvec, x, ldx,
+         y, ldy, blockSize, primme, ierr);
+}
+
+static void mixed_globalSumReal(void *sendBuf, void *recvBuf, int *count,
+      primme_params *primme, int *ierr) {
+
+   mixed_params *mp = (mixed_params*)primme;
+   double *s, *r;
+   int i;
+
+   if (mixed_buffer(mp, ((size_t)*count*2*sizeof(double) + sizeof(SCALAR) - 1)
+            /sizeof(SCALAR))) {
+      *ierr = 1;
+      return;
+   }
+   s = (double*)mp->buf;
+   r = s + *count;
+   for (i=0; i<*count; i++) s[i] = ((float*)sendBuf)[i];
+   mp->primme0->globalSumReal(s, r, count, mp->primme0, ierr);
+   for (i=0; i<*count; i++) ((float*)recvBuf)[i] = (float)r[i];
+}
+
+/******************************************************************************
+ * Function solve_mixed_precision - Solve the problem first in single
+ *    precision and refine the solution in double precision. The parameters
+ *    and the return value are the same as in Sprimme; primme->initSize is
+ *    the caller's on input, and the number of converged pairs on output
+ *    unless the refinement fails before iterating.
+ *
+ ******************************************************************************/
+
+static int solve_mixed_precision(REAL *evals, SCALAR *evecs, REAL *resNorms,
+      primme_params *primme) {
+
+   mixed_params mp;
+   primme_params *primmef = &mp.primme;
+   LSCALAR *evecsf;
+   float *evalsf, *resNormsf;
+   PRIMME_INT ldevecs, ldevecsf, maxMatvecs;
+   int i, ret, numCols, numGuesses;
+   int initSize = primme->initSize, mixedPrecision = primme->mixedPrecision;
+
+   /* Set the parameters for the single precision solver */
+
+   mp.primme = *primme;
+   mp.primme0 = primme;
+   mp.buf = NULL;
+   mp.bufSize = 0;
+   primmef->mixedPrecision = 0;
+   primmef->matrixMatvec = mixed_matrixMatvec;
+   if (primme->applyPreconditioner) {
+      primmef->applyPreconditioner = mixed_applyPreconditioner;
+   }
+   if (primme->massMatrixMatvec) {
+      primmef->massMatrixMatvec = mixed_massMatrixMatvec;
+   }
+   if (primme->globalSumReal) {
+      primmef->globalSumReal = mixed_globalSumReal;
+   }
+   primmef->globalSumRealStart = NULL;
+   primmef->globalSumRealWait = NULL;
+   primmef->convTestFun = NULL;
+   primmef->eps = max(primme->eps, MIXED_PRECISION_SWITCH_TOL);
+   primmef->intWork = NULL;
+   primmef->realWork = NULL;
+   primmef->intWorkSize = 0;
+   primmef->realWorkSize = 0;
+   primmef->ldevecs = ldevecsf = primme->nLocal;
+   primmef->ldOPs = 0;
+   primmef->cacheBlockSize = 0;
+   primmef->checkpointFile = NULL;
+   primmef->checkpointInterval = 0;
+   primmef->warmStart = 0;
+   primmef->warmStartState = NULL;
+
+   /* Leave at least half of the matvecs for the refinement, in case */
+   /* the single precision solver stagnates                          */
+
+   if (primme->maxMatvecs > 0) {
+      primmef->maxMatvecs = max(1, primme->maxMatvecs/2);
+   }
+
+   /* Copy the constraints and the initial guesses in single precision */
+
+   ldevecs = primme->ldevecs > 0 ? primme->ldevecs : primme->nLocal;
+   numCols = primme->numOrthoConst + max(primme->numEvals, primme->initSize);
+   evecsf = (LSCALAR*)malloc(sizeof(LSCALAR)*ldevecsf*numCols);
+   evalsf = (float*)malloc(sizeof(float)*primme->numEvals);
+   resNormsf = (float*)malloc(sizeof(float)*primme->numEvals);
+   if (!evecsf || !evalsf || !resNormsf) {
+      free(evecsf); free(evalsf); free(resNormsf);
+      return MALLOC_FAILURE;
+   }
+   copy_to_single(evecs, ldevecs, evecsf, ldevecsf, primme->nLocal,
+         primme->numOrthoConst + max(primme->initSize, 0));
+
+   /* Solve in single precision */
+
+   ret = Lprimme(evalsf, evecsf, resNormsf, primmef);
+
+   /* Stop for invalid input or problems with the memory; continue if */
+   /* the single precision solver did not converge                    */
+
+   if (ret != 0 && ret != MAIN_ITER_FAILURE) {
+      free(evecsf); free(evalsf); free(resNormsf); free(mp.buf);
+      primme_free(primmef);
+      return ret;
+   }
+
+   /* Use the computed vectors as initial guesses in double precision */
+
+   numGuesses = ret == 0 ? primme->numEvals : primmef->initSize;
+   copy_to_double(&evecsf[ldevecsf*primme->numOrthoConst], ldevecsf,
+         &evecs[ldevecs*primme->numOrthoConst], ldevecs, primme->nLocal,
+         numGuesses);
+   if (primme->printLevel >= 2 && primme->procID == 0) {
+      fprintf(primme->outputFile, "Single precision presolve: refining in "
+            "double precision after %" PRIMME_INT_P " matvecs with %d "
+            "initial guesses\n", primmef->stats.numMatvecs, numGuesses);
+      fflush(primme->outputFile);
+   }
+   free(evecsf); free(evalsf); free(resNormsf); free(mp.buf);
+   primme_free(primmef);
+
+   /* Refine in double precision */
+
+   maxMatvecs = primme->maxMatvecs;
+   if (maxMatvecs > 0) {
+      primme->maxMatvecs = max(1, maxMatvecs - primmef->stats.numMatvecs);
+   }
+   primme->initSize = numGuesses;
+   primme->mixedPrecision = 0;
+   ret = Sprimme(evals, evecs, resNorms, primme);
+   primme->mixedPrecision = mixedPrecision;
+   primme->maxMatvecs = maxMatvecs;
+
+   /* Sprimme returns the number of converged pairs in initSize, unless */
+   /* it stopped before iterating; then give back the caller's value    */
+
+   if (ret != 0 && ret != MAIN_ITER_FAILURE) {
+      primme->initSize = initSize;
+   }
+
+   /* Accumulate the statistics of both stages */
+
+   if (primmef->stats.numOuterIterations > 0) {
+      primme->stats.avgBlockSize = (primme->stats.avgBlockSize
+            *primme->stats.numOuterIterations + primmef->stats.avgBlockSize
+            *primmef->stats.numOuterIterations)
+         / (primme->stats.numOuterIterations
+               + primmef->stats.numOuterIterations);
+   }
+   primme->stats.numOuterIterations += primmef->stats.numOuterIterations;
+   primme->stats.numRestarts += primmef->stats.numRestarts;
+   primme->stats.numMatvecs += primmef->stats.numMatvecs;
+   primme->stats.numPreconds += primmef->stats.numPreconds;
+   primme->stats.numGlobalSum += primmef->stats.numGlobalSum;
+   primme->stats.volumeGlobalSum += primmef->stats.volumeGlobalSum;
+   primme->stats.numOrthoInnerProds += primmef->stats.numOrthoInnerProds;
+   primme->stats.elapsedTime += primmef->stats.elapsedTime;
+   primme->stats.timeMatvec += primmef->stats.timeMatvec;
+   primme->stats.timePrecond += primmef->stats.timePrecond;
+   primme->stats.timeOrtho += primmef->stats.timeOrtho;
+   primme->stats.timeGlobalSum += primmef->stats.timeGlobalSum;
+   for (i=0; i<4; i++) primme->iseed[i] = primmef->iseed[i];
+
+   return ret;
+}
+
+#endif /* LSCALAR */
+
+/******************************************************************************
+ * Function autotune_cache_block_size - Return the number of rows processed at
+ *    once by the cache-blocked kernels (Num_update_VWXR, ortho, restart and
+ *    locking).
+ *
+ *    Each block of rows involves a panel of V or W with up to maxBasisSize
+ *    columns and the panel with the product, also with up to maxBasisSize
+ *    columns. The number of rows is chosen so that both panels fill half the
+ *    L2 cache, leaving room for the rotation matrix and other data. The
+ *    result is rounded down to a multiple of 16 rows and clamped to
+ *    [PRIMME_MIN_CACHE_BLOCK_SIZE, PRIMME_MAX_CACHE_BLOCK_SIZE]. If the size
+ *    of the L2 cache is unknown, PRIMME_BLOCK_SIZE is returned.
+ *
+ * INPUT PARAMETERS
+ * ----------------
+ * primme    Structure containing various solver parameters
+ *
+ ******************************************************************************/
+
+static int autotune_cache_block_size(primme_params *primme) {
+
+   long l2 = get_l2_cache_size();
+   size_t rowSize;   /* Bytes of a row in both panels */
+   size_t m;
+
+   if (l2 <= 0) return PRIMME_BLOCK_SIZE;
+
+   rowSize = sizeof(SCALAR)*2*(size_t)max(primme->maxBasisSize, 1);
+   m = ((size_t)l2/2/rowSize)/16*16;
+   return (int)min(max(m, (size_t)PRIMME_MIN_CACHE_BLOCK_SIZE),
+         (size_t)PRIMME_MAX_CACHE_BLOCK_SIZE);
+}
+
+/******************************************************************************
+ * Function get_l2_cache_size - Return the size in bytes of the L2 cache of
+ *    the first CPU, or zero if it cannot be found out.
+ *
+ ******************************************************************************/
+
+static long get_l2_cache_size(void) {
+
+   long size = 0;
+
+#if defined(_SC_LEVEL2_CACHE_SIZE)
+   size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+#endif
+
+#if defined(__linux__)
+   if (size <= 0) {
+      FILE *f = fopen("/sys/devices/system/cpu/cpu0/cache/index2/size", "r");
+      char unit = 0;
+      if (f) {
+         if (fscanf(f, "%ld%c", &size, &unit) < 1) size = 0;
+         if (unit == 'K') size *= 1024;
+         else if (unit == 'M') size *= 1024*1024;
+         fclose(f);
+      }
+   }
+#endif
+
+   return size > 0 ? size : 0;
+}
+
+/******************************************************************************
+ * Function basis_size - Return the number of SCALARs taken by the arrays of
+ *    ldOPs rows used by main_iter: V, W, B*V in the generalized problem, and
+ *    Q in the harmonic and refined projections.
+ *
+ ******************************************************************************/
+
+static size_t basis_size(primme_params *primme) {
+
+   size_t n = 2;     /* V and W */
+
+   if (primme->massMatrixMatvec) n++;
+   if (primme->projectionParams.projection == primme_proj_harmonic ||
+         primme->projectionParams.projection == primme_proj_refined) n++;
+   return n*primme->ldOPs*primme->maxBasisSize;
+}
+
+/******************************************************************************
+ * Function map_basis - Create a file in primme.outOfCoreDir with room for V,
+ *    W, BV and Q, and map it into memory. The file is removed right away, so
+ *    it disappears when it is unmapped or the process ends. As the mapping
+ *    is shared, the operating system writes the pages of the basis that do
+ *    not fit in memory back to the file instead of to the swap; the kernels
+ *    that walk the basis by panels of rows ask for the next panel in
+ *    advance, see Num_prefetch_rows_Sprimme.
+ *
+ * Output
+ *  basis     Pointer to the mapped memory
+ *  size      Size of the mapping in bytes
+ *
+ * Return value
+ * ------------
+ * int -  0 if the file is created and mapped successfully, -1 otherwise
+ *
+ ******************************************************************************/
+
+static int map_basis(primme_params *primme, SCALAR **basis, size_t *size) {
+
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+   char *fileName;
+   int fd;
+   void *p = MAP_FAILED;
+
+   *size = basis_size(primme)*sizeof(SCALAR);
+   if (MALLOC_PRIMME(strlen(primme->outOfCoreDir) + 24, &fileName) != 0) {
+      return -1;
+   }
+   sprintf(fileName, "%s/primme_basis.XXXXXX", primme->outOfCoreDir);
+   fd = mkstemp(fileName);
+   if (fd >= 0) {
+      unlink(fileName);
+      if (ftruncate(fd, (off_t)*size) == 0) {
+         p = mmap(NULL, *size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      }
+      close(fd);
+   }
+   if (p == MAP_FAILED && primme->printLevel > 0 && primme->outputFile) {
+      fprintf(primme->outputFile, "PRIMME: Could not map a file of %zd bytes "
+            "in '%s'\n", *size, primme->outOfCoreDir);
+   }
+   free(fileName);
+   *basis = p != MAP_FAILED ? (SCALAR*)p : NULL;
+   return *basis ? 0 : -1;
+#else
+   (void)basis;
+   (void)size;
+   if (primme->printLevel > 0 && primme->outputFile) {
+      fprintf(primme->outputFile, "PRIMME: outOfCoreDir is not supported in "
+            "this platform\n");
+   }
+   return -1;
+#endif
+}
+
 /******************************************************************************
  * Function allocate_workspace - This function computes the amount of integer 
  *    and real workspace needed by the solver and possibly allocates the space 
@@ -245,7 +717,7 @@ static int allocate_workspace(primme_params *primme, int allocate) {
    size_t rworkByteSize=0; /* Size of all real data in bytes            */
    int intWorkSize=0;/* Size of integer work space in bytes             */
 
-   int dataSize;     /* Number of SCALAR positions allocated, excluding */
+   size_t dataSize;  /* Number of SCALAR positions allocated, excluding */
                      /* REAL (see doubleSize below) and work space.  */
    int doubleSize=0; /* Number of doubles allocated exclusively to the  */
                      /* double arrays: hVals, prevRitzVals, blockNorms  */
@@ -261,25 +733,33 @@ static int allocate_workspace(primme_params *primme, int allocate) {
    /* Compute the memory required by the main iteration data structures    */
    /*----------------------------------------------------------------------*/
 
-   dataSize = primme->ldOPs*primme->maxBasisSize   /* Size of V            */
-      + primme->ldOPs*primme->maxBasisSize         /* Size of W            */
-      + primme->maxBasisSize*primme->maxBasisSize  /* Size of H            */
+   dataSize = primme->maxBasisSize*primme->maxBasisSize /* Size of H       */
       + primme->maxBasisSize*primme->maxBasisSize  /* Size of hVecs        */
       + primme->restartingParams.maxPrevRetain*primme->maxBasisSize;
                                                    /* size of prevHVecs    */
 
+   /*----------------------------------------------------------------------*/
+   /* Add memory for V, W, B*V and Q, unless they are stored in a file     */
+   /*----------------------------------------------------------------------*/
+   if (!primme->outOfCoreDir) {
+      dataSize += basis_size(primme);
+   }
+
    /*----------------------------------------------------------------------*/
    /* Add memory for Harmonic or Refined projection                        */
    /*----------------------------------------------------------------------*/
    if (primme->projectionParams.projection == primme_proj_harmonic ||
          primme->projectionParams.projection == primme_proj_refined) {
 
-      dataSize += primme->ldOPs*primme->maxBasisSize     /* Size of Q      */
-         + primme->maxBasisSize*primme->maxBasisSize     /* Size of R      */
+      dataSize += primme->maxBasisSize*primme->maxBasisSize  /* Size of R      */
          + primme->maxBasisSize*primme->maxBasisSize     /* Size of hU     */
          + primme->maxBasisSize*primme->maxBasisSize;    /* Size of hVecsRot */
       doubleSize += primme->maxBasisSize;                /* Size of hSVals */
    }
+   if (primme->orth == primme_orth_pipelined) {
+      dataSize +=
+            primme->maxBasisSize*primme->maxBasisSize;      /* Size of WtW */
+   }
    if (primme->projectionParams.projection == primme_proj_harmonic) {
       /* Stored QtV = Q'*V */
       dataSize +=
@@ -302,12 +782,19 @@ static int allocate_workspace(primme_params *primme, int allocate) {
       evecsHat = &t; /* set not NULL */
    }
 
+   /*----------------------------------------------------------------------*/
+   /* Add memory for B*evecs in the generalized problem with locking       */
+   /*----------------------------------------------------------------------*/
+   if (primme->massMatrixMatvec && primme->locking) {
+      dataSize += primme->nLocal*maxEvecsSize;      /* Size of Bevecs       */
+   }
+
    /*----------------------------------------------------------------------*/
    /* Determine workspace required by init and its children                */
    /*----------------------------------------------------------------------*/
 
-   CHKERR(init_basis_Sprimme(NULL, primme->nLocal, 0, NULL, 0, NULL, 0,
-            NULL, 0, NULL, 0, NULL, 0, NULL, 0, NULL, &realWorkSize,
+   CHKERR(init_basis_Sprimme(NULL, primme->nLocal, 0, NULL, 0, NULL, NULL,
+            0, NULL, 0, NULL, 0, NULL, 0, NULL, 0, NULL, &realWorkSize,
             &primme->maxBasisSize, NULL, NULL, primme), -1);
 
    /*----------------------------------------------------------------------*/
@@ -318,6 +805,22 @@ static int allocate_workspace(primme_params *primme, int allocate) {
             primme->maxBasisSize+primme->maxBlockSize-1, NULL, primme->nLocal, 
             primme->locking?maxEvecsSize:primme->numOrthoConst+1, primme->nLocal,
             NULL, 0.0, NULL, &realWorkSize, primme), -1);
+   if (primme->massMatrixMatvec) {
+      CHKERR(Bortho_Sprimme(NULL, 0, NULL, 0, primme->maxBasisSize,
+               primme->maxBasisSize+primme->maxBlockSize-1, NULL, 0, NULL, 0,
+               primme->locking?maxEvecsSize:0, primme->nLocal, NULL, 0.0, NULL,
+               &realWorkSize, primme), -1);
+   }
+
+   /* The pipelined ortho also computes W'*W from scratch after restarting */
+
+   if (primme->orth == primme_orth_pipelined) {
+      CHKERR(ortho_pipelined_Sprimme(NULL, 0, NULL, 0, NULL, 0, NULL, 0,
+               primme->nLocal, primme->maxBasisSize, primme->maxBlockSize, 0.0,
+               NULL, NULL, &realWorkSize, primme), -1);
+      CHKERR(update_projection_Sprimme(NULL, 0, NULL, 0, NULL, 0, 0,
+               primme->maxBasisSize, 0, NULL, &realWorkSize, 1, primme), -1);
+   }
 
    /*----------------------------------------------------------------------*/
    /* Determine workspace required by solve_H and its children             */
@@ -331,8 +834,8 @@ static int allocate_workspace(primme_params *primme, int allocate) {
    /* Determine workspace required by solve_correction and its children    */
    /*----------------------------------------------------------------------*/
 
-   CHKERR(solve_correction_Sprimme(NULL, 0, NULL, 0, NULL, 0, NULL, 0, NULL, 
-            NULL, NULL, maxEvecsSize, 0, NULL, NULL, NULL, NULL, 
+   CHKERR(solve_correction_Sprimme(NULL, 0, NULL, 0, NULL, NULL, 0, NULL, 0,
+            NULL, NULL, NULL, maxEvecsSize, 0, NULL, NULL, NULL, NULL, 
             primme->maxBasisSize, NULL, NULL, primme->maxBlockSize, 
             0.0, NULL, &realWorkSize, &intWorkSize, 0, primme), -1);
 
@@ -340,9 +843,11 @@ static int allocate_workspace(primme_params *primme, int allocate) {
    /* Determine workspace required by restarting and its children          */
    /*----------------------------------------------------------------------*/
 
-   CHKERR(restart_Sprimme(NULL, NULL, primme->nLocal, primme->maxBasisSize,
-            0, NULL, NULL, NULL, NULL, &primme->maxBlockSize, NULL, NULL, 0,
-            NULL, NULL, NULL, evecsHat, 0, NULL, 0, NULL, 0, NULL,
+   CHKERR(restart_Sprimme(NULL, NULL, NULL, primme->nLocal,
+            primme->maxBasisSize,
+            0, NULL, NULL, NULL, NULL, &primme->maxBlockSize, NULL, NULL,
+            NULL, NULL, NULL, 0, NULL, 0, NULL, NULL, NULL, evecsHat, 0, NULL,
+            0, NULL, 0, NULL,
             &primme->numEvals, &primme->numEvals, &primme->numEvals, NULL,
             &primme->restartingParams.maxPrevRetain, primme->maxBasisSize,
             primme->initSize, NULL, &primme->maxBasisSize, NULL,
@@ -357,8 +862,8 @@ static int allocate_workspace(primme_params *primme, int allocate) {
    CHKERR(update_projection_Sprimme(NULL, 0, NULL, 0, NULL, 0, 0, 0,
             primme->maxBasisSize, NULL, &realWorkSize, 0, primme), -1);
 
-   CHKERR(prepare_candidates_Sprimme(NULL, 0, NULL, 0, primme->nLocal, NULL, 0,
-            primme->maxBasisSize, NULL, NULL, NULL, 0, NULL, NULL, NULL,
+   CHKERR(prepare_candidates_Sprimme(NULL, 0, NULL, 0, NULL, primme->nLocal,
+            NULL, 0, NULL, 0, 0.0, primme->maxBasisSize, NULL, NULL, NULL, NULL, 0, NULL, NULL, NULL,
             primme->numEvals, NULL, 0, primme->maxBlockSize,
             NULL, primme->numEvals, 0, NULL, NULL, 0, 0.0, NULL,
             &primme->maxBlockSize, NULL, NULL, NULL, NULL, 0, NULL, NULL,
@@ -374,14 +879,21 @@ static int allocate_workspace(primme_params *primme, int allocate) {
    /*----------------------------------------------------------------------*/
    realWorkSize = max(realWorkSize, (size_t)2*primme->numEvals);
 
+   /*----------------------------------------------------------------------*/
+   /* Workspace needed by permute_vecs in Sprimme, which may not be        */
+   /* included already if V and W are not in realWork                     */
+   /*----------------------------------------------------------------------*/
+   realWorkSize = max(realWorkSize, (size_t)primme->nLocal);
+
    /*----------------------------------------------------------------------*/
    /* The following size is always allocated as REAL                       */
    /*----------------------------------------------------------------------*/
 
-   doubleSize += 4     /* padding cause by TO_REAL aligning them to SCALAR */
+   doubleSize += 6     /* padding cause by TO_REAL aligning them to SCALAR */
       + primme->maxBasisSize                       /* Size of hVals        */
       + primme->numEvals+primme->maxBasisSize      /* Size of prevRitzVals */
-      + primme->maxBlockSize;                      /* Size of blockNorms   */
+      + primme->maxBlockSize                       /* Size of blockNorms   */
+      + 2*primme->maxBasisSize;                    /* convNorms, convVals  */
 
    /*----------------------------------------------------------------------*/
    /* Determine the integer workspace needed                               */
@@ -532,6 +1044,22 @@ static int check_input(REAL *evals, SCALAR *evecs, REAL *resNorms,
    else if (primme->ldOPs != 0 && primme->ldOPs < primme->nLocal)
       ret = -35;
    /* Booked -36 and -37 */
+   else if ((primme->globalSumRealStart == NULL)
+         != (primme->globalSumRealWait == NULL))
+      ret = -38;
+   else if (primme->cacheBlockSize < 0)
+      ret = -39;
+   else if (primme->massMatrixMatvec && (primme->numOrthoConst > 0 ||
+            primme->projectionParams.projection != primme_proj_RR ||
+            primme->correctionParams.maxInnerIterations != 0 ||
+            primme->correctionParams.filterDegree > 0 ||
+            primme->dynamicMethodSwitch > 0))
+      ret = -40;
+   else if (primme->checkpointInterval < 0 || (!primme->checkpointFile &&
+            (primme->checkpointInterval > 0 || primme->checkpointResume)))
+      ret = -41;
+   else if (primme->correctionParams.filterDegree < 0)
+      ret = -42;
    /* Please keep this if instruction at the end */
    else if ( primme->target == primme_largest_abs ||
              primme->target == primme_closest_geq ||
@@ -53,6 +53,19 @@ void AS_FORTRAN(Sprimme)(REAL *evals, SCALAR *evecs,
 
 } /* end of xprimme_f77 wrapper for calling from Fortran */
 
+/******************************************************************************
+ * Same for the spectrum slicing front end
+ *****************************************************************************/
+
+void AS_FORTRAN(Sprimme_slicing)(REAL *evals, SCALAR *evecs,
+      REAL *rnorms, double *lower, double *upper, int *numSlices,
+      primme_params **primme, int *ierr) {
+
+  *ierr = Sprimme_slicing(evals, evecs, rnorms, *lower, *upper, *numSlices,
+        *primme);
+
+} /* end of xprimme_slicing_f77 wrapper for calling from Fortran */
+
 
 /* Only define these functions ones */
 #ifdef USE_DOUBLE
@@ -152,6 +165,12 @@ void AS_FORTRAN(primme_set_member)(primme_params **primme, int *label,
       case PRIMMEF77_globalSumReal:
               (*primme)->globalSumReal = v.globalSumRealFunc_v;
       break;
+      case PRIMMEF77_globalSumRealStart:
+              (*primme)->globalSumRealStart = v.globalSumRealStartFunc_v;
+      break;
+      case PRIMMEF77_globalSumRealWait:
+              (*primme)->globalSumRealWait = v.globalSumRealWaitFunc_v;
+      break;
       case PRIMMEF77_numEvals:
               if (*v.int_v > INT_MAX) *ierr = 1; else 
               (*primme)->numEvals = (int)*v.int_v;
@@ -182,6 +201,10 @@ void AS_FORTRAN(primme_set_member)(primme_params **primme, int *label,
               if (*v.int_v > INT_MAX) *ierr = 1; else 
               (*primme)->dynamicMethodSwitch = (int)*v.int_v;
       break;
+      case PRIMMEF77_dynamicBlockSize:
+              if (*v.int_v > INT_MAX) *ierr = 1; else 
+              (*primme)->dynamicBlockSize = (int)*v.int_v;
+      break;
       case PRIMMEF77_maxBasisSize:
               if (*v.int_v > INT_MAX) *ierr = 1; else 
               (*primme)->maxBasisSize = (int)*v.int_v;
@@ -243,6 +266,9 @@ void AS_FORTRAN(primme_set_member)(primme_params **primme, int *label,
       case PRIMMEF77_projectionParams_projection:
               (*primme)->projectionParams.projection = *v.projection_v;
       break;
+      case PRIMMEF77_orth:
+              (*primme)->orth = *v.orth_v;
+      break;
       case PRIMMEF77_restartingParams_scheme:
               (*primme)->restartingParams.scheme = *v.restartscheme_v;
       break;
@@ -292,6 +318,14 @@ void AS_FORTRAN(primme_set_member)(primme_params **primme, int *label,
       case PRIMMEF77_correctionParams_relTolBase:
               (*primme)->correctionParams.relTolBase = *v.double_v;
       break;
+      case PRIMMEF77_correctionParams_fuseGlobalSums:
+              if (*v.int_v > INT_MAX) *ierr = 1; else 
+              (*primme)->correctionParams.fuseGlobalSums = (int)*v.int_v;
+      break;
+      case PRIMMEF77_correctionParams_filterDegree:
+              if (*v.int_v > INT_MAX) *ierr = 1; else 
+              (*primme)->correctionParams.filterDegree = (int)*v.int_v;
+      break;
       case PRIMMEF77_stats_numOuterIterations:
               (*primme)->stats.numOuterIterations = *v.int_v;
       break;
@@ -319,6 +353,9 @@ void AS_FORTRAN(primme_set_member)(primme_params **primme, int *label,
       case PRIMMEF77_stats_maxConvTol:
               (*primme)->stats.maxConvTol = *v.double_v;
       break;
+      case PRIMMEF77_stats_avgBlockSize:
+              (*primme)->stats.avgBlockSize = *v.double_v;
+      break;
       case PRIMMEF77_convTestFun:
               (*primme)->convTestFun = v.convTestFun_v;
       break;
@@ -328,6 +365,37 @@ void AS_FORTRAN(primme_set_member)(primme_params **primme, int *label,
       case PRIMMEF77_ldOPs:
               (*primme)->ldOPs = *v.int_v;
       break;
+      case PRIMMEF77_cacheBlockSize:
+              if (*v.int_v > INT_MAX) *ierr = 1; else 
+              (*primme)->cacheBlockSize = (int)*v.int_v;
+      break;
+      case PRIMMEF77_mixedPrecision:
+              if (*v.int_v > INT_MAX) *ierr = 1; else 
+              (*primme)->mixedPrecision = (int)*v.int_v;
+      break;
+      case PRIMMEF77_checkpointFile:
+              (*primme)->checkpointFile = (const char*)v.ptr_v;
+      break;
+      case PRIMMEF77_checkpointInterval:
+              if (*v.int_v > INT_MAX) *ierr = 1; else 
+              (*primme)->checkpointInterval = (int)*v.int_v;
+      break;
+      case PRIMMEF77_checkpointResume:
+              if (*v.int_v > INT_MAX) *ierr = 1; else 
+              (*primme)->checkpointResume = (int)*v.int_v;
+      break;
+      case PRIMMEF77_monitor:
+              (*primme)->monitor = v.ptr_v;
+      break;
+      case PRIMMEF77_monitorFun:
+              (*primme)->monitorFun = v.monitorFun_v;
+      break;
+      case PRIMMEF77_outOfCoreDir:
+              (*primme)->outOfCoreDir = (const char*)v.ptr_v;
+      break;
+      case PRIMMEF77_warmStart:
+              (*primme)->warmStart = (int)*v.int_v;
+      break;
       default : 
       *ierr = 1;
    }
@@ -395,6 +463,12 @@ void AS_FORTRAN(primme_get_member)(primme_params *primme, int *label,
       case PRIMMEF77_globalSumReal:
               v->globalSumRealFunc_v = primme->globalSumReal;
       break;
+      case PRIMMEF77_globalSumRealStart:
+              v->globalSumRealStartFunc_v = primme->globalSumRealStart;
+      break;
+      case PRIMMEF77_globalSumRealWait:
+              v->globalSumRealWaitFunc_v = primme->globalSumRealWait;
+      break;
       case PRIMMEF77_numEvals:
               v->int_v = primme->numEvals;
       break;
@@ -421,6 +495,9 @@ void AS_FORTRAN(primme_get_member)(primme_params *primme, int *label,
       case PRIMMEF77_dynamicMethodSwitch:
               v->int_v = primme->dynamicMethodSwitch;
       break;
+      case PRIMMEF77_dynamicBlockSize:
+              v->int_v = primme->dynamicBlockSize;
+      break;
       case PRIMMEF77_maxBasisSize:
               v->int_v = primme->maxBasisSize;
       break;
@@ -471,6 +548,9 @@ void AS_FORTRAN(primme_get_member)(primme_params *primme, int *label,
       case PRIMMEF77_preconditioner:
               v->ptr_v = primme->preconditioner;
       break;
+      case PRIMMEF77_orth:
+              v->orth_v = primme->orth;
+      break;
       case PRIMMEF77_restartingParams_scheme:
               v->restartscheme_v = primme->restartingParams.scheme;
       break;
@@ -510,6 +590,12 @@ void AS_FORTRAN(primme_get_member)(primme_params *primme, int *label,
       case PRIMMEF77_correctionParams_relTolBase:
               v->double_v = primme->correctionParams.relTolBase;
       break;
+      case PRIMMEF77_correctionParams_fuseGlobalSums:
+              v->int_v = primme->correctionParams.fuseGlobalSums;
+      break;
+      case PRIMMEF77_correctionParams_filterDegree:
+              v->int_v = primme->correctionParams.filterDegree;
+      break;
       case PRIMMEF77_stats_numOuterIterations:
               v->int_v = primme->stats.numOuterIterations;
       break;
@@ -525,12 +611,42 @@ void AS_FORTRAN(primme_get_member)(primme_params *primme, int *label,
       case PRIMMEF77_stats_elapsedTime:
               v->double_v = primme->stats.elapsedTime;
       break;
+      case PRIMMEF77_stats_avgBlockSize:
+              v->double_v = primme->stats.avgBlockSize;
+      break;
       case PRIMMEF77_ldevecs:
               v->int_v = primme->ldevecs;
       break;
       case PRIMMEF77_ldOPs:
               v->int_v = primme->ldOPs;
       break;
+      case PRIMMEF77_cacheBlockSize:
+              v->int_v = primme->cacheBlockSize;
+      break;
+      case PRIMMEF77_mixedPrecision:
+              v->int_v = primme->mixedPrecision;
+      break;
+      case PRIMMEF77_checkpointFile:
+              v->ptr_v = (void*)primme->checkpointFile;
+      break;
+      case PRIMMEF77_checkpointInterval:
+              v->int_v = primme->checkpointInterval;
+      break;
+      case PRIMMEF77_checkpointResume:
+              v->int_v = primme->checkpointResume;
+      break;
+      case PRIMMEF77_monitor:
+              v->ptr_v = primme->monitor;
+      break;
+      case PRIMMEF77_monitorFun:
+              v->monitorFun_v = primme->monitorFun;
+      break;
+      case PRIMMEF77_outOfCoreDir:
+              v->ptr_v = (void*)primme->outOfCoreDir;
+      break;
+      case PRIMMEF77_warmStart:
+              v->int_v = primme->warmStart;
+      break;
       default :
       *ierr = 1;
    }
@@ -48,6 +48,8 @@
 #define PRIMMEF77_commInfo  5
 #define PRIMMEF77_nLocal  6
 #define PRIMMEF77_globalSumReal  7
+#define PRIMMEF77_globalSumRealStart  71
+#define PRIMMEF77_globalSumRealWait  72
 #define PRIMMEF77_numEvals  8
 #define PRIMMEF77_target  9
 #define PRIMMEF77_numTargetShifts  10
@@ -73,6 +75,7 @@
 #define PRIMMEF77_preconditioner  30
 #define PRIMMEF77_initBasisMode   301
 #define PRIMMEF77_projectionParams_projection  302
+#define PRIMMEF77_orth  303
 #define PRIMMEF77_restartingParams_scheme  31
 #define PRIMMEF77_restartingParams_maxPrevRetain  32
 #define PRIMMEF77_correctionParams_precondition  33
@@ -86,6 +89,8 @@
 #define PRIMMEF77_correctionParams_projectors_SkewX  41
 #define PRIMMEF77_correctionParams_convTest  42
 #define PRIMMEF77_correctionParams_relTolBase  43
+#define PRIMMEF77_correctionParams_fuseGlobalSums  431
+#define PRIMMEF77_correctionParams_filterDegree  432
 #define PRIMMEF77_stats_numOuterIterations  44
 #define PRIMMEF77_stats_numRestarts  45
 #define PRIMMEF77_stats_numMatvecs  46
@@ -95,11 +100,22 @@
 #define PRIMMEF77_stats_estimateMaxEVal  482
 #define PRIMMEF77_stats_estimateLargestSVal  483
 #define PRIMMEF77_stats_maxConvTol  484
+#define PRIMMEF77_stats_avgBlockSize  485
 #define PRIMMEF77_dynamicMethodSwitch 49
 #define PRIMMEF77_massMatrixMatvec  50
 #define PRIMMEF77_convTestFun  51
 #define PRIMMEF77_ldevecs  52
 #define PRIMMEF77_ldOPs  53
+#define PRIMMEF77_cacheBlockSize  54
+#define PRIMMEF77_mixedPrecision  55
+#define PRIMMEF77_checkpointFile  56
+#define PRIMMEF77_checkpointInterval  57
+#define PRIMMEF77_checkpointResume  58
+#define PRIMMEF77_monitor  59
+#define PRIMMEF77_monitorFun  60
+#define PRIMMEF77_outOfCoreDir  61
+#define PRIMMEF77_dynamicBlockSize  62
+#define PRIMMEF77_warmStart  63
 
 #include "template.h"
 #include "primme_interface.h" /* for Sprimme */
@@ -115,11 +131,15 @@ union f77_value {
    void (*matFunc_v) (void *,PRIMME_INT*,void *,PRIMME_INT*,int *,struct primme_params *,int*);
    void *ptr_v;
    void (*globalSumRealFunc_v) (void *,void *,int *,struct primme_params *,int*);
+   void (*globalSumRealStartFunc_v) (void *,void *,int *,struct primme_params *,void **,int*);
+   void (*globalSumRealWaitFunc_v) (void *,struct primme_params *,int*);
    void (*convTestFun_v)(double *,void*,double*,int*,struct primme_params*,int*);
+   void (*monitorFun_v)(primme_event*,double*,double*,int*,int*,double*,int*,struct primme_params*,int*);
    primme_target *target_v;
    double *double_v;
    FILE *file_v;
    primme_init *init_v;
+   primme_orth *orth_v;
    primme_projection *projection_v;
    primme_restartscheme *restartscheme_v;
    primme_convergencetest *convergencetest_v;
@@ -129,11 +149,15 @@ union f77_value_ptr {
    void (*matFunc_v) (void *,PRIMME_INT*,void *,PRIMME_INT*,int *,struct primme_params *,int*);
    void *ptr_v;
    void (*globalSumRealFunc_v) (void *,void *,int *,struct primme_params *,int*);
+   void (*globalSumRealStartFunc_v) (void *,void *,int *,struct primme_params *,void **,int*);
+   void (*globalSumRealWaitFunc_v) (void *,struct primme_params *,int*);
    void (*convTestFun_v)(double *,void*,double*,int*,struct primme_params*,int*);
+   void (*monitorFun_v)(primme_event*,double*,double*,int*,int*,double*,int*,struct primme_params*,int*);
    primme_target target_v;
    double double_v;
    FILE *file_v;
    primme_init init_v;
+   primme_orth orth_v;
    primme_projection projection_v;
    primme_restartscheme restartscheme_v;
    primme_convergencetest convergencetest_v;
@@ -144,6 +168,9 @@ union f77_value_ptr {
 
 void AS_FORTRAN(Sprimme)(REAL *evals, SCALAR *evecs,
       REAL *rnorms, primme_params **primme, int *ierr);
+void AS_FORTRAN(Sprimme_slicing)(REAL *evals, SCALAR *evecs,
+      REAL *rnorms, double *lower, double *upper, int *numSlices,
+      primme_params **primme, int *ierr);
 
 /* Only define these functions ones */
 #ifdef USE_DOUBLE
@@ -80,6 +80,8 @@ void primme_initialize(primme_params *primme) {
    primme->nLocal                  = 0;
    primme->commInfo                = NULL;
    primme->globalSumReal           = NULL;
+   primme->globalSumRealStart      = NULL;
+   primme->globalSumRealWait       = NULL;
 
    /* Initial guesses/constraints */
    primme->initSize                = 0;
@@ -88,10 +90,12 @@ void primme_initialize(primme_params *primme) {
    primme->projectionParams.projection = primme_proj_default;
 
    primme->initBasisMode                       = primme_init_default;
+   primme->orth                                = primme_orth_default;
 
    /* Eigensolver parameters (outer) */
    primme->locking                             = -1;
    primme->dynamicMethodSwitch                 = -1;
+   primme->dynamicBlockSize                    = 0;
    primme->maxBasisSize                        = 0;
    primme->minRestartSize                      = 0;
    primme->maxBlockSize                        = 0;
@@ -112,6 +116,8 @@ void primme_initialize(primme_params *primme) {
    primme->correctionParams.projectors.SkewX   = 0;
    primme->correctionParams.relTolBase         = 0;
    primme->correctionParams.convTest           = primme_adaptive_ETolerance;
+   primme->correctionParams.fuseGlobalSums     = 0;
+   primme->correctionParams.filterDegree       = 0;
 
    /* Printing and reporting */
    primme->outputFile              = stdout;
@@ -120,6 +126,7 @@ void primme_initialize(primme_params *primme) {
    primme->stats.numRestarts       = 0;
    primme->stats.numMatvecs        = 0;
    primme->stats.numPreconds       = 0;
+   primme->stats.numGlobalSum      = 0;
    primme->stats.volumeGlobalSum   = 0;
    primme->stats.numOrthoInnerProds= 0.0;
    primme->stats.elapsedTime       = 0.0;
@@ -130,6 +137,9 @@ void primme_initialize(primme_params *primme) {
    primme->stats.estimateMinEVal   = HUGE_VAL;
    primme->stats.estimateLargestSVal = -HUGE_VAL;
    primme->stats.maxConvTol        = 0.0L;
+   primme->stats.avgBlockSize      = 0.0;
+   primme->ctx.timerStart          = 0.0;
+   primme->ctx.cacheBlockSize      = 0;
 
    /* Optional user defined structures */
    primme->matrix                  = NULL;
@@ -148,6 +158,16 @@ void primme_initialize(primme_params *primme) {
    primme->convTestFun             = NULL;
    primme->ldevecs                 = 0;
    primme->ldOPs                   = 0;
+   primme->cacheBlockSize          = 0;
+   primme->mixedPrecision          = 0;
+   primme->checkpointFile          = NULL;
+   primme->checkpointInterval      = 0;
+   primme->checkpointResume        = 0;
+   primme->outOfCoreDir            = NULL;
+   primme->warmStart               = 0;
+   primme->warmStartState          = NULL;
+   primme->monitor                 = NULL;
+   primme->monitorFun              = NULL;
 
 }
 
@@ -157,6 +177,11 @@ void primme_free(primme_params *params) {
    free(params->realWork);
    params->intWorkSize  = 0;
    params->realWorkSize = 0;
+   if (params->warmStartState) {
+      free(params->warmStartState->V);
+      free(params->warmStartState);
+      params->warmStartState = NULL;
+   }
 
 } /**************************************************************************/
 
@@ -223,9 +248,11 @@ void primme_free(primme_params *params) {
  ******************************************************************************/
 int primme_set_method(primme_preset_method method, primme_params *params) {
 
-   /* Set default method as DYNAMIC */
+   /* Set default method as DYNAMIC, or GD+k for the generalized problem */
+   /* that doesn't support inner iterations                             */
    if (method == PRIMME_DEFAULT_METHOD)
-      method = PRIMME_DYNAMIC;
+      method = params->massMatrixMatvec ? PRIMME_GD_Olsen_plusK :
+         PRIMME_DYNAMIC;
 
    /* From our experience, these two methods yield the smallest matvecs/time */
    /* DYNAMIC will make some timings before it settles on one of the two     */
@@ -448,7 +475,7 @@ int primme_set_method(primme_preset_method method, primme_params *params) {
 
 void primme_set_defaults(primme_params *params) {
    if (params->dynamicMethodSwitch < 0) {
-      primme_set_method(PRIMME_DYNAMIC, params);
+      primme_set_method(PRIMME_DEFAULT_METHOD, params);
    }
 
    /* ----------------------------------------- */
@@ -465,10 +492,14 @@ void primme_set_defaults(primme_params *params) {
       params->projectionParams.projection = primme_proj_RR;
    if (params->initBasisMode == primme_init_default)
       params->initBasisMode = primme_init_krylov;
+   if (params->orth == primme_orth_default)
+      params->orth = primme_orth_column;
 
    /* If we are free to choose the leading dimension of V and W, use    */
    /* a multiple of PRIMME_BLOCK_SIZE. This may improve the performance */
    /* of Num_update_VWXR_Sprimme.                                       */
+   /* NOTE: cacheBlockSize is autotuned in Sprimme, because the best    */
+   /*       value depends on the size of SCALAR.                        */
 
    if (params->ldOPs == 0) {
       params->ldOPs = min(((params->nLocal + PRIMME_BLOCK_SIZE - 1)
@@ -594,6 +625,11 @@ void primme_display_params_prefix(const char* prefix, primme_params primme) {
    PRINTIF(initBasisMode, primme_init_random);
    PRINTIF(initBasisMode, primme_init_user);
 
+   PRINTIF(orth, primme_orth_default);
+   PRINTIF(orth, primme_orth_column);
+   PRINTIF(orth, primme_orth_block);
+   PRINTIF(orth, primme_orth_pipelined);
+
    PRINT(numTargetShifts, %d);
    if (primme.numTargetShifts > 0 && primme.targetShifts) {
       fprintf(outputFile, "%s.targetShifts =", prefix);
@@ -604,11 +640,23 @@ void primme_display_params_prefix(const char* prefix, primme_params primme) {
    }
 
    PRINT(dynamicMethodSwitch, %d);
+   PRINT(dynamicBlockSize, %d);
    PRINT(locking, %d);
    PRINT(initSize, %d);
    PRINT(numOrthoConst, %d);
    PRINT_PRIMME_INT(ldevecs);
    PRINT_PRIMME_INT(ldOPs);
+   PRINT(cacheBlockSize, %d);
+   PRINT(mixedPrecision, %d);
+   if (primme.checkpointFile) {
+      fprintf(outputFile, "%s.checkpointFile = %s\n", prefix, primme.checkpointFile);
+   }
+   PRINT(checkpointInterval, %d);
+   PRINT(checkpointResume, %d);
+   if (primme.outOfCoreDir) {
+      fprintf(outputFile, "%s.outOfCoreDir = %s\n", prefix, primme.outOfCoreDir);
+   }
+   PRINT(warmStart, %d);
    fprintf(outputFile, "%s.iseed =", prefix);
    for (i=0; i<4;i++) {
       fprintf(outputFile, " %" PRIMME_INT_P, primme.iseed[i]);
@@ -626,6 +674,8 @@ void primme_display_params_prefix(const char* prefix, primme_params primme) {
    PRINTParams(correction, robustShifts, %d);
    PRINTParams(correction, maxInnerIterations, %d);
    PRINTParams(correction, relTolBase, %g);
+   PRINTParams(correction, fuseGlobalSums, %d);
+   PRINTParams(correction, filterDegree, %d);
 
    PRINTParamsIF(correction, convTest, primme_full_LTolerance);
    PRINTParamsIF(correction, convTest, primme_decreasing_LTolerance);
@@ -650,4 +700,65 @@ void primme_display_params_prefix(const char* prefix, primme_params primme) {
 } /* end of display params */
   /**************************************************************************/
 
+/*******************************************************************************
+ * Subroutine primme_monitor_trace - Monitor function that writes the events
+ *    in the Chrome trace event format (JSON array format), which can be loaded
+ *    in chrome://tracing or Perfetto. The events are written into the FILE
+ *    in primme->monitor, or into primme->outputFile if it is NULL.
+ *
+ *    The phases are written as complete events ("ph":"X"), the iterations as
+ *    instant events with the residual norms of the block, and the whole solve
+ *    as a complete event when it finishes. The array is opened when the file
+ *    is empty; several solves can write into the same file. The closing
+ *    bracket is optional in this format and it is not written.
+ *
+ ******************************************************************************/
+
+void primme_monitor_trace(primme_event *event, double *time, double *duration,
+      int *basisSize, int *blockSize, double *blockNorms, int *numConverged,
+      primme_params *primme, int *ierr) {
+
+   static const char *names[] = {"solve", "init", "prepare_candidates",
+      "iteration", "correction", "ortho", "matvec", "update_projection",
+      "solve_H", "restart", "locking", "solve"};
+   FILE *f = primme->monitor ? (FILE*)primme->monitor : primme->outputFile;
+   int i;
+
+   *ierr = 0;
+   if (f == NULL || *event < primme_event_start || *event > primme_event_finish)
+      return;
+
+   if (*event == primme_event_start) {
+      if (ftell(f) <= 0) fprintf(f, "[\n");
+      fprintf(f, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,"
+            "\"tid\":0,\"args\":{\"name\":\"PRIMME proc %d\"}},\n",
+            primme->procID, primme->procID);
+      return;
+   }
+
+   /* Times are in microseconds */
+
+   fprintf(f, "{\"name\":\"%s\",\"pid\":%d,\"tid\":0,\"ts\":%.3f,",
+         names[*event], primme->procID, *time*1e6);
+   if (*event == primme_event_iteration) {
+      fprintf(f, "\"ph\":\"i\",\"s\":\"p\",");
+   }
+   else {
+      fprintf(f, "\"ph\":\"X\",\"dur\":%.3f,", *duration*1e6);
+   }
+   fprintf(f, "\"args\":{\"iteration\":%" PRIMME_INT_P ",\"matvecs\":%"
+         PRIMME_INT_P ",\"basisSize\":%d,\"blockSize\":%d,"
+         "\"numConverged\":%d", primme->stats.numOuterIterations,
+         primme->stats.numMatvecs, *basisSize, *blockSize, *numConverged);
+   if (*event == primme_event_iteration) {
+      fprintf(f, ",\"resNorms\":[");
+      for (i=0; i<*blockSize; i++) {
+         fprintf(f, "%s%g", i > 0 ? "," : "", blockNorms[i]);
+      }
+      fprintf(f, "]");
+   }
+   fprintf(f, "}},\n");
+   if (*event == primme_event_finish) fflush(f);
+}
+
 #endif /* USE_DOUBLE */
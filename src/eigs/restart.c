@@ -48,11 +48,18 @@
 #include "update_W.h"
 #include "convergence.h"
 #include "globalsum.h"
+#include "wtime.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 static int restart_soft_locking_Sprimme(int *restartSize, SCALAR *V,
-       SCALAR *W, PRIMME_INT nLocal, int basisSize, PRIMME_INT ldV, SCALAR **X,
+       SCALAR *W, SCALAR *BV, PRIMME_INT nLocal, int basisSize,
+       PRIMME_INT ldV, SCALAR **X,
        SCALAR **R, SCALAR *hVecs, int ldhVecs, int *restartPerm,
        REAL *hVals, int *flags, int *iev, int *ievSize, REAL *blockNorms,
+       REAL *convNorms, REAL *convVals, int *numConvNorms,
        SCALAR *evecs, REAL *evals, REAL *resNorms, SCALAR *evecsHat,
        PRIMME_INT ldevecsHat, SCALAR *M, int ldM, int *numConverged,
        int *numConvergedStored, int numPrevRetained, int *indexOfPreviousVecs,
@@ -152,6 +159,8 @@ static int ortho_coefficient_vectors_Sprimme(SCALAR *hVecs, int basisSize,
  *
  * W                A*V
  *
+ * BV               B*V for the generalized problem, or NULL
+ *
  * hU               The left singular vectors of R or the eigenvectors of QtV/R
  *
  * ldhU             The leading dimension of the input hU
@@ -177,10 +186,19 @@ static int ortho_coefficient_vectors_Sprimme(SCALAR *hVecs, int basisSize,
  *
  * blockNorms       The residual norms of the eigenpairs in the block
  *
+ * convNorms        Without locking and if all wanted pairs have converged,
+ *                  the residual norms of the first numConvNorms restarted
+ *                  vectors, computed with the values in convVals. They are
+ *                  used by verify_norms in main_iter
+ *
+ * numConvNorms     The number of valid entries in convNorms and convVals
+ *
  * evecs            The converged Ritz vectors. Without locking, all converged
  *                  eigenvectors are copied from V to evecs if skew projections
  *                  are required
  *
+ * Bevecs           B*evecs for the generalized problem with locking, or NULL
+ *
  * evals            The converged Ritz values
  *
  * resNorms         The residual norms of the converged eigenpairs
@@ -242,10 +260,12 @@ static int ortho_coefficient_vectors_Sprimme(SCALAR *hVecs, int basisSize,
  ******************************************************************************/
  
 TEMPLATE_PLEASE
-int restart_Sprimme(SCALAR *V, SCALAR *W, PRIMME_INT nLocal, int basisSize,
-       PRIMME_INT ldV, REAL *hVals, REAL *hSVals, int *flags, int *iev,
-       int *ievSize, REAL *blockNorms, SCALAR *evecs, PRIMME_INT ldevecs,
-       int *evecsPerm, REAL *evals, REAL *resNorms, SCALAR *evecsHat,
+int restart_Sprimme(SCALAR *V, SCALAR *W, SCALAR *BV, PRIMME_INT nLocal,
+       int basisSize, PRIMME_INT ldV, REAL *hVals, REAL *hSVals, int *flags, int *iev,
+       int *ievSize, REAL *blockNorms, REAL *convNorms, REAL *convVals,
+       int *numConvNorms, SCALAR *evecs, PRIMME_INT ldevecs, SCALAR *Bevecs,
+       PRIMME_INT ldBevecs, int *evecsPerm, REAL *evals, REAL *resNorms,
+       SCALAR *evecsHat,
        PRIMME_INT ldevecsHat, SCALAR *M, int ldM, SCALAR *UDU, int ldUDU,
        int *ipivot, int *numConverged, int *numLocked, int *numConvergedStored,
        SCALAR *previousHVecs, int *numPrevRetained, int ldpreviousHVecs,
@@ -277,16 +297,18 @@ int restart_Sprimme(SCALAR *V, SCALAR *W, PRIMME_INT nLocal, int basisSize,
             primme), -1);
 
       if (primme->locking) {
-         CHKERR(restart_locking_Sprimme(&basisSize, NULL, NULL, nLocal,
+         CHKERR(restart_locking_Sprimme(&basisSize, NULL, NULL, NULL, nLocal,
                   basisSize, 0, NULL, NULL, NULL, 0, NULL, NULL, NULL, NULL,
-                  ievSize, NULL, NULL, 0, NULL, numConverged, numConverged,
+                  ievSize, NULL, NULL, 0, NULL, 0, NULL, numConverged,
+                  numConverged,
                   NULL, NULL, *numPrevRetained, NULL, NULL, 0, 0.0, NULL,
                   rworkSize, &iworkSize0, 0, primme), -1);
       }
       else {
-         CHKERR(restart_soft_locking_Sprimme(&basisSize, NULL, NULL,
+         CHKERR(restart_soft_locking_Sprimme(&basisSize, NULL, NULL, NULL,
                nLocal, basisSize, 0, NULL, NULL, NULL, 0, NULL, NULL, NULL,
-               NULL, ievSize, NULL, NULL, NULL, NULL, evecsHat, 0, NULL, 0,
+               NULL, ievSize, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+               evecsHat, 0, NULL, 0,
                numConverged, numConverged, *numPrevRetained, NULL, NULL, 0, 0.0,
                NULL, rworkSize, &iworkSize0, 0, primme), -1);
       }
@@ -449,21 +471,27 @@ int restart_Sprimme(SCALAR *V, SCALAR *W, PRIMME_INT nLocal, int basisSize,
 
    if (!primme->locking) {
       SCALAR *X, *Res;
-      CHKERR(restart_soft_locking_Sprimme(&restartSize, V, W, nLocal,
+      CHKERR(restart_soft_locking_Sprimme(&restartSize, V, W, BV, nLocal,
                basisSize, ldV, &X, &Res, hVecs, ldhVecs, restartPerm, hVals,
-               flags, iev, ievSize, blockNorms, evecs, evals, resNorms,
-               evecsHat, ldevecsHat, M, ldM, numConverged, numConvergedStored,
+               flags, iev, ievSize, blockNorms, convNorms, convVals,
+               numConvNorms, evecs, evals, resNorms, evecsHat, ldevecsHat, M,
+               ldM, numConverged, numConvergedStored,
                *numPrevRetained, &indexOfPreviousVecs, hVecsPerm, *reset,
                machEps, rwork, rworkSize, iwork0, iworkSize0, primme), -1);
    }
    else {
       SCALAR *X, *Res;
-      CHKERR(restart_locking_Sprimme(&restartSize, V, W, nLocal, basisSize,
-               ldV, &X, &Res, hVecs, ldhVecs, restartPerm, hVals, flags, iev,
-               ievSize, blockNorms, evecs, ldevecs, evals, numConverged,
+      double t0 = primme_get_wtime();
+      CHKERR(restart_locking_Sprimme(&restartSize, V, W, BV, nLocal,
+               basisSize, ldV, &X, &Res, hVecs, ldhVecs, restartPerm, hVals,
+               flags, iev, ievSize, blockNorms, evecs, ldevecs, Bevecs,
+               ldBevecs, evals, numConverged,
                numLocked, resNorms, evecsPerm, *numPrevRetained,
                &indexOfPreviousVecs, hVecsPerm, *reset, machEps, rwork,
                rworkSize, iwork0, iworkSize0, primme), -1);
+      CHKERR(monitor_Sprimme(primme_event_locking, t0, restartSize, 0, NULL,
+               *numLocked, primme), -1);
+      *numConvNorms = 0;
    }
 
    *reset = 0;
@@ -501,6 +529,14 @@ int restart_Sprimme(SCALAR *V, SCALAR *W, PRIMME_INT nLocal, int basisSize,
    if (*numConverged >= primme->numEvals && !primme->locking) {
       permute_vecs_Sprimme(V, nLocal, restartSize, ldV, hVecsPerm, rwork,
             iwork0);
+      if (BV) permute_vecs_Sprimme(BV, nLocal, restartSize, ldV, hVecsPerm,
+            rwork, iwork0);
+
+      /* W isn't permuted: keep the norms of the columns that didn't move */
+
+      for (i=0; i<*numConvNorms; i++) {
+         if (hVecsPerm[i] != i) *numConvNorms = i;
+      }
    }
 
    *restartSizeOutput = restartSize; 
@@ -553,6 +589,9 @@ int restart_Sprimme(SCALAR *V, SCALAR *W, PRIMME_INT nLocal, int basisSize,
  *
  * W                A*V
  *
+ * BV               B*V for the generalized problem, or NULL. After restart,
+ *                  it also contains B*X after the columns of the restarted V
+ *
  * X                Reference to the Ritz vectors of the eigenpairs in the block
  *
  * R                Reference to the residual vectors of the eigenpairs in the block
@@ -572,6 +611,9 @@ int restart_Sprimme(SCALAR *V, SCALAR *W, PRIMME_INT nLocal, int basisSize,
  *
  * blockNorms       The residual norms of the eigenpairs in the block
  *
+ * convNorms        The residual norms of the first numConvNorms columns of
+ *                  the restarted V and W, computed with the values convVals
+ *
  * evecs            The converged Ritz vectors. Without locking, all converged
  *                  eigenvectors are copied from V to evecs if skew projections
  *                  are required
@@ -613,9 +655,11 @@ int restart_Sprimme(SCALAR *V, SCALAR *W, PRIMME_INT nLocal, int basisSize,
  ******************************************************************************/
  
 static int restart_soft_locking_Sprimme(int *restartSize, SCALAR *V,
-       SCALAR *W, PRIMME_INT nLocal, int basisSize, PRIMME_INT ldV, SCALAR **X,
+       SCALAR *W, SCALAR *BV, PRIMME_INT nLocal, int basisSize,
+       PRIMME_INT ldV, SCALAR **X,
        SCALAR **R, SCALAR *hVecs, int ldhVecs, int *restartPerm,
        REAL *hVals, int *flags, int *iev, int *ievSize, REAL *blockNorms,
+       REAL *convNorms, REAL *convVals, int *numConvNorms,
        SCALAR *evecs, REAL *evals, REAL *resNorms, SCALAR *evecsHat,
        PRIMME_INT ldevecsHat, SCALAR *M, int ldM, int *numConverged,
        int *numConvergedStored, int numPrevRetained, int *indexOfPreviousVecs,
@@ -632,15 +676,20 @@ static int restart_soft_locking_Sprimme(int *restartSize, SCALAR *V,
       SCALAR t;
       REAL d;
       *rworkSize = max(*rworkSize, (size_t)basisSize); /* permute_vecs for hVecs */
-      CHKERR(Num_reset_update_VWXR_Sprimme(NULL, NULL, nLocal, basisSize, 0, &t,
-            *restartSize, 0, NULL,
+      CHKERR(Num_reset_update_VWXR_Sprimme(NULL, NULL, NULL, nLocal,
+            basisSize, 0, &t, *restartSize, 0, NULL,
             &t, 0, *restartSize, 0,
             &t, *numConverged, *numConverged+*ievSize, 0,
             NULL, 0, 0, 0, 0,
             &t, 0, *restartSize, 0,
             &t, *numConverged, *numConverged+*ievSize, 0, &d,
-            NULL, 0, 0,
+            &d, 0, *numConverged,
+            NULL, 0, NULL, 0, NULL, 0,
             0, 0.0, NULL, rworkSize, primme), -1);
+      if (primme->massMatrixMatvec) {
+         CHKERR(Bortho_Sprimme(NULL, 0, NULL, 0, 0, *restartSize-1, NULL, 0,
+                  NULL, 0, 0, nLocal, NULL, 0.0, NULL, rworkSize, primme), -1);
+      }
       /* if evecsHat, permutation matrix & compute_submatrix workspace */
       if (evecsHat) {
          *rworkSize = max(*rworkSize, 
@@ -700,7 +749,9 @@ static int restart_soft_locking_Sprimme(int *restartSize, SCALAR *V,
    /* X & R have the eigenvectors and residual vectors of the        */
    /* first ievSize candidates pairs to be targeted after restart.   */
    /* Their computation is performed more efficiently here together  */
-   /* with the V, W                                                  */
+   /* with the V, W. If all wanted pairs have converged, the         */
+   /* residual norms of them are also computed in the same pass, so  */
+   /* that verify_norms doesn't have to form the residual vectors.   */
    /* -------------------------------------------------------------- */
 
    *indexOfPreviousVecs = *restartSize;
@@ -739,17 +790,23 @@ static int restart_soft_locking_Sprimme(int *restartSize, SCALAR *V,
 
    *X = &V[*restartSize*ldV];
    *R = &W[*restartSize*ldV];
+   *numConvNorms = wholeSpace || *numConverged < primme->numEvals ? 0 :
+      min(*numConverged, *restartSize);
 
-   CHKERR(Num_reset_update_VWXR_Sprimme(V, W, nLocal, basisSize, ldV,
+   CHKERR(Num_reset_update_VWXR_Sprimme(V, W, BV, nLocal, basisSize, ldV,
             hVecs, *restartSize, ldhVecs, hVals,
             V, 0, *restartSize, ldV,
             *X, *numConverged, *numConverged+*ievSize, ldV,
             NULL, 0, 0, 0, 0,
             W, 0, *restartSize, ldV,
             *R, *numConverged, *numConverged+*ievSize, ldV, blockNorms,
-            NULL, 0, 0,
+            *numConvNorms>0?convNorms:NULL, 0, *numConvNorms,
+            BV, ldV, BV?&BV[*restartSize*ldV]:NULL, ldV, NULL, 0,
             reset, machEps, rwork, rworkSize, primme), -1);
 
+   for (i=0; i<*numConvNorms; i++)
+      convVals[i] = hVals[i];
+
    if (!wholeSpace) {
       /* ----------------------------------------------------------------- */
       /* Generate the permutation hVecsPerm that undoes restartPerm        */
@@ -874,10 +931,16 @@ static int restart_soft_locking_Sprimme(int *restartSize, SCALAR *V,
  *
  * NOTE: if Rnorms and rnorms are requested, nRb-nRe+nrb-nre < mV
  *
+ * If BV = B*V is given, for the generalized problem A*x = lambda*B*x, then
+ * BX0 = B*X0, BX1 = B*X1 and Bevecs(evecsSize:) = B*evecs(evecsSize:) are
+ * also returned, X0 is B-orthonormalized against evecs(0:evecsSize-1) and
+ * itself if reset > 1, and the residual vectors are Wo - BX0*diag(hVals).
+ *
  * INPUT ARRAYS AND PARAMETERS
  * ---------------------------
  * V, W        input basis
- * mV,nV,ldV   number of rows and columns and leading dimension of V and W
+ * BV          B*V (optional)
+ * mV,nV,ldV   number of rows and columns and leading dimension of V, W and BV
  * h           input rotation matrix
  * nh          Number of columns of h
  * ldh         The leading dimension of h
@@ -899,6 +962,10 @@ static int restart_soft_locking_Sprimme(int *restartSize, SCALAR *V,
  * Rnorms      Output array with the norms of R (optional)
  * rnorms      Output array with the extra residual vector norms (optional)
  * nrb, nre    Columns of residual vector to compute the norm
+ * BX0, BX1    Output matrices B*X0 and B*X1 (required if BV)
+ * Bevecs      B*evecs; the first evecsSize columns are input and the next
+ *             nX2e-nX2b are output (required if BV and evecs)
+ * ldBevecs    The leading dimension of Bevecs
  * reset       if reset>1, reothogonalize Xi; if reset>0, recompute Wo=A*X0
  * 
  * NOTE: n*e, n*b are zero-base indices of ranges where the first value is
@@ -907,8 +974,8 @@ static int restart_soft_locking_Sprimme(int *restartSize, SCALAR *V,
  ******************************************************************************/
 
 TEMPLATE_PLEASE
-int Num_reset_update_VWXR_Sprimme(SCALAR *V, SCALAR *W, PRIMME_INT mV,
-   int nV, PRIMME_INT ldV,
+int Num_reset_update_VWXR_Sprimme(SCALAR *V, SCALAR *W, SCALAR *BV,
+   PRIMME_INT mV, int nV, PRIMME_INT ldV,
    SCALAR *h, int nh, int ldh, REAL *hVals,
    SCALAR *X0, int nX0b, int nX0e, PRIMME_INT ldX0,
    SCALAR *X1, int nX1b, int nX1e, PRIMME_INT ldX1,
@@ -916,38 +983,52 @@ int Num_reset_update_VWXR_Sprimme(SCALAR *V, SCALAR *W, PRIMME_INT mV,
    SCALAR *Wo, int nWob, int nWoe, PRIMME_INT ldWo,
    SCALAR *R, int nRb, int nRe, PRIMME_INT ldR, REAL *Rnorms,
    REAL *rnorms, int nrb, int nre,
-   int reset, double machEps, SCALAR *rwork, size_t *lrwork,
-   primme_params *primme) {
-
-   int i, j;         /* Loop variables */
-   REAL *tmp, *tmp0;
+   SCALAR *BX0, PRIMME_INT ldBX0, SCALAR *BX1, PRIMME_INT ldBX1,
+   SCALAR *Bevecs, PRIMME_INT ldBevecs, int reset, double machEps,
+   SCALAR *rwork, size_t *lrwork, primme_params *primme) {
+
+   PRIMME_INT i;     /* Loop variables */
+   int j, t;         /* Loop variables */
+   int m;            /* Number of rows in the cache */
+   int numNorms, nR; /* Number of norms to reduce, and of them from R */
+   int nt;           /* Number of threads */
+   REAL *tmp, *tmp0, *part;
+   SCALAR *BX;       /* B*X0 if BV, and X0 otherwise */
+   PRIMME_INT ldBX;  /* The leading dimension of BX */
 
    /* Return memory requirements */
    if (V == NULL) {
       *lrwork = max(*lrwork,
             (size_t)Num_update_VWXR_Sprimme(
-               V, W, mV, nV, ldV, h, nh, ldh, hVals,
+               V, W, BV, mV, nV, ldV, h, nh, ldh, hVals,
                X0, nX0b, nX0e, ldX0,
                X1, nX1b, nX1e, ldX1,
                evecs, nX2b, nX2e, ldevecs,
                Wo, nWob, nWoe, ldWo,
                R, nRb, nRe, ldR, Rnorms,
                rnorms, nrb, nre,
+               BX0, ldBX0, BX1, ldBX1,
                NULL, 0, primme));
       return 0;
    }
 
+   assert(!BV || (BX0 && (!X1 || BX1) && (!evecs || Bevecs)));
+   assert(!BV || !evecs || (nX0b <= nX2b && nX2e <= nX0e));
+
    /* Quick exit */
    if (reset == 0) {
       CHKERR(Num_update_VWXR_Sprimme(
-               V, W, mV, nV, ldV, h, nh, ldh, hVals,
+               V, W, BV, mV, nV, ldV, h, nh, ldh, hVals,
                X0, nX0b, nX0e, ldX0,
                X1, nX1b, nX1e, ldX1,
                evecs?&evecs[ldevecs*evecsSize]:NULL, nX2b, nX2e, ldevecs,
                Wo, nWob, nWoe, ldWo,
                R, nRb, nRe, ldR, Rnorms,
                rnorms, nrb, nre,
+               BX0, ldBX0, BX1, ldBX1,
                rwork, TO_INT(*lrwork), primme), -1);
+      if (BV && evecs) Num_copy_matrix_Sprimme(&BX0[ldBX0*(nX2b-nX0b)], mV,
+            nX2e-nX2b, ldBX0, &Bevecs[ldBevecs*evecsSize], ldBevecs);
       return 0;
    }
 
@@ -956,22 +1037,51 @@ int Num_reset_update_VWXR_Sprimme(SCALAR *V, SCALAR *W, PRIMME_INT mV,
    assert(!(R || Rnorms || rnorms) || W);
 
    assert((size_t)(nre-nrb)*2 <= *lrwork); /* Check workspace for tmp and tmp0 */
+   assert((size_t)min(CACHE_BLOCK_SIZE(primme), mV) + nRe-nRb+nre-nrb
+         <= *lrwork);
 
    /* X_i = V*h(nX_ib:nX_ie-1) */
 
    assert(!reset || !evecs || (nX0b <= nX2b && nX2e <= nX0e));
-   Num_update_VWXR_Sprimme(V, NULL, mV, nV, ldV, h, nh, ldh, NULL,
+   Num_update_VWXR_Sprimme(V, NULL, NULL, mV, nV, ldV, h, nh, ldh, NULL,
          X0, nX0b, nX0e, ldX0,
          X1, nX1b, nX1e, ldX1,
          evecs?&evecs[ldevecs*evecsSize]:NULL, nX2b, nX2e, ldevecs,
          NULL, 0, 0, 0,
          NULL, 0, 0, 0, NULL,
          NULL, 0, 0,
+         NULL, 0, NULL, 0,
          rwork, TO_INT(*lrwork), primme);
 
+   /* For the generalized problem, B-orthonormalize X0 if asked, and */
+   /* recompute BX0 = B*X0 anyway                                    */
+
+   if (BV) {
+      if (reset > 1) {
+         CHKERR(Bortho_Sprimme(X0, ldX0, BX0, ldBX0, 0, nX0e-nX0b-1, evecs,
+                  ldevecs, Bevecs, ldBevecs, evecs?evecsSize:0, mV,
+                  primme->iseed, machEps, rwork, lrwork, primme), -1);
+         if (evecs) Num_copy_matrix_Sprimme(&X0[ldX0*(nX2b-nX0b)], mV,
+               nX2e-nX2b, ldX0, &evecs[ldevecs*evecsSize], ldevecs);
+      }
+      else {
+         CHKERR(massMatrixMatvec_Sprimme(X0, mV, ldX0, BX0, ldBX0, 0,
+                  nX0e-nX0b, primme), -1);
+      }
+      if (evecs) Num_copy_matrix_Sprimme(&BX0[ldBX0*(nX2b-nX0b)], mV,
+            nX2e-nX2b, ldBX0, &Bevecs[ldBevecs*evecsSize], ldBevecs);
+      assert(!X1 || (nX0b <= nX1b && nX1e <= nX0e));
+      if (X1) {
+         if (reset > 1) Num_copy_matrix_Sprimme(&X0[ldX0*(nX1b-nX0b)], mV,
+               nX1e-nX1b, ldX0, X1, ldX1);
+         Num_copy_matrix_Sprimme(&BX0[ldBX0*(nX1b-nX0b)], mV, nX1e-nX1b,
+               ldBX0, BX1, ldBX1);
+      }
+   }
+
    /* Reortho [evecs(evecSize:) X0] against evecs if asked */
 
-   if (reset > 1) {
+   else if (reset > 1) {
       CHKERR(ortho_Sprimme(evecs, ldevecs, NULL, 0, evecsSize, 
                evecsSize+nX2e-nX2b-1, NULL, 0, 0, mV, primme->iseed, 
                machEps, rwork, lrwork, primme), -1);
@@ -994,28 +1104,72 @@ int Num_reset_update_VWXR_Sprimme(SCALAR *V, SCALAR *W, PRIMME_INT mV,
    CHKERR(matrixMatvec_Sprimme(X0, mV, ldX0, Wo, ldWo, 0, nWoe-nWob,
             primme), -1);
  
-   /* R = Y(nRb-nYb:nRe-nYb-1) - X(nRb-nYb:nRe-nYb-1)*diag(nRb:nRe-1) */
-   for (j=nRb; j<nRe; j++) {
-      Num_compute_residual_Sprimme(mV, hVals[j], &X0[ldX0*(j-nX0b)],
-            &Wo[ldWo*(j-nWob)], &R[ldR*(j-nRb)]);
-      if (Rnorms) {
-         Rnorms[j-nRb] = REAL_PART(Num_dot_Sprimme(mV, &R[ldR*(j-nRb)], 1,
-                  &R[ldR*(j-nRb)], 1));
+   /* Compute R and the norms. As in Num_update_VWXR, if PRIMME is compiled */
+   /* with OpenMP, the chunks of rows are distributed among threads, and   */
+   /* every thread has a piece of rwork and its own partial sums.          */
+
+   BX = BV ? BX0 : X0;
+   ldBX = BV ? ldBX0 : ldX0;
+   nR = Rnorms ? nRe-nRb : 0;
+   numNorms = nR + (rnorms ? nre-nrb : 0);
+   m = min(CACHE_BLOCK_SIZE(primme), mV);
+   nt = Num_update_VWXR_num_threads_Sprimme(mV, primme);
+   while (nt > 1 && ((size_t)m + numNorms)*nt > *lrwork) nt--;
+   part = (REAL*)(rwork + (size_t)m*nt);
+   for (j=0; j<numNorms*nt; j++) part[j] = 0.0;
+
+#ifdef _OPENMP
+   #pragma omp parallel num_threads(nt) if(nt > 1) private(i, j)
+#endif
+   {
+      int mi, it=0, nit=1;
+      PRIMME_INT numChunks, ib, ie;
+      SCALAR *r;
+      REAL *pn;
+
+#ifdef _OPENMP
+      it = omp_get_thread_num();
+      nit = omp_get_num_threads();
+#endif
+
+      /* Every thread takes a contiguous range of chunks of rows */
+
+      numChunks = m > 0 ? (mV + m - 1)/m : 0;
+      ib = numChunks*it/nit*m;
+      ie = min(numChunks*(it+1)/nit*m, mV);
+      r = rwork + (size_t)m*it;
+      pn = &part[numNorms*it];
+
+      /* R = Y(nRb-nYb:nRe-nYb-1) - X(nRb-nYb:nRe-nYb-1)*diag(nRb:nRe-1) */
+      if (ib < ie) for (j=nRb; j<nRe; j++) {
+         Num_compute_residual_Sprimme(ie-ib, hVals[j], &BX[ib+ldBX*(j-nX0b)],
+               &Wo[ib+ldWo*(j-nWob)], &R[ib+ldR*(j-nRb)]);
+         if (Rnorms) {
+            pn[j-nRb] = REAL_PART(Num_dot_Sprimme(ie-ib, &R[ib+ldR*(j-nRb)],
+                     1, &R[ib+ldR*(j-nRb)], 1));
+         }
       }
-   }
 
-   /* rnorms = Y(nrb-nYb:nre-nYb-1) - X(nrb-nYb:nre-nYb-1)*diag(nrb:nre-1) */
-   if (rnorms) for (j=nrb; j<nre; j++) {
-      int m=min(PRIMME_BLOCK_SIZE, mV);   /* Number of rows in the cache */
-      rnorms[j-nrb] = 0.0;
-      for (i=0; i < mV; i+=m, m=min(m,mV-i)) {
-         Num_compute_residual_Sprimme(m, hVals[j], &X0[ldX0*(j-nX0b)],
-               &Wo[i+ldWo*(j-nWob)], rwork);
-         rnorms[j-nrb] +=
-            REAL_PART(Num_dot_Sprimme(m, rwork, 1, rwork, 1));
+      /* rnorms = Y(nrb-nYb:nre-nYb-1) - X(nrb-nYb:nre-nYb-1)*diag(nrb:nre-1) */
+      if (rnorms) for (j=nrb; j<nre; j++) {
+         for (i=ib, mi=min(m, ie-ib); i < ie; i+=mi, mi=min(mi,ie-i)) {
+            Num_compute_residual_Sprimme(mi, hVals[j], &BX[i+ldBX*(j-nX0b)],
+                  &Wo[i+ldWo*(j-nWob)], r);
+            pn[nR+j-nrb] += REAL_PART(Num_dot_Sprimme(mi, r, 1, r, 1));
+         }
       }
    }
 
+   /* Add up the partial sums of the threads */
+
+   if (Rnorms) for (j=0; j<nR; j++) Rnorms[j] = part[j];
+   if (rnorms) for (j=nR; j<numNorms; j++) rnorms[j-nR] = part[j];
+   for (t=1; t<nt; t++) {
+      if (Rnorms) for (j=0; j<nR; j++) Rnorms[j] += part[numNorms*t+j];
+      if (rnorms) for (j=nR; j<numNorms; j++)
+         rnorms[j-nR] += part[numNorms*t+j];
+   }
+
    /* Reduce Rnorms and rnorms and sqrt the results */
 
    if (primme->globalSumReal) {
@@ -1550,14 +1704,15 @@ static int restart_refined(SCALAR *V, PRIMME_INT ldV, SCALAR *W, PRIMME_INT ldW,
       /* The workspace for permute_vecs(hU) is basisSize */
       *rworkSize = max(*rworkSize, (size_t)basisSize*(size_t)basisSize);
       *rworkSize = max(*rworkSize,
-            (size_t)Num_update_VWXR_Sprimme(NULL, NULL, nLocal, basisSize,
-               0, NULL, basisSize, 0, NULL,
+            (size_t)Num_update_VWXR_Sprimme(NULL, NULL, NULL, nLocal,
+               basisSize, 0, NULL, basisSize, 0, NULL,
                NULL, 0, 0, 0,
                NULL, 0, 0, 0,
                NULL, 0, 0, 0,
                NULL, 0, 0, 0,
                NULL, 0, 0, 0, NULL,
                NULL, 0, 0,
+               NULL, 0, NULL, 0,
                NULL, 0, primme));
       CHKERR(solve_H_Sprimme(NULL, basisSize, 0, NULL, 0, NULL, 0, NULL, 0,
                NULL, 0, NULL, NULL, numConverged, 0.0, rworkSize, NULL, 0,
@@ -1731,7 +1886,7 @@ static int restart_refined(SCALAR *V, PRIMME_INT ldV, SCALAR *W, PRIMME_INT ldW,
    /* Restart Q by replacing it with Q*hU */
    /* ----------------------------------- */
 
-   CHKERR(Num_update_VWXR_Sprimme(Q, NULL, nLocal, basisSize, ldQ, hU,
+   CHKERR(Num_update_VWXR_Sprimme(Q, NULL, NULL, nLocal, basisSize, ldQ, hU,
             restartSize,
             basisSize, NULL,
             Q, 0, restartSize, ldQ,
@@ -1740,6 +1895,7 @@ static int restart_refined(SCALAR *V, PRIMME_INT ldV, SCALAR *W, PRIMME_INT ldW,
             NULL, 0, 0, 0,
             NULL, 0, 0, 0, NULL,
             NULL, 0, 0,
+            NULL, 0, NULL, 0,
             rwork, TO_INT(*rworkSize), primme), -1);
 
    /* ---------------------------------------------------------------------- */
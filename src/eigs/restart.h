@@ -39,10 +39,12 @@
 #if !defined(CHECK_TEMPLATE) && !defined(restart_Rprimme)
 #  define restart_Rprimme CONCAT(restart_,REAL_SUF)
 #endif
-int restart_dprimme(double *V, double *W, int64_t nLocal, int basisSize,
-       int64_t ldV, double *hVals, double *hSVals, int *flags, int *iev,
-       int *ievSize, double *blockNorms, double *evecs, int64_t ldevecs,
-       int *evecsPerm, double *evals, double *resNorms, double *evecsHat,
+int restart_dprimme(double *V, double *W, double *BV, int64_t nLocal,
+       int basisSize, int64_t ldV, double *hVals, double *hSVals, int *flags, int *iev,
+       int *ievSize, double *blockNorms, double *convNorms, double *convVals,
+       int *numConvNorms, double *evecs, int64_t ldevecs, double *Bevecs,
+       int64_t ldBevecs, int *evecsPerm, double *evals, double *resNorms,
+       double *evecsHat,
        int64_t ldevecsHat, double *M, int ldM, double *UDU, int ldUDU,
        int *ipivot, int *numConverged, int *numLocked, int *numConvergedStored,
        double *previousHVecs, int *numPrevRetained, int ldpreviousHVecs,
@@ -60,8 +62,8 @@ int restart_dprimme(double *V, double *W, int64_t nLocal, int basisSize,
 #if !defined(CHECK_TEMPLATE) && !defined(Num_reset_update_VWXR_Rprimme)
 #  define Num_reset_update_VWXR_Rprimme CONCAT(Num_reset_update_VWXR_,REAL_SUF)
 #endif
-int Num_reset_update_VWXR_dprimme(double *V, double *W, int64_t mV,
-   int nV, int64_t ldV,
+int Num_reset_update_VWXR_dprimme(double *V, double *W, double *BV,
+   int64_t mV, int nV, int64_t ldV,
    double *h, int nh, int ldh, double *hVals,
    double *X0, int nX0b, int nX0e, int64_t ldX0,
    double *X1, int nX1b, int nX1e, int64_t ldX1,
@@ -69,8 +71,9 @@ int Num_reset_update_VWXR_dprimme(double *V, double *W, int64_t mV,
    double *Wo, int nWob, int nWoe, int64_t ldWo,
    double *R, int nRb, int nRe, int64_t ldR, double *Rnorms,
    double *rnorms, int nrb, int nre,
-   int reset, double machEps, double *rwork, size_t *lrwork,
-   primme_params *primme);
+   double *BX0, int64_t ldBX0, double *BX1, int64_t ldBX1,
+   double *Bevecs, int64_t ldBevecs, int reset, double machEps,
+   double *rwork, size_t *lrwork, primme_params *primme);
 #if !defined(CHECK_TEMPLATE) && !defined(retain_previous_coefficients_Sprimme)
 #  define retain_previous_coefficients_Sprimme CONCAT(retain_previous_coefficients_,SCALAR_SUF)
 #endif
@@ -81,10 +84,12 @@ int retain_previous_coefficients_dprimme(double *hVecs, int ldhVecs,
    double *hU, int ldhU, double *previousHVecs, int ldpreviousHVecs,
    int mprevious, int basisSize, int *iev, int blockSize, int *flags,
    int *numPrevRetained, int *iwork, int iworkSize, primme_params *primme);
-int restart_zprimme(PRIMME_COMPLEX_DOUBLE *V, PRIMME_COMPLEX_DOUBLE *W, int64_t nLocal, int basisSize,
-       int64_t ldV, double *hVals, double *hSVals, int *flags, int *iev,
-       int *ievSize, double *blockNorms, PRIMME_COMPLEX_DOUBLE *evecs, int64_t ldevecs,
-       int *evecsPerm, double *evals, double *resNorms, PRIMME_COMPLEX_DOUBLE *evecsHat,
+int restart_zprimme(PRIMME_COMPLEX_DOUBLE *V, PRIMME_COMPLEX_DOUBLE *W, PRIMME_COMPLEX_DOUBLE *BV, int64_t nLocal,
+       int basisSize, int64_t ldV, double *hVals, double *hSVals, int *flags, int *iev,
+       int *ievSize, double *blockNorms, double *convNorms, double *convVals,
+       int *numConvNorms, PRIMME_COMPLEX_DOUBLE *evecs, int64_t ldevecs, PRIMME_COMPLEX_DOUBLE *Bevecs,
+       int64_t ldBevecs, int *evecsPerm, double *evals, double *resNorms,
+       PRIMME_COMPLEX_DOUBLE *evecsHat,
        int64_t ldevecsHat, PRIMME_COMPLEX_DOUBLE *M, int ldM, PRIMME_COMPLEX_DOUBLE *UDU, int ldUDU,
        int *ipivot, int *numConverged, int *numLocked, int *numConvergedStored,
        PRIMME_COMPLEX_DOUBLE *previousHVecs, int *numPrevRetained, int ldpreviousHVecs,
@@ -96,8 +101,8 @@ int restart_zprimme(PRIMME_COMPLEX_DOUBLE *V, PRIMME_COMPLEX_DOUBLE *W, int64_t
        int ldhVecsRot, int *restartsSinceReset, int *reset,
        double machEps, PRIMME_COMPLEX_DOUBLE *rwork, size_t *rworkSize, int *iwork,
        int iworkSize, primme_params *primme);
-int Num_reset_update_VWXR_zprimme(PRIMME_COMPLEX_DOUBLE *V, PRIMME_COMPLEX_DOUBLE *W, int64_t mV,
-   int nV, int64_t ldV,
+int Num_reset_update_VWXR_zprimme(PRIMME_COMPLEX_DOUBLE *V, PRIMME_COMPLEX_DOUBLE *W, PRIMME_COMPLEX_DOUBLE *BV,
+   int64_t mV, int nV, int64_t ldV,
    PRIMME_COMPLEX_DOUBLE *h, int nh, int ldh, double *hVals,
    PRIMME_COMPLEX_DOUBLE *X0, int nX0b, int nX0e, int64_t ldX0,
    PRIMME_COMPLEX_DOUBLE *X1, int nX1b, int nX1e, int64_t ldX1,
@@ -105,16 +110,19 @@ int Num_reset_update_VWXR_zprimme(PRIMME_COMPLEX_DOUBLE *V, PRIMME_COMPLEX_DOUBL
    PRIMME_COMPLEX_DOUBLE *Wo, int nWob, int nWoe, int64_t ldWo,
    PRIMME_COMPLEX_DOUBLE *R, int nRb, int nRe, int64_t ldR, double *Rnorms,
    double *rnorms, int nrb, int nre,
-   int reset, double machEps, PRIMME_COMPLEX_DOUBLE *rwork, size_t *lrwork,
-   primme_params *primme);
+   PRIMME_COMPLEX_DOUBLE *BX0, int64_t ldBX0, PRIMME_COMPLEX_DOUBLE *BX1, int64_t ldBX1,
+   PRIMME_COMPLEX_DOUBLE *Bevecs, int64_t ldBevecs, int reset, double machEps,
+   PRIMME_COMPLEX_DOUBLE *rwork, size_t *lrwork, primme_params *primme);
 int retain_previous_coefficients_zprimme(PRIMME_COMPLEX_DOUBLE *hVecs, int ldhVecs,
    PRIMME_COMPLEX_DOUBLE *hU, int ldhU, PRIMME_COMPLEX_DOUBLE *previousHVecs, int ldpreviousHVecs,
    int mprevious, int basisSize, int *iev, int blockSize, int *flags,
    int *numPrevRetained, int *iwork, int iworkSize, primme_params *primme);
-int restart_sprimme(float *V, float *W, int64_t nLocal, int basisSize,
-       int64_t ldV, float *hVals, float *hSVals, int *flags, int *iev,
-       int *ievSize, float *blockNorms, float *evecs, int64_t ldevecs,
-       int *evecsPerm, float *evals, float *resNorms, float *evecsHat,
+int restart_sprimme(float *V, float *W, float *BV, int64_t nLocal,
+       int basisSize, int64_t ldV, float *hVals, float *hSVals, int *flags, int *iev,
+       int *ievSize, float *blockNorms, float *convNorms, float *convVals,
+       int *numConvNorms, float *evecs, int64_t ldevecs, float *Bevecs,
+       int64_t ldBevecs, int *evecsPerm, float *evals, float *resNorms,
+       float *evecsHat,
        int64_t ldevecsHat, float *M, int ldM, float *UDU, int ldUDU,
        int *ipivot, int *numConverged, int *numLocked, int *numConvergedStored,
        float *previousHVecs, int *numPrevRetained, int ldpreviousHVecs,
@@ -126,8 +134,8 @@ int restart_sprimme(float *V, float *W, int64_t nLocal, int basisSize,
        int ldhVecsRot, int *restartsSinceReset, int *reset,
        double machEps, float *rwork, size_t *rworkSize, int *iwork,
        int iworkSize, primme_params *primme);
-int Num_reset_update_VWXR_sprimme(float *V, float *W, int64_t mV,
-   int nV, int64_t ldV,
+int Num_reset_update_VWXR_sprimme(float *V, float *W, float *BV,
+   int64_t mV, int nV, int64_t ldV,
    float *h, int nh, int ldh, float *hVals,
    float *X0, int nX0b, int nX0e, int64_t ldX0,
    float *X1, int nX1b, int nX1e, int64_t ldX1,
@@ -135,16 +143,19 @@ int Num_reset_update_VWXR_sprimme(float *V, float *W, int64_t mV,
    float *Wo, int nWob, int nWoe, int64_t ldWo,
    float *R, int nRb, int nRe, int64_t ldR, float *Rnorms,
    float *rnorms, int nrb, int nre,
-   int reset, double machEps, float *rwork, size_t *lrwork,
-   primme_params *primme);
+   float *BX0, int64_t ldBX0, float *BX1, int64_t ldBX1,
+   float *Bevecs, int64_t ldBevecs, int reset, double machEps,
+   float *rwork, size_t *lrwork, primme_params *primme);
 int retain_previous_coefficients_sprimme(float *hVecs, int ldhVecs,
    float *hU, int ldhU, float *previousHVecs, int ldpreviousHVecs,
    int mprevious, int basisSize, int *iev, int blockSize, int *flags,
    int *numPrevRetained, int *iwork, int iworkSize, primme_params *primme);
-int restart_cprimme(PRIMME_COMPLEX_FLOAT *V, PRIMME_COMPLEX_FLOAT *W, int64_t nLocal, int basisSize,
-       int64_t ldV, float *hVals, float *hSVals, int *flags, int *iev,
-       int *ievSize, float *blockNorms, PRIMME_COMPLEX_FLOAT *evecs, int64_t ldevecs,
-       int *evecsPerm, float *evals, float *resNorms, PRIMME_COMPLEX_FLOAT *evecsHat,
+int restart_cprimme(PRIMME_COMPLEX_FLOAT *V, PRIMME_COMPLEX_FLOAT *W, PRIMME_COMPLEX_FLOAT *BV, int64_t nLocal,
+       int basisSize, int64_t ldV, float *hVals, float *hSVals, int *flags, int *iev,
+       int *ievSize, float *blockNorms, float *convNorms, float *convVals,
+       int *numConvNorms, PRIMME_COMPLEX_FLOAT *evecs, int64_t ldevecs, PRIMME_COMPLEX_FLOAT *Bevecs,
+       int64_t ldBevecs, int *evecsPerm, float *evals, float *resNorms,
+       PRIMME_COMPLEX_FLOAT *evecsHat,
        int64_t ldevecsHat, PRIMME_COMPLEX_FLOAT *M, int ldM, PRIMME_COMPLEX_FLOAT *UDU, int ldUDU,
        int *ipivot, int *numConverged, int *numLocked, int *numConvergedStored,
        PRIMME_COMPLEX_FLOAT *previousHVecs, int *numPrevRetained, int ldpreviousHVecs,
@@ -156,8 +167,8 @@ int restart_cprimme(PRIMME_COMPLEX_FLOAT *V, PRIMME_COMPLEX_FLOAT *W, int64_t nL
        int ldhVecsRot, int *restartsSinceReset, int *reset,
        double machEps, PRIMME_COMPLEX_FLOAT *rwork, size_t *rworkSize, int *iwork,
        int iworkSize, primme_params *primme);
-int Num_reset_update_VWXR_cprimme(PRIMME_COMPLEX_FLOAT *V, PRIMME_COMPLEX_FLOAT *W, int64_t mV,
-   int nV, int64_t ldV,
+int Num_reset_update_VWXR_cprimme(PRIMME_COMPLEX_FLOAT *V, PRIMME_COMPLEX_FLOAT *W, PRIMME_COMPLEX_FLOAT *BV,
+   int64_t mV, int nV, int64_t ldV,
    PRIMME_COMPLEX_FLOAT *h, int nh, int ldh, float *hVals,
    PRIMME_COMPLEX_FLOAT *X0, int nX0b, int nX0e, int64_t ldX0,
    PRIMME_COMPLEX_FLOAT *X1, int nX1b, int nX1e, int64_t ldX1,
@@ -165,8 +176,9 @@ int Num_reset_update_VWXR_cprimme(PRIMME_COMPLEX_FLOAT *V, PRIMME_COMPLEX_FLOAT
    PRIMME_COMPLEX_FLOAT *Wo, int nWob, int nWoe, int64_t ldWo,
    PRIMME_COMPLEX_FLOAT *R, int nRb, int nRe, int64_t ldR, float *Rnorms,
    float *rnorms, int nrb, int nre,
-   int reset, double machEps, PRIMME_COMPLEX_FLOAT *rwork, size_t *lrwork,
-   primme_params *primme);
+   PRIMME_COMPLEX_FLOAT *BX0, int64_t ldBX0, PRIMME_COMPLEX_FLOAT *BX1, int64_t ldBX1,
+   PRIMME_COMPLEX_FLOAT *Bevecs, int64_t ldBevecs, int reset, double machEps,
+   PRIMME_COMPLEX_FLOAT *rwork, size_t *lrwork, primme_params *primme);
 int retain_previous_coefficients_cprimme(PRIMME_COMPLEX_FLOAT *hVecs, int ldhVecs,
    PRIMME_COMPLEX_FLOAT *hU, int ldhU, PRIMME_COMPLEX_FLOAT *previousHVecs, int ldpreviousHVecs,
    int mprevious, int basisSize, int *iev, int blockSize, int *flags,
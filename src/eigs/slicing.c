@@ -0,0 +1,537 @@
+/*******************************************************************************
+ * Copyright (c) 2016, College of William & Mary
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the College of William & Mary nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COLLEGE OF WILLIAM & MARY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * PRIMME: https://github.com/primme/primme
+ * Contact: Andreas Stathopoulos, a n d r e a s _at_ c s . w m . e d u
+ *******************************************************************************
+ * File: slicing.c
+ *
+ * Purpose - Front end that computes all the eigenpairs in an interval by
+ *           solving independent problems on windows of the interval
+ *           (spectrum slicing).
+ *
+ ******************************************************************************/
+
+#include <stdlib.h>   /* mallocs, free, qsort */
+#include <stdio.h>
+#include <math.h>
+#include "const.h"
+#include "wtime.h"
+#include "numerical.h"
+#include "globalsum.h"
+#include "primme_interface.h"
+
+#define MAIN_ITER_FAILURE         -3
+#define SLICING_INVALID_INPUT     -43
+#define SLICING_TOO_MANY_PAIRS    -44
+
+/* State of a window [lower, upper) of the interval */
+
+typedef struct {
+   double lower, upper;  /* The window                                     */
+   int numPairs;         /* Pairs computed by this slice                   */
+   REAL *evals;          /* Their eigenvalues, residual norms and vectors  */
+   REAL *resNorms;       /* (the vectors with leading dimension nLocal)    */
+   SCALAR *evecs;
+   int ret;              /* Error code of the last call to Sprimme         */
+   int full;             /* Nonzero if it stopped by reaching numEvals     */
+   primme_stats stats;   /* Accumulated statistics of the calls to Sprimme */
+} slice_t;
+
+/* Reference to a pair computed by some slice, used for sorting */
+
+typedef struct {
+   REAL eval;
+   const slice_t *slice;
+   int col;
+} pair_ref;
+
+static int solve_slice(slice_t *s, slice_t *left, slice_t *right,
+      SCALAR *evecs, int k0, primme_params *primme);
+static int collect_pairs(slice_t **slices, int numSlices, double lower,
+      double upper, REAL *evals, REAL *resNorms, SCALAR *X, PRIMME_INT ldX,
+      int maxPairs, int *numPairs, int *overflow, primme_params *primme);
+static int compare_pair_refs(const void *a, const void *b);
+static void clear_stats(primme_stats *stats);
+static void add_stats(primme_stats *dst, primme_stats *src);
+
+
+/*******************************************************************************
+ * Subroutine Sprimme_slicing - Computes the eigenpairs with eigenvalues in
+ *    [lower, upper) by splitting the interval into numSlices windows of the
+ *    same width and solving every window with Sprimme, targeting the closest
+ *    eigenvalues to its center (primme_closest_abs).
+ *
+ *    The even windows are solved first and then the odd ones; the pairs
+ *    computed by the two neighbors of an odd window are passed to it as
+ *    orthogonality constraints, so that it does not compute them again.
+ *    A window requests numEvals/numSlices pairs and doubles the request,
+ *    taking the pairs already found as constraints, until it finds an
+ *    eigenvalue out of the window. The pairs found twice at the boundaries
+ *    are removed by comparing their vectors.
+ *
+ *    If PRIMME is compiled with OpenMP and numProcs is one, the windows of
+ *    every stage are solved concurrently, and the user callbacks are called
+ *    from several threads at once.
+ *
+ * INPUT PARAMETERS
+ * ----------------
+ * lower, upper  The interval
+ * numSlices     The number of windows
+ *
+ * INPUT/OUTPUT ARRAYS AND PARAMETERS
+ * ----------------------------------
+ * evals     The eigenvalues in the interval in ascending order. Should be of
+ *           size primme->numEvals
+ *
+ * evecs     The first primme->numOrthoConst columns are the constraints of
+ *           all the windows; the eigenvectors are returned after them
+ *
+ * resNorms  The residual norms of the eigenpairs. Should be of size
+ *           primme->numEvals
+ *
+ * primme    Structure with the solver parameters, the same as for Sprimme.
+ *           On output primme->initSize has the number of returned pairs and
+ *           primme->stats the sum of the statistics of all windows.
+ *
+ * Return Value
+ * ------------
+ *  0 - Success
+ * -1, -2 - Failure to allocate memory
+ * -3 - Some window did not converge
+ * -4 ...-42 - Invalid primme_params, returned by Sprimme
+ * -43 - Invalid interval, numSlices or numEvals
+ * -44 - There are more than numEvals eigenvalues in the interval
+ *
+ ******************************************************************************/
+
+int Sprimme_slicing(REAL *evals, SCALAR *evecs, REAL *resNorms, double lower,
+      double upper, int numSlices, primme_params *primme) {
+
+   slice_t *slices, **all;  /* The windows                                  */
+   int i, phase;
+   int k0;                  /* Pairs requested initially on every window    */
+   int ret=0, overflow=0;
+   double t0, width;
+
+   if (evals == NULL || evecs == NULL || resNorms == NULL || numSlices < 1 ||
+         !(lower < upper) || primme->numEvals < 1) {
+      return SLICING_INVALID_INPUT;
+   }
+
+   /* The defaults depend on the target, so they are set on the          */
+   /* parameters of every window (see solve_slice). Here only the local   */
+   /* sizes are set as Sprimme would do.                                  */
+
+   t0 = primme_get_wtime();
+   if (primme->numProcs <= 1) {
+      primme->nLocal = primme->n;
+      primme->procID = 0;
+   }
+   if (primme->ldevecs == 0) primme->ldevecs = primme->nLocal;
+   primme->initSize = 0;
+
+   /* Set up the windows */
+
+   CHKERR(MALLOC_PRIMME(numSlices, &slices), -2);
+   if (MALLOC_PRIMME(numSlices, &all)) {
+      free(slices);
+      return -2;
+   }
+   width = (upper - lower)/numSlices;
+   for (i=0; i<numSlices; i++) {
+      slices[i].lower = lower + width*i;
+      slices[i].upper = i < numSlices-1 ? lower + width*(i+1) : upper;
+      slices[i].numPairs = 0;
+      slices[i].evals = slices[i].resNorms = NULL;
+      slices[i].evecs = NULL;
+      slices[i].ret = 0;
+      slices[i].full = 0;
+      all[i] = &slices[i];
+   }
+   k0 = (primme->numEvals + numSlices - 1)/numSlices;
+
+   /* Solve the even windows and then the odd windows. Collective        */
+   /* operations of several windows cannot be interleaved, so with more  */
+   /* than one process the windows are solved one after another.         */
+
+   for (phase=0; phase<2; phase++) {
+#ifdef _OPENMP
+      #pragma omp parallel for schedule(dynamic) if(primme->numProcs == 1)
+#endif
+      for (i=phase; i<numSlices; i+=2) {
+         slices[i].ret = solve_slice(&slices[i],
+               phase == 1 ? &slices[i-1] : NULL,
+               phase == 1 && i+1 < numSlices ? &slices[i+1] : NULL,
+               evecs, k0, primme);
+      }
+   }
+
+   /* Return the pairs in the interval in ascending order */
+
+   clear_stats(&primme->stats);
+   for (i=0; i<numSlices; i++) {
+      if (slices[i].ret != 0 && ret == 0) ret = slices[i].ret;
+      if (slices[i].full) overflow = 1;
+   }
+   if (ret == 0 || ret == MAIN_ITER_FAILURE) {
+      CHKERR(collect_pairs(all, numSlices, lower, upper, evals, resNorms,
+               &evecs[primme->ldevecs*primme->numOrthoConst], primme->ldevecs,
+               primme->numEvals, &primme->initSize, &overflow, primme), -1);
+   }
+
+   /* Report */
+
+   for (i=0; i<numSlices; i++) {
+      add_stats(&primme->stats, &slices[i].stats);
+      if (primme->printLevel >= 2 && primme->procID == 0) {
+         fprintf(primme->outputFile, "Slice %d [%g, %g): %d pairs, "
+               "%" PRIMME_INT_P " matvecs, ret %d\n", i, slices[i].lower,
+               slices[i].upper, slices[i].numPairs,
+               slices[i].stats.numMatvecs, slices[i].ret);
+      }
+      free(slices[i].evals);
+      free(slices[i].resNorms);
+      free(slices[i].evecs);
+   }
+   if (primme->printLevel >= 2 && primme->procID == 0) fflush(primme->outputFile);
+   primme->stats.elapsedTime = primme_get_wtime() - t0;
+   if (primme->aNorm <= 0.0) primme->aNorm = primme->stats.estimateLargestSVal;
+   free(slices);
+   free(all);
+
+   if (ret == 0 && overflow) ret = SLICING_TOO_MANY_PAIRS;
+   return ret;
+}
+
+
+/*******************************************************************************
+ * Function solve_slice - Computes the eigenpairs of the window s. It calls
+ *    Sprimme targeting the closest eigenvalues to the center of the window,
+ *    with numEvals = k0 at first, and again doubling numEvals and adding the
+ *    pairs found to the constraints, until an eigenvalue out of the window is
+ *    found or primme->numEvals pairs have been found.
+ *
+ * INPUT PARAMETERS
+ * ----------------
+ * left, right  The neighbor windows, whose pairs are added to the
+ *              constraints; NULL if they are not used
+ * evecs        The constraints of all windows, primme->numOrthoConst columns
+ *              with leading dimension primme->ldevecs
+ * k0           The number of pairs requested in the first call
+ *
+ * INPUT/OUTPUT PARAMETERS
+ * -----------------------
+ * s            The window; on output numPairs, evals, resNorms, evecs, full
+ *              and stats are set
+ *
+ * Return Value
+ * ------------
+ * int  Error code: 0 upon success, otherwise the error returned by Sprimme
+ *      or -2 if some allocation failed
+ ******************************************************************************/
+
+static int solve_slice(slice_t *s, slice_t *left, slice_t *right,
+      SCALAR *evecs, int k0, primme_params *primme) {
+
+   primme_params sp;         /* The parameters for this window            */
+   slice_t *neighbors[2];
+   PRIMME_INT nLocal = primme->nLocal;
+   int numNeighbors=0;       /* Number of neighbor windows                */
+   int numConst;             /* Constraints: the user's plus the neighbors'*/
+   int i, k, ret=0, overflow=0, done=0;
+   double center, halfWidth;
+   SCALAR *X, *X0;           /* Constraints followed by the found vectors */
+
+   center = (s->lower + s->upper)/2.0;
+   halfWidth = (s->upper - s->lower)/2.0;
+   clear_stats(&s->stats);
+   if (left) neighbors[numNeighbors++] = left;
+   if (right) neighbors[numNeighbors++] = right;
+
+   /* Allocate the space for the user constraints, the pairs of the  */
+   /* neighbors and the first request                                */
+
+   numConst = primme->numOrthoConst;
+   for (i=0; i<numNeighbors; i++) numConst += neighbors[i]->numPairs;
+   if (MALLOC_PRIMME(nLocal*(numConst+k0), &X)) {
+      return -2;
+   }
+   if (MALLOC_PRIMME(max(primme->numEvals, numConst), &s->evals)) {
+      free(X);
+      return -2;
+   }
+   if (MALLOC_PRIMME(max(primme->numEvals, numConst), &s->resNorms)) {
+      free(X);
+      free(s->evals);
+      s->evals = NULL;
+      return -2;
+   }
+
+   /* Copy the user constraints and the pairs of the neighbors without */
+   /* repetitions. Use s->evals and s->resNorms as temporal storage.   */
+   /* The windows may run concurrently, so the reductions are done     */
+   /* with a copy of primme and their statistics are added to s.       */
+
+   Num_copy_matrix_Sprimme(evecs, nLocal, primme->numOrthoConst,
+         primme->ldevecs, X, nLocal);
+   numConst = primme->numOrthoConst;
+   if (numNeighbors > 0) {
+      sp = *primme;
+      clear_stats(&sp.stats);
+      ret = collect_pairs(neighbors, numNeighbors, -HUGE_VAL, HUGE_VAL,
+            s->evals, s->resNorms, &X[nLocal*numConst], nLocal,
+            primme->numEvals + numConst, &i, &overflow, &sp);
+      add_stats(&s->stats, &sp.stats);
+      if (ret != 0) {
+         free(X);
+         return ret;
+      }
+      numConst += i;
+   }
+
+   /* Request more pairs until finding one out of the window */
+
+   for (k=k0; !done; k*=2) {
+      k = min(k, primme->numEvals - s->numPairs);
+      k = (int)min(k, primme->n - numConst - s->numPairs);
+      if (k <= 0) {
+         s->full = (s->numPairs >= primme->numEvals);
+         break;
+      }
+      X0 = (SCALAR*)realloc(X, sizeof(SCALAR)*nLocal*(numConst+s->numPairs+k));
+      if (X0 == NULL) {
+         ret = -2;
+         break;
+      }
+      X = X0;
+
+      sp = *primme;
+      sp.numOrthoConst = numConst + s->numPairs;
+      sp.numEvals = k;
+      sp.initSize = 0;
+      sp.target = primme_closest_abs;
+      sp.numTargetShifts = 1;
+      sp.targetShifts = &center;
+      sp.locking = 1;
+      sp.ldevecs = nLocal;
+      sp.intWork = NULL;
+      sp.realWork = NULL;
+      sp.intWorkSize = 0;
+      sp.realWorkSize = 0;
+      sp.checkpointFile = NULL;
+      sp.checkpointInterval = 0;
+      sp.checkpointResume = 0;
+      sp.warmStart = 0;
+      sp.warmStartState = NULL;
+      if (primme->maxMatvecs > 0) {
+         sp.maxMatvecs = max(1, primme->maxMatvecs - s->stats.numMatvecs);
+      }
+      primme_set_defaults(&sp);
+
+      ret = Sprimme(&s->evals[s->numPairs], X, &s->resNorms[s->numPairs], &sp);
+      add_stats(&s->stats, &sp.stats);
+      primme_free(&sp);
+      if (ret != 0 && ret != MAIN_ITER_FAILURE) break;
+
+      for (i=s->numPairs; i<s->numPairs+sp.initSize; i++) {
+         if (fabs(s->evals[i] - center) >= halfWidth) done = 1;
+      }
+      s->numPairs += sp.initSize;
+      if (ret != 0) break;
+   }
+
+   /* Keep the vectors computed by this window */
+
+   if (s->numPairs > 0 && MALLOC_PRIMME(nLocal*s->numPairs, &s->evecs)) {
+      ret = -2;
+   }
+   else {
+      Num_copy_matrix_Sprimme(&X[nLocal*numConst], nLocal, s->numPairs,
+            nLocal, s->evecs, nLocal);
+   }
+   free(X);
+
+   return ret;
+}
+
+/*******************************************************************************
+ * Function collect_pairs - Copies the pairs computed by several windows with
+ *    eigenvalues in [lower, upper) in ascending order, and discards the
+ *    pairs computed twice. Two pairs are the same if their eigenvalues are
+ *    closer than the sum of their residual norms and the cosine of the angle
+ *    between their vectors is larger than 1/sqrt(2); the one with the
+ *    smallest residual norm is kept.
+ *
+ * INPUT PARAMETERS
+ * ----------------
+ * slices        The windows
+ * numSlices     The number of windows
+ * lower, upper  The interval of the returned eigenvalues
+ * ldX           The leading dimension of X
+ * maxPairs      The maximum number of pairs to return
+ *
+ * OUTPUT PARAMETERS
+ * -----------------
+ * evals, resNorms, X  The returned pairs
+ * numPairs      The number of returned pairs
+ * overflow      Set to one if there are more than maxPairs pairs
+ *
+ * Return Value
+ * ------------
+ * int  Error code: 0 upon success, -2 if some allocation failed
+ ******************************************************************************/
+
+static int collect_pairs(slice_t **slices, int numSlices, double lower,
+      double upper, REAL *evals, REAL *resNorms, SCALAR *X, PRIMME_INT ldX,
+      int maxPairs, int *numPairs, int *overflow, primme_params *primme) {
+
+   pair_ref *refs;
+   PRIMME_INT nLocal = primme->nLocal;
+   int i, j, n=0, numRefs=0, dup;
+   SCALAR *x, ip, ip0;
+   REAL resNorm;
+
+   /* Sort the pairs in the interval */
+
+   for (i=0; i<numSlices; i++) {
+      for (j=0; j<slices[i]->numPairs; j++) {
+         if (lower <= slices[i]->evals[j] && slices[i]->evals[j] < upper)
+            numRefs++;
+      }
+   }
+   if (MALLOC_PRIMME(max(numRefs, 1), &refs)) return -2;
+   numRefs = 0;
+   for (i=0; i<numSlices; i++) {
+      for (j=0; j<slices[i]->numPairs; j++) {
+         if (lower <= slices[i]->evals[j] && slices[i]->evals[j] < upper) {
+            refs[numRefs].eval = slices[i]->evals[j];
+            refs[numRefs].slice = slices[i];
+            refs[numRefs].col = j;
+            numRefs++;
+         }
+      }
+   }
+   qsort(refs, numRefs, sizeof(pair_ref), compare_pair_refs);
+
+   /* Copy every pair unless it is already in X */
+
+   for (i=0; i<numRefs; i++) {
+      x = &refs[i].slice->evecs[nLocal*refs[i].col];
+      resNorm = refs[i].slice->resNorms[refs[i].col];
+
+      dup = -1;
+      for (j=n-1; j>=0 && evals[j] >= refs[i].eval - resNorms[j] - resNorm
+            - MACHINE_EPSILON*fabs(refs[i].eval); j--) {
+         ip = Num_dot_Sprimme(nLocal, &X[ldX*j], 1, x, 1);
+         CHKERR(globalSum_Sprimme(&ip, &ip0, 1, primme), -1);
+         if (ABS(ip0) > 1.0/sqrt(2.0)) {
+            dup = j;
+            break;
+         }
+      }
+
+      if (dup >= 0) {
+         if (resNorm < resNorms[dup]) {
+            evals[dup] = refs[i].eval;
+            resNorms[dup] = resNorm;
+            Num_copy_Sprimme(nLocal, x, 1, &X[ldX*dup], 1);
+         }
+      }
+      else if (n >= maxPairs) {
+         *overflow = 1;
+         break;
+      }
+      else {
+         evals[n] = refs[i].eval;
+         resNorms[n] = resNorm;
+         Num_copy_Sprimme(nLocal, x, 1, &X[ldX*n], 1);
+         n++;
+      }
+   }
+
+   *numPairs = n;
+   free(refs);
+   return 0;
+}
+
+/* Order pair references by eigenvalue, and then by window and column */
+
+static int compare_pair_refs(const void *a, const void *b) {
+   const pair_ref *ra = (const pair_ref*)a, *rb = (const pair_ref*)b;
+
+   if (ra->eval != rb->eval) return ra->eval < rb->eval ? -1 : 1;
+   if (ra->slice != rb->slice) return ra->slice < rb->slice ? -1 : 1;
+   return ra->col - rb->col;
+}
+
+static void clear_stats(primme_stats *stats) {
+   stats->numOuterIterations = 0;
+   stats->numRestarts = 0;
+   stats->numMatvecs = 0;
+   stats->numPreconds = 0;
+   stats->numGlobalSum = 0;
+   stats->volumeGlobalSum = 0;
+   stats->numOrthoInnerProds = 0.0;
+   stats->elapsedTime = 0.0;
+   stats->timeMatvec = 0.0;
+   stats->timePrecond = 0.0;
+   stats->timeOrtho = 0.0;
+   stats->timeGlobalSum = 0.0;
+   stats->estimateMinEVal = HUGE_VAL;
+   stats->estimateMaxEVal = -HUGE_VAL;
+   stats->estimateLargestSVal = -HUGE_VAL;
+   stats->maxConvTol = 0.0;
+   stats->estimateResidualError = 0.0;
+   stats->avgBlockSize = 0.0;
+}
+
+static void add_stats(primme_stats *dst, primme_stats *src) {
+   if (src->numOuterIterations > 0) {
+      dst->avgBlockSize = (dst->avgBlockSize*dst->numOuterIterations
+            + src->avgBlockSize*src->numOuterIterations)
+         / (dst->numOuterIterations + src->numOuterIterations);
+   }
+   dst->numOuterIterations += src->numOuterIterations;
+   dst->numRestarts += src->numRestarts;
+   dst->numMatvecs += src->numMatvecs;
+   dst->numPreconds += src->numPreconds;
+   dst->numGlobalSum += src->numGlobalSum;
+   dst->volumeGlobalSum += src->volumeGlobalSum;
+   dst->numOrthoInnerProds += src->numOrthoInnerProds;
+   dst->elapsedTime += src->elapsedTime;
+   dst->timeMatvec += src->timeMatvec;
+   dst->timePrecond += src->timePrecond;
+   dst->timeOrtho += src->timeOrtho;
+   dst->timeGlobalSum += src->timeGlobalSum;
+   dst->estimateMinEVal = min(dst->estimateMinEVal, src->estimateMinEVal);
+   dst->estimateMaxEVal = max(dst->estimateMaxEVal, src->estimateMaxEVal);
+   dst->estimateLargestSVal = max(dst->estimateLargestSVal,
+         src->estimateLargestSVal);
+   dst->maxConvTol = max(dst->maxConvTol, src->maxConvTol);
+   dst->estimateResidualError = max(dst->estimateResidualError,
+         src->estimateResidualError);
+}
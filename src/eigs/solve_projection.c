@@ -40,10 +40,18 @@
 #include "solve_projection.h"
 #include "ortho.h"
 
+/* Smallest dimension of H for which its eigenproblem is solved with xHEEVR */
+/* instead of xHEEV                                                         */
+#define HEEVR_MIN_SIZE 32
+
 static int solve_H_RR_Sprimme(SCALAR *H, int ldH, SCALAR *hVecs,
    int ldhVecs, REAL *hVals, int basisSize, int numConverged, size_t *lrwork,
    SCALAR *rwork, int liwork, int *iwork, primme_params *primme);
 
+static int solve_H_heev_Sprimme(SCALAR *H, int ldH, REAL alpha,
+   SCALAR *hVecs, int ldhVecs, REAL *hVals, int basisSize, size_t *lrwork,
+   SCALAR *rwork, int liwork, int *iwork, primme_params *primme);
+
 static int solve_H_Harm_Sprimme(SCALAR *H, int ldH, SCALAR *QtV, int ldQtV,
    SCALAR *R, int ldR, SCALAR *hVecs, int ldhVecs, SCALAR *hU, int ldhU,
    REAL *hVals, int basisSize, int numConverged, double machEps,
@@ -176,17 +184,15 @@ static int solve_H_RR_Sprimme(SCALAR *H, int ldH, SCALAR *hVecs,
    SCALAR *rwork, int liwork, int *iwork, primme_params *primme) {
 
    int i, j; /* Loop variables    */
-   int info; /* dsyev error value */
    int index;
    int *permu, *permw;
    double targetShift;
 
-#ifdef USE_COMPLEX
-   REAL  *doubleWork;
-#endif
-
 #ifdef NUM_ESSL
    int apSize, idx;
+#  ifdef USE_COMPLEX
+   REAL  *doubleWork;
+#  endif
 #endif
 
    /* Some LAPACK implementations don't like zero-size matrices */
@@ -198,16 +204,9 @@ static int solve_H_RR_Sprimme(SCALAR *H, int ldH, SCALAR *hVecs,
       *lrwork = max(*lrwork, (size_t)2*basisSize
                     + (size_t)basisSize*(basisSize + 1)/2);
 #else
-      SCALAR rwork0;
-#  ifdef USE_COMPLEX
-      CHKERR((Num_heev_Sprimme("V", "U", basisSize, hVecs, basisSize, hVals,
-               &rwork0, -1, hVals, &info), info), -1);
-      *lrwork = max(*lrwork, (size_t)REAL_PART(rwork0) + 2*basisSize);
-#  else
-      CHKERR((Num_heev_Sprimme("V", "U", basisSize, hVecs, basisSize, hVals,
-               &rwork0, -1, &info), info), -1);
-      *lrwork = max(*lrwork, (size_t)rwork0);
-#  endif
+      CHKERR(solve_H_heev_Sprimme(NULL, 0, 1.0, NULL, 0, NULL, basisSize,
+               lrwork, NULL, 0, iwork, primme), -1);
+      *iwork = max(*iwork, 2*basisSize);
       return 0;
 #endif
    }
@@ -220,14 +219,13 @@ static int solve_H_RR_Sprimme(SCALAR *H, int ldH, SCALAR *hVecs,
    permw = permu + basisSize;
 
 
+#ifdef NUM_ESSL
    /* ------------------------------------------------------------------- */
-   /* Copy the upper triangular portion of H into hvecs.  We need to do   */
-   /* this since DSYEV overwrites the input matrix with the eigenvectors. */  
+   /* Copy the upper triangular portion of H into rwork in packed format. */
    /* Note that H is maxBasisSize-by-maxBasisSize and the basisSize-by-   */
-   /* basisSize submatrix of H is copied into hvecs.                      */
+   /* basisSize submatrix of H is copied.                                 */
    /* ------------------------------------------------------------------- */
 
-#ifdef NUM_ESSL
    idx = 0;
 
    if (primme->target != primme_largest) { /* smallest or any of closest_XXX */
@@ -263,33 +261,9 @@ static int solve_H_RR_Sprimme(SCALAR *H, int ldH, SCALAR *hVecs,
 #  endif
 
 #else /* NUM_ESSL */
-   if (primme->target != primme_largest) {
-      for (j=0; j < basisSize; j++) {
-         for (i=0; i <= j; i++) { 
-            hVecs[ldhVecs*j+i] = H[ldH*j+i];
-         }
-      }      
-   }
-   else { /* (primme->target == primme_largest) */
-      for (j=0; j < basisSize; j++) {
-         for (i=0; i <= j; i++) { 
-            hVecs[ldhVecs*j+i] = -H[ldH*j+i];
-         }
-      }
-   }
-
-#  ifdef USE_COMPLEX
-   /* -------------------------------------------------------------------- */
-   /* Assign also 3N double work space after the 2N complex rwork finishes */
-   /* -------------------------------------------------------------------- */
-   doubleWork = (REAL *) (rwork+ 2*basisSize);
-
-   CHKERR((Num_heev_Sprimme("V", "U", basisSize, hVecs, ldhVecs, hVals, rwork, 
-                2*basisSize, doubleWork, &info), info), -1);
-#  else
-   CHKERR((Num_heev_Sprimme("V", "U", basisSize, hVecs, ldhVecs, hVals, rwork, 
-                TO_INT(*lrwork), &info), info), -1);
-#  endif
+   CHKERR(solve_H_heev_Sprimme(H, ldH,
+            primme->target != primme_largest ? 1.0 : -1.0, hVecs, ldhVecs,
+            hVals, basisSize, lrwork, rwork, liwork, iwork, primme), -1);
 #endif /* NUM_ESSL */
 
    /* ---------------------------------------------------------------------- */
@@ -402,6 +376,186 @@ static int solve_H_RR_Sprimme(SCALAR *H, int ldH, SCALAR *hVecs,
    return 0;   
 }
 
+/*******************************************************************************
+ * Subroutine solve_H_heev - Computes all eigenpairs of the Hermitian matrix
+ *    alpha*H, where only the upper triangular part of H is referenced. The
+ *    dense solver is chosen by the size of H: xHEEV (QR algorithm) has the
+ *    smallest overhead for small matrices, and xHEEVR (MRRR) is faster
+ *    otherwise. If xHEEVR fails, the problem is solved again with xHEEVD
+ *    (divide and conquer).
+ *
+ * INPUT ARRAYS AND PARAMETERS
+ * ---------------------------
+ * H              The matrix
+ * ldH            The leading dimension of H
+ * alpha          Either 1.0 or -1.0
+ * basisSize      The dimension of H
+ * lrwork         Length of the work array rwork
+ * liwork         Length of the work array iwork
+ * primme         Structure containing various solver parameters
+ *
+ * OUTPUT ARRAYS
+ * -------------
+ * hVecs          The eigenvectors of alpha*H
+ * ldhVecs        The leading dimension of hVecs
+ * hVals          The eigenvalues of alpha*H in ascending order
+ * rwork          Workspace
+ * iwork          Workspace in integers
+ *
+ * Return Value
+ * ------------
+ * int -  0 upon successful return
+ *     - -1 the dense eigensolver was unsuccessful
+ ******************************************************************************/
+
+static int solve_H_heev_Sprimme(SCALAR *H, int ldH, REAL alpha,
+   SCALAR *hVecs, int ldhVecs, REAL *hVals, int basisSize, size_t *lrwork,
+   SCALAR *rwork, int liwork, int *iwork, primme_params *primme) {
+
+   int i, j; /* Loop variables */
+   int info; /* LAPACK error value */
+   int m;    /* Number of eigenpairs computed by xHEEVR */
+   SCALAR *A, *work;
+   int lwork, liwork0;
+   size_t lA, lrw;
+   SCALAR rwork0;
+   int iwork0;
+
+#ifdef USE_COMPLEX
+   REAL *doubleWork, doubleWork0;
+   int lrwork0;
+#endif
+
+   /* ------------------------------------------------------------------ */
+   /* Return memory requirements of xHEEV and, for basisSize of at least */
+   /* HEEVR_MIN_SIZE, also of xHEEVR and xHEEVD                          */
+   /* ------------------------------------------------------------------ */
+
+   if (H == NULL) {
+#ifdef USE_COMPLEX
+      CHKERR((Num_heev_Sprimme("V", "U", basisSize, hVecs, basisSize, hVals,
+               &rwork0, -1, hVals, &info), info), -1);
+      *lrwork = max(*lrwork, (size_t)REAL_PART(rwork0) + 2*basisSize);
+#else
+      CHKERR((Num_heev_Sprimme("V", "U", basisSize, hVecs, basisSize, hVals,
+               &rwork0, -1, &info), info), -1);
+      *lrwork = max(*lrwork, (size_t)rwork0);
+#endif
+      if (basisSize < HEEVR_MIN_SIZE) return 0;
+   }
+
+   if (basisSize < HEEVR_MIN_SIZE) {
+
+      /* Copy alpha*H into hVecs, because xHEEV overwrites the input */
+      /* matrix with the eigenvectors                                */
+
+      for (j=0; j < basisSize; j++) {
+         for (i=0; i <= j; i++) { 
+            hVecs[ldhVecs*j+i] = alpha*H[ldH*j+i];
+         }
+      }      
+
+#ifdef USE_COMPLEX
+      /* -------------------------------------------------------------------- */
+      /* Assign also 3N double work space after the 2N complex rwork finishes */
+      /* -------------------------------------------------------------------- */
+      doubleWork = (REAL *) (rwork+ 2*basisSize);
+
+      CHKERR((Num_heev_Sprimme("V", "U", basisSize, hVecs, ldhVecs, hVals,
+                  rwork, 2*basisSize, doubleWork, &info), info), -1);
+#else
+      CHKERR((Num_heev_Sprimme("V", "U", basisSize, hVecs, ldhVecs, hVals,
+                  rwork, TO_INT(*lrwork), &info), info), -1);
+#endif
+      return 0;
+   }
+
+   /* ------------------------------------------------------------------- */
+   /* Query the workspace for xHEEVR and xHEEVD. Both are stored after a  */
+   /* copy of alpha*H, because xHEEVR doesn't return the eigenvectors in  */
+   /* the input matrix.                                                   */
+   /* ------------------------------------------------------------------- */
+
+#ifdef USE_COMPLEX
+   Num_heevr_Sprimme("V", "A", "U", basisSize, NULL, basisSize, 0, 0, &m,
+         NULL, NULL, basisSize, &rwork0, -1, &doubleWork0, -1, &iwork0, -1,
+         &info);
+   CHKERR(info, -1);
+   lwork = (int)REAL_PART(rwork0);
+   lrwork0 = (int)doubleWork0;
+   liwork0 = iwork0;
+   Num_heevd_Sprimme("V", "U", basisSize, NULL, basisSize, NULL, &rwork0, -1,
+         &doubleWork0, -1, &iwork0, -1, &info);
+   CHKERR(info, -1);
+   lwork = max(lwork, (int)REAL_PART(rwork0));
+   lrwork0 = max(lrwork0, (int)doubleWork0);
+   liwork0 = max(liwork0, iwork0);
+   lrw = ((size_t)lrwork0*sizeof(REAL) + sizeof(SCALAR) - 1)/sizeof(SCALAR);
+#else
+   Num_heevr_Sprimme("V", "A", "U", basisSize, NULL, basisSize, 0, 0, &m,
+         NULL, NULL, basisSize, &rwork0, -1, &iwork0, -1, &info);
+   CHKERR(info, -1);
+   lwork = (int)rwork0;
+   liwork0 = iwork0;
+   Num_heevd_Sprimme("V", "U", basisSize, NULL, basisSize, NULL, &rwork0, -1,
+         &iwork0, -1, &info);
+   CHKERR(info, -1);
+   lwork = max(lwork, (int)rwork0);
+   liwork0 = max(liwork0, iwork0);
+   lrw = 0;
+#endif
+   lA = (size_t)basisSize*(size_t)basisSize;
+
+   if (H == NULL) {
+      *lrwork = max(*lrwork, lA + (size_t)lwork + lrw);
+      *iwork = max(*iwork, liwork0);
+      return 0;
+   }
+
+   assert(*lrwork >= lA + (size_t)lwork + lrw && liwork >= liwork0);
+   A = rwork;
+   work = rwork + lA;
+#ifdef USE_COMPLEX
+   doubleWork = (REAL *) (work + lwork);
+#endif
+
+   for (j=0; j < basisSize; j++) {
+      for (i=0; i <= j; i++) { 
+         A[basisSize*j+i] = alpha*H[ldH*j+i];
+      }
+   }      
+
+#ifdef USE_COMPLEX
+   Num_heevr_Sprimme("V", "A", "U", basisSize, A, basisSize, 0, 0, &m, hVals,
+         hVecs, ldhVecs, work, lwork, doubleWork, lrwork0, iwork, liwork0,
+         &info);
+#else
+   Num_heevr_Sprimme("V", "A", "U", basisSize, A, basisSize, 0, 0, &m, hVals,
+         hVecs, ldhVecs, work, lwork, iwork, liwork0, &info);
+#endif
+   if (info == 0 && m == basisSize) return 0;
+
+   /* xHEEVR failed; solve the problem again with xHEEVD */
+
+   for (j=0; j < basisSize; j++) {
+      for (i=0; i <= j; i++) { 
+         hVecs[ldhVecs*j+i] = alpha*H[ldH*j+i];
+      }
+   }      
+
+#ifdef USE_COMPLEX
+   Num_heevd_Sprimme("V", "U", basisSize, hVecs, ldhVecs, hVals, work, lwork,
+         doubleWork, lrwork0, iwork, liwork0, &info);
+#else
+   Num_heevd_Sprimme("V", "U", basisSize, hVecs, ldhVecs, hVals, work, lwork,
+         iwork, liwork0, &info);
+#endif
+   CHKERR(info, -1);
+
+   return 0;
+}
+
+
 /*******************************************************************************
  * Subroutine solve_H_Harm - This procedure implements the harmonic extraction
  *    in a novelty way. In standard harmonic the next eigenproblem is solved:
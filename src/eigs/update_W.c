@@ -73,7 +73,7 @@ int matrixMatvec_Sprimme(SCALAR *V, PRIMME_INT nLocal, PRIMME_INT ldV,
    assert(ldV >= nLocal && ldW >= nLocal);
    assert(primme->ldOPs == 0 || primme->ldOPs >= nLocal);
 
-   t0 = primme_wTimer(0);
+   t0 = primme_get_wtime();
 
    /* W(:,c) = A*V(:,c) for c = basisSize:basisSize+blockSize-1 */
    if (primme->ldOPs == 0 || (ldV == primme->ldOPs && ldW == primme->ldOPs)) {
@@ -90,13 +90,70 @@ int matrixMatvec_Sprimme(SCALAR *V, PRIMME_INT nLocal, PRIMME_INT ldV,
       }
    }
 
-   primme->stats.timeMatvec += primme_wTimer(0) - t0;
+   primme->stats.timeMatvec += primme_get_wtime() - t0;
    primme->stats.numMatvecs += blockSize;
 
    return ierr;
 
 }
 
+/*******************************************************************************
+ * Subroutine massMatrixMatvec_ - Computes B*V(:,nv+1) through B*V(:,nv+blksze)
+ *           for the generalized problem A*x = lambda*B*x. The products are
+ *           not counted in primme.stats.numMatvecs, but their time is added
+ *           to primme.stats.timeMatvec.
+ *
+ * INPUT ARRAYS AND PARAMETERS
+ * ---------------------------
+ * V          The basis
+ * nLocal     Number of rows of each vector stored on this node
+ * ldV        The leading dimension of V
+ * ldBV       The leading dimension of BV
+ * basisSize  Number of vectors in V
+ * blockSize  The current block size
+ *
+ * INPUT/OUTPUT ARRAYS
+ * -------------------
+ * BV         B*V
+ ******************************************************************************/
+
+TEMPLATE_PLEASE
+int massMatrixMatvec_Sprimme(SCALAR *V, PRIMME_INT nLocal, PRIMME_INT ldV,
+      SCALAR *BV, PRIMME_INT ldBV, int basisSize, int blockSize,
+      primme_params *primme) {
+
+   int i, ONE=1, ierr=0;
+   double t0;
+
+   if (blockSize <= 0) return 0;
+
+   assert(ldV >= nLocal && ldBV >= nLocal);
+   assert(primme->ldOPs == 0 || primme->ldOPs >= nLocal);
+
+   t0 = primme_get_wtime();
+
+   /* BV(:,c) = B*V(:,c) for c = basisSize:basisSize+blockSize-1 */
+   if (primme->ldOPs == 0 || (ldV == primme->ldOPs && ldBV == primme->ldOPs)) {
+      CHKERRM((primme->massMatrixMatvec(&V[ldV*basisSize], &ldV,
+                  &BV[ldBV*basisSize], &ldBV, &blockSize, primme, &ierr),
+               ierr), -1,
+            "Error returned by 'massMatrixMatvec' %d", ierr);
+   }
+   else {
+      for (i=0; i<blockSize; i++) {
+         CHKERRM((primme->massMatrixMatvec(&V[ldV*(basisSize+i)],
+                     &primme->ldOPs, &BV[ldBV*(basisSize+i)], &primme->ldOPs,
+                     &ONE, primme, &ierr), ierr), -1,
+               "Error returned by 'massMatrixMatvec' %d", ierr);
+      }
+   }
+
+   primme->stats.timeMatvec += primme_get_wtime() - t0;
+
+   return ierr;
+
+}
+
 /*******************************************************************************
  * Subroutine update_QR - Computes the QR factorization (A-targetShift*I)*V
  *    updating only the columns nv:nv+blockSize-1 of Q and R.
@@ -42,6 +42,15 @@
 int matrixMatvec_dprimme(double *V, int64_t nLocal, int64_t ldV,
       double *W, int64_t ldW, int basisSize, int blockSize,
       primme_params *primme);
+#if !defined(CHECK_TEMPLATE) && !defined(massMatrixMatvec_Sprimme)
+#  define massMatrixMatvec_Sprimme CONCAT(massMatrixMatvec_,SCALAR_SUF)
+#endif
+#if !defined(CHECK_TEMPLATE) && !defined(massMatrixMatvec_Rprimme)
+#  define massMatrixMatvec_Rprimme CONCAT(massMatrixMatvec_,REAL_SUF)
+#endif
+int massMatrixMatvec_dprimme(double *V, int64_t nLocal, int64_t ldV,
+      double *BV, int64_t ldBV, int basisSize, int blockSize,
+      primme_params *primme);
 #if !defined(CHECK_TEMPLATE) && !defined(update_Q_Sprimme)
 #  define update_Q_Sprimme CONCAT(update_Q_,SCALAR_SUF)
 #endif
@@ -55,6 +64,9 @@ int update_Q_dprimme(double *V, int64_t nLocal, int64_t ldV,
 int matrixMatvec_zprimme(PRIMME_COMPLEX_DOUBLE *V, int64_t nLocal, int64_t ldV,
       PRIMME_COMPLEX_DOUBLE *W, int64_t ldW, int basisSize, int blockSize,
       primme_params *primme);
+int massMatrixMatvec_zprimme(PRIMME_COMPLEX_DOUBLE *V, int64_t nLocal, int64_t ldV,
+      PRIMME_COMPLEX_DOUBLE *BV, int64_t ldBV, int basisSize, int blockSize,
+      primme_params *primme);
 int update_Q_zprimme(PRIMME_COMPLEX_DOUBLE *V, int64_t nLocal, int64_t ldV,
       PRIMME_COMPLEX_DOUBLE *W, int64_t ldW, PRIMME_COMPLEX_DOUBLE *Q, int64_t ldQ, PRIMME_COMPLEX_DOUBLE *R, int ldR,
       double targetShift, int basisSize, int blockSize, PRIMME_COMPLEX_DOUBLE *rwork,
@@ -62,6 +74,9 @@ int update_Q_zprimme(PRIMME_COMPLEX_DOUBLE *V, int64_t nLocal, int64_t ldV,
 int matrixMatvec_sprimme(float *V, int64_t nLocal, int64_t ldV,
       float *W, int64_t ldW, int basisSize, int blockSize,
       primme_params *primme);
+int massMatrixMatvec_sprimme(float *V, int64_t nLocal, int64_t ldV,
+      float *BV, int64_t ldBV, int basisSize, int blockSize,
+      primme_params *primme);
 int update_Q_sprimme(float *V, int64_t nLocal, int64_t ldV,
       float *W, int64_t ldW, float *Q, int64_t ldQ, float *R, int ldR,
       double targetShift, int basisSize, int blockSize, float *rwork,
@@ -69,6 +84,9 @@ int update_Q_sprimme(float *V, int64_t nLocal, int64_t ldV,
 int matrixMatvec_cprimme(PRIMME_COMPLEX_FLOAT *V, int64_t nLocal, int64_t ldV,
       PRIMME_COMPLEX_FLOAT *W, int64_t ldW, int basisSize, int blockSize,
       primme_params *primme);
+int massMatrixMatvec_cprimme(PRIMME_COMPLEX_FLOAT *V, int64_t nLocal, int64_t ldV,
+      PRIMME_COMPLEX_FLOAT *BV, int64_t ldBV, int basisSize, int blockSize,
+      primme_params *primme);
 int update_Q_cprimme(PRIMME_COMPLEX_FLOAT *V, int64_t nLocal, int64_t ldV,
       PRIMME_COMPLEX_FLOAT *W, int64_t ldW, PRIMME_COMPLEX_FLOAT *Q, int64_t ldQ, PRIMME_COMPLEX_FLOAT *R, int ldR,
       double targetShift, int basisSize, int blockSize, PRIMME_COMPLEX_FLOAT *rwork,
@@ -130,6 +130,24 @@ void Num_swap_dprimme(int64_t n, double *x, int incx, double *y, int incy);
 #endif
 void Num_heev_dprimme(const char *jobz, const char *uplo, int n, double *a,
       int lda, double *w, double *work, int ldwork, int *info);
+#if !defined(CHECK_TEMPLATE) && !defined(Num_heevd_Sprimme)
+#  define Num_heevd_Sprimme CONCAT(Num_heevd_,SCALAR_SUF)
+#endif
+#if !defined(CHECK_TEMPLATE) && !defined(Num_heevd_Rprimme)
+#  define Num_heevd_Rprimme CONCAT(Num_heevd_,REAL_SUF)
+#endif
+void Num_heevd_dprimme(const char *jobz, const char *uplo, int n, double *a,
+      int lda, double *w, double *work, int ldwork, int *iwork, int liwork,
+      int *info);
+#if !defined(CHECK_TEMPLATE) && !defined(Num_heevr_Sprimme)
+#  define Num_heevr_Sprimme CONCAT(Num_heevr_,SCALAR_SUF)
+#endif
+#if !defined(CHECK_TEMPLATE) && !defined(Num_heevr_Rprimme)
+#  define Num_heevr_Rprimme CONCAT(Num_heevr_,REAL_SUF)
+#endif
+void Num_heevr_dprimme(const char *jobz, const char *range, const char *uplo,
+      int n, double *a, int lda, int il, int iu, int *m, double *w, double *z,
+      int ldz, double *work, int ldwork, int *iwork, int liwork, int *info);
 #if !defined(CHECK_TEMPLATE) && !defined(Num_gesvd_Sprimme)
 #  define Num_gesvd_Sprimme CONCAT(Num_gesvd_,SCALAR_SUF)
 #endif
@@ -155,6 +173,14 @@ void Num_hetrf_dprimme(const char *uplo, int n, double *a, int lda, int *ipivot,
 #endif
 void Num_hetrs_dprimme(const char *uplo, int n, int nrhs, double *a,
       int lda, int *ipivot, double *b, int ldb, int *info);
+#if !defined(CHECK_TEMPLATE) && !defined(Num_potrf_Sprimme)
+#  define Num_potrf_Sprimme CONCAT(Num_potrf_,SCALAR_SUF)
+#endif
+#if !defined(CHECK_TEMPLATE) && !defined(Num_potrf_Rprimme)
+#  define Num_potrf_Rprimme CONCAT(Num_potrf_,REAL_SUF)
+#endif
+void Num_potrf_dprimme(const char *uplo, int n, double *a, int lda,
+      int *info);
 #if !defined(CHECK_TEMPLATE) && !defined(Num_trsm_Sprimme)
 #  define Num_trsm_Sprimme CONCAT(Num_trsm_,SCALAR_SUF)
 #endif
@@ -189,6 +215,13 @@ void Num_scal_zprimme(int64_t n, PRIMME_COMPLEX_DOUBLE alpha, PRIMME_COMPLEX_DOU
 void Num_swap_zprimme(int64_t n, PRIMME_COMPLEX_DOUBLE *x, int incx, PRIMME_COMPLEX_DOUBLE *y, int incy);
 void Num_heev_zprimme(const char *jobz, const char *uplo, int n, PRIMME_COMPLEX_DOUBLE *a,
       int lda, double *w, PRIMME_COMPLEX_DOUBLE *work, int ldwork, double *rwork, int *info);
+void Num_heevd_zprimme(const char *jobz, const char *uplo, int n, PRIMME_COMPLEX_DOUBLE *a,
+      int lda, double *w, PRIMME_COMPLEX_DOUBLE *work, int ldwork, double *rwork, int lrwork,
+      int *iwork, int liwork, int *info);
+void Num_heevr_zprimme(const char *jobz, const char *range, const char *uplo,
+      int n, PRIMME_COMPLEX_DOUBLE *a, int lda, int il, int iu, int *m, double *w, PRIMME_COMPLEX_DOUBLE *z,
+      int ldz, PRIMME_COMPLEX_DOUBLE *work, int ldwork, double *rwork, int lrwork, int *iwork,
+      int liwork, int *info);
 void Num_gesvd_zprimme(const char *jobu, const char *jobvt, int m, int n,
    PRIMME_COMPLEX_DOUBLE *a, int lda, double *s, PRIMME_COMPLEX_DOUBLE *u, int ldu, PRIMME_COMPLEX_DOUBLE *vt, int ldvt,
    PRIMME_COMPLEX_DOUBLE *work, int ldwork, double *rwork, int *info);
@@ -196,6 +229,8 @@ void Num_hetrf_zprimme(const char *uplo, int n, PRIMME_COMPLEX_DOUBLE *a, int ld
    PRIMME_COMPLEX_DOUBLE *work, int ldwork, int *info);
 void Num_hetrs_zprimme(const char *uplo, int n, int nrhs, PRIMME_COMPLEX_DOUBLE *a,
       int lda, int *ipivot, PRIMME_COMPLEX_DOUBLE *b, int ldb, int *info);
+void Num_potrf_zprimme(const char *uplo, int n, PRIMME_COMPLEX_DOUBLE *a, int lda,
+      int *info);
 void Num_trsm_zprimme(const char *side, const char *uplo, const char *transa,
       const char *diag, int m, int n, PRIMME_COMPLEX_DOUBLE alpha, PRIMME_COMPLEX_DOUBLE *a, int lda,
       PRIMME_COMPLEX_DOUBLE *b, int ldb);
@@ -224,6 +259,12 @@ void Num_scal_sprimme(int64_t n, float alpha, float *x, int incx);
 void Num_swap_sprimme(int64_t n, float *x, int incx, float *y, int incy);
 void Num_heev_sprimme(const char *jobz, const char *uplo, int n, float *a,
       int lda, float *w, float *work, int ldwork, int *info);
+void Num_heevd_sprimme(const char *jobz, const char *uplo, int n, float *a,
+      int lda, float *w, float *work, int ldwork, int *iwork, int liwork,
+      int *info);
+void Num_heevr_sprimme(const char *jobz, const char *range, const char *uplo,
+      int n, float *a, int lda, int il, int iu, int *m, float *w, float *z,
+      int ldz, float *work, int ldwork, int *iwork, int liwork, int *info);
 void Num_gesvd_sprimme(const char *jobu, const char *jobvt, int m, int n,
       float *a, int lda, float *s, float *u, int ldu, float *vt, int ldvt,
       float *work, int ldwork, int *info);
@@ -231,6 +272,8 @@ void Num_hetrf_sprimme(const char *uplo, int n, float *a, int lda, int *ipivot,
    float *work, int ldwork, int *info);
 void Num_hetrs_sprimme(const char *uplo, int n, int nrhs, float *a,
       int lda, int *ipivot, float *b, int ldb, int *info);
+void Num_potrf_sprimme(const char *uplo, int n, float *a, int lda,
+      int *info);
 void Num_trsm_sprimme(const char *side, const char *uplo, const char *transa,
       const char *diag, int m, int n, float alpha, float *a, int lda,
       float *b, int ldb);
@@ -259,6 +302,13 @@ void Num_scal_cprimme(int64_t n, PRIMME_COMPLEX_FLOAT alpha, PRIMME_COMPLEX_FLOA
 void Num_swap_cprimme(int64_t n, PRIMME_COMPLEX_FLOAT *x, int incx, PRIMME_COMPLEX_FLOAT *y, int incy);
 void Num_heev_cprimme(const char *jobz, const char *uplo, int n, PRIMME_COMPLEX_FLOAT *a,
       int lda, float *w, PRIMME_COMPLEX_FLOAT *work, int ldwork, float *rwork, int *info);
+void Num_heevd_cprimme(const char *jobz, const char *uplo, int n, PRIMME_COMPLEX_FLOAT *a,
+      int lda, float *w, PRIMME_COMPLEX_FLOAT *work, int ldwork, float *rwork, int lrwork,
+      int *iwork, int liwork, int *info);
+void Num_heevr_cprimme(const char *jobz, const char *range, const char *uplo,
+      int n, PRIMME_COMPLEX_FLOAT *a, int lda, int il, int iu, int *m, float *w, PRIMME_COMPLEX_FLOAT *z,
+      int ldz, PRIMME_COMPLEX_FLOAT *work, int ldwork, float *rwork, int lrwork, int *iwork,
+      int liwork, int *info);
 void Num_gesvd_cprimme(const char *jobu, const char *jobvt, int m, int n,
    PRIMME_COMPLEX_FLOAT *a, int lda, float *s, PRIMME_COMPLEX_FLOAT *u, int ldu, PRIMME_COMPLEX_FLOAT *vt, int ldvt,
    PRIMME_COMPLEX_FLOAT *work, int ldwork, float *rwork, int *info);
@@ -266,6 +316,8 @@ void Num_hetrf_cprimme(const char *uplo, int n, PRIMME_COMPLEX_FLOAT *a, int lda
    PRIMME_COMPLEX_FLOAT *work, int ldwork, int *info);
 void Num_hetrs_cprimme(const char *uplo, int n, int nrhs, PRIMME_COMPLEX_FLOAT *a,
       int lda, int *ipivot, PRIMME_COMPLEX_FLOAT *b, int ldb, int *info);
+void Num_potrf_cprimme(const char *uplo, int n, PRIMME_COMPLEX_FLOAT *a, int lda,
+      int *info);
 void Num_trsm_cprimme(const char *side, const char *uplo, const char *transa,
       const char *diag, int m, int n, PRIMME_COMPLEX_FLOAT alpha, PRIMME_COMPLEX_FLOAT *a, int lda,
       PRIMME_COMPLEX_FLOAT *b, int ldb);
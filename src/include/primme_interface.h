@@ -39,5 +39,7 @@
 void primme_set_defaults(primme_params *params);
 void primme_display_params_prefix(const char* prefix, primme_params primme);
 #define Sprimme CONCAT(SCALAR_PRE,primme)
+#define Sprimme_slicing CONCAT(SCALAR_PRE,primme_slicing)
+#define Sprimme_batch CONCAT(SCALAR_PRE,primme_batch)
 
 #endif
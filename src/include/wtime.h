@@ -40,7 +40,9 @@
 extern "C" {
 #endif
 
-double primme_wTimer(int zeroTimer);
+struct primme_params;
+
+double primme_wTimer(struct primme_params *primme);
 extern double primme_get_wtime();
 #if defined (__unix__) || (defined (__APPLE__) && defined (__MACH__))
 double primme_get_time(double *, double *);
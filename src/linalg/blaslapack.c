@@ -457,6 +457,290 @@ void Num_heev_Sprimme(const char *jobz, const char *uplo, int n, SCALAR *a,
 #  endif
 #endif
 
+/*******************************************************************************
+ * Subroutine Num_heevd_Sprimme - eigenvalue decomposition of a Hermitian
+ *    matrix by divide and conquer. If ldwork is -1, the optimal sizes of work,
+ *    rwork and iwork are returned in their first element.
+ ******************************************************************************/
+
+#ifndef NUM_ESSL
+TEMPLATE_PLEASE
+#  ifndef USE_COMPLEX
+void Num_heevd_Sprimme(const char *jobz, const char *uplo, int n, SCALAR *a,
+      int lda, REAL *w, SCALAR *work, int ldwork, int *iwork, int liwork,
+      int *info) {
+
+   PRIMME_BLASINT ln = n;
+   PRIMME_BLASINT llda = lda;
+   PRIMME_BLASINT lldwork = ldwork;
+   PRIMME_BLASINT lliwork = liwork;
+   PRIMME_BLASINT *liw;
+   PRIMME_BLASINT linfo = 0;
+   PRIMME_BLASINT liwork0 = 0;
+   SCALAR dummys=0;
+   REAL   dummyr=0;
+
+   /* Zero dimension matrix may cause problems */
+   if (n == 0) return;
+
+   /* NULL matrices and zero leading dimension may cause problems */
+   if (a == NULL) a = &dummys;
+   if (llda < 1) llda = 1;
+   if (w == NULL) w = &dummyr;
+
+   /* LAPACK may use integers of a different size than int */
+   if (ldwork == -1 || liwork == -1) {
+      lldwork = lliwork = -1;
+      liw = &liwork0;
+   }
+   else if (sizeof(int) != sizeof(PRIMME_BLASINT)) {
+      if (MALLOC_PRIMME(max(liwork, 1), &liw) != 0) {
+         *info = -1;
+         return;
+      }
+   } else {
+      liw = (PRIMME_BLASINT *)iwork; /* cast avoid compiler warning */
+   }
+
+#ifdef NUM_CRAY
+   _fcd jobz_fcd, uplo_fcd;
+
+   jobz_fcd = _cptofcd(jobz, strlen(jobz));
+   uplo_fcd = _cptofcd(uplo, strlen(uplo));
+
+   XHEEVD(jobz_fcd, uplo_fcd, &ln, a, &llda, w, work, &lldwork, liw, &lliwork,
+         &linfo);
+#else
+   XHEEVD(jobz, uplo, &ln, a, &llda, w, work, &lldwork, liw, &lliwork, &linfo);
+#endif
+
+   if (lldwork == -1) {
+      iwork[0] = (int)liwork0;
+   }
+   else if (sizeof(int) != sizeof(PRIMME_BLASINT)) {
+      free(liw);
+   }
+   *info = (int)linfo;
+}
+#  else
+void Num_heevd_Sprimme(const char *jobz, const char *uplo, int n, SCALAR *a,
+      int lda, REAL *w, SCALAR *work, int ldwork, REAL *rwork, int lrwork,
+      int *iwork, int liwork, int *info) {
+
+   PRIMME_BLASINT ln = n;
+   PRIMME_BLASINT llda = lda;
+   PRIMME_BLASINT lldwork = ldwork;
+   PRIMME_BLASINT llrwork = lrwork;
+   PRIMME_BLASINT lliwork = liwork;
+   PRIMME_BLASINT *liw;
+   PRIMME_BLASINT linfo = 0;
+   PRIMME_BLASINT liwork0 = 0;
+   SCALAR dummys=0;
+   REAL   dummyr=0;
+
+   /* Zero dimension matrix may cause problems */
+   if (n == 0) return;
+
+   /* NULL matrices and zero leading dimension may cause problems */
+   if (a == NULL) a = &dummys;
+   if (llda < 1) llda = 1;
+   if (w == NULL) w = &dummyr;
+
+   /* LAPACK may use integers of a different size than int */
+   if (ldwork == -1 || lrwork == -1 || liwork == -1) {
+      lldwork = llrwork = lliwork = -1;
+      liw = &liwork0;
+   }
+   else if (sizeof(int) != sizeof(PRIMME_BLASINT)) {
+      if (MALLOC_PRIMME(max(liwork, 1), &liw) != 0) {
+         *info = -1;
+         return;
+      }
+   } else {
+      liw = (PRIMME_BLASINT *)iwork; /* cast avoid compiler warning */
+   }
+
+#ifdef NUM_CRAY
+   _fcd jobz_fcd, uplo_fcd;
+
+   jobz_fcd = _cptofcd(jobz, strlen(jobz));
+   uplo_fcd = _cptofcd(uplo, strlen(uplo));
+
+   XHEEVD(jobz_fcd, uplo_fcd, &ln, a, &llda, w, work, &lldwork, rwork,
+         &llrwork, liw, &lliwork, &linfo);
+#else
+   XHEEVD(jobz, uplo, &ln, a, &llda, w, work, &lldwork, rwork, &llrwork, liw,
+         &lliwork, &linfo);
+#endif
+
+   if (lldwork == -1) {
+      iwork[0] = (int)liwork0;
+   }
+   else if (sizeof(int) != sizeof(PRIMME_BLASINT)) {
+      free(liw);
+   }
+   *info = (int)linfo;
+}
+#  endif
+#endif /* NUM_ESSL */
+
+/*******************************************************************************
+ * Subroutine Num_heevr_Sprimme - eigenvalue decomposition of a Hermitian
+ *    matrix by the MRRR algorithm. All eigenpairs are computed if range is
+ *    "A", and only the pairs il to iu (1-based, in ascending order) if range
+ *    is "I". The number of computed pairs is returned in m. The first 2*n
+ *    elements of iwork are used for the support of the eigenvectors. If
+ *    ldwork is -1, the optimal sizes of work, rwork and iwork are returned in
+ *    their first element.
+ ******************************************************************************/
+
+#ifndef NUM_ESSL
+TEMPLATE_PLEASE
+#  ifndef USE_COMPLEX
+void Num_heevr_Sprimme(const char *jobz, const char *range, const char *uplo,
+      int n, SCALAR *a, int lda, int il, int iu, int *m, REAL *w, SCALAR *z,
+      int ldz, SCALAR *work, int ldwork, int *iwork, int liwork, int *info) {
+
+   PRIMME_BLASINT ln = n;
+   PRIMME_BLASINT llda = lda;
+   PRIMME_BLASINT lil = il;
+   PRIMME_BLASINT liu = iu;
+   PRIMME_BLASINT lm = 0;
+   PRIMME_BLASINT lldz = ldz;
+   PRIMME_BLASINT lldwork = ldwork;
+   PRIMME_BLASINT lliwork = liwork - 2*n;
+   PRIMME_BLASINT *liw;
+   PRIMME_BLASINT linfo = 0;
+   PRIMME_BLASINT liwork0 = 0;
+   SCALAR dummys=0;
+   REAL   dummyr=0;
+   REAL   vl=0, vu=0, abstol=0;
+
+   /* Zero dimension matrix may cause problems */
+   *m = 0;
+   if (n == 0) return;
+
+   /* NULL matrices and zero leading dimension may cause problems */
+   if (a == NULL) a = &dummys;
+   if (llda < 1) llda = 1;
+   if (w == NULL) w = &dummyr;
+   if (z == NULL) z = &dummys;
+   if (lldz < 1) lldz = 1;
+
+   /* LAPACK may use integers of a different size than int */
+   if (ldwork == -1 || liwork == -1) {
+      lldwork = lliwork = -1;
+      liw = &liwork0;
+   }
+   else if (sizeof(int) != sizeof(PRIMME_BLASINT)) {
+      if (MALLOC_PRIMME(max(liwork, 1), &liw) != 0) {
+         *info = -1;
+         return;
+      }
+   } else {
+      liw = (PRIMME_BLASINT *)iwork; /* cast avoid compiler warning */
+   }
+
+#ifdef NUM_CRAY
+   _fcd jobz_fcd, range_fcd, uplo_fcd;
+
+   jobz_fcd = _cptofcd(jobz, strlen(jobz));
+   range_fcd = _cptofcd(range, strlen(range));
+   uplo_fcd = _cptofcd(uplo, strlen(uplo));
+
+   XHEEVR(jobz_fcd, range_fcd, uplo_fcd, &ln, a, &llda, &vl, &vu, &lil, &liu,
+         &abstol, &lm, w, z, &lldz, liw, work, &lldwork,
+         lldwork == -1 ? liw : &liw[2*n], &lliwork, &linfo);
+#else
+   XHEEVR(jobz, range, uplo, &ln, a, &llda, &vl, &vu, &lil, &liu, &abstol,
+         &lm, w, z, &lldz, liw, work, &lldwork,
+         lldwork == -1 ? liw : &liw[2*n], &lliwork, &linfo);
+#endif
+
+   if (lldwork == -1) {
+      iwork[0] = (int)liwork0 + 2*n;
+   }
+   else if (sizeof(int) != sizeof(PRIMME_BLASINT)) {
+      free(liw);
+   }
+   *m = (int)lm;
+   *info = (int)linfo;
+}
+#  else
+void Num_heevr_Sprimme(const char *jobz, const char *range, const char *uplo,
+      int n, SCALAR *a, int lda, int il, int iu, int *m, REAL *w, SCALAR *z,
+      int ldz, SCALAR *work, int ldwork, REAL *rwork, int lrwork, int *iwork,
+      int liwork, int *info) {
+
+   PRIMME_BLASINT ln = n;
+   PRIMME_BLASINT llda = lda;
+   PRIMME_BLASINT lil = il;
+   PRIMME_BLASINT liu = iu;
+   PRIMME_BLASINT lm = 0;
+   PRIMME_BLASINT lldz = ldz;
+   PRIMME_BLASINT lldwork = ldwork;
+   PRIMME_BLASINT llrwork = lrwork;
+   PRIMME_BLASINT lliwork = liwork - 2*n;
+   PRIMME_BLASINT *liw;
+   PRIMME_BLASINT linfo = 0;
+   PRIMME_BLASINT liwork0 = 0;
+   SCALAR dummys=0;
+   REAL   dummyr=0;
+   REAL   vl=0, vu=0, abstol=0;
+
+   /* Zero dimension matrix may cause problems */
+   *m = 0;
+   if (n == 0) return;
+
+   /* NULL matrices and zero leading dimension may cause problems */
+   if (a == NULL) a = &dummys;
+   if (llda < 1) llda = 1;
+   if (w == NULL) w = &dummyr;
+   if (z == NULL) z = &dummys;
+   if (lldz < 1) lldz = 1;
+
+   /* LAPACK may use integers of a different size than int */
+   if (ldwork == -1 || lrwork == -1 || liwork == -1) {
+      lldwork = llrwork = lliwork = -1;
+      liw = &liwork0;
+   }
+   else if (sizeof(int) != sizeof(PRIMME_BLASINT)) {
+      if (MALLOC_PRIMME(max(liwork, 1), &liw) != 0) {
+         *info = -1;
+         return;
+      }
+   } else {
+      liw = (PRIMME_BLASINT *)iwork; /* cast avoid compiler warning */
+   }
+
+#ifdef NUM_CRAY
+   _fcd jobz_fcd, range_fcd, uplo_fcd;
+
+   jobz_fcd = _cptofcd(jobz, strlen(jobz));
+   range_fcd = _cptofcd(range, strlen(range));
+   uplo_fcd = _cptofcd(uplo, strlen(uplo));
+
+   XHEEVR(jobz_fcd, range_fcd, uplo_fcd, &ln, a, &llda, &vl, &vu, &lil, &liu,
+         &abstol, &lm, w, z, &lldz, liw, work, &lldwork, rwork, &llrwork,
+         lldwork == -1 ? liw : &liw[2*n], &lliwork, &linfo);
+#else
+   XHEEVR(jobz, range, uplo, &ln, a, &llda, &vl, &vu, &lil, &liu, &abstol,
+         &lm, w, z, &lldz, liw, work, &lldwork, rwork, &llrwork,
+         lldwork == -1 ? liw : &liw[2*n], &lliwork, &linfo);
+#endif
+
+   if (lldwork == -1) {
+      iwork[0] = (int)liwork0 + 2*n;
+   }
+   else if (sizeof(int) != sizeof(PRIMME_BLASINT)) {
+      free(liw);
+   }
+   *m = (int)lm;
+   *info = (int)linfo;
+}
+#  endif
+#endif /* NUM_ESSL */
+
 /*******************************************************************************
  * Subroutines for dense singular value decomposition
  ******************************************************************************/
@@ -641,6 +925,36 @@ void Num_hetrs_Sprimme(const char *uplo, int n, int nrhs, SCALAR *a,
    *info = (int)linfo;
 }
 
+/*******************************************************************************
+ * Subroutine Num_potrf_Sprimme - Cholesky factorization A = U^H U or L L^H
+ ******************************************************************************/
+
+TEMPLATE_PLEASE
+void Num_potrf_Sprimme(const char *uplo, int n, SCALAR *a, int lda,
+      int *info) {
+
+   PRIMME_BLASINT ln = n;
+   PRIMME_BLASINT llda = lda;
+   PRIMME_BLASINT linfo = 0;
+
+   /* Zero dimension matrix may cause problems */
+   if (n == 0) {
+      *info = 0;
+      return;
+   }
+
+#ifdef NUM_CRAY
+   _fcd uplo_fcd;
+
+   uplo_fcd = _cptofcd(uplo, strlen(uplo));
+   XPOTRF(uplo_fcd, &ln, a, &llda, &linfo);
+#else
+   XPOTRF(uplo, &ln, a, &llda, &linfo);
+#endif
+
+   *info = (int)linfo;
+}
+
 /*******************************************************************************
  * Subroutine Num_trsm_Sprimme - b = op(A)\b
  ******************************************************************************/
@@ -38,6 +38,7 @@
 #  include <sys/time.h>
 #  include <sys/resource.h>
 #endif
+#include "primme.h"
 #include "wtime.h"
 
 #ifdef RUSAGE_SELF
@@ -48,53 +49,36 @@
 /* Only define these functions ones */
 #ifdef USE_DOUBLE
 
-#if defined (__unix__) || (defined (__APPLE__) && defined (__MACH__))
-double primme_wTimer(int zeroTimer) {
-   static struct timeval tv;
-   static double StartingTime;
-   
-   if (zeroTimer) {
-      gettimeofday(&tv, NULL); 
-      StartingTime = ((double) tv.tv_sec) + ((double) tv.tv_usec )/(double) 1E6;
-      return StartingTime;
-   }
-   else {
-      gettimeofday(&tv, NULL); 
-      return ((double) tv.tv_sec) + ((double) tv.tv_usec ) / (double) 1E6
-           - StartingTime;
-   }
+/*******************************************************************************
+ * Function primme_wTimer - Return the wall-clock time elapsed since the
+ *    current solve started. The starting time is kept in primme->ctx, so
+ *    concurrent solves with different primme_params do not interfere.
+ *
+ ******************************************************************************/
+
+double primme_wTimer(primme_params *primme) {
+   return primme_get_wtime() - primme->ctx.timerStart;
 }
 
+#if defined (__unix__) || (defined (__APPLE__) && defined (__MACH__))
+
 /* In the unlikely event that gettimeofday() is not available, but POSIX is, 
- * we can use the following alternative definition for primme_wTimer, 
+ * we can use the following alternative definition for primme_get_wtime, 
  * after including time.h at the top.
  */
 /*
 #include <time.h>
-double primme_wTimer(int zeroTimer) {
-   static struct timespec ts;
-   static double StartingTime;
-   
-   if (zeroTimer) {
-      clock_gettime(CLOCK_REALTIME, &ts);
-      StartingTime = ((double) ts.tv_sec) + ((double) ts.tv_nsec )/(double) 1E9;
-      return StartingTime;
-   }
-   else {
-      clock_gettime(CLOCK_REALTIME, &ts);
-      return ((double) ts.tv_sec) + ((double) ts.tv_nsec ) / (double) 1E9;
-           - StartingTime;
-   }
+double primme_get_wtime() {
+   struct timespec ts;
+
+   clock_gettime(CLOCK_REALTIME, &ts);
+   return ((double) ts.tv_sec) + ((double) ts.tv_nsec ) / (double) 1E9;
 }
 */
 
-/* 
- * Other timers that may be of use -------------------------------------------
- */
-
 /* Simply return the microseconds time of day */
 double primme_get_wtime() {
-   static struct timeval tv;
+   struct timeval tv;
 
    gettimeofday(&tv, NULL); 
    return ((double) tv.tv_sec) + ((double) tv.tv_usec ) / (double) 1E6;
@@ -103,7 +87,7 @@ double primme_get_wtime() {
 /* Return user/system times */
 double primme_get_time(double *utime, double *stime) {
    struct rusage usage;
-   static struct timeval utv,stv;
+   struct timeval utv,stv;
 
    getrusage(RUSAGE_SELF, &usage);
    utv = usage.ru_utime;
@@ -116,16 +100,8 @@ double primme_get_time(double *utime, double *stime) {
 }
 #else
 #include <Windows.h>
-double primme_wTimer(int zeroTimer) {
-   static DWORD StartingTime;
-
-   if (zeroTimer) {
-      StartingTime = GetTickCount();
-      return StartingTime;
-   }
-   else {
-      return GetTickCount() - StartingTime;
-   }
+double primme_get_wtime() {
+   return GetTickCount() / (double) 1E3;
 }
 
 #endif
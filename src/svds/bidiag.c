@@ -0,0 +1,408 @@
+/*******************************************************************************
+ * Copyright (c) 2016, College of William & Mary
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the College of William & Mary nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COLLEGE OF WILLIAM & MARY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * PRIMME: https://github.com/primme/primme
+ * Contact: Andreas Stathopoulos, a n d r e a s _at_ c s . w m . e d u
+ *******************************************************************************
+ * File: bidiag.c
+ *
+ * Purpose - Thick-restarted Golub-Kahan-Lanczos bidiagonalization for the
+ *           largest singular triplets.
+ *
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <assert.h>
+#include "numerical.h"
+#include "../eigs/const.h"
+#include "wtime.h"
+#include "../eigs/ortho.h"
+#include "../eigs/auxiliary_eigs.h"
+#include "bidiag.h"
+
+#define MAIN_ITER_FAILURE          -3
+
+static int basis_size(primme_svds_params *primme_svds);
+
+
+/*******************************************************************************
+ * Function bidiag - Computes the numSvals largest singular triplets of A with
+ *    a Golub-Kahan-Lanczos bidiagonalization of p = basis_size() steps,
+ *
+ *       A*V = U*B,   A'*U = V*B' + beta*v_p*e_p',
+ *
+ *    where V and U have orthonormal columns and B is p x p. Every step takes
+ *    one product with A and one with A', and both bases are fully
+ *    reorthogonalized with ortho, which also returns the new column of B.
+ *    The singular triplets (s, x, y) of B give the approximations
+ *    (s, U*x, V*y) with residual norm |beta*x(p)|. When the basis is full,
+ *    it is restarted with the k largest approximations and v_p (thick
+ *    restart), so that B becomes diag(s_1,...,s_k) plus the column computed
+ *    in the next step. The Ritz values converge slowly to the smallest
+ *    singular values, so that target is not supported.
+ *
+ *    The process starts with the sum of the right initial guesses, or with a
+ *    random vector if initSize is zero. Both bases are kept orthogonal to the
+ *    constraint vectors, if numOrthoConst is not zero.
+ *
+ *    Calling bidiag with svecs set to NULL returns the workspace required.
+ *
+ * INPUT/OUTPUT ARRAYS AND PARAMETERS
+ * ----------------------------------
+ * svals       The singular values, in descending order
+ * svecs       On input, [Uc U0 Vc V0], the constraint and initial vectors;
+ *             on output, [Uc U Vc V] with the singular vectors
+ * resNorms    The residual norms, |A'*u - s*v|
+ * rwork       Workspace
+ * rworkSize   Size of rwork in SCALARs; in query mode, it is increased to
+ *             the size required
+ * primme_svds Structure containing various solver parameters; the number
+ *             of returned triplets is set in initSize, aNorm is set to the
+ *             estimation of the largest singular value if it was not set,
+ *             and the stats are increased
+ *
+ * Return Value
+ * ------------
+ *  0 - Success
+ * -1 - Error in a product with A or in a LAPACK function
+ * -3 - The triplets did not converge within maxMatvecs products
+ *
+ ******************************************************************************/
+
+TEMPLATE_PLEASE
+int bidiag_Sprimme(REAL *svals, SCALAR *svecs, REAL *resNorms,
+      SCALAR *rwork, size_t *rworkSize, primme_svds_params *primme_svds) {
+
+   primme_params *primme = &primme_svds->primme;
+   const double machEps = MACHINE_EPSILON;
+   PRIMME_INT mLocal = primme_svds->mLocal, nLocal = primme_svds->nLocal;
+   PRIMME_INT numMatvecs = 0, numOuterIterations = 0, numRestarts = 0;
+   int numSvals = primme_svds->numSvals;
+   int nc = primme_svds->numOrthoConst;
+   int p = basis_size(primme_svds);   /* Maximum basis size */
+   int nb;                   /* Number of columns of U and B; V has nb+1 */
+   int k;                    /* Number of vectors kept when restarting */
+   int numConv=0;            /* Number of wanted triplets converged */
+   int done;                 /* Whether to return */
+   int i, j, info, ierr=0, one=1, notrans=0, trans=1;
+   SCALAR *V;                /* Right basis, nLocal x (p+1) */
+   SCALAR *U;                /* Left basis, mLocal x p */
+   SCALAR *B;                /* U'*A*V, p x p upper triangular */
+   SCALAR *C;                /* Coefficients from ortho of V, (p+1)x(p+1) */
+   SCALAR *H, *hU, *hVt;     /* gesvd input and left and right vectors */
+   SCALAR *Vc;               /* Copy of the right constraint vectors */
+   SCALAR *Uc = svecs;       /* Left constraint vectors */
+   SCALAR *work;             /* Workspace for ortho, gesvd and update_VWXR */
+   REAL *hSVals, *hResNorms; /* Singular values of B and residual norms */
+   REAL beta=0.0;            /* Norm of v_nb before normalization */
+   double aNorm=0.0;         /* Estimation of the largest singular value */
+   size_t lwork=0;
+   int lgesvd;
+   double t0 = primme_get_wtime();
+
+   /* ----------------------------------------------------- */
+   /* Return the workspace: the bases, the small matrices   */
+   /* and the largest workspace of ortho, gesvd and update  */
+   /* ----------------------------------------------------- */
+
+   {
+      SCALAR w0;
+      CHKERRS(ortho_Sprimme(NULL, 0, NULL, 0, 0, p, NULL, 0, nc, 0, NULL,
+               machEps, NULL, &lwork, primme), -1);
+#ifdef USE_COMPLEX
+      /* zgesvd requires 5*p REALs of rwork; booked 3*p SCALARs */
+      CHKERRS((Num_gesvd_Sprimme("S", "S", p, p, NULL, p, NULL, NULL, p,
+                  NULL, p, &w0, -1, NULL, &info), info), -1);
+      lgesvd = (int)REAL_PART(w0) + 3*p;
+#else
+      CHKERRS((Num_gesvd_Sprimme("S", "S", p, p, NULL, p, NULL, NULL, p,
+                  NULL, p, &w0, -1, &info), info), -1);
+      lgesvd = (int)REAL_PART(w0);
+#endif
+      lwork = max(lwork, (size_t)lgesvd);
+      lwork = max(lwork, (size_t)Num_update_VWXR_Sprimme(NULL, NULL, NULL,
+               max(mLocal, nLocal), p, 0, NULL, p, 0, NULL,
+               NULL, 0, 0, 0, NULL, 0, 0, 0, NULL, 0, 0, 0,
+               NULL, 0, 0, 0, NULL, 0, 0, 0, NULL,
+               NULL, 0, 0, NULL, 0, NULL, 0, NULL, 0, primme));
+   }
+
+   if (svecs == NULL) {
+      *rworkSize = max(*rworkSize, (size_t)nLocal*(p+1) + (size_t)mLocal*p
+            + (size_t)4*p*p + (size_t)(p+1)*(p+1) + 2*p + (size_t)nLocal*nc
+            + lwork);
+      return 0;
+   }
+
+   V = rwork;
+   U = V + nLocal*(p+1);
+   B = U + mLocal*p;
+   C = B + p*p;
+   H = C + (p+1)*(p+1);
+   hU = H + p*p;
+   hVt = hU + p*p;
+   hSVals = (REAL*)(hVt + p*p);
+   hResNorms = (REAL*)((SCALAR*)hSVals + p);
+   Vc = (SCALAR*)hResNorms + p;
+   work = Vc + nLocal*nc;
+   assert(*rworkSize >= (size_t)(work - rwork) + lwork);
+
+   /* ----------------------------------------------------- */
+   /* Reset random number seed if inappropriate for DLARENV */
+   /* ----------------------------------------------------- */
+
+   if (primme_svds->iseed[0]<0 || primme_svds->iseed[0]>4095)
+      primme_svds->iseed[0] = primme_svds->procID % 4096;
+   if (primme_svds->iseed[1]<0 || primme_svds->iseed[1]>4095)
+      primme_svds->iseed[1] = (int)(primme_svds->procID/4096+1) % 4096;
+   if (primme_svds->iseed[2]<0 || primme_svds->iseed[2]>4095)
+      primme_svds->iseed[2] = (int)((primme_svds->procID/4096)/4096+2) % 4096;
+   if (primme_svds->iseed[3]<0 || primme_svds->iseed[3]>4095)
+      primme_svds->iseed[3] =
+         (2*(int)(((primme_svds->procID/4096)/4096)/4096)+1) % 4096;
+
+   /* The global sums in ortho reach primme_svds through primme->matrix */
+
+   primme->matrix = primme_svds;
+
+   /* ---------------------------------------------------------------- */
+   /* Copy Vc, which is overwritten by the returned left vectors, and  */
+   /* start with the sum of the right initial guesses or a random one  */
+   /* ---------------------------------------------------------------- */
+
+   Num_copy_matrix_Sprimme(&svecs[mLocal*(nc+primme_svds->initSize)], nLocal,
+         nc, nLocal, Vc, nLocal);
+   if (primme_svds->initSize > 0) {
+      SCALAR *V0 = &svecs[mLocal*(nc+primme_svds->initSize) + nLocal*nc];
+      Num_copy_Sprimme(nLocal, V0, 1, V, 1);
+      for (i=1; i<primme_svds->initSize; i++) {
+         Num_axpy_Sprimme(nLocal, 1.0, &V0[nLocal*i], 1, V, 1);
+      }
+   }
+   else {
+      Num_larnv_Sprimme(2, primme_svds->iseed, nLocal, V);
+   }
+   CHKERRS(ortho_Sprimme(V, nLocal, NULL, 0, 0, 0, Vc, nLocal, nc, nLocal,
+            primme_svds->iseed, machEps, work, &lwork, primme), -1);
+   Num_zero_matrix_Sprimme(B, p, p, p);
+
+   nb = 0;
+   while (1) {
+
+      /* ------------------------------------------------------------- */
+      /* Extend the bidiagonalization up to p steps, or until the next */
+      /* step exceeds maxMatvecs                                       */
+      /* ------------------------------------------------------------- */
+
+      for (; nb < p && numMatvecs + 2 <= primme_svds->maxMatvecs; nb++) {
+         j = nb;
+
+         /* u_j = A*v_j orthogonalized against Uc and U(:,0:j-1); the  */
+         /* coefficients are the column j of B. If A*v_j is in the span */
+         /* of U, continue with a random direction.                     */
+
+         CHKERRMS((primme_svds->matrixMatvec(&V[nLocal*j], &nLocal,
+                     &U[mLocal*j], &mLocal, &one, &notrans, primme_svds,
+                     &ierr), ierr), -1,
+               "Error returned by 'matrixMatvec' %d", ierr);
+         CHKERRS(ortho_Sprimme(U, mLocal, B, p, j, j, Uc, mLocal, nc, mLocal,
+                  primme_svds->iseed, machEps, work, &lwork, primme), -1);
+         if (B[p*j+j] == 0.0) {
+            CHKERRS(ortho_Sprimme(U, mLocal, NULL, 0, j, j, Uc, mLocal, nc,
+                     mLocal, primme_svds->iseed, machEps, work, &lwork,
+                     primme), -1);
+         }
+
+         /* v_{j+1} = A'*u_j orthogonalized against Vc and V(:,0:j); */
+         /* beta is the norm before normalizing it                    */
+
+         CHKERRMS((primme_svds->matrixMatvec(&U[mLocal*j], &mLocal,
+                     &V[nLocal*(j+1)], &nLocal, &one, &trans, primme_svds,
+                     &ierr), ierr), -1,
+               "Error returned by 'matrixMatvec' %d", ierr);
+         CHKERRS(ortho_Sprimme(V, nLocal, C, p+1, j+1, j+1, Vc, nLocal, nc,
+                  nLocal, primme_svds->iseed, machEps, work, &lwork, primme),
+               -1);
+         beta = REAL_PART(C[(p+1)*(j+1)+j+1]);
+         if (beta == 0.0 && j+1 < p) {
+            CHKERRS(ortho_Sprimme(V, nLocal, NULL, 0, j+1, j+1, Vc, nLocal,
+                     nc, nLocal, primme_svds->iseed, machEps, work, &lwork,
+                     primme), -1);
+         }
+
+         numMatvecs += 2;
+         numOuterIterations++;
+      }
+
+      if (nb == 0) break;
+
+      /* ------------------------------------------------------------ */
+      /* Compute the SVD of B; gesvd returns the singular values in   */
+      /* descending order and the right vectors conjugate transposed  */
+      /* ------------------------------------------------------------ */
+
+      Num_copy_matrix_Sprimme(B, nb, nb, p, H, p);
+#ifdef USE_COMPLEX
+      CHKERRS((Num_gesvd_Sprimme("S", "S", nb, nb, H, p, hSVals, hU, p, hVt,
+                  p, work+3*p, lgesvd-3*p, (REAL*)work, &info), info), -1);
+#else
+      CHKERRS((Num_gesvd_Sprimme("S", "S", nb, nb, H, p, hSVals, hU, p, hVt,
+                  p, work, lgesvd, &info), info), -1);
+#endif
+
+      /* ------------------------------------------------------------ */
+      /* Check the convergence of the wanted triplets: the residual   */
+      /* norm of (s_i, U*x_i, V*y_i) is |beta*x_i(nb-1)|, but it     */
+      /* cannot be smaller than the rounding error in U and V         */
+      /* ------------------------------------------------------------ */
+
+      aNorm = max(aNorm, hSVals[0]);
+      if (primme_svds->aNorm > 0.0) aNorm = primme_svds->aNorm;
+      numConv = 0;
+      for (i=0; i<min(numSvals, nb); i++) {
+         hResNorms[i] = max(fabs(beta)*ABS(hU[p*i+nb-1]),
+               machEps*3.16*aNorm);
+         if (hResNorms[i] <= max(primme_svds->eps*aNorm, machEps*3.16*aNorm))
+            numConv++;
+      }
+
+      if (primme_svds->printLevel >= 3 && primme_svds->procID == 0) {
+         for (i=0; i<min(numSvals, nb); i++) {
+            fprintf(primme_svds->outputFile,
+                  "OUT %" PRIMME_INT_P " conv %d blk %d MV %" PRIMME_INT_P
+                  " Sec %E SV %13E |r| %.3E\n", numOuterIterations, numConv,
+                  i, numMatvecs, primme_get_wtime() - t0, hSVals[i],
+                  hResNorms[i]);
+         }
+      }
+
+      /* Return if the triplets converged or maxMatvecs was reached; */
+      /* otherwise restart with k vectors                            */
+
+      done = numConv >= numSvals || nb < p;
+      k = done ? min(numSvals, nb) :
+         min(p-1, numSvals + (p-numSvals)/2);
+
+      /* Put in H the first k right singular vectors of B */
+
+      for (i=0; i<k; i++) {
+         for (j=0; j<nb; j++) {
+            H[p*i+j] = CONJ(hVt[p*j+i]);
+         }
+      }
+
+      if (done) {
+         /* svecs = [Uc U*X Vc V*Y] */
+         Num_update_VWXR_Sprimme(U, NULL, NULL, mLocal, nb, mLocal, hU, k, p,
+               NULL,
+               &svecs[mLocal*nc], 0, k, mLocal,
+               NULL, 0, 0, 0, NULL, 0, 0, 0, NULL, 0, 0, 0,
+               NULL, 0, 0, 0, NULL, NULL, 0, 0,
+               NULL, 0, NULL, 0, work, (int)lwork, primme);
+         Num_copy_matrix_Sprimme(Vc, nLocal, nc, nLocal,
+               &svecs[mLocal*(nc+k)], nLocal);
+         Num_update_VWXR_Sprimme(V, NULL, NULL, nLocal, nb, nLocal, H, k, p,
+               NULL,
+               &svecs[mLocal*(nc+k)+nLocal*nc], 0, k, nLocal,
+               NULL, 0, 0, 0, NULL, 0, 0, 0, NULL, 0, 0, 0,
+               NULL, 0, 0, 0, NULL, NULL, 0, 0,
+               NULL, 0, NULL, 0, work, (int)lwork, primme);
+         for (i=0; i<k; i++) {
+            svals[i] = hSVals[i];
+            resNorms[i] = hResNorms[i];
+         }
+         break;
+      }
+
+      /* ------------------------------------------------------------ */
+      /* Restart: V(:,0:k-1) = V*Y, U(:,0:k-1) = U*X, v_k = v_nb and  */
+      /* B = diag(s); the next step computes the column k of B        */
+      /* ------------------------------------------------------------ */
+
+      Num_update_VWXR_Sprimme(V, NULL, NULL, nLocal, nb, nLocal, H, k, p,
+            NULL,
+            V, 0, k, nLocal,
+            NULL, 0, 0, 0, NULL, 0, 0, 0, NULL, 0, 0, 0,
+            NULL, 0, 0, 0, NULL, NULL, 0, 0,
+            NULL, 0, NULL, 0, work, (int)lwork, primme);
+      Num_update_VWXR_Sprimme(U, NULL, NULL, mLocal, nb, mLocal, hU, k, p,
+            NULL,
+            U, 0, k, mLocal,
+            NULL, 0, 0, 0, NULL, 0, 0, 0, NULL, 0, 0, 0,
+            NULL, 0, 0, 0, NULL, NULL, 0, 0,
+            NULL, 0, NULL, 0, work, (int)lwork, primme);
+      Num_copy_Sprimme(nLocal, &V[nLocal*nb], 1, &V[nLocal*k], 1);
+      if (beta == 0.0) {
+         CHKERRS(ortho_Sprimme(V, nLocal, NULL, 0, k, k, Vc, nLocal, nc,
+                  nLocal, primme_svds->iseed, machEps, work, &lwork, primme),
+               -1);
+      }
+      Num_zero_matrix_Sprimme(B, p, p, p);
+      for (i=0; i<k; i++) {
+         B[p*i+i] = hSVals[i];
+      }
+      nb = k;
+      numRestarts++;
+   }
+
+   /* Record performance measurements */
+
+   primme_svds->initSize = min(numSvals, nb);
+   if (primme_svds->aNorm <= 0.0) primme_svds->aNorm = aNorm;
+   primme_svds->stats.numOuterIterations += numOuterIterations;
+   primme_svds->stats.numRestarts        += numRestarts;
+   primme_svds->stats.numMatvecs         += numMatvecs;
+   primme_svds->stats.elapsedTime        += primme_get_wtime() - t0;
+
+   return primme_svds->initSize >= numSvals && numConv >= numSvals ?
+      0 : MAIN_ITER_FAILURE;
+}
+
+/*******************************************************************************
+ * Function basis_size - Returns the number of steps of the bidiagonalization
+ *    before restarting: primme_svds.maxBasisSize if it is set, and otherwise
+ *    twice numSvals and at least 15 more than numSvals. It is at most the
+ *    dimension of the space orthogonal to the constraint vectors.
+ *
+ ******************************************************************************/
+
+static int basis_size(primme_svds_params *primme_svds) {
+
+   PRIMME_INT p;
+
+   if (primme_svds->maxBasisSize > 0) {
+      p = primme_svds->maxBasisSize;
+   }
+   else {
+      p = max(2*primme_svds->numSvals, primme_svds->numSvals + 15);
+   }
+   p = max(p, primme_svds->numSvals);
+   p = min(p, min(primme_svds->m, primme_svds->n)
+         - primme_svds->numOrthoConst);
+   return (int)max(p, 1);
+}
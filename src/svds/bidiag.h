@@ -0,0 +1,50 @@
+/*******************************************************************************
+ * Copyright (c) 2016, College of William & Mary
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the College of William & Mary nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COLLEGE OF WILLIAM & MARY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * PRIMME: https://github.com/primme/primme
+ * Contact: Andreas Stathopoulos, a n d r e a s _at_ c s . w m . e d u
+ *******************************************************************************
+ *   NOTE: THIS FILE IS AUTOMATICALLY GENERATED. PLEASE DON'T MODIFY
+ ******************************************************************************/
+
+
+#ifndef bidiag_H
+#define bidiag_H
+#if !defined(CHECK_TEMPLATE) && !defined(bidiag_Sprimme)
+#  define bidiag_Sprimme CONCAT(bidiag_,SCALAR_SUF)
+#endif
+#if !defined(CHECK_TEMPLATE) && !defined(bidiag_Rprimme)
+#  define bidiag_Rprimme CONCAT(bidiag_,REAL_SUF)
+#endif
+int bidiag_dprimme(double *svals, double *svecs, double *resNorms,
+      double *rwork, size_t *rworkSize, primme_svds_params *primme_svds);
+int bidiag_zprimme(double *svals, PRIMME_COMPLEX_DOUBLE *svecs, double *resNorms,
+      PRIMME_COMPLEX_DOUBLE *rwork, size_t *rworkSize, primme_svds_params *primme_svds);
+int bidiag_sprimme(float *svals, float *svecs, float *resNorms,
+      float *rwork, size_t *rworkSize, primme_svds_params *primme_svds);
+int bidiag_cprimme(float *svals, PRIMME_COMPLEX_FLOAT *svecs, float *resNorms,
+      PRIMME_COMPLEX_FLOAT *rwork, size_t *rworkSize, primme_svds_params *primme_svds);
+#endif
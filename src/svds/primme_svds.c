@@ -41,6 +41,7 @@
 #include "numerical.h"
 #include "../eigs/ortho.h"
 #include "wtime.h"
+#include "bidiag.h"
 #include "primme_interface.h"
 #include "primme_svds_interface.h"
 
@@ -142,6 +143,17 @@ int Sprimme_svds(REAL *svals, SCALAR *svecs, REAL *resNorms,
       return ALLOCATE_WORKSPACE_FAILURE;
    }
 
+   /* ------------------------------------------------------------- */
+   /* The bidiagonalization works on A directly, in a single stage  */
+   /* ------------------------------------------------------------- */
+
+   if (primme_svds->method == primme_svds_op_bidiag) {
+      size_t rworkSize = primme_svds->realWorkSize/sizeof(SCALAR);
+      ret = bidiag_Sprimme(svals, svecs, resNorms,
+            (SCALAR*)primme_svds->realWork, &rworkSize, primme_svds);
+      return ret == 0 ? 0 : ret - 100;
+   }
+
    /* --------------- */
    /* Execute stage 1 */
    /* --------------- */
@@ -227,6 +239,7 @@ static SCALAR* copy_last_params_from_svds(primme_svds_params *primme_svds, int s
       case primme_svds_op_augmented:
          primme->aNorm = primme_svds->aNorm;
          break;
+      case primme_svds_op_bidiag:
       case primme_svds_op_none:
          break;
       }
@@ -242,6 +255,7 @@ static SCALAR* copy_last_params_from_svds(primme_svds_params *primme_svds, int s
    case primme_svds_op_augmented:
       primme->convTestFun = convTestFunAugmented;
       break;
+   case primme_svds_op_bidiag:
    case primme_svds_op_none:
       break;
    }
@@ -282,6 +296,7 @@ static SCALAR* copy_last_params_from_svds(primme_svds_params *primme_svds, int s
       Num_scal_Sprimme(primme->nLocal*primme_svds->numOrthoConst, 1./sqrt(2.),
             svecs, 1);
       break;
+   case primme_svds_op_bidiag:
    case primme_svds_op_none:
       break;
    }
@@ -294,7 +309,9 @@ static SCALAR* copy_last_params_from_svds(primme_svds_params *primme_svds, int s
    primme->intWork = primme_svds->intWork;
    primme->intWorkSize = primme_svds->intWorkSize;
    /* If matrixMatvecSVDS is used, it needs extra space to compute A*A' or A'*A */
+   /* unless the user provides the fused product                               */
    if ((primme->matrixMatvec == matrixMatvecSVDS) &&
+       !primme_svds->matrixNormalMatvec &&
        (method == primme_svds_op_AtA || method == primme_svds_op_AAt)) {
       cut = primme->maxBlockSize * (method == primme_svds_op_AtA ?
                      primme_svds->mLocal : primme_svds->nLocal);
@@ -462,14 +479,23 @@ static int allocate_workspace_svds(primme_svds_params *primme_svds, int allocate
    int intWorkSize=0;         /* Size of int work space */
    size_t realWorkSize=0;     /* Size of real work space */
 
+   /* Require workspace for the bidiagonalization */
+   if (primme_svds->method == primme_svds_op_bidiag) {
+      CHKERRS(bidiag_Sprimme(NULL, NULL, NULL, NULL, &realWorkSize,
+               primme_svds), -1);
+      realWorkSize *= sizeof(SCALAR);
+   }
+
    /* Require workspace for 1st stage */
-   if (primme_svds->method != primme_svds_op_none) {
+   else if (primme_svds->method != primme_svds_op_none) {
       primme = primme_svds->primme;
       Sprimme(NULL, NULL, NULL, &primme);
       intWorkSize = primme.intWorkSize;
       realWorkSize = primme.realWorkSize;
       /* If matrixMatvecSVDS is used, it needs extra space to compute A*A' or A'*A */
+      /* unless the user provides the fused product                               */
       if ((primme.matrixMatvec == NULL || primme.matrixMatvec == matrixMatvecSVDS) &&
+          !primme_svds->matrixNormalMatvec &&
           (primme_svds->method == primme_svds_op_AtA || primme_svds->method == primme_svds_op_AAt))
          realWorkSize += primme.maxBlockSize * sizeof(SCALAR) *
                            (primme_svds->method == primme_svds_op_AtA ?
@@ -569,6 +595,7 @@ int copy_last_params_to_svds(primme_svds_params *primme_svds, int stage,
       case primme_svds_op_augmented:
          primme_svds->aNorm = primme->aNorm;
          break;
+      case primme_svds_op_bidiag:
       case primme_svds_op_none:
          break;
       }
@@ -653,6 +680,7 @@ int copy_last_params_to_svds(primme_svds_params *primme_svds, int stage,
       }
       free(norms2_);
       break;
+   case primme_svds_op_bidiag:
    case primme_svds_op_none:
       break;
    }
@@ -686,6 +714,7 @@ int copy_last_params_to_svds(primme_svds_params *primme_svds, int stage,
             rnorms[i] *= sqrt(2.0);
          }
          break;
+      case primme_svds_op_bidiag:
       case primme_svds_op_none:
          break;
       }
@@ -705,7 +734,7 @@ int copy_last_params_to_svds(primme_svds_params *primme_svds, int stage,
  *  primme_svds              the main structure of parameters 
  *
  * return value -   0    If input parameters in primme are appropriate
- *              -4..-19  Inappropriate input parameters were found
+ *              -4..-22  Inappropriate input parameters were found
  *
  ******************************************************************************/
 static int primme_svds_check_input(REAL *svals, SCALAR *svecs, REAL *resNorms, 
@@ -736,9 +765,11 @@ static int primme_svds_check_input(REAL *svals, SCALAR *svecs, REAL *resNorms,
       ret = -13;
    else if ( primme_svds->method != primme_svds_op_AtA &&
              primme_svds->method != primme_svds_op_AAt &&
-             primme_svds->method != primme_svds_op_augmented)
+             primme_svds->method != primme_svds_op_augmented &&
+             primme_svds->method != primme_svds_op_bidiag)
       ret = -14;
-   else if ( (primme_svds->method == primme_svds_op_augmented &&
+   else if ( ((primme_svds->method == primme_svds_op_augmented ||
+               primme_svds->method == primme_svds_op_bidiag) &&
               primme_svds->methodStage2 != primme_svds_op_none) ||
              (primme_svds->method != primme_svds_op_augmented &&
               primme_svds->methodStage2 != primme_svds_op_augmented &&
@@ -753,6 +784,9 @@ static int primme_svds_check_input(REAL *svals, SCALAR *svecs, REAL *resNorms,
    else if (resNorms == NULL)
       ret = -19;
    /* Booked -20 and -21*/
+   else if (primme_svds->method == primme_svds_op_bidiag &&
+            primme_svds->target != primme_svds_largest)
+      ret = -22;
 
    return ret;
    /***************************************************************************/
@@ -772,6 +806,16 @@ static void matrixMatvecSVDS(void *x_, PRIMME_INT *ldx, void *y_,
       primme_svds->method : primme_svds->methodStage2;
    int i, bs;
 
+   /* The fused product needs no workspace, so it applies the whole block */
+
+   if (primme_svds->matrixNormalMatvec &&
+       (method == primme_svds_op_AtA || method == primme_svds_op_AAt)) {
+      primme_svds->matrixNormalMatvec(x, ldx, y, ldy, blockSize,
+            method == primme_svds_op_AtA ? &notrans : &trans, primme_svds,
+            ierr);
+      return;
+   }
+
    switch(method) {
    case primme_svds_op_AtA:
       for (i=0, bs=min((*blockSize-i), primme->maxBlockSize); bs>0;
@@ -805,6 +849,7 @@ static void matrixMatvecSVDS(void *x_, PRIMME_INT *ldx, void *y_,
          ldy, blockSize, &notrans, primme_svds, ierr);
          if (*ierr != 0) return;
       break;
+   case primme_svds_op_bidiag:
    case primme_svds_op_none:
       break;
    }
@@ -215,6 +215,9 @@ void AS_FORTRAN(primme_svds_set_member)(primme_svds_params **primme_svds_, int *
       case PRIMMEF77_SVDS_stats_elapsedTime :
          primme_svds->stats.elapsedTime = *v.double_v;
          break;
+      case PRIMMEF77_SVDS_matrixNormalMatvec :
+         primme_svds->matrixNormalMatvec = v.matFunc_v;
+         break;
       default:
          *ierr = 1;
    }
@@ -354,6 +357,9 @@ void AS_FORTRAN(primme_svdstop_get_member)(primme_svds_params **primme_svds_, in
       case PRIMMEF77_SVDS_stats_elapsedTime :
          v->double_v = primme_svds->stats.elapsedTime;
          break;
+      case PRIMMEF77_SVDS_matrixNormalMatvec :
+         v->matFunc_v = primme_svds->matrixNormalMatvec;
+         break;
       default:
          *ierr = 1;
    }
@@ -90,6 +90,7 @@
 #define PRIMMEF77_SVDS_stats_numMatvecs 38
 #define PRIMMEF77_SVDS_stats_numPreconds 39
 #define PRIMMEF77_SVDS_stats_elapsedTime 40
+#define PRIMMEF77_SVDS_matrixNormalMatvec 41
 
 /*-------------------------------------------------------*/
 /*    Defining easy to remember labels for setting the   */
@@ -83,6 +83,7 @@ void primme_svds_initialize(primme_svds_params *primme_svds) {
    /* Matvec and preconditioner */
    primme_svds->matrixMatvec            = NULL;
    primme_svds->applyPreconditioner     = NULL;
+   primme_svds->matrixNormalMatvec      = NULL;
 
    /* Other important parameters users may set */
    primme_svds->aNorm                   = 0.0L;
@@ -138,6 +139,10 @@ int primme_svds_set_method(primme_svds_preset_method method,
       primme_svds->method = primme_svds_op_augmented;
       primme_svds->methodStage2 = primme_svds_op_none;
       break;
+   case primme_svds_bidiag:
+      primme_svds->method = primme_svds_op_bidiag;
+      primme_svds->methodStage2 = primme_svds_op_none;
+      break;
    }
 
    /* Setup underneath eigensolvers based on primme_svds configuration */
@@ -204,6 +209,7 @@ static void copy_params_from_svds(primme_svds_params *primme_svds, int stage) {
       case primme_svds_op_augmented:
          primme->aNorm = primme_svds->aNorm*sqrt(2.0);
          break;
+      case primme_svds_op_bidiag:
       case primme_svds_op_none:
          break;
       }
@@ -242,6 +248,11 @@ static void copy_params_from_svds(primme_svds_params *primme_svds, int stage) {
       primme->n = primme_svds->m + primme_svds->n;
       primme->nLocal = primme_svds->mLocal + primme_svds->nLocal;
       break;
+   case primme_svds_op_bidiag:
+      /* primme only carries the options for ortho */
+      primme->n = primme_svds->n;
+      primme->nLocal = primme_svds->nLocal;
+      break;
    case primme_svds_op_none:
       break;
    }
@@ -360,13 +371,16 @@ fprintf(outputFile, "// ---------------------------------------------------\n"
    PRINTIF(method, primme_svds_op_AtA);
    PRINTIF(method, primme_svds_op_AAt);
    PRINTIF(method, primme_svds_op_augmented);
+   PRINTIF(method, primme_svds_op_bidiag);
 
    PRINTIF(methodStage2, primme_svds_op_none);
    PRINTIF(methodStage2, primme_svds_op_AtA);
    PRINTIF(methodStage2, primme_svds_op_AAt);
    PRINTIF(methodStage2, primme_svds_op_augmented);
+   PRINTIF(methodStage2, primme_svds_op_bidiag);
 
-   if (primme_svds.method != primme_svds_op_none) {
+   if (primme_svds.method != primme_svds_op_none &&
+       primme_svds.method != primme_svds_op_bidiag) {
       fprintf(outputFile, "\n"
                           "// ---------------------------------------------------\n"
                           "//            1st stage primme configuration          \n"
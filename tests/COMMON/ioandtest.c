@@ -64,7 +64,7 @@ int check_solution(const char *checkXFileName, primme_params *primme, double *ev
                    SCALAR *evecs, double *rnorms, int *perm, int checkInterface) {
 
    double eval0, rnorm0, prod, bound, delta;
-   SCALAR *Ax, *r, *X=NULL, *h, *h0;
+   SCALAR *Ax, *Bx, *x, *r, *X=NULL, *h, *h0;
    int i, j, cols, retX=0, one=1, ierr=0;
    primme_params primme0;
 
@@ -125,6 +125,8 @@ int check_solution(const char *checkXFileName, primme_params *primme, double *ev
    h = (SCALAR *)primme_calloc(i*2, sizeof(SCALAR), "h"); h0 = &h[i];
    Ax = (SCALAR *)primme_calloc(primme->nLocal, sizeof(SCALAR), "Ax");
    r = (SCALAR *)primme_calloc(primme->nLocal, sizeof(SCALAR), "r");
+   Bx = primme->massMatrixMatvec ?
+      (SCALAR *)primme_calloc(primme->nLocal, sizeof(SCALAR), "Bx") : NULL;
 
    /* Estimate the separation between eigenvalues */
    delta = primme->aNorm > 0.0 ? primme->aNorm : HUGE_VAL;
@@ -133,8 +135,15 @@ int check_solution(const char *checkXFileName, primme_params *primme, double *ev
    }
 
    for (i=0; i < primme->initSize; i++) {
-      /* Check |V(:,0:i-1)'V(:,i)| < sqrt(machEps) */
-      Num_gemv_Sprimme("C", primme->nLocal, i+1, 1.0, evecs, primme->nLocal, &evecs[primme->nLocal*i], 1, 0., h, 1);
+      /* In the generalized problem the inner products are in the B-norm */
+      x = &evecs[primme->nLocal*i];
+      if (Bx) {
+         primme->massMatrixMatvec(x, &primme->nLocal, Bx, &primme->nLocal, &one, primme, &ierr);
+         x = Bx;
+      }
+
+      /* Check |V(:,0:i-1)'B*V(:,i)| < sqrt(machEps) */
+      Num_gemv_Sprimme("C", primme->nLocal, i+1, 1.0, evecs, primme->nLocal, x, 1, 0., h, 1);
       if (primme->globalSumReal) {
          int cols0 = (i+1)*sizeof(SCALAR)/sizeof(double);
          primme->globalSumReal(h, h0, &cols0, primme, &ierr);
@@ -158,8 +167,8 @@ int check_solution(const char *checkXFileName, primme_params *primme, double *ev
          fprintf(stderr, "Warning: Eval[%d] = %-22.15E should be close to %-22.15E\n", i+1, evals[i], eval0);
          retX = 1;
       }
-      /* Check |A*V(:,i) - (V(:,i)'A*V(:,i))*V(:,i)| < |r| */
-      for (j=0; j<primme->nLocal; j++) r[j] = Ax[j] - evals[i]*evecs[primme->nLocal*i+j];
+      /* Check |A*V(:,i) - (V(:,i)'A*V(:,i))*B*V(:,i)| < |r| */
+      for (j=0; j<primme->nLocal; j++) r[j] = Ax[j] - evals[i]*x[j];
       rnorm0 = sqrt(primme_dot_real(r, r, primme));
       if (fabs(rnorms[i]-rnorm0) > max(0.1*rnorm0, 10*max(primme->aNorm,fabs(evals[i]))*MACHINE_EPSILON) && primme->procID == 0) {
          fprintf(stderr, "Warning: Eval[%d] = %-22.15E, residual %5E should be close to %5E\n", i+1, evals[i], rnorms[i], rnorm0);
@@ -170,7 +179,7 @@ int check_solution(const char *checkXFileName, primme_params *primme, double *ev
          retX = 1;
       }
       /* Check angle X and V(:,i) is less than twice the max angle of the eigenvector with largest residual  */
-      Num_gemv_Sprimme("C", primme->nLocal, cols, 1.0, X, primme->nLocal, &evecs[primme->nLocal*i], 1, 0., h, 1);
+      Num_gemv_Sprimme("C", primme->nLocal, cols, 1.0, X, primme->nLocal, x, 1, 0., h, 1);
       if (primme->globalSumReal) {
          int cols0 = cols*sizeof(SCALAR)/sizeof(double);
          primme->globalSumReal(h, h0, &cols0, primme, &ierr);
@@ -187,6 +196,7 @@ int check_solution(const char *checkXFileName, primme_params *primme, double *ev
    free(X);
    free(r);
    free(Ax);
+   if (Bx) free(Bx);
 
    return retX; 
 }
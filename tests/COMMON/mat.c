@@ -41,14 +41,10 @@ extern "C" {
 #endif
 
 #ifndef USE_DOUBLECOMPLEX
-void FORTRAN_FUNCTION(amux)(int*, double*, double*, double*, int*, int*);
-void FORTRAN_FUNCTION(atmuxr)(int*, int*, double*, double*, double*, int*, int*);
 void FORTRAN_FUNCTION(ilut)(int*, double*, int*, int*, int*, double*, double*, int*, int*, int*,
                             double*, double*, int*, int*, int*, int*);
 void FORTRAN_FUNCTION(lusol0)(int*, double*, double*, double*, int*, int*);
 #else
-void FORTRAN_FUNCTION(zamux)(int*, SCALAR*, SCALAR*, SCALAR*, int*, int*);
-void FORTRAN_FUNCTION(zatmuxr)(int*, int*, SCALAR*, SCALAR*, SCALAR*, int*, int*);
 void FORTRAN_FUNCTION(zilut)(int*, SCALAR*, int*, int*, int*, double*, SCALAR*, int*, int*, int*,
                              SCALAR*, int*, int*);
 void FORTRAN_FUNCTION(zlusol)(int*, SCALAR*, SCALAR*, SCALAR*, int*, int*);
@@ -58,74 +54,6 @@ void FORTRAN_FUNCTION(zlusol)(int*, SCALAR*, SCALAR*, SCALAR*, int*, int*);
 }
 #endif
 
-/******************************************************************************
- * Applies the matrix vector multiplication on a block of vectors.
- * Because a block function is not available, we call blockSize times
- * the SPARSKIT function amux(). Note the (void *) parameters x, y that must 
- * be cast as doubles for use in amux()
- *
-******************************************************************************/
-void CSRMatrixMatvec(void *x, PRIMME_INT *ldx, void *y, PRIMME_INT *ldy, int *blockSize, primme_params *primme, int *ierr) {
-   
-   int i;
-   int n = (int)primme->n;
-   SCALAR *xvec, *yvec;
-   CSRMatrix *matrix;
-   
-   matrix = (CSRMatrix *)primme->matrix;
-   xvec = (SCALAR *)x;
-   yvec = (SCALAR *)y;
-
-   for (i=0;i<*blockSize;i++) {
-#ifndef USE_DOUBLECOMPLEX
-      FORTRAN_FUNCTION(amux)
-#else
-      FORTRAN_FUNCTION(zamux)
-#endif
-            (&n, &xvec[*ldx*i], &yvec[*ldy*i], 
-             matrix->AElts, matrix->JA, matrix->IA);
-   }
-   *ierr = 0;
-}
-
-void CSRMatrixMatvecSVD(void *x, PRIMME_INT *ldx, void *y, PRIMME_INT *ldy,
-      int *blockSize, int *trans, primme_svds_params *primme_svds, int *ierr) {
-   
-   int i;
-   int m = (int)primme_svds->m;
-   int n = (int)primme_svds->n;
-   SCALAR *xvec, *yvec;
-   CSRMatrix *matrix;
-   
-   matrix = (CSRMatrix *)primme_svds->matrix;
-   xvec = (SCALAR *)x;
-   yvec = (SCALAR *)y;
-
-   if (*trans == 0) {
-      for (i=0;i<*blockSize;i++) {
-#ifndef USE_DOUBLECOMPLEX
-         FORTRAN_FUNCTION(amux)
-#else
-         FORTRAN_FUNCTION(zamux)
-#endif
-              (&m, &xvec[(*ldx)*i], &yvec[(*ldy)*i], 
-               matrix->AElts, matrix->JA, matrix->IA);
-      }
-   } else {
-      for (i=0;i<*blockSize;i++) {
-#ifndef USE_DOUBLECOMPLEX
-         FORTRAN_FUNCTION(atmuxr)
-#else
-         FORTRAN_FUNCTION(zatmuxr)
-#endif
-           (&n, &m, &xvec[(*ldx)*i], 
-            &yvec[(*ldy)*i], matrix->AElts, matrix->JA, matrix->IA);
-      }
-   }
-   *ierr = 0;
-}
-
-
 /******************************************************************************
  * Applies the (already inverted) diagonal preconditioner
  *
@@ -30,9 +30,9 @@
 #define NATIVE_H
 
 #include "csr.h"
+#include "spmm.h"
 #include "primme_svds.h"
 
-void CSRMatrixMatvec(void *x, PRIMME_INT *ldx, void *y, PRIMME_INT *ldy, int *blockSize, primme_params *primme, int *ierr);
 int createInvDiagPrecNative(const CSRMatrix *matrix, double shift, double **prec);
 void ApplyInvDiagPrecNative(void *x, PRIMME_INT *ldx, void *y, PRIMME_INT *ldy, int *blockSize, 
                                         primme_params *primme, int *ierr);
@@ -41,8 +41,6 @@ void ApplyInvDavidsonDiagPrecNative(void *x, PRIMME_INT *ldx, void *y, PRIMME_IN
 int createILUTPrecNative(const CSRMatrix *matrix, double shift, int level,
                          double threshold, double filter, CSRMatrix **prec);
 void ApplyILUTPrecNative(void *x, PRIMME_INT *ldx, void *y, PRIMME_INT *ldy, int *blockSize, primme_params *primme, int *ierr);
-void CSRMatrixMatvecSVD(void *x, PRIMME_INT *ldx, void *y, PRIMME_INT *ldy,
-      int *blockSize, int *trans, primme_svds_params *primme_svds, int *ierr);
 int createInvNormalPrecNative(const CSRMatrix *matrix, double shift, double **prec);
 void ApplyInvNormalPrecNative(void *x, PRIMME_INT *ldx, void *y,
       PRIMME_INT *ldy, int *blockSize, int *mode,
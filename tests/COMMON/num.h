@@ -41,6 +41,8 @@
 #  define IMAGINARY 0.0
 #endif
 #define Sprimme CONCAT(SCALAR_PRE,primme)
+#define Sprimme_slicing CONCAT(SCALAR_PRE,primme_slicing)
+#define Sprimme_batch CONCAT(SCALAR_PRE,primme_batch)
 #define Sprimme_svds CONCAT(SCALAR_PRE,primme_svds)
 #if !(defined (__APPLE__) && defined (__MACH__))
 #  include <malloc.h> /* malloc */
@@ -162,6 +162,13 @@ int read_solver_params(char *configFileName, char *outputFileName,
             OPTION(initBasisMode, primme_init_user)
          );
 
+         READ_FIELD_OP(orth,
+            OPTION(orth, primme_orth_default)
+            OPTION(orth, primme_orth_column)
+            OPTION(orth, primme_orth_block)
+            OPTION(orth, primme_orth_pipelined)
+         );
+
          READ_FIELD(numTargetShifts, "%d");
          if (strcmp(field, "targetShifts") == 0) {
             ret = 1;
@@ -181,9 +188,32 @@ int read_solver_params(char *configFileName, char *outputFileName,
          }
  
          READ_FIELD(dynamicMethodSwitch, "%d");
+         READ_FIELD(dynamicBlockSize, "%d");
          READ_FIELD(locking, "%d");
          READ_FIELD(initSize, "%d");
          READ_FIELD(numOrthoConst, "%d");
+         READ_FIELD(cacheBlockSize, "%d");
+         READ_FIELD(mixedPrecision, "%d");
+         READ_FIELD(checkpointInterval, "%d");
+         READ_FIELD(checkpointResume, "%d");
+         if (strcmp(field, "checkpointFile") == 0) {
+            ret = fscanf(configFile, "%s", stringValue);
+            if (ret == 1) {
+               char *fileName = (char *)primme_calloc(strlen(stringValue)+1,
+                     sizeof(char), "checkpointFile");
+               strcpy(fileName, stringValue);
+               primme->checkpointFile = fileName;
+            }
+         }
+         if (strcmp(field, "outOfCoreDir") == 0) {
+            ret = fscanf(configFile, "%s", stringValue);
+            if (ret == 1) {
+               char *dirName = (char *)primme_calloc(strlen(stringValue)+1,
+                     sizeof(char), "outOfCoreDir");
+               strcpy(dirName, stringValue);
+               primme->outOfCoreDir = dirName;
+            }
+         }
 
          if (strcmp(field, "iseed") == 0) {
             ret = 1;
@@ -209,6 +239,8 @@ int read_solver_params(char *configFileName, char *outputFileName,
          READ_FIELDParams(correction, robustShifts, "%d");
          READ_FIELDParams(correction, maxInnerIterations, "%d");
          READ_FIELDParams(correction, relTolBase, "%lf");
+         READ_FIELDParams(correction, fuseGlobalSums, "%d");
+         READ_FIELDParams(correction, filterDegree, "%d");
 
          READ_FIELD_OPParams(correction, convTest,
             OPTIONParams(correction, convTest, primme_full_LTolerance)
@@ -326,6 +358,24 @@ int read_driver_params(char *configFileName, driver_params *driver) {
          else if (strcmp(ident, "driver.matrixFile") == 0) {
             ret = fscanf(configFile, "%s", driver->matrixFileName);
          }
+         else if (strcmp(ident, "driver.massMatrixFile") == 0) {
+            ret = fscanf(configFile, "%s", driver->massMatrixFileName);
+         }
+         else if (strcmp(ident, "driver.checkpointInterrupt") == 0) {
+            ret = fscanf(configFile, "%d", &driver->checkpointInterrupt);
+         }
+         else if (strcmp(ident, "driver.numSlices") == 0) {
+            ret = fscanf(configFile, "%d", &driver->numSlices);
+         }
+         else if (strcmp(ident, "driver.slicingLower") == 0) {
+            ret = fscanf(configFile, "%le", &driver->slicingLower);
+         }
+         else if (strcmp(ident, "driver.slicingUpper") == 0) {
+            ret = fscanf(configFile, "%le", &driver->slicingUpper);
+         }
+         else if (strcmp(ident, "driver.traceFile") == 0) {
+            ret = fscanf(configFile, "%s", driver->traceFileName);
+         }
          else if (strcmp(ident, "driver.initialGuessesFile") == 0) {
             ret = fscanf(configFile, "%s", driver->initialGuessesFileName);
          }
@@ -399,6 +449,15 @@ int read_driver_params(char *configFileName, driver_params *driver) {
          else if (strcmp(ident, "driver.isymm") == 0) {
             ret = fscanf(configFile, "%d", &driver->isymm);
          }
+         else if (strcmp(ident, "driver.sellChunkSize") == 0) {
+            ret = fscanf(configFile, "%d", &driver->sellChunkSize);
+         }
+         else if (strcmp(ident, "driver.sellSigma") == 0) {
+            ret = fscanf(configFile, "%d", &driver->sellSigma);
+         }
+         else if (strcmp(ident, "driver.normalMatvec") == 0) {
+            ret = fscanf(configFile, "%d", &driver->normalMatvec);
+         }
          else if (strcmp(ident, "driver.level") == 0) {
             ret = fscanf(configFile, "%d", &driver->level);
          }
@@ -449,12 +508,21 @@ fprintf(outputFile, "// ---------------------------------------------------\n"
 fprintf(outputFile, "driver.partId        = %s\n", driver.partId);
 fprintf(outputFile, "driver.partDir       = %s\n", driver.partDir);
 fprintf(outputFile, "driver.matrixFile    = %s\n", driver.matrixFileName);
+fprintf(outputFile, "driver.massMatrixFile = %s\n", driver.massMatrixFileName);
 fprintf(outputFile, "driver.matrixChoice  = %s\n", strMatrixChoice[driver.matrixChoice]);
+fprintf(outputFile, "driver.sellChunkSize = %d\n", driver.sellChunkSize);
+fprintf(outputFile, "driver.sellSigma     = %d\n", driver.sellSigma);
+fprintf(outputFile, "driver.normalMatvec  = %d\n", driver.normalMatvec);
 fprintf(outputFile, "driver.initialGuessesFile = %s\n", driver.initialGuessesFileName);
 fprintf(outputFile, "driver.initialGuessesPert = %e\n", driver.initialGuessesPert);
 fprintf(outputFile, "driver.saveXFile     = %s\n", driver.saveXFileName);
 fprintf(outputFile, "driver.checkXFile    = %s\n", driver.checkXFileName);
 fprintf(outputFile, "driver.checkInterface = %d\n", driver.checkInterface);
+fprintf(outputFile, "driver.checkpointInterrupt = %d\n", driver.checkpointInterrupt);
+fprintf(outputFile, "driver.numSlices     = %d\n", driver.numSlices);
+fprintf(outputFile, "driver.slicingLower  = %e\n", driver.slicingLower);
+fprintf(outputFile, "driver.slicingUpper  = %e\n", driver.slicingUpper);
+fprintf(outputFile, "driver.traceFile     = %s\n", driver.traceFileName);
 fprintf(outputFile, "driver.PrecChoice    = %s\n", strPrecChoice[driver.PrecChoice]);
 fprintf(outputFile, "driver.shift         = %e\n", driver.shift);
 fprintf(outputFile, "driver.isymm         = %d\n", driver.isymm);
@@ -494,7 +562,8 @@ void driver_display_methodsvd(primme_svds_preset_method method, const char* meth
       "primme_svds_default",
       "primme_svds_hybrid",
       "primme_svds_normalequations",
-      "primme_svds_augmented"};
+      "primme_svds_augmented",
+      "primme_svds_bidiag"};
 
    fprintf(outputFile, "%s               = %s\n", methodstr, strMethod[method]);
 
@@ -547,6 +616,7 @@ int read_solver_params_svds(char *configFileName, char *outputFileName,
                READ_METHOD(primme_svds_hybrid);
                READ_METHOD(primme_svds_normalequations);
                READ_METHOD(primme_svds_augmented);
+               READ_METHOD(primme_svds_bidiag);
                #undef READ_METHOD
             }
             if (ret == 0) {
@@ -630,6 +700,7 @@ int read_solver_params_svds(char *configFileName, char *outputFileName,
             OPTION(method, primme_svds_op_AtA)
             OPTION(method, primme_svds_op_AAt)
             OPTION(method, primme_svds_op_augmented)
+            OPTION(method, primme_svds_op_bidiag)
          );
 
          READ_FIELD_OP(methodStage2,
@@ -705,11 +776,19 @@ void broadCast(primme_params *primme, primme_preset_method *method,
    if (driver) {
       MPI_Bcast(driver->outputFileName, 512, MPI_CHAR, 0, comm);
       MPI_Bcast(driver->matrixFileName, 1024, MPI_CHAR, 0, comm);
+      MPI_Bcast(driver->massMatrixFileName, 1024, MPI_CHAR, 0, comm);
       MPI_Bcast(driver->initialGuessesFileName, 1024, MPI_CHAR, 0, comm);
       MPI_Bcast(driver->saveXFileName, 1024, MPI_CHAR, 0, comm);
       MPI_Bcast(driver->checkXFileName, 1024, MPI_CHAR, 0, comm);
       MPI_Bcast(&driver->initialGuessesPert, 1, MPI_DOUBLE, 0, comm);
       MPI_Bcast(&driver->matrixChoice, 1, MPI_INT, 0, comm);
+      MPI_Bcast(&driver->sellChunkSize, 1, MPI_INT, 0, comm);
+      MPI_Bcast(&driver->checkpointInterrupt, 1, MPI_INT, 0, comm);
+      MPI_Bcast(&driver->numSlices, 1, MPI_INT, 0, comm);
+      MPI_Bcast(&driver->slicingLower, 1, MPI_DOUBLE, 0, comm);
+      MPI_Bcast(&driver->slicingUpper, 1, MPI_DOUBLE, 0, comm);
+      MPI_Bcast(driver->traceFileName, 1024, MPI_CHAR, 0, comm);
+      MPI_Bcast(&driver->sellSigma, 1, MPI_INT, 0, comm);
       MPI_Bcast(&driver->PrecChoice, 1, MPI_INT, 0, comm);
       MPI_Bcast(&driver->isymm, 1, MPI_INT, 0, comm);
       MPI_Bcast(&driver->level, 1, MPI_INT, 0, comm);
@@ -731,6 +810,7 @@ void broadCast(primme_params *primme, primme_preset_method *method,
 
    MPI_Bcast(&(primme->locking), 1, MPI_INT, 0, comm);
    MPI_Bcast(&(primme->dynamicMethodSwitch), 1, MPI_INT, 0, comm);
+   MPI_Bcast(&(primme->dynamicBlockSize), 1, MPI_INT, 0, comm);
    MPI_Bcast(&(primme->initSize), 1, MPI_INT, 0, comm);
    MPI_Bcast(&(primme->numOrthoConst), 1, MPI_INT, 0, comm);
    MPI_Bcast(&(primme->maxBasisSize), 1, MPI_INT, 0, comm);
@@ -742,6 +822,27 @@ void broadCast(primme_params *primme, primme_preset_method *method,
    MPI_Bcast(&(primme->eps), 1, MPI_DOUBLE, 0, comm);
    MPI_Bcast(&(primme->printLevel), 1, MPI_INT, 0, comm);
    MPI_Bcast(&(primme->initBasisMode), 1, MPI_INT, 0, comm);
+   MPI_Bcast(&(primme->orth), 1, MPI_INT, 0, comm);
+   MPI_Bcast(&(primme->cacheBlockSize), 1, MPI_INT, 0, comm);
+   MPI_Bcast(&(primme->mixedPrecision), 1, MPI_INT, 0, comm);
+   MPI_Bcast(&(primme->checkpointInterval), 1, MPI_INT, 0, comm);
+   MPI_Bcast(&(primme->checkpointResume), 1, MPI_INT, 0, comm);
+   i = primme->checkpointFile ? (int)strlen(primme->checkpointFile)+1 : 0;
+   MPI_Bcast(&i, 1, MPI_INT, 0, comm);
+   if (i > 0) {
+      char *fileName = master ? (char *)primme->checkpointFile :
+         (char *)primme_calloc(i, sizeof(char), "checkpointFile");
+      MPI_Bcast(fileName, i, MPI_CHAR, 0, comm);
+      primme->checkpointFile = fileName;
+   }
+   i = primme->outOfCoreDir ? (int)strlen(primme->outOfCoreDir)+1 : 0;
+   MPI_Bcast(&i, 1, MPI_INT, 0, comm);
+   if (i > 0) {
+      char *dirName = master ? (char *)primme->outOfCoreDir :
+         (char *)primme_calloc(i, sizeof(char), "outOfCoreDir");
+      MPI_Bcast(dirName, i, MPI_CHAR, 0, comm);
+      primme->outOfCoreDir = dirName;
+   }
 
    MPI_Bcast(&(primme->projectionParams.projection), 1, MPI_INT, 0, comm);
    MPI_Bcast(&(primme->restartingParams.scheme), 1, MPI_INT, 0, comm);
@@ -752,6 +853,8 @@ void broadCast(primme_params *primme, primme_preset_method *method,
    MPI_Bcast(&(primme->correctionParams.maxInnerIterations),1, MPI_INT, 0,comm);
    MPI_Bcast(&(primme->correctionParams.convTest), 1, MPI_INT, 0, comm);
    MPI_Bcast(&(primme->correctionParams.relTolBase), 1, MPI_DOUBLE, 0, comm);
+   MPI_Bcast(&(primme->correctionParams.fuseGlobalSums), 1, MPI_INT, 0, comm);
+   MPI_Bcast(&(primme->correctionParams.filterDegree), 1, MPI_INT, 0, comm);
    MPI_Bcast(&(primme->correctionParams.projectors.LeftQ),  1, MPI_INT, 0,comm);
    MPI_Bcast(&(primme->correctionParams.projectors.LeftX),  1, MPI_INT, 0,comm);
    MPI_Bcast(&(primme->correctionParams.projectors.RightQ), 1, MPI_INT, 0,comm);
@@ -775,11 +878,15 @@ void broadCast_svds(primme_svds_params *primme_svds, primme_svds_preset_method *
 
    MPI_Bcast(driver->outputFileName, 512, MPI_CHAR, 0, comm);
    MPI_Bcast(driver->matrixFileName, 1024, MPI_CHAR, 0, comm);
+   MPI_Bcast(driver->massMatrixFileName, 1024, MPI_CHAR, 0, comm);
    MPI_Bcast(driver->initialGuessesFileName, 1024, MPI_CHAR, 0, comm);
    MPI_Bcast(driver->saveXFileName, 1024, MPI_CHAR, 0, comm);
    MPI_Bcast(driver->checkXFileName, 1024, MPI_CHAR, 0, comm);
    MPI_Bcast(&driver->initialGuessesPert, 1, MPI_DOUBLE, 0, comm);
    MPI_Bcast(&driver->matrixChoice, 1, MPI_INT, 0, comm);
+   MPI_Bcast(&driver->sellChunkSize, 1, MPI_INT, 0, comm);
+   MPI_Bcast(&driver->sellSigma, 1, MPI_INT, 0, comm);
+   MPI_Bcast(&driver->normalMatvec, 1, MPI_INT, 0, comm);
    MPI_Bcast(&driver->PrecChoice, 1, MPI_INT, 0, comm);
    MPI_Bcast(&driver->isymm, 1, MPI_INT, 0, comm);
    MPI_Bcast(&driver->level, 1, MPI_INT, 0, comm);
@@ -837,6 +944,29 @@ void par_GlobalSumDouble(void *sendBuf, void *recvBuf, int *count,
 #endif
 }
 
+/******************************************************************************
+ * MPI split-phase globalSumDouble functions
+ *
+******************************************************************************/
+void par_GlobalSumDoubleStart(void *sendBuf, void *recvBuf, int *count, 
+                         primme_params *primme, void **request, int *ierr) {
+   MPI_Comm communicator = *(MPI_Comm *) primme->commInfo;
+   MPI_Request *req = (MPI_Request *) primme_calloc(1, sizeof(MPI_Request),
+         "MPI_Request");
+
+   *request = req;
+   *ierr = MPI_Iallreduce(sendBuf, recvBuf, *count, MPI_DOUBLE, MPI_SUM,
+         communicator, req);
+}
+
+void par_GlobalSumDoubleWait(void *request, primme_params *primme, int *ierr) {
+   MPI_Request *req = (MPI_Request *) request;
+
+   (void)primme; /* unused parameter */
+   *ierr = MPI_Wait(req, MPI_STATUS_IGNORE);
+   free(req);
+}
+
 void par_GlobalSumDoubleSvds(void *sendBuf, void *recvBuf, int *count, 
                          primme_svds_params *primme_svds, int *ierr) {
    MPI_Comm communicator = *(MPI_Comm *) primme_svds->commInfo;
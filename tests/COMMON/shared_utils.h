@@ -60,13 +60,25 @@ typedef struct driver_params {
    char testId[256];
    char partDir[1024];
    char matrixFileName[1024];
+   char massMatrixFileName[1024]; /* B in A*x = lambda*B*x; empty if B = I */
    char initialGuessesFileName[1024];
    char saveXFileName[1024];
    double initialGuessesPert;
    char checkXFileName[1024];
    int checkInterface;
+   int checkpointInterrupt; /* if > 0, stop after that many matvecs and */
+                            /* resume from the checkpoint                */
+   int numSlices;           /* if > 0, compute the eigenpairs in          */
+   double slicingLower;     /* [slicingLower, slicingUpper) with          */
+   double slicingUpper;     /* Sprimme_slicing and that many windows      */
+   char traceFileName[1024]; /* if not empty, write a trace of the solver */
+                             /* with primme_monitor_trace                 */
 
    driver_mat matrixChoice;
+   int sellChunkSize;    /* native matrix in SELL-C-sigma with C = sellChunkSize, */
+   int sellSigma;        /* and sigma = sellSigma; CSR if sellChunkSize is 0     */
+   int normalMatvec;     /* svds with native matrix: if nonzero, set           */
+                         /* primme_svds.matrixNormalMatvec                      */
 
    int weightedPart;
 
@@ -97,6 +109,9 @@ void driver_display_methodsvd(primme_svds_preset_method method, const char *meth
 #include <mpi.h>
 void par_GlobalSumDouble(void *sendBuf, void *recvBuf, int *count, 
                          primme_params *primme, int *ierr);
+void par_GlobalSumDoubleStart(void *sendBuf, void *recvBuf, int *count, 
+                         primme_params *primme, void **request, int *ierr);
+void par_GlobalSumDoubleWait(void *request, primme_params *primme, int *ierr);
 void par_GlobalSumDoubleSvds(void *sendBuf, void *recvBuf, int *count, 
                          primme_svds_params *primme, int *ierr);
 void broadCast_svds(primme_svds_params *primme_svds, primme_svds_preset_method *method,
@@ -0,0 +1,527 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2016 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ * File: spmm.c
+ * 
+ * Purpose - Sparse matrix times a block of vectors in CSR and SELL-C-sigma
+ *           formats. The products are parallelized over the rows of A with
+ *           OpenMP (compile with -fopenmp). In the product with A every row
+ *           is computed by a single thread, so results do not depend on the
+ *           number of threads; the products with A' and A'*A add up partial
+ *           results of every thread (see spmmScatter).
+ * 
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "primme.h"
+#include "spmm.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Number of vectors whose products are accumulated at the same time in CSR */
+#define SPMM_TILE 4
+
+static void spmmCSR(const SpMatrix *A, SCALAR *x, PRIMME_INT ldx, SCALAR *y,
+      PRIMME_INT ldy, int bs);
+static void spmmSELL(const SpMatrix *A, SCALAR *x, PRIMME_INT ldx, SCALAR *y,
+      PRIMME_INT ldy, int bs);
+static void spmmScatter(const SpMatrix *A, SCALAR *x, PRIMME_INT ldx,
+      SCALAR *y, PRIMME_INT ldy, int bs, int normal);
+static void spmmTransRows(const SpMatrix *A, SCALAR *x, PRIMME_INT ldx,
+      SCALAR *y, PRIMME_INT ldy, int bs, PRIMME_INT ib, PRIMME_INT ie);
+static void spmmNormalRows(const SpMatrix *A, SCALAR *x, PRIMME_INT ldx,
+      SCALAR *y, PRIMME_INT ldy, int bs, PRIMME_INT ib, PRIMME_INT ie);
+
+typedef struct {
+   PRIMME_INT len, row;
+} row_len;
+
+static int cmp_row_len(const void *a, const void *b) {
+   const row_len *ra = (const row_len*)a, *rb = (const row_len*)b;
+   if (ra->len != rb->len) return ra->len > rb->len ? -1 : 1;
+   return ra->row < rb->row ? -1 : (ra->row > rb->row);
+}
+
+/******************************************************************************
+ * Creates a copy of matrix in CSR (chunkSize == 0) or in SELL-C-sigma format
+ * (chunkSize = C > 0). The original matrix has Fortran indexing, and the copy
+ * uses C indexing and PRIMME_INT row and chunk pointers.
+ *
+ * Return Value
+ * ------------
+ *  0  - success
+ * -1  - invalid chunkSize
+ *
+******************************************************************************/
+
+int createSpMatrix(const CSRMatrix *matrix, int chunkSize, int sigma,
+      SpMatrix **spmatrix) {
+
+   PRIMME_INT i, k, l, c, r, m = matrix->m, n = matrix->n;
+   SpMatrix *A;
+   row_len *rows;
+
+   if (chunkSize < 0 || chunkSize > SPMM_MAX_CHUNK) {
+      fprintf(stderr, "ERROR: SELL chunk size should be between 0 and %d\n",
+            SPMM_MAX_CHUNK);
+      return -1;
+   }
+
+   A = (SpMatrix *)primme_calloc(1, sizeof(SpMatrix), "SpMatrix");
+   memset(A, 0, sizeof(SpMatrix));
+   A->m = m;
+   A->n = n;
+   A->chunkSize = chunkSize;
+
+   /* CSR */
+
+   if (chunkSize == 0) {
+      A->nnz = matrix->IA[m] - 1;
+      A->rowPtr = (PRIMME_INT *)primme_calloc(m+1, sizeof(PRIMME_INT), "rowPtr");
+      A->colInd = (PRIMME_INT *)primme_calloc(A->nnz, sizeof(PRIMME_INT),
+            "colInd");
+      A->val = (SCALAR *)primme_calloc(A->nnz, sizeof(SCALAR), "val");
+      for (i=0; i<=m; i++) A->rowPtr[i] = matrix->IA[i] - 1;
+      for (k=0; k<A->nnz; k++) {
+         A->colInd[k] = matrix->JA[k] - 1;
+         A->val[k] = matrix->AElts[k];
+      }
+      *spmatrix = A;
+      return 0;
+   }
+
+   /* SELL-C-sigma: sort the rows by decreasing length inside each window */
+
+   A->sigma = sigma = sigma > 0 ? sigma : 1;
+   rows = (row_len *)primme_calloc(m, sizeof(row_len), "rows");
+   for (i=0; i<m; i++) {
+      rows[i].len = matrix->IA[i+1] - matrix->IA[i];
+      rows[i].row = i;
+   }
+   for (i=0; i<m; i+=sigma) {
+      qsort(&rows[i], m-i < sigma ? m-i : sigma, sizeof(row_len), cmp_row_len);
+   }
+   A->rowPerm = (PRIMME_INT *)primme_calloc(m, sizeof(PRIMME_INT), "rowPerm");
+   for (i=0; i<m; i++) A->rowPerm[i] = rows[i].row;
+
+   /* Chunk c has the rows c*C:(c+1)*C-1 and is as long as its longest row */
+
+   A->numChunks = (m + chunkSize - 1) / chunkSize;
+   A->chunkPtr = (PRIMME_INT *)primme_calloc(A->numChunks+1,
+         sizeof(PRIMME_INT), "chunkPtr");
+   A->chunkLen = (PRIMME_INT *)primme_calloc(A->numChunks,
+         sizeof(PRIMME_INT), "chunkLen");
+   A->chunkPtr[0] = 0;
+   for (c=0; c<A->numChunks; c++) {
+      A->chunkLen[c] = 0;
+      for (r=c*chunkSize; r<(c+1)*chunkSize && r<m; r++) {
+         if (rows[r].len > A->chunkLen[c]) A->chunkLen[c] = rows[r].len;
+      }
+      A->chunkPtr[c+1] = A->chunkPtr[c] + A->chunkLen[c]*chunkSize;
+   }
+   A->nnz = A->chunkPtr[A->numChunks];
+
+   /* Copy the rows; padding has zero values and points to the first column */
+
+   A->colInd = (PRIMME_INT *)primme_calloc(A->nnz, sizeof(PRIMME_INT),
+            "colInd");
+   A->val = (SCALAR *)primme_calloc(A->nnz, sizeof(SCALAR), "val");
+   for (c=0; c<A->numChunks; c++) {
+      for (r=0; r<chunkSize; r++) {
+         PRIMME_INT len = c*chunkSize+r < m ? rows[c*chunkSize+r].len : 0;
+         PRIMME_INT k0 = len > 0 ? matrix->IA[rows[c*chunkSize+r].row] - 1 : 0;
+         for (l=0; l<A->chunkLen[c]; l++) {
+            k = A->chunkPtr[c] + l*chunkSize + r;
+            A->colInd[k] = l < len ? matrix->JA[k0+l] - 1 : 0;
+            A->val[k] = l < len ? matrix->AElts[k0+l] : 0.0;
+         }
+      }
+   }
+   free(rows);
+
+   *spmatrix = A;
+   return 0;
+}
+
+void freeSpMatrix(SpMatrix *spmatrix) {
+   if (!spmatrix) return;
+   free(spmatrix->colInd);
+   free(spmatrix->val);
+   free(spmatrix->rowPtr);
+   free(spmatrix->chunkPtr);
+   free(spmatrix->chunkLen);
+   free(spmatrix->rowPerm);
+   free(spmatrix);
+}
+
+/******************************************************************************
+ * Applies the matrix vector multiplication on a block of vectors,
+ *
+ *    y(:,i) = A*x(:,i), i=0:blockSize-1
+ *
+******************************************************************************/
+
+void SpMatrixMatvec(void *x, PRIMME_INT *ldx, void *y, PRIMME_INT *ldy,
+      int *blockSize, primme_params *primme, int *ierr) {
+
+   SpMatrixApply((SpMatrix *)primme->matrix, (SCALAR*)x, *ldx, (SCALAR*)y,
+         *ldy, *blockSize);
+   *ierr = 0;
+}
+
+/******************************************************************************
+ * Same as SpMatrixMatvec for a given matrix, for instance the mass matrix B
+ * of a generalized problem
+ *
+******************************************************************************/
+
+void SpMatrixApply(const SpMatrix *A, SCALAR *x, PRIMME_INT ldx, SCALAR *y,
+      PRIMME_INT ldy, int blockSize) {
+
+   if (A->chunkSize == 0) {
+      spmmCSR(A, x, ldx, y, ldy, blockSize);
+   }
+   else {
+      spmmSELL(A, x, ldx, y, ldy, blockSize);
+   }
+}
+
+/******************************************************************************
+ * Applies A (trans == 0) or A' (trans != 0) on a block of vectors
+ *
+******************************************************************************/
+
+void SpMatrixMatvecSVD(void *x, PRIMME_INT *ldx, void *y, PRIMME_INT *ldy,
+      int *blockSize, int *trans, primme_svds_params *primme_svds, int *ierr) {
+
+   SpMatrix *A = (SpMatrix *)primme_svds->matrix;
+
+   if (*trans != 0) {
+      spmmScatter(A, (SCALAR*)x, *ldx, (SCALAR*)y, *ldy, *blockSize, 0);
+   }
+   else if (A->chunkSize == 0) {
+      spmmCSR(A, (SCALAR*)x, *ldx, (SCALAR*)y, *ldy, *blockSize);
+   }
+   else {
+      spmmSELL(A, (SCALAR*)x, *ldx, (SCALAR*)y, *ldy, *blockSize);
+   }
+   *ierr = 0;
+}
+
+/******************************************************************************
+ * Applies A'*A (trans == 0) or A*A' (trans != 0) on a block of vectors. The
+ * first one reads A once; the second one computes A'*x in a temporary array
+ * and then A times it.
+ *
+******************************************************************************/
+
+void SpMatrixNormalMatvecSVD(void *x, PRIMME_INT *ldx, void *y, PRIMME_INT *ldy,
+      int *blockSize, int *trans, primme_svds_params *primme_svds, int *ierr) {
+
+   SpMatrix *A = (SpMatrix *)primme_svds->matrix;
+   SCALAR *t;
+
+   if (*trans == 0) {
+      spmmScatter(A, (SCALAR*)x, *ldx, (SCALAR*)y, *ldy, *blockSize, 1);
+   }
+   else {
+      t = (SCALAR*)malloc(sizeof(SCALAR)*A->n*(*blockSize));
+      if (t == NULL) {
+         *ierr = -1;
+         return;
+      }
+      spmmScatter(A, (SCALAR*)x, *ldx, t, A->n, *blockSize, 0);
+      SpMatrixApply(A, t, A->n, (SCALAR*)y, *ldy, *blockSize);
+      free(t);
+   }
+   *ierr = 0;
+}
+
+/******************************************************************************
+ * y = A*x with A in CSR. Every row reads its elements once for every group of
+ * SPMM_TILE vectors.
+ *
+******************************************************************************/
+
+static void spmmCSR(const SpMatrix *A, SCALAR *x, PRIMME_INT ldx, SCALAR *y,
+      PRIMME_INT ldy, int bs) {
+
+   PRIMME_INT i, m = A->m;
+   const PRIMME_INT *rowPtr = A->rowPtr;
+   const PRIMME_INT *colInd = A->colInd;
+   const SCALAR *val = A->val;
+
+#ifdef _OPENMP
+   #pragma omp parallel for schedule(static)
+#endif
+   for (i=0; i<m; i++) {
+      PRIMME_INT k, k0 = rowPtr[i], k1 = rowPtr[i+1];
+      int j;
+
+      for (j=0; j+SPMM_TILE<=bs; j+=SPMM_TILE) {
+         SCALAR a0 = 0.0, a1 = 0.0, a2 = 0.0, a3 = 0.0;
+         for (k=k0; k<k1; k++) {
+            const SCALAR v = val[k], *xk = &x[colInd[k]+ldx*j];
+            a0 += v*xk[0];
+            a1 += v*xk[ldx];
+            a2 += v*xk[ldx*2];
+            a3 += v*xk[ldx*3];
+         }
+         y[i+ldy*j] = a0;
+         y[i+ldy*(j+1)] = a1;
+         y[i+ldy*(j+2)] = a2;
+         y[i+ldy*(j+3)] = a3;
+      }
+      for (; j<bs; j++) {
+         SCALAR a0 = 0.0;
+         const SCALAR *xj = &x[ldx*j];
+         for (k=k0; k<k1; k++) a0 += val[k]*xj[colInd[k]];
+         y[i+ldy*j] = a0;
+      }
+   }
+}
+
+/******************************************************************************
+ * y = A*x with A in SELL-C-sigma. The C rows of a chunk are computed at the
+ * same time for every group of SPMM_TILE vectors, reading contiguous values
+ * and column indices.
+ *
+******************************************************************************/
+
+static void spmmSELL(const SpMatrix *A, SCALAR *x, PRIMME_INT ldx, SCALAR *y,
+      PRIMME_INT ldy, int bs) {
+
+   PRIMME_INT c;
+   const int C = A->chunkSize;
+
+#ifdef _OPENMP
+   #pragma omp parallel for schedule(static)
+#endif
+   for (c=0; c<A->numChunks; c++) {
+      PRIMME_INT l, len = A->chunkLen[c], r0 = c*C;
+      const SCALAR *val = &A->val[A->chunkPtr[c]];
+      const PRIMME_INT *colInd = &A->colInd[A->chunkPtr[c]];
+      const PRIMME_INT *rowPerm = &A->rowPerm[r0];
+      int r, j, t, nj, nr = A->m-r0 < C ? (int)(A->m-r0) : C;
+      SCALAR acc[SPMM_TILE][SPMM_MAX_CHUNK];
+
+      for (j=0; j<bs; j+=SPMM_TILE) {
+         nj = bs-j < SPMM_TILE ? bs-j : SPMM_TILE;
+         for (t=0; t<nj; t++) for (r=0; r<C; r++) acc[t][r] = 0.0;
+         for (l=0; l<len; l++) {
+            const SCALAR *v = &val[l*C];
+            const PRIMME_INT *ci = &colInd[l*C];
+            for (t=0; t<nj; t++) {
+               const SCALAR *xt = &x[ldx*(j+t)];
+               SCALAR *at = acc[t];
+               for (r=0; r<C; r++) at[r] += v[r]*xt[ci[r]];
+            }
+         }
+         for (t=0; t<nj; t++) {
+            for (r=0; r<nr; r++) y[rowPerm[r]+ldy*(j+t)] = acc[t][r];
+         }
+      }
+   }
+}
+
+/******************************************************************************
+ * Computes y = A'*x (normal == 0) or y = A'*A*x (normal != 0). Every thread
+ * takes a contiguous range of rows of A (chunks in SELL), as in spmmCSR, and
+ * scatters its products into its own accumulator; the first thread uses y
+ * and the others a temporary array of n x bs. Then every thread adds up the
+ * accumulators for a range of rows of y, always in the order of the threads,
+ * so the result only depends on the number of threads. If the temporary
+ * array cannot be allocated, the product is computed by a single thread.
+ *
+******************************************************************************/
+
+static void spmmScatter(const SpMatrix *A, SCALAR *x, PRIMME_INT ldx,
+      SCALAR *y, PRIMME_INT ldy, int bs, int normal) {
+
+   PRIMME_INT n = A->n;
+   PRIMME_INT numRows = A->chunkSize == 0 ? A->m : A->numChunks;
+   SCALAR *work = NULL;
+   int nt = 1;
+
+#ifdef _OPENMP
+   nt = omp_get_max_threads();
+   if (nt > numRows) nt = numRows > 0 ? (int)numRows : 1;
+   if (nt > 1) {
+      work = (SCALAR*)malloc(sizeof(SCALAR)*n*bs*(nt-1));
+      if (work == NULL) nt = 1;
+   }
+   #pragma omp parallel num_threads(nt) if(nt > 1)
+#endif
+   {
+      PRIMME_INT i, ib, ie, ldyt;
+      SCALAR *yt;
+      int j, t, it=0, nit=1;
+
+#ifdef _OPENMP
+      it = omp_get_thread_num();
+      nit = omp_get_num_threads();
+#endif
+
+      /* Accumulate the products of the rows ib:ie-1 of A in yt */
+
+      yt = it == 0 ? y : &work[n*bs*(it-1)];
+      ldyt = it == 0 ? ldy : n;
+      for (j=0; j<bs; j++) for (i=0; i<n; i++) yt[i+ldyt*j] = 0.0;
+      ib = numRows*it/nit;
+      ie = numRows*(it+1)/nit;
+      if (normal) {
+         spmmNormalRows(A, x, ldx, yt, ldyt, bs, ib, ie);
+      }
+      else {
+         spmmTransRows(A, x, ldx, yt, ldyt, bs, ib, ie);
+      }
+
+      /* y(ib:ie-1,:) += sum of the other accumulators, now in rows of y */
+
+#ifdef _OPENMP
+      #pragma omp barrier
+#endif
+      ib = n*it/nit;
+      ie = n*(it+1)/nit;
+      for (t=1; t<nit; t++) {
+         const SCALAR *wt = &work[n*bs*(t-1)];
+         for (j=0; j<bs; j++) {
+            for (i=ib; i<ie; i++) y[i+ldy*j] += wt[i+n*j];
+         }
+      }
+   }
+
+   free(work);
+}
+
+/******************************************************************************
+ * y += A(ib:ie-1,:)'*x(ib:ie-1,:), where ib:ie-1 are rows in CSR and chunks
+ * in SELL-C-sigma. Every element of A is read once for all the vectors.
+ *
+******************************************************************************/
+
+static void spmmTransRows(const SpMatrix *A, SCALAR *x, PRIMME_INT ldx,
+      SCALAR *y, PRIMME_INT ldy, int bs, PRIMME_INT ib, PRIMME_INT ie) {
+
+   PRIMME_INT i, k, l, c, r;
+   int j;
+
+   if (A->chunkSize == 0) {
+      for (i=ib; i<ie; i++) {
+         for (k=A->rowPtr[i]; k<A->rowPtr[i+1]; k++) {
+            const SCALAR v = CONJ(A->val[k]);
+            SCALAR *yk = &y[A->colInd[k]];
+            for (j=0; j<bs; j++) yk[ldy*j] += v*x[i+ldx*j];
+         }
+      }
+   }
+   else {
+      const PRIMME_INT C = A->chunkSize;
+      for (c=ib; c<ie; c++) {
+         for (r=0; r<C && c*C+r<A->m; r++) {
+            const SCALAR *xr = &x[A->rowPerm[c*C+r]];
+            for (l=0; l<A->chunkLen[c]; l++) {
+               k = A->chunkPtr[c] + l*C + r;
+               {
+                  const SCALAR v = CONJ(A->val[k]);
+                  SCALAR *yk = &y[A->colInd[k]];
+                  for (j=0; j<bs; j++) yk[ldy*j] += v*xr[ldx*j];
+               }
+            }
+         }
+      }
+   }
+}
+
+/******************************************************************************
+ * y += A(ib:ie-1,:)'*A(ib:ie-1,:)*x, where ib:ie-1 are rows in CSR and chunks
+ * in SELL-C-sigma. Every row i computes (A*x)(i) and scatters it right away,
+ * y += A(i,:)'*(A*x)(i), while the row is still in cache, so A is read from
+ * memory once and A*x is never stored. In CSR the vectors go in groups of
+ * SPMM_TILE.
+ *
+******************************************************************************/
+
+static void spmmNormalRows(const SpMatrix *A, SCALAR *x, PRIMME_INT ldx,
+      SCALAR *y, PRIMME_INT ldy, int bs, PRIMME_INT ib, PRIMME_INT ie) {
+
+   PRIMME_INT i, k, l, c, r;
+   int j;
+   SCALAR t;
+
+   if (A->chunkSize == 0) {
+      for (i=ib; i<ie; i++) {
+         const PRIMME_INT k0 = A->rowPtr[i], k1 = A->rowPtr[i+1];
+         for (j=0; j+SPMM_TILE<=bs; j+=SPMM_TILE) {
+            SCALAR a0 = 0.0, a1 = 0.0, a2 = 0.0, a3 = 0.0;
+            for (k=k0; k<k1; k++) {
+               const SCALAR v = A->val[k], *xk = &x[A->colInd[k]+ldx*j];
+               a0 += v*xk[0];
+               a1 += v*xk[ldx];
+               a2 += v*xk[ldx*2];
+               a3 += v*xk[ldx*3];
+            }
+            for (k=k0; k<k1; k++) {
+               const SCALAR v = CONJ(A->val[k]);
+               SCALAR *yk = &y[A->colInd[k]+ldy*j];
+               yk[0] += v*a0;
+               yk[ldy] += v*a1;
+               yk[ldy*2] += v*a2;
+               yk[ldy*3] += v*a3;
+            }
+         }
+         for (; j<bs; j++) {
+            const SCALAR *xj = &x[ldx*j];
+            SCALAR *yj = &y[ldy*j];
+            t = 0.0;
+            for (k=k0; k<k1; k++) t += A->val[k]*xj[A->colInd[k]];
+            for (k=k0; k<k1; k++) yj[A->colInd[k]] += CONJ(A->val[k])*t;
+         }
+      }
+   }
+   else {
+      /* The padding has zero values, so it adds nothing */
+      const PRIMME_INT C = A->chunkSize;
+      for (c=ib; c<ie; c++) {
+         const PRIMME_INT k0 = A->chunkPtr[c];
+         for (r=0; r<C && c*C+r<A->m; r++) {
+            for (j=0; j<bs; j++) {
+               const SCALAR *xj = &x[ldx*j];
+               SCALAR *yj = &y[ldy*j];
+               t = 0.0;
+               for (l=0; l<A->chunkLen[c]; l++) {
+                  k = k0 + l*C + r;
+                  t += A->val[k]*xj[A->colInd[k]];
+               }
+               for (l=0; l<A->chunkLen[c]; l++) {
+                  k = k0 + l*C + r;
+                  yj[A->colInd[k]] += CONJ(A->val[k])*t;
+               }
+            }
+         }
+      }
+   }
+}
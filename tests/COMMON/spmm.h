@@ -0,0 +1,77 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2016 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ * File: spmm.h
+ * 
+ * Purpose - Definitions of the sparse matrix times block of vectors kernels
+ *           (CSR and SELL-C-sigma) used by the driver. They do not depend on
+ *           the rest of the driver, and the matvec functions follow the
+ *           PRIMME callback interface, so they may be used directly as
+ *           primme.matrixMatvec and primme_svds.matrixMatvec.
+ * 
+ ******************************************************************************/
+
+#ifndef SPMM_H
+#define SPMM_H
+
+#include "csr.h"
+#include "primme_svds.h"
+
+/* Largest chunk size supported by the SELL-C-sigma format */
+#define SPMM_MAX_CHUNK 64
+
+typedef struct {
+   PRIMME_INT m;          /* number of rows */
+   PRIMME_INT n;          /* number of columns */
+   PRIMME_INT nnz;        /* number of stored elements, including padding */
+   PRIMME_INT *colInd;    /* column indices, 0-based */
+   SCALAR *val;           /* values */
+
+   /* CSR: row i is stored in [rowPtr[i], rowPtr[i+1]). The row and chunk   */
+   /* pointers are PRIMME_INT, so the number of elements may exceed INT_MAX */
+   PRIMME_INT *rowPtr;
+
+   /* SELL-C-sigma: the rows are sorted by decreasing length within windows  */
+   /* of sigma rows and grouped in chunks of chunkSize rows. Every chunk is  */
+   /* padded to the length of its longest row and stored column-major from   */
+   /* chunkPtr[c]. Row r of the chunk storage is row rowPerm[r] of A.        */
+   int chunkSize;         /* C; zero if the matrix is stored in CSR */
+   int sigma;             /* sorting window */
+   PRIMME_INT numChunks;
+   PRIMME_INT *chunkPtr;
+   PRIMME_INT *chunkLen;
+   PRIMME_INT *rowPerm;
+} SpMatrix;
+
+int createSpMatrix(const CSRMatrix *matrix, int chunkSize, int sigma,
+      SpMatrix **spmatrix);
+void freeSpMatrix(SpMatrix *spmatrix);
+void SpMatrixMatvec(void *x, PRIMME_INT *ldx, void *y, PRIMME_INT *ldy,
+      int *blockSize, primme_params *primme, int *ierr);
+void SpMatrixApply(const SpMatrix *A, SCALAR *x, PRIMME_INT ldx, SCALAR *y,
+      PRIMME_INT ldy, int blockSize);
+void SpMatrixMatvecSVD(void *x, PRIMME_INT *ldx, void *y, PRIMME_INT *ldy,
+      int *blockSize, int *trans, primme_svds_params *primme_svds, int *ierr);
+void SpMatrixNormalMatvecSVD(void *x, PRIMME_INT *ldx, void *y, PRIMME_INT *ldy,
+      int *blockSize, int *trans, primme_svds_params *primme_svds, int *ierr);
+
+#endif
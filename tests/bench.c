@@ -0,0 +1,341 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2016 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ * File: bench.c
+ *
+ * Purpose - measure the solver on large matrix-free problems and compare
+ *           the results with a baseline.
+ *
+ *  Calling format:
+ *
+ *             bench_double [-n n] [-numEvals k] [-baseline file] [-save file]
+ *
+ *  Solves for the numEvals (4 by default) smallest eigenvalues of these
+ *  operators of size about n (64000 by default):
+ *
+ *    laplace3d  7-point Laplacian on a cube with Dirichlet boundary,
+ *    aniso3d    the same with diffusion coefficients 1, 0.1 and 0.01 along
+ *               the axes,
+ *    graph      Laplacian of a random circulant graph of degree 8.
+ *
+ *  In complex, the couplings along one direction carry a phase, so the
+ *  operators are Hermitian but not real. The operators are not stored, so n
+ *  may go up to 10^8 if the memory holds the basis.
+ *
+ *  Every operator is solved with several methods and block sizes, and the
+ *  matvecs and the time spent in the main phases are printed, taken from
+ *  primme.stats and from the durations passed to primme.monitorFun. With
+ *  -save, the results are written into file; with -baseline, they are
+ *  compared with a file written before, and the runs that take 10% more
+ *  matvecs than in the baseline are reported as regressions. The ratio of
+ *  the time to the time in the baseline is also printed, but it is not
+ *  checked, because it depends on the machine and its load. The program
+ *  returns 1 if there is any regression or failure.
+ *
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "primme.h"
+#include "num.h"
+
+#define MAX_RUNS 256
+
+typedef struct {
+   const char *name;
+   PRIMME_INT nx, ny, nz;  /* grid size; ny=nz=0 for graphs            */
+   double a[3];            /* diffusion coefficients along the axes     */
+   PRIMME_INT offsets[4];  /* graph: vertex i is joined to i +- offsets */
+   double phase;           /* angle of the couplings along the first axis
+                              or offset in complex                     */
+} operator_t;
+
+typedef struct {
+   char problem[32], method[32];
+   int blockSize;
+   PRIMME_INT n, matvecs;
+   double time;
+} result_t;
+
+static const struct {
+   const char *name;
+   primme_preset_method method;
+} methods[] = {
+   {"DEFAULT_MIN_TIME",     PRIMME_DEFAULT_MIN_TIME},
+   {"DEFAULT_MIN_MATVECS",  PRIMME_DEFAULT_MIN_MATVECS},
+   {"GD_plusK",             PRIMME_GD_plusK},
+   {"JDQMR",                PRIMME_JDQMR},
+   {"LOBPCG_OrthoBasis_Window", PRIMME_LOBPCG_OrthoBasis_Window}};
+
+static const int blockSizes[] = {1, 4};
+
+/* y = A*x for the stencil on the grid nx x ny x nz */
+
+static void GridMatvec(void *x, PRIMME_INT *ldx, void *y, PRIMME_INT *ldy,
+      int *blockSize, primme_params *primme, int *ierr) {
+
+   operator_t *op = (operator_t*)primme->matrix;
+   PRIMME_INT nx = op->nx, ny = op->ny, nz = op->nz, nxy = nx*ny;
+   double diag = 2.0*(op->a[0] + op->a[1] + op->a[2]);
+   SCALAR w = -op->a[0]*(cos(op->phase) + IMAGINARY*sin(op->phase));
+   int b;
+
+   for (b=0; b<*blockSize; b++) {
+      SCALAR *xv = (SCALAR*)x + *ldx*b, *yv = (SCALAR*)y + *ldy*b;
+      PRIMME_INT k;
+#ifdef _OPENMP
+      #pragma omp parallel for
+#endif
+      for (k=0; k<nz; k++) {
+         PRIMME_INT i, j, p;
+         for (j=0; j<ny; j++) {
+            for (i=0, p=k*nxy+j*nx; i<nx; i++, p++) {
+               SCALAR s = diag*xv[p];
+               if (i > 0)    s += w*xv[p-1];
+               if (i < nx-1) s += CONJ(w)*xv[p+1];
+               if (j > 0)    s -= op->a[1]*xv[p-nx];
+               if (j < ny-1) s -= op->a[1]*xv[p+nx];
+               if (k > 0)    s -= op->a[2]*xv[p-nxy];
+               if (k < nz-1) s -= op->a[2]*xv[p+nxy];
+               yv[p] = s;
+            }
+         }
+      }
+   }
+   *ierr = 0;
+}
+
+/* y = L*x for the Laplacian of the circulant graph */
+
+static void GraphMatvec(void *x, PRIMME_INT *ldx, void *y, PRIMME_INT *ldy,
+      int *blockSize, primme_params *primme, int *ierr) {
+
+   operator_t *op = (operator_t*)primme->matrix;
+   PRIMME_INT n = primme->n;
+   int nd = sizeof(op->offsets)/sizeof(PRIMME_INT);
+   SCALAR w = -(cos(op->phase) + IMAGINARY*sin(op->phase));
+   int b;
+
+   for (b=0; b<*blockSize; b++) {
+      SCALAR *xv = (SCALAR*)x + *ldx*b, *yv = (SCALAR*)y + *ldy*b;
+      PRIMME_INT i;
+#ifdef _OPENMP
+      #pragma omp parallel for
+#endif
+      for (i=0; i<n; i++) {
+         SCALAR s = 2.0*nd*xv[i];
+         int d;
+         s += w*xv[(i - op->offsets[0] + n)%n]
+            + CONJ(w)*xv[(i + op->offsets[0])%n];
+         for (d=1; d<nd; d++) {
+            s -= xv[(i - op->offsets[d] + n)%n] + xv[(i + op->offsets[d])%n];
+         }
+         yv[i] = s;
+      }
+   }
+   *ierr = 0;
+}
+
+/* Accumulate the time spent in every phase */
+
+static void MonitorPhases(primme_event *event, double *time, double *duration,
+      int *basisSize, int *blockSize, double *blockNorms, int *numConverged,
+      primme_params *primme, int *ierr) {
+
+   ((double*)primme->monitor)[*event] += *duration;
+   (void)time; (void)basisSize; (void)blockSize; (void)blockNorms;
+   (void)numConverged;
+   *ierr = 0;
+}
+
+static int read_baseline(const char *fileName, result_t *base) {
+   FILE *f = fopen(fileName, "r");
+   int n = 0;
+
+   if (!f) return -1;
+   while (n < MAX_RUNS && fscanf(f, "%31s %31s %d %" PRIMME_INT_P " %"
+            PRIMME_INT_P " %lf", base[n].problem, base[n].method,
+            &base[n].blockSize, &base[n].n, &base[n].matvecs, &base[n].time)
+         == 6) {
+      n++;
+   }
+   fclose(f);
+   return n;
+}
+
+int main(int argc, char **argv) {
+
+   PRIMME_INT n = 64000, m;
+   int numEvals = 4, numBase = 0, numRuns = 0, regressions = 0, failures = 0;
+   const char *baselineFile = NULL, *saveFile = NULL;
+   double phases[primme_event_finish+1], *evals, *rnorms;
+   operator_t ops[3];
+   result_t *base, *runs;
+   SCALAR *evecs;
+   primme_params primme;
+   int i, j, o, b, ret;
+
+   for (i=1; i+1<argc; i+=2) {
+      if (!strcmp(argv[i], "-n")) n = atol(argv[i+1]);
+      else if (!strcmp(argv[i], "-numEvals")) numEvals = atoi(argv[i+1]);
+      else if (!strcmp(argv[i], "-baseline")) baselineFile = argv[i+1];
+      else if (!strcmp(argv[i], "-save")) saveFile = argv[i+1];
+      else break;
+   }
+   if (i < argc) {
+      fprintf(stderr, "Usage: %s [-n n] [-numEvals k] [-baseline file] "
+            "[-save file]\n", argv[0]);
+      return 1;
+   }
+
+   /* Set the operators */
+
+   m = (PRIMME_INT)(cbrt((double)n) + 0.5);
+   memset(ops, 0, sizeof(ops));
+   ops[0].name = "laplace3d";
+   ops[0].nx = ops[0].ny = ops[0].nz = m;
+   ops[0].a[0] = ops[0].a[1] = ops[0].a[2] = 1.0;
+   ops[1] = ops[0];
+   ops[1].name = "aniso3d";
+   ops[1].a[1] = 0.1;
+   ops[1].a[2] = 0.01;
+   ops[2].name = "graph";
+   ops[2].nx = m*m*m;
+   srand(1);
+   for (i=0; i<4; i++) {
+      ops[2].offsets[i] = 1 + (PRIMME_INT)((double)rand()/RAND_MAX*(ops[2].nx/2-2));
+   }
+#ifdef USE_COMPLEX
+   for (o=0; o<3; o++) ops[o].phase = 0.3;
+#endif
+
+   base = (result_t*)malloc(sizeof(result_t)*MAX_RUNS);
+   runs = (result_t*)malloc(sizeof(result_t)*MAX_RUNS);
+   if (baselineFile && (numBase = read_baseline(baselineFile, base)) < 0) {
+      fprintf(stderr, "Warning: cannot read the baseline %s\n", baselineFile);
+      numBase = 0;
+   }
+   evals = (double*)malloc(sizeof(double)*numEvals);
+   rnorms = (double*)malloc(sizeof(double)*numEvals);
+   evecs = (SCALAR*)malloc(sizeof(SCALAR)*m*m*m*numEvals);
+
+   printf("n = %" PRIMME_INT_P " numEvals = %d sizeof(SCALAR) = %d\n", m*m*m,
+         numEvals, (int)sizeof(SCALAR));
+   printf("%-10s %-25s %2s %8s %9s %9s %9s %9s %9s %9s %9s %9s\n",
+         "Problem", "Method", "bs", "Matvecs", "Time (s)", "Matvec", "Ortho",
+         "Correct.", "Proj+H", "Restart", "Time/base", "Baseline");
+
+   for (o=0; o<3; o++) {
+      for (j=0; j<(int)(sizeof(methods)/sizeof(methods[0])); j++) {
+         for (b=0; b<(int)(sizeof(blockSizes)/sizeof(int)); b++) {
+            result_t *r = &runs[numRuns];
+            const char *flag = "";
+            char ratio[16] = "";
+
+            primme_initialize(&primme);
+            primme.n = m*m*m;
+            primme.matrix = &ops[o];
+            primme.matrixMatvec = ops[o].ny ? GridMatvec : GraphMatvec;
+            primme.numEvals = numEvals;
+            primme.eps = 1e-6;
+            primme.maxBlockSize = blockSizes[b];
+            primme.maxMatvecs = 20000;
+            primme.printLevel = 0;
+            primme.monitor = phases;
+            primme.monitorFun = MonitorPhases;
+            primme_set_method(methods[j].method, &primme);
+            memset(phases, 0, sizeof(phases));
+
+            ret = Sprimme(evals, evecs, rnorms, &primme);
+
+            strcpy(r->problem, ops[o].name);
+            strcpy(r->method, methods[j].name);
+            r->blockSize = blockSizes[b];
+            r->n = primme.n;
+            r->matvecs = primme.stats.numMatvecs;
+            r->time = primme.stats.elapsedTime;
+            if (numRuns < MAX_RUNS-1) numRuns++;
+
+            /* Compare with the baseline */
+
+            if (ret != 0) {
+               flag = "FAILED";
+               failures++;
+            }
+            for (i=0; i<numBase && ret == 0; i++) {
+               if (strcmp(base[i].problem, r->problem)
+                     || strcmp(base[i].method, r->method)
+                     || base[i].blockSize != r->blockSize
+                     || base[i].n != r->n) continue;
+               if (base[i].time > 0.0) {
+                  sprintf(ratio, "%.2f", r->time/base[i].time);
+               }
+               if (r->matvecs > 1.1*base[i].matvecs + 10) {
+                  flag = "REGRESSION";
+                  regressions++;
+               }
+               else flag = "ok";
+               break;
+            }
+
+            printf("%-10s %-25s %2d %8" PRIMME_INT_P " %9.3f %9.3f %9.3f %9.3f "
+                  "%9.3f %9.3f %9s %9s\n", r->problem, r->method, r->blockSize,
+                  r->matvecs, r->time, primme.stats.timeMatvec,
+                  primme.stats.timeOrtho, phases[primme_event_correction],
+                  phases[primme_event_update_projection]
+                  + phases[primme_event_solve_H],
+                  phases[primme_event_restart], ratio, flag);
+            fflush(stdout);
+
+            primme_free(&primme);
+         }
+      }
+   }
+
+   if (saveFile) {
+      FILE *f = fopen(saveFile, "w");
+      if (!f) {
+         fprintf(stderr, "Error: cannot write %s\n", saveFile);
+         return 1;
+      }
+      for (i=0; i<numRuns; i++) {
+         fprintf(f, "%s %s %d %" PRIMME_INT_P " %" PRIMME_INT_P " %g\n",
+               runs[i].problem, runs[i].method, runs[i].blockSize, runs[i].n,
+               runs[i].matvecs, runs[i].time);
+      }
+      fclose(f);
+   }
+
+   if (baselineFile || failures) {
+      printf("%d regressions, %d failures\n", regressions, failures);
+   }
+
+   free(base);
+   free(runs);
+   free(evals);
+   free(rnorms);
+   free(evecs);
+
+   return regressions || failures ? 1 : 0;
+}
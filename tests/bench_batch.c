@@ -0,0 +1,165 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2016 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ * File: bench_batch.c
+ *
+ * Purpose - measure the throughput of Sprimme_batch.
+ *
+ *  Calling format:
+ *
+ *             bench_batch_double [numProblems [n]]
+ *
+ *  Solves numProblems (500 by default) shifted 1-D Laplacians of size n
+ *  (200 by default), first calling Sprimme on every problem and then with
+ *  a single call to Sprimme_batch, and reports the problems solved per
+ *  second. Both runs should return the same eigenvalues. Build PRIMME with
+ *  OpenMP to solve the batch with several threads.
+ *
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "primme.h"
+#include "num.h"
+/* wtime.h header file is included so primme's timing functions can be used */
+#include "../src/include/wtime.h"
+
+#define NUMEVALS 4
+
+/* y = (L + shift*I)*x, where L is the 1-D Laplacian and shift is in matrix */
+
+static void ShiftedLaplacianMatvec(void *x, PRIMME_INT *ldx, void *y,
+      PRIMME_INT *ldy, int *blockSize, primme_params *primme, int *ierr) {
+
+   int i;
+   PRIMME_INT j, n = primme->n;
+   double diag = 2.0 + *(double*)primme->matrix;
+   SCALAR *xv, *yv;
+
+   for (i=0; i<*blockSize; i++) {
+      xv = (SCALAR*)x + *ldx*i;
+      yv = (SCALAR*)y + *ldy*i;
+      for (j=0; j<n; j++) {
+         yv[j] = diag*xv[j];
+         if (j > 0) yv[j] -= xv[j-1];
+         if (j < n-1) yv[j] -= xv[j+1];
+      }
+   }
+   *ierr = 0;
+}
+
+static void setup(primme_params *primme, PRIMME_INT n, double *shift) {
+   primme_initialize(primme);
+   primme->n = n;
+   primme->matrixMatvec = ShiftedLaplacianMatvec;
+   primme->matrix = shift;
+   primme->numEvals = NUMEVALS;
+   primme->eps = 1e-9;
+   primme->printLevel = 0;
+   primme_set_method(PRIMME_DEFAULT_MIN_MATVECS, primme);
+}
+
+int main(int argc, char **argv) {
+
+   int numProblems = argc > 1 ? atoi(argv[1]) : 500;
+   PRIMME_INT n = argc > 2 ? atol(argv[2]) : 200;
+   primme_params *primme;
+   double *shifts, **evals, **rnorms, *evals0, t0, tLoop, tBatch;
+   SCALAR **evecs;
+   PRIMME_INT matvecs = 0;
+   int i, ret, fails = 0;
+
+   primme = (primme_params*)malloc(sizeof(primme_params)*numProblems);
+   shifts = (double*)malloc(sizeof(double)*numProblems);
+   evals0 = (double*)malloc(sizeof(double)*NUMEVALS*numProblems);
+   evals = (double**)malloc(sizeof(double*)*numProblems);
+   rnorms = (double**)malloc(sizeof(double*)*numProblems);
+   evecs = (SCALAR**)malloc(sizeof(SCALAR*)*numProblems);
+   for (i=0; i<numProblems; i++) {
+      shifts[i] = (double)i/numProblems;
+      evals[i] = (double*)malloc(sizeof(double)*NUMEVALS);
+      rnorms[i] = (double*)malloc(sizeof(double)*NUMEVALS);
+      evecs[i] = (SCALAR*)malloc(sizeof(SCALAR)*n*NUMEVALS);
+   }
+
+   printf("numProblems = %d n = %" PRIMME_INT_P " numEvals = %d"
+         " sizeof(SCALAR) = %d\n", numProblems, n, NUMEVALS,
+         (int)sizeof(SCALAR));
+
+   /* One call per problem */
+
+   t0 = primme_get_wtime();
+   for (i=0; i<numProblems; i++) {
+      setup(&primme[i], n, &shifts[i]);
+      ret = Sprimme(evals[i], evecs[i], rnorms[i], &primme[i]);
+      if (ret != 0) {
+         fprintf(stderr, "Error: Sprimme returned %d on problem %d\n", ret, i);
+         return 1;
+      }
+      memcpy(&evals0[NUMEVALS*i], evals[i], sizeof(double)*NUMEVALS);
+      matvecs += primme[i].stats.numMatvecs;
+      primme_free(&primme[i]);
+   }
+   tLoop = primme_get_wtime() - t0;
+
+   /* A single batched call */
+
+   t0 = primme_get_wtime();
+   for (i=0; i<numProblems; i++) {
+      setup(&primme[i], n, &shifts[i]);
+   }
+   ret = Sprimme_batch(evals, evecs, rnorms, numProblems, primme, NULL);
+   tBatch = primme_get_wtime() - t0;
+   if (ret != 0) {
+      fprintf(stderr, "Error: Sprimme_batch returned %d\n", ret);
+      return 1;
+   }
+
+   for (i=0; i<numProblems; i++) {
+      if (memcmp(&evals0[NUMEVALS*i], evals[i], sizeof(double)*NUMEVALS)) {
+         fprintf(stderr, "Problem %d: eigenvalues differ\n", i);
+         fails++;
+      }
+      primme_free(&primme[i]);
+   }
+
+   printf("%-14s %12s %12s\n", "", "Time (s)", "Problems/s");
+   printf("%-14s %12.3f %12.1f\n", "Sprimme", tLoop, numProblems/tLoop);
+   printf("%-14s %12.3f %12.1f\n", "Sprimme_batch", tBatch,
+         numProblems/tBatch);
+   printf("Matvecs per problem: %.1f\n", (double)matvecs/numProblems);
+
+   for (i=0; i<numProblems; i++) {
+      free(evals[i]);
+      free(rnorms[i]);
+      free(evecs[i]);
+   }
+   free(primme);
+   free(shifts);
+   free(evals0);
+   free(evals);
+   free(rnorms);
+   free(evecs);
+
+   return fails ? 1 : 0;
+}
@@ -0,0 +1,127 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2016 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ * File: bench_cacheblock.c
+ *
+ * Purpose - measure the effect of primme.cacheBlockSize.
+ *
+ *  Calling format:
+ *
+ *             bench_cacheblock_double [n [maxBasisSize [maxMatvecs]]]
+ *
+ *  Runs GD+k on the 1-D Laplacian of size n (50000 by default) with a fixed
+ *  number of matrix-vector products, for the autotuned cacheBlockSize and
+ *  for several fixed values. The matrix-vector product is cheap, so the time
+ *  is dominated by the kernels that use cacheBlockSize. It reports the best
+ *  time out of three runs.
+ *
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "primme.h"
+#include "num.h"
+
+static void LaplacianMatvec(void *x, PRIMME_INT *ldx, void *y, PRIMME_INT *ldy,
+      int *blockSize, primme_params *primme, int *ierr) {
+
+   int i;
+   PRIMME_INT j, n = primme->n;
+   SCALAR *xv, *yv;
+
+   for (i=0; i<*blockSize; i++) {
+      xv = (SCALAR*)x + *ldx*i;
+      yv = (SCALAR*)y + *ldy*i;
+      for (j=0; j<n; j++) {
+         yv[j] = 2.0*xv[j];
+         if (j > 0) yv[j] -= xv[j-1];
+         if (j < n-1) yv[j] -= xv[j+1];
+      }
+   }
+   *ierr = 0;
+}
+
+int main(int argc, char **argv) {
+
+   static const int cacheBlockSizes[] = {0, 64, 128, 256, 512, 1024, 2048,
+      4096};
+   int numValues = sizeof(cacheBlockSizes)/sizeof(int);
+   PRIMME_INT n = argc > 1 ? atol(argv[1]) : 50000;
+   int maxBasisSize = argc > 2 ? atoi(argv[2]) : 60;
+   PRIMME_INT maxMatvecs = argc > 3 ? atol(argv[3]) : 200;
+   int numEvals = 4;
+   double *evals, *rnorms, best;
+   SCALAR *evecs;
+   primme_params primme;
+   int i, j, ret;
+
+   evals = (double*)malloc(sizeof(double)*numEvals);
+   rnorms = (double*)malloc(sizeof(double)*numEvals);
+   evecs = (SCALAR*)malloc(sizeof(SCALAR)*n*numEvals);
+
+   printf("n = %" PRIMME_INT_P " maxBasisSize = %d maxMatvecs = %" PRIMME_INT_P
+         " sizeof(SCALAR) = %d\n", n, maxBasisSize, maxMatvecs,
+         (int)sizeof(SCALAR));
+   printf("%16s %12s %10s\n", "cacheBlockSize", "Time (s)", "Matvecs");
+
+   for (i=0; i<numValues; i++) {
+      best = -1.0;
+      for (j=0; j<3; j++) {
+         primme_initialize(&primme);
+         primme.n = n;
+         primme.matrixMatvec = LaplacianMatvec;
+         primme.numEvals = numEvals;
+         primme.maxBasisSize = maxBasisSize;
+         primme.minRestartSize = maxBasisSize/2;
+         primme.maxBlockSize = 1;
+         primme.eps = 1e-14;
+         primme.maxMatvecs = maxMatvecs;
+         primme.printLevel = 0;
+         primme.cacheBlockSize = cacheBlockSizes[i];
+         primme_set_method(PRIMME_GD_Olsen_plusK, &primme);
+
+         ret = Sprimme(evals, evecs, rnorms, &primme);
+         if (ret != 0 && primme.stats.numMatvecs < maxMatvecs) {
+            fprintf(stderr, "Error: Sprimme returned %d\n", ret);
+            return 1;
+         }
+         if (best < 0.0 || primme.stats.elapsedTime < best) {
+            best = primme.stats.elapsedTime;
+         }
+         if (j == 2) {
+            printf("%12d%s %12.3f %10" PRIMME_INT_P "\n",
+                  primme.ctx.cacheBlockSize,
+                  cacheBlockSizes[i] == 0 ? "(a)" : "   ", best,
+                  primme.stats.numMatvecs);
+         }
+         primme_free(&primme);
+      }
+   }
+
+   printf("(a): autotuned value\n");
+
+   free(evals);
+   free(rnorms);
+   free(evecs);
+
+   return 0;
+}
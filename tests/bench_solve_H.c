@@ -0,0 +1,183 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2016 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ * File: bench_solve_H.c
+ *
+ * Purpose - measure the dense eigensolvers for the projected problem.
+ *
+ *  Calling format:
+ *
+ *             bench_solve_H_double [maxBasisSize]
+ *
+ *  For basis sizes from 8 up to maxBasisSize (512 by default), solves the
+ *  eigenproblem of a random Hermitian matrix with solve_H (the Rayleigh-Ritz
+ *  projection, as in every outer iteration), and with xHEEV, xHEEVD, xHEEVR
+ *  and xHEEVR computing only the smallest quarter of the eigenvectors. It
+ *  reports the average time per call in microseconds.
+ *
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "primme.h"
+#include "num.h"
+#include "../src/eigs/solve_projection.h"
+/* wtime.h header file is included so primme's timing functions can be used */
+#include "../src/include/wtime.h"
+
+#define NUMMETHODS 5
+
+static const char *methodNames[NUMMETHODS] = {"solve_H", "heev", "heevd",
+   "heevr", "heevr(n/4)"};
+
+/* Solves the eigenproblem of H with the given method; return 0 on success */
+
+static int solve(int method, int n, SCALAR *H, SCALAR *A, SCALAR *Z,
+      REAL *w, SCALAR *work, size_t lwork, REAL *rwork, int lrwork,
+      int *iwork, int liwork, primme_params *primme) {
+
+   int info = 0, m;
+
+   /* Every method but solve_H and heevr overwrites A with the eigenvectors */
+
+   memcpy(A, H, sizeof(SCALAR)*n*n);
+   switch(method) {
+   case 0:
+      return solve_H_Sprimme(H, n, n, NULL, 0, NULL, 0, NULL, 0, Z, n, w,
+            NULL, 0, 0.0, &lwork, work, liwork, iwork, primme);
+#ifdef USE_COMPLEX
+   case 1:
+      Num_heev_Sprimme("V", "U", n, A, n, w, work, (int)lwork, rwork, &info);
+      break;
+   case 2:
+      Num_heevd_Sprimme("V", "U", n, A, n, w, work, (int)lwork, rwork, lrwork,
+            iwork, liwork, &info);
+      break;
+   case 3: case 4:
+      Num_heevr_Sprimme("V", method == 3 ? "A" : "I", "U", n, A, n, 1,
+            max(1, n/4), &m, w, Z, n, work, (int)lwork, rwork, lrwork,
+            iwork, liwork, &info);
+      break;
+#else
+   case 1:
+      Num_heev_Sprimme("V", "U", n, A, n, w, work, (int)lwork, &info);
+      break;
+   case 2:
+      Num_heevd_Sprimme("V", "U", n, A, n, w, work, (int)lwork, iwork, liwork,
+            &info);
+      break;
+   case 3: case 4:
+      Num_heevr_Sprimme("V", method == 3 ? "A" : "I", "U", n, A, n, 1,
+            max(1, n/4), &m, w, Z, n, work, (int)lwork, iwork, liwork, &info);
+      break;
+#endif
+   }
+   (void)rwork; (void)lrwork; (void)m;
+   return info;
+}
+
+int main(int argc, char **argv) {
+
+   int maxBasisSize = argc > 1 ? atoi(argv[1]) : 512;
+   PRIMME_INT iseed[4] = {1, 2, 3, 5};
+   primme_params primme;
+   SCALAR *H, *A, *Z, *work;
+   REAL *w, *rwork;
+   int *iwork;
+   size_t lwork;
+   int n, i, j, method, reps, lrwork, liwork;
+   double t0, t;
+
+   /* Workspace for the largest basis size and any method */
+
+   primme_initialize(&primme);
+   primme.target = primme_smallest;
+   primme.projectionParams.projection = primme_proj_RR;
+   lwork = 0;
+   liwork = 0;
+   if (solve_H_Sprimme(NULL, maxBasisSize, 0, NULL, 0, NULL, 0, NULL, 0, NULL,
+            0, NULL, NULL, 0, 0.0, &lwork, NULL, 0, &liwork, &primme) != 0) {
+      fprintf(stderr, "Error: solve_H workspace query failed\n");
+      return 1;
+   }
+   n = maxBasisSize;
+   lwork = max(lwork, (size_t)2*n*n + 64*n + 1);
+   lrwork = 2*n*n + 24*n + 1;
+   liwork = max(liwork, 12*n + 3);
+
+   H = (SCALAR*)malloc(sizeof(SCALAR)*n*n);
+   A = (SCALAR*)malloc(sizeof(SCALAR)*n*n);
+   Z = (SCALAR*)malloc(sizeof(SCALAR)*n*n);
+   work = (SCALAR*)malloc(sizeof(SCALAR)*lwork);
+   w = (REAL*)malloc(sizeof(REAL)*n);
+   rwork = (REAL*)malloc(sizeof(REAL)*lrwork);
+   iwork = (int*)malloc(sizeof(int)*liwork);
+
+   printf("sizeof(SCALAR) = %d; time per call in microseconds\n",
+         (int)sizeof(SCALAR));
+   printf("%9s", "basisSize");
+   for (method=0; method<NUMMETHODS; method++) {
+      printf(" %11s", methodNames[method]);
+   }
+   printf("\n");
+
+   for (n=8; n<=maxBasisSize; n*=2) {
+
+      /* Random Hermitian H; only the upper triangular part is referenced */
+
+      Num_larnv_Sprimme(2, iseed, (PRIMME_INT)n*n, H);
+      for (i=0; i<n; i++) {
+         H[n*i+i] = REAL_PART(H[n*i+i]);
+         for (j=0; j<i; j++) H[n*j+i] = CONJ(H[n*i+j]);
+      }
+
+      printf("%9d", n);
+      for (method=0; method<NUMMETHODS; method++) {
+         reps = 0;
+         t0 = primme_get_wtime();
+         do {
+            if (solve(method, n, H, A, Z, w, work, lwork, rwork, lrwork, iwork,
+                     liwork, &primme) != 0) {
+               fprintf(stderr, "Error: %s failed for basisSize %d\n",
+                     methodNames[method], n);
+               return 1;
+            }
+            reps++;
+            t = primme_get_wtime() - t0;
+         } while (t < 0.2);
+         printf(" %11.1f", t/reps*1e6);
+      }
+      printf("\n");
+   }
+
+   primme_free(&primme);
+   free(H);
+   free(A);
+   free(Z);
+   free(work);
+   free(w);
+   free(rwork);
+   free(iwork);
+
+   return 0;
+}
@@ -81,6 +81,11 @@ PetscLogEvent PRIMME_GLOBAL_SUM;
 static int real_main (int argc, char *argv[]);
 static int setMatrixAndPrecond(driver_params *driver, primme_params *primme, int **permutation);
 static int destroyMatrixAndPrecond(driver_params *driver, primme_params *primme, int *permutation);
+#ifdef USE_NATIVE
+static SpMatrix *massMatrix = NULL;
+static void SpMassMatrixMatvec(void *x, PRIMME_INT *ldx, void *y, PRIMME_INT *ldy,
+      int *blockSize, primme_params *primme, int *ierr);
+#endif
 
 
 
@@ -286,6 +291,14 @@ static int real_main (int argc, char *argv[]) {
    }
 
 
+   /* Write the trace of the solver from the master process */
+   if (driver.traceFileName[0] && master) {
+      primme.monitor = fopen(driver.traceFileName, "w");
+      ASSERT_MSG(primme.monitor, 1, "Could not open trace file '%s'\n",
+            driver.traceFileName);
+      primme.monitorFun = primme_monitor_trace;
+   }
+
    /* ------------- */
    /*  Call primme  */
    /* ------------- */
@@ -295,13 +308,35 @@ static int real_main (int argc, char *argv[]) {
    primme_get_time(&ut1,&st1);
 #endif
 
-   ret = Sprimme(evals, evecs, rnorms, &primme);
+   /* Simulate an interrupted run: stop after checkpointInterrupt matvecs */
+   /* and solve again resuming from the last checkpoint                   */
+   if (driver.checkpointInterrupt > 0) {
+      PRIMME_INT maxMatvecs = primme.maxMatvecs;
+      primme.maxMatvecs = driver.checkpointInterrupt;
+      Sprimme(evals, evecs, rnorms, &primme);
+      primme.maxMatvecs = maxMatvecs;
+      primme.checkpointResume = 1;
+   }
+
+   if (driver.numSlices > 0) {
+      ret = Sprimme_slicing(evals, evecs, rnorms, driver.slicingLower,
+            driver.slicingUpper, driver.numSlices, &primme);
+   }
+   else {
+      ret = Sprimme(evals, evecs, rnorms, &primme);
+   }
 
    wt2 = primme_get_wtime();
 #if defined (__unix__) || (defined (__APPLE__) && defined (__MACH__))
    primme_get_time(&ut2,&st2);
 #endif
 
+   if (primme.monitor) {
+      fclose((FILE*)primme.monitor);
+      primme.monitor = NULL;
+      primme.monitorFun = NULL;
+   }
+
    if (driver.checkXFileName[0]) {
       retX = check_solution(driver.checkXFileName, &primme, evals, evecs, rnorms, permutation, driver.checkInterface);
    }
@@ -337,9 +372,11 @@ static int real_main (int argc, char *argv[]) {
       fprintf(primme.outputFile, "Restarts   : %-" PRIMME_INT_P "\n", primme.stats.numRestarts);
       fprintf(primme.outputFile, "Matvecs    : %-" PRIMME_INT_P "\n", primme.stats.numMatvecs);
       fprintf(primme.outputFile, "Preconds   : %-" PRIMME_INT_P "\n", primme.stats.numPreconds);
+      fprintf(primme.outputFile, "Global sums: %-" PRIMME_INT_P "\n", primme.stats.numGlobalSum);
       fprintf(primme.outputFile, "Time matvecs  : %f\n",  primme.stats.timeMatvec);
       fprintf(primme.outputFile, "Time precond  : %f\n",  primme.stats.timePrecond);
       fprintf(primme.outputFile, "Time ortho  : %f\n",  primme.stats.timeOrtho);
+      fprintf(primme.outputFile, "Avg block size: %f\n",  primme.stats.avgBlockSize);
       if (primme.locking && primme.intWork && primme.intWork[0] == 1) {
          fprintf(primme.outputFile, "\nA locking problem has occurred.\n");
          fprintf(primme.outputFile,
@@ -420,6 +457,10 @@ static int setMatrixAndPrecond(driver_params *driver, primme_params *primme, int
 #        endif
       }
    }
+   if (driver->massMatrixFileName[0] && driver->matrixChoice != driver_native) {
+      fprintf(stderr, "ERROR: massMatrixFile is only supported with NATIVE!\n");
+      return -1;
+   }
    switch(driver->matrixChoice) {
    case driver_default:
       assert(0);
@@ -438,17 +479,32 @@ static int setMatrixAndPrecond(driver_params *driver, primme_params *primme, int
 #  endif
       {
          CSRMatrix *matrix, *prec;
+         SpMatrix *spmatrix;
          double *diag;
-         /* Fix to use a single thread */
-         #ifdef _OPENMP
-         omp_set_num_threads(1);
-         #endif
           
          if (readMatrixNative(driver->matrixFileName, &matrix, &aNorm) !=0 )
             return -1;
-         primme->matrix = matrix;
-         primme->matrixMatvec = CSRMatrixMatvec;
+         if (createSpMatrix(matrix, driver->sellChunkSize, driver->sellSigma,
+                  &spmatrix) != 0)
+            return -1;
+         primme->matrix = spmatrix;
+         primme->matrixMatvec = SpMatrixMatvec;
          primme->n = primme->nLocal = matrix->n;
+         if (driver->massMatrixFileName[0]) {
+            CSRMatrix *B;
+            double bNorm;
+            if (readMatrixNative(driver->massMatrixFileName, &B, &bNorm) != 0)
+               return -1;
+            if (B->n != matrix->n) {
+               fprintf(stderr, "ERROR: the mass matrix should have the same size as the matrix!\n");
+               return -1;
+            }
+            if (createSpMatrix(B, driver->sellChunkSize, driver->sellSigma,
+                     &massMatrix) != 0)
+               return -1;
+            primme->massMatrixMatvec = SpMassMatrixMatvec;
+            freeCSRMatrix(B);
+         }
          switch(driver->PrecChoice) {
          case driver_noprecond:
             primme->preconditioner = NULL;
@@ -474,6 +530,7 @@ static int setMatrixAndPrecond(driver_params *driver, primme_params *primme, int
             fprintf(stderr, "ERROR: preconditioner is not supported with NATIVE, use other!\n");
             return -1;
          }
+         freeCSRMatrix(matrix);
       }
 #endif
       break;
@@ -614,6 +671,8 @@ static int setMatrixAndPrecond(driver_params *driver, primme_params *primme, int
 
 #if defined(USE_MPI)
    primme->globalSumReal = par_GlobalSumDouble;
+   primme->globalSumRealStart = par_GlobalSumDoubleStart;
+   primme->globalSumRealWait = par_GlobalSumDoubleWait;
 #endif
 
 #ifdef NOT_USE_ALIGNMENT
@@ -632,7 +691,11 @@ static int destroyMatrixAndPrecond(driver_params *driver, primme_params *primme,
       fprintf(stderr, "ERROR: NATIVE is needed!\n");
       return -1;
 #else
-      freeCSRMatrix((CSRMatrix*)primme->matrix);
+      freeSpMatrix((SpMatrix*)primme->matrix);
+      if (massMatrix) {
+         freeSpMatrix(massMatrix);
+         massMatrix = NULL;
+      }
 
       switch(driver->PrecChoice) {
       case driver_noprecond:
@@ -722,3 +785,20 @@ static int destroyMatrixAndPrecond(driver_params *driver, primme_params *primme,
    if (permutation) free(permutation);
    return 0;
 }
+
+#ifdef USE_NATIVE
+/******************************************************************************
+ * Applies the mass matrix B read from driver.massMatrixFile,
+ *
+ *    y(:,i) = B*x(:,i), i=0:blockSize-1
+ *
+******************************************************************************/
+
+static void SpMassMatrixMatvec(void *x, PRIMME_INT *ldx, void *y, PRIMME_INT *ldy,
+      int *blockSize, primme_params *primme, int *ierr) {
+
+   (void)primme; /* unused parameter */
+   SpMatrixApply(massMatrix, (SCALAR*)x, *ldx, (SCALAR*)y, *ldy, *blockSize);
+   *ierr = 0;
+}
+#endif
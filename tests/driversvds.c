@@ -363,7 +363,7 @@ static int real_main (int argc, char *argv[]) {
          fprintf(primme_svds.outputFile, "Sval[%d]: %-22.15E rnorm: %-22.15E\n", i+1,
             svals[i], rnorms[i]); 
       }
-      fprintf(primme_svds.outputFile, "%d singular triplets converged\n", primme_svds.primme.initSize);
+      fprintf(primme_svds.outputFile, "%d singular triplets converged\n", primme_svds.initSize);
 
       fprintf(primme_svds.outputFile, "Tolerance : %-22.15E\n", 
                                                             primme_svds.aNorm*primme_svds.eps);
@@ -469,16 +469,19 @@ static int setMatrixAndPrecond(driver_params *driver,
 #  endif
       {
          CSRMatrix *matrix;
+         SpMatrix *spmatrix;
          double *diag;
-         /* Fix to use a single thread */
-         #ifdef _OPENMP
-         omp_set_num_threads(1);
-         #endif
           
          if (readMatrixNative(driver->matrixFileName, &matrix, &aNorm) !=0 )
             return -1;
-         primme_svds->matrix = matrix;
-         primme_svds->matrixMatvec = CSRMatrixMatvecSVD;
+         if (createSpMatrix(matrix, driver->sellChunkSize, driver->sellSigma,
+                  &spmatrix) != 0)
+            return -1;
+         primme_svds->matrix = spmatrix;
+         primme_svds->matrixMatvec = SpMatrixMatvecSVD;
+         if (driver->normalMatvec) {
+            primme_svds->matrixNormalMatvec = SpMatrixNormalMatvecSVD;
+         }
          primme_svds->m = primme_svds->mLocal = matrix->m;
          primme_svds->n = primme_svds->nLocal = matrix->n;
          switch(driver->PrecChoice) {
@@ -503,6 +506,7 @@ static int setMatrixAndPrecond(driver_params *driver,
             fprintf(stderr, "ERROR: preconditioner is not supported with NATIVE, use other!\n");
             return -1;
          }
+         freeCSRMatrix(matrix);
       }
 #endif
       break;
@@ -751,7 +755,7 @@ static int destroyMatrixAndPrecond(driver_params *driver, primme_svds_params *pr
       fprintf(stderr, "ERROR: NATIVE is needed!\n");
       return -1;
 #else
-      freeCSRMatrix((CSRMatrix*)primme_svds->matrix);
+      freeSpMatrix((SpMatrix*)primme_svds->matrix);
 
       switch(driver->PrecChoice) {
       case driver_noprecond:
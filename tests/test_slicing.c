@@ -0,0 +1,170 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2016 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ * File: test_slicing.c
+ *
+ * Purpose - check that the windows of the spectrum slicing do not share
+ *           their primme_params.
+ *
+ *  Calling format:
+ *
+ *             test_slicing_double [n]
+ *
+ *  Computes with Sprimme_slicing the ten smallest eigenvalues of the 1-D
+ *  Laplacian of size n (300 by default), and checks that no two callbacks
+ *  with the same primme_params were running at the same time. If PRIMME is
+ *  compiled with OpenMP, the windows are solved concurrently.
+ *
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "primme.h"
+#include "num.h"
+
+#define NUMSLICES 5
+#define NUMEVALS 40
+
+static void LaplacianMatvec(void *x, PRIMME_INT *ldx, void *y, PRIMME_INT *ldy,
+      int *blockSize, primme_params *primme, int *ierr) {
+
+   int i;
+   PRIMME_INT j, n = primme->n;
+   SCALAR *xv, *yv;
+
+   for (i=0; i<*blockSize; i++) {
+      xv = (SCALAR*)x + *ldx*i;
+      yv = (SCALAR*)y + *ldy*i;
+      for (j=0; j<n; j++) {
+         yv[j] = 2.0*xv[j];
+         if (j > 0) yv[j] -= xv[j-1];
+         if (j < n-1) yv[j] -= xv[j+1];
+      }
+   }
+   *ierr = 0;
+}
+
+/* The primme_params whose callbacks are running, to detect if the same     */
+/* struct is passed to concurrent calls                                     */
+
+#define MAX_ACTIVE 64
+static pthread_mutex_t activeLock = PTHREAD_MUTEX_INITIALIZER;
+static primme_params *active[MAX_ACTIVE];
+static int numActive = 0, overlaps = 0;
+
+static void enter_callback(primme_params *primme) {
+   int i;
+
+   pthread_mutex_lock(&activeLock);
+   for (i=0; i<numActive; i++) if (active[i] == primme) overlaps++;
+   if (numActive < MAX_ACTIVE) active[numActive++] = primme;
+   pthread_mutex_unlock(&activeLock);
+}
+
+static void leave_callback(primme_params *primme) {
+   int i;
+
+   pthread_mutex_lock(&activeLock);
+   for (i=0; i<numActive && active[i] != primme; i++);
+   if (i < numActive) active[i] = active[--numActive];
+   pthread_mutex_unlock(&activeLock);
+}
+
+static void CheckedLaplacianMatvec(void *x, PRIMME_INT *ldx, void *y,
+      PRIMME_INT *ldy, int *blockSize, primme_params *primme, int *ierr) {
+
+   enter_callback(primme);
+   LaplacianMatvec(x, ldx, y, ldy, blockSize, primme, ierr);
+   leave_callback(primme);
+}
+
+static void CheckedGlobalSum(void *sendBuf, void *recvBuf, int *count,
+      primme_params *primme, int *ierr) {
+
+   enter_callback(primme);
+   usleep(100);   /* Make overlapping calls more likely */
+   memmove(recvBuf, sendBuf, sizeof(double)*(*count));
+   leave_callback(primme);
+   *ierr = 0;
+}
+
+int main(int argc, char **argv) {
+
+   PRIMME_INT n = argc > 1 ? atol(argv[1]) : 300;
+   primme_params primme;
+   double evals[NUMEVALS], rnorms[NUMEVALS], upper, pi;
+   SCALAR *evecs;
+   int i, ret, fails = 0;
+
+   /* The eigenvalues of the Laplacian are 2 - 2*cos(k*pi/(n+1)); take an */
+   /* interval with ten of them                                           */
+
+   pi = acos(-1.0);
+   upper = 2.0 - 2.0*cos(10.5*pi/(n+1));
+
+   evecs = (SCALAR*)malloc(sizeof(SCALAR)*n*NUMEVALS);
+
+   primme_initialize(&primme);
+   primme.n = n;
+   primme.matrixMatvec = CheckedLaplacianMatvec;
+   primme.globalSumReal = CheckedGlobalSum;
+   primme.numEvals = NUMEVALS;
+   primme.eps = 1e-9;
+   primme.printLevel = 0;
+
+   ret = Sprimme_slicing(evals, evecs, rnorms, 0.0, upper, NUMSLICES,
+         &primme);
+   if (ret != 0) {
+      fprintf(stderr, "Error: Sprimme_slicing returned %d\n", ret);
+      fails++;
+   }
+   else if (primme.initSize != 10) {
+      fprintf(stderr, "Error: %d eigenvalues returned, 10 expected\n",
+            primme.initSize);
+      fails++;
+   }
+   else {
+      for (i=0; i<primme.initSize; i++) {
+         if (fabs(evals[i] - (2.0 - 2.0*cos((i+1)*pi/(n+1)))) > 1e-8) {
+            fprintf(stderr, "Error: eigenvalue %d is %g\n", i, evals[i]);
+            fails++;
+         }
+      }
+   }
+   if (overlaps > 0) {
+      fprintf(stderr, "Error: %d callbacks overlapped with another one on "
+            "the same primme_params\n", overlaps);
+      fails++;
+   }
+
+   printf("Slicing with %d windows, %" PRIMME_INT_P " matvecs: %s\n",
+         NUMSLICES, primme.stats.numMatvecs, fails ? "FAILED" : "passed");
+
+   primme_free(&primme);
+   free(evecs);
+
+   return fails ? 1 : 0;
+}
@@ -0,0 +1,171 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2016 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ * File: test_threads.c
+ *
+ * Purpose - check that concurrent calls to the solver do not interfere.
+ *
+ *  Calling format:
+ *
+ *             test_threads_double [numThreads [n]]
+ *
+ *  Solves the 1-D Laplacian of size n (3000 by default) once, and then
+ *  numThreads times (4 by default) concurrently from different threads.
+ *  Every concurrent solve should return the same eigenvalues and number of
+ *  matrix-vector products as the first one, and its primme.stats.elapsedTime
+ *  should match the time measured by the calling thread.
+ *
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include "primme.h"
+#include "num.h"
+/* wtime.h header file is included so primme's timing functions can be used */
+#include "../src/include/wtime.h"
+
+#define NUMEVALS 6
+
+typedef struct {
+   PRIMME_INT n;
+   double evals[NUMEVALS];
+   PRIMME_INT numMatvecs;
+   double elapsedTime;     /* primme.stats.elapsedTime */
+   double wallTime;        /* time measured around the call */
+   double timeMatvec;      /* primme.stats.timeMatvec */
+   int ret;
+} solve_t;
+
+static void LaplacianMatvec(void *x, PRIMME_INT *ldx, void *y, PRIMME_INT *ldy,
+      int *blockSize, primme_params *primme, int *ierr) {
+
+   int i;
+   PRIMME_INT j, n = primme->n;
+   SCALAR *xv, *yv;
+
+   for (i=0; i<*blockSize; i++) {
+      xv = (SCALAR*)x + *ldx*i;
+      yv = (SCALAR*)y + *ldy*i;
+      for (j=0; j<n; j++) {
+         yv[j] = 2.0*xv[j];
+         if (j > 0) yv[j] -= xv[j-1];
+         if (j < n-1) yv[j] -= xv[j+1];
+      }
+   }
+   *ierr = 0;
+}
+
+static void *solve(void *arg) {
+
+   solve_t *s = (solve_t*)arg;
+   primme_params primme;
+   double rnorms[NUMEVALS], t0;
+   SCALAR *evecs;
+
+   evecs = (SCALAR*)malloc(sizeof(SCALAR)*s->n*NUMEVALS);
+
+   primme_initialize(&primme);
+   primme.n = s->n;
+   primme.matrixMatvec = LaplacianMatvec;
+   primme.numEvals = NUMEVALS;
+   primme.eps = 1e-9;
+   primme.printLevel = 0;
+   primme_set_method(PRIMME_DEFAULT_MIN_MATVECS, &primme);
+
+   t0 = primme_get_wtime();
+   s->ret = Sprimme(s->evals, evecs, rnorms, &primme);
+   s->wallTime = primme_get_wtime() - t0;
+   s->numMatvecs = primme.stats.numMatvecs;
+   s->elapsedTime = primme.stats.elapsedTime;
+   s->timeMatvec = primme.stats.timeMatvec;
+
+   primme_free(&primme);
+   free(evecs);
+   return NULL;
+}
+
+int main(int argc, char **argv) {
+
+   int numThreads = argc > 1 ? atoi(argv[1]) : 4;
+   PRIMME_INT n = argc > 2 ? atol(argv[2]) : 3000;
+   solve_t ref, *s;
+   pthread_t *threads;
+   int i, fails = 0;
+
+   /* Reference solve */
+
+   ref.n = n;
+   solve(&ref);
+   if (ref.ret != 0) {
+      fprintf(stderr, "Error: Sprimme returned %d\n", ref.ret);
+      return 1;
+   }
+
+   /* Concurrent solves */
+
+   s = (solve_t*)malloc(sizeof(solve_t)*numThreads);
+   threads = (pthread_t*)malloc(sizeof(pthread_t)*numThreads);
+   for (i=0; i<numThreads; i++) {
+      s[i].n = n;
+      if (pthread_create(&threads[i], NULL, solve, &s[i]) != 0) {
+         fprintf(stderr, "Error: pthread_create failed\n");
+         return 1;
+      }
+   }
+   for (i=0; i<numThreads; i++) {
+      pthread_join(threads[i], NULL);
+   }
+
+   /* Check that the results are the same as in the reference solve, and */
+   /* that every solve measured its own time                              */
+
+   for (i=0; i<numThreads; i++) {
+      if (s[i].ret != 0) {
+         fprintf(stderr, "Thread %d: Sprimme returned %d\n", i, s[i].ret);
+         fails++;
+      }
+      else if (memcmp(s[i].evals, ref.evals, sizeof(ref.evals)) != 0
+            || s[i].numMatvecs != ref.numMatvecs) {
+         fprintf(stderr, "Thread %d: results differ from the serial solve\n",
+               i);
+         fails++;
+      }
+      else if (s[i].elapsedTime > s[i].wallTime
+            || s[i].elapsedTime < 0.9*s[i].wallTime - 1e-2
+            || s[i].timeMatvec > s[i].elapsedTime) {
+         fprintf(stderr, "Thread %d: elapsedTime %g, timeMatvec %g, "
+               "measured %g\n", i, s[i].elapsedTime, s[i].timeMatvec,
+               s[i].wallTime);
+         fails++;
+      }
+   }
+
+   printf("%d concurrent solves, %" PRIMME_INT_P " matvecs each: %s\n",
+         numThreads, ref.numMatvecs, fails ? "FAILED" : "passed");
+
+   free(s);
+   free(threads);
+
+   return fails ? 1 : 0;
+}
@@ -0,0 +1,152 @@
+/*******************************************************************************
+ *   PRIMME PReconditioned Iterative MultiMethod Eigensolver
+ *   Copyright (C) 2016 College of William & Mary,
+ *   James R. McCombs, Eloy Romero Alcalde, Andreas Stathopoulos, Lingfei Wu
+ *
+ *   This file is part of PRIMME.
+ *
+ *   PRIMME is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU Lesser General Public
+ *   License as published by the Free Software Foundation; either
+ *   version 2.1 of the License, or (at your option) any later version.
+ *
+ *   PRIMME is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public
+ *   License along with this library; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *******************************************************************************
+ *******************************************************************************
+ * File: test_warm_start.c
+ *
+ * Purpose - check that primme.warmStart reduces the matrix-vector products
+ *           in a sequence of slowly varying problems.
+ *
+ *  Calling format:
+ *
+ *             test_warm_start_double [numSteps [n]]
+ *
+ *  Solves numSteps (10 by default) tridiagonal problems A_k of size n (2000
+ *  by default) with -1 off the diagonal and a diagonal that changes a little
+ *  from one step to the next. The sequence is solved
+ *  twice, passing the eigenvectors of the previous step as initial guesses,
+ *  and keeping the basis between calls with primme.warmStart. Both should
+ *  return the same eigenvalues, and the second one should take fewer
+ *  matrix-vector products.
+ *
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include "primme.h"
+#include "num.h"
+
+#define NUMEVALS 6
+
+/* y = A_k*x, where k is in matrix */
+
+static void PerturbedMatvec(void *x, PRIMME_INT *ldx, void *y,
+      PRIMME_INT *ldy, int *blockSize, primme_params *primme, int *ierr) {
+
+   int i;
+   PRIMME_INT j, n = primme->n;
+   int k = *(int*)primme->matrix;
+   SCALAR *xv, *yv;
+
+   for (i=0; i<*blockSize; i++) {
+      xv = (SCALAR*)x + *ldx*i;
+      yv = (SCALAR*)y + *ldy*i;
+      for (j=0; j<n; j++) {
+         yv[j] = (1.0 + 0.01*j + 1e-3*k*sin(0.01*j))*xv[j];
+         if (j > 0) yv[j] -= xv[j-1];
+         if (j < n-1) yv[j] -= xv[j+1];
+      }
+   }
+   *ierr = 0;
+}
+
+/* Solve the sequence and return the total number of matvecs, or -1 */
+
+static PRIMME_INT solve_sequence(int numSteps, PRIMME_INT n, int warmStart,
+      double *evals) {
+
+   primme_params primme;
+   double rnorms[NUMEVALS];
+   SCALAR *evecs;
+   PRIMME_INT matvecs = 0;
+   int k, ret;
+
+   evecs = (SCALAR*)malloc(sizeof(SCALAR)*n*NUMEVALS);
+
+   primme_initialize(&primme);
+   primme.n = n;
+   primme.matrixMatvec = PerturbedMatvec;
+   primme.matrix = &k;
+   primme.numEvals = NUMEVALS;
+   primme.eps = 1e-9;
+   primme.printLevel = 0;
+   primme.warmStart = warmStart;
+   primme.maxBasisSize = 24;
+   primme.minRestartSize = 12;
+   primme_set_method(PRIMME_DEFAULT_MIN_MATVECS, &primme);
+
+   for (k=0; k<numSteps; k++) {
+      primme.initSize = k > 0 ? NUMEVALS : 0;
+      ret = Sprimme(&evals[NUMEVALS*k], evecs, rnorms, &primme);
+      if (ret != 0) {
+         fprintf(stderr, "Error: Sprimme returned %d at step %d\n", ret, k);
+         matvecs = -1;
+         break;
+      }
+      matvecs += primme.stats.numMatvecs;
+   }
+
+   primme_free(&primme);
+   free(evecs);
+   return matvecs;
+}
+
+int main(int argc, char **argv) {
+
+   int numSteps = argc > 1 ? atoi(argv[1]) : 10;
+   PRIMME_INT n = argc > 2 ? atol(argv[2]) : 2000;
+   PRIMME_INT coldMatvecs, warmMatvecs;
+   double *cold, *warm;
+   int i, fails = 0;
+
+   cold = (double*)malloc(sizeof(double)*NUMEVALS*numSteps);
+   warm = (double*)malloc(sizeof(double)*NUMEVALS*numSteps);
+
+   coldMatvecs = solve_sequence(numSteps, n, 0, cold);
+   warmMatvecs = solve_sequence(numSteps, n, 1, warm);
+   if (coldMatvecs < 0 || warmMatvecs < 0) return 1;
+
+   /* Check that both sequences return the same eigenvalues, up to the */
+   /* tolerance, and that the warm start saves matvecs                 */
+
+   for (i=0; i<NUMEVALS*numSteps; i++) {
+      if (fabs(cold[i] - warm[i]) > 1e-8) {
+         fprintf(stderr, "Step %d: eigenvalue %g differs from %g\n",
+               i/NUMEVALS, warm[i], cold[i]);
+         fails++;
+      }
+   }
+   if (warmMatvecs >= coldMatvecs) {
+      fprintf(stderr, "The warm start did not reduce the matvecs\n");
+      fails++;
+   }
+
+   printf("%d steps, matvecs with initial guesses %" PRIMME_INT_P
+         ", with warm start %" PRIMME_INT_P ": %s\n", numSteps, coldMatvecs,
+         warmMatvecs, fails ? "FAILED" : "passed");
+
+   free(cold);
+   free(warm);
+
+   return fails ? 1 : 0;
+}